@@ -39,7 +39,16 @@
 #include <CommonConstants/PhysicsConstants.h>
 #include <Framework/Logger.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <map>
+#include <span>
 #include <string>
 
 namespace o2
@@ -49,6 +58,156 @@ namespace delphes
 
 /*****************************************************************/
 
+void LutTable::reset()
+{
+  if (mMappedData) {
+    munmap(mMappedData, mMappedSize);
+    mMappedData = nullptr;
+    mMappedSize = 0;
+  }
+  mOwnedEntries.clear();
+  mOwnedEntries.shrink_to_fit();
+  mEntries = nullptr;
+  mNEntries = 0;
+  mHeader = lutHeader_t();
+}
+
+/*****************************************************************/
+
+bool LutTable::load(const char* filename)
+{
+  reset();
+  std::ifstream lutFile(filename, std::ifstream::binary);
+  if (!lutFile.is_open()) {
+    LOG(info) << " --- cannot open covariance matrix file: " << filename;
+    return false;
+  }
+  char magic[sizeof(lutFlatHeader_t::magic)] = {0};
+  lutFile.read(magic, sizeof(magic));
+  const bool isFlat = (lutFile.gcount() == sizeof(magic) && std::memcmp(magic, lutFlatHeader_t().magic, sizeof(magic)) == 0);
+  lutFile.close();
+  return isFlat ? loadFlat(filename) : loadLegacy(filename);
+}
+
+/*****************************************************************/
+
+bool LutTable::loadFlat(const char* filename)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    LOG(info) << " --- cannot open flat covariance matrix file: " << filename;
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || static_cast<std::size_t>(fileStat.st_size) < sizeof(lutFlatHeader_t)) {
+    LOG(info) << " --- troubles reading flat covariance matrix header: " << filename;
+    close(fd);
+    return false;
+  }
+  const std::size_t fileSize = fileStat.st_size;
+  void* data = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // the mapping stays valid after closing the file, and even after removing it
+  if (data == MAP_FAILED) {
+    LOG(info) << " --- cannot map flat covariance matrix file: " << filename;
+    return false;
+  }
+  mMappedData = data;
+  mMappedSize = fileSize;
+
+  lutFlatHeader_t flatHeader;
+  std::memcpy(&flatHeader, data, sizeof(lutFlatHeader_t));
+  if (flatHeader.version != LUTFLAT_VERSION || flatHeader.headerSize != sizeof(lutHeader_t) || flatHeader.entrySize != sizeof(lutEntry_t)) {
+    LOG(info) << " --- flat LUT layout mismatch: expected/detected version = " << LUTFLAT_VERSION << "/" << flatHeader.version
+              << ", header size = " << sizeof(lutHeader_t) << "/" << flatHeader.headerSize
+              << ", entry size = " << sizeof(lutEntry_t) << "/" << flatHeader.entrySize;
+    reset();
+    return false;
+  }
+  mHeader = flatHeader.lutHeader;
+  const std::size_t nEntries = static_cast<std::size_t>(mHeader.nchmap.nbins) * mHeader.radmap.nbins * mHeader.etamap.nbins * mHeader.ptmap.nbins;
+  if (nEntries != flatHeader.nEntries || flatHeader.entriesOffset % alignof(lutEntry_t) != 0 || flatHeader.entriesOffset + nEntries * sizeof(lutEntry_t) > fileSize) {
+    LOG(info) << " --- troubles reading flat covariance matrix entries: " << filename;
+    reset();
+    return false;
+  }
+  mNEntries = nEntries;
+  mEntries = reinterpret_cast<const lutEntry_t*>(static_cast<const char*>(data) + flatHeader.entriesOffset);
+  return true;
+}
+
+/*****************************************************************/
+
+bool LutTable::loadLegacy(const char* filename)
+{
+  std::ifstream lutFile(filename, std::ifstream::binary);
+  if (!lutFile.is_open()) {
+    LOG(info) << " --- cannot open covariance matrix file: " << filename;
+    return false;
+  }
+  lutFile.read(reinterpret_cast<char*>(&mHeader), sizeof(lutHeader_t));
+  if (lutFile.gcount() != sizeof(lutHeader_t)) {
+    LOG(info) << " --- troubles reading covariance matrix header: " << filename;
+    return false;
+  }
+  const std::size_t nEntries = static_cast<std::size_t>(mHeader.nchmap.nbins) * mHeader.radmap.nbins * mHeader.etamap.nbins * mHeader.ptmap.nbins;
+  mOwnedEntries.resize(nEntries);
+  lutFile.read(reinterpret_cast<char*>(mOwnedEntries.data()), nEntries * sizeof(lutEntry_t));
+  if (static_cast<std::size_t>(lutFile.gcount()) != nEntries * sizeof(lutEntry_t)) {
+    LOG(info) << " --- troubles reading covariance matrix entries: " << filename;
+    reset();
+    return false;
+  }
+  mNEntries = nEntries;
+  mEntries = mOwnedEntries.data();
+  return true;
+}
+
+/*****************************************************************/
+
+bool LutTable::write(const char* filename) const
+{
+  if (!mEntries) {
+    LOG(info) << " --- no LUT to write to " << filename;
+    return false;
+  }
+  std::ofstream lutFile(filename, std::ofstream::binary);
+  if (!lutFile.is_open()) {
+    LOG(info) << " --- cannot open flat covariance matrix file for writing: " << filename;
+    return false;
+  }
+  static constexpr std::size_t kEntriesAlignment = 64; // cache line
+  lutFlatHeader_t flatHeader;
+  flatHeader.nEntries = mNEntries;
+  flatHeader.entriesOffset = (sizeof(lutFlatHeader_t) + kEntriesAlignment - 1) / kEntriesAlignment * kEntriesAlignment;
+  flatHeader.lutHeader = mHeader;
+  const std::vector<char> padding(flatHeader.entriesOffset - sizeof(lutFlatHeader_t), 0);
+  lutFile.write(reinterpret_cast<const char*>(&flatHeader), sizeof(lutFlatHeader_t));
+  lutFile.write(padding.data(), padding.size());
+  lutFile.write(reinterpret_cast<const char*>(mEntries), mNEntries * sizeof(lutEntry_t));
+  if (!lutFile.good()) {
+    LOG(info) << " --- troubles writing flat covariance matrix file: " << filename;
+    return false;
+  }
+  return true;
+}
+
+/*****************************************************************/
+
+bool LutTable::convert(const char* inFilename, const char* outFilename)
+{
+  LutTable lut;
+  if (!lut.load(inFilename)) {
+    return false;
+  }
+  if (!lut.write(outFilename)) {
+    return false;
+  }
+  LOG(info) << " --- converted LUT " << inFilename << " to flat LUT " << outFilename;
+  return true;
+}
+
+/*****************************************************************/
+
 bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
 {
   if (!filename || filename[0] == '\0') {
@@ -57,7 +216,7 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
   }
   const auto ipdg = getIndexPDG(pdg);
   LOGF(info, "Will load %s lut file ..: '%s'", getParticleName(pdg), filename);
-  if (mLUTHeader[ipdg] && !forceReload) {
+  if (mLUT[ipdg] && !forceReload) {
     LOG(info) << " --- LUT table for PDG " << pdg << " has been already loaded with index " << ipdg << std::endl;
     return false;
   }
@@ -65,10 +224,20 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
     LOG(info) << " --- LUT file source identified as CCDB.";
     std::string path = std::string(filename).substr(5); // Remove "ccdb:" prefix
     const std::string outPath = "/tmp/LUTs/";
-    filename = Form("%s/%s/snapshot.root", outPath.c_str(), path.c_str());
-    LOG(info) << " --- Local LUT filename will be: " << filename;
-    std::ifstream checkFile(filename); // Check if file already exists
-    if (!checkFile.is_open()) {        // File does not exist, retrieve from CCDB
+    const std::string localFilename = Form("%s/%s/snapshot.root", outPath.c_str(), path.c_str());
+    // The downloaded LUT is converted once into a flat LUT next to it, which is then memory-mapped,
+    // so that the processes loading the same LUT share its pages
+    const std::string flatFilename = localFilename + ".flat";
+    LOG(info) << " --- Local LUT filename will be: " << localFilename;
+    std::ifstream checkFlatFile(flatFilename); // Check if the flat LUT already exists
+    if (checkFlatFile.is_open()) {
+      LOG(info) << " --- Flat LUT file already exists: " << flatFilename << ". Skipping download.";
+      checkFlatFile.close();
+      return loadTable(pdg, flatFilename.c_str(), forceReload);
+    }
+    bool downloaded = false;
+    std::ifstream checkFile(localFilename); // Check if file already exists
+    if (!checkFile.is_open()) {             // File does not exist, retrieve from CCDB
       LOG(info) << " --- CCDB source detected for PDG " << pdg << ": " << path;
       if (!mCcdbManager) {
         LOG(fatal) << " --- CCDB manager not set. Please set it before loading LUT from CCDB.";
@@ -76,143 +245,120 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
       std::map<std::string, std::string> metadata;
       mCcdbManager->getCCDBAccessor().retrieveBlob(path, outPath, metadata, 1);
       // Add CCDB handling logic here if needed
-      LOG(info) << " --- Now retrieving LUT file from CCDB to: " << filename;
-      if (mCleanupDownloadedFile) { // Clean up the downloaded file if needed
-        bool status = loadTable(pdg, filename, forceReload);
-        if (std::remove(filename) != 0) {
-          LOG(warn) << " --- Could not remove temporary LUT file: " << filename;
+      LOG(info) << " --- Now retrieving LUT file from CCDB to: " << localFilename;
+      downloaded = true;
+    } else { // File exists, proceed to load
+      LOG(info) << " --- LUT file already exists: " << localFilename << ". Skipping download.";
+      checkFile.close();
+    }
+    // Convert into a temporary file first, so that concurrent processes never map a partially written flat LUT
+    const std::string tmpFlatFilename = flatFilename + "." + std::to_string(getpid());
+    bool status = false;
+    if (LutTable::convert(localFilename.c_str(), tmpFlatFilename.c_str()) && std::rename(tmpFlatFilename.c_str(), flatFilename.c_str()) == 0) {
+      status = loadTable(pdg, flatFilename.c_str(), forceReload);
+    } else {
+      LOG(warn) << " --- Could not convert LUT file " << localFilename << " to a flat LUT, loading it directly";
+      std::remove(tmpFlatFilename.c_str());
+      status = loadTable(pdg, localFilename.c_str(), forceReload);
+    }
+    if (downloaded && mCleanupDownloadedFile) { // Clean up the downloaded file if needed, the flat LUT stays mapped after removal
+      for (const auto& file : {localFilename, flatFilename}) {
+        if (std::remove(file.c_str()) != 0) {
+          LOG(warn) << " --- Could not remove temporary LUT file: " << file;
         } else {
-          LOG(info) << " --- Removed temporary LUT file: " << filename;
+          LOG(info) << " --- Removed temporary LUT file: " << file;
         }
-        return status;
       }
-    } else { // File exists, proceed to load
-      LOG(info) << " --- LUT file already exists: " << filename << ". Skipping download.";
-      checkFile.close();
     }
-    return loadTable(pdg, filename, forceReload);
+    return status;
   }
 
-  mLUTHeader[ipdg] = new lutHeader_t;
-
-  std::ifstream lutFile(filename, std::ifstream::binary);
-  if (!lutFile.is_open()) {
-    LOG(info) << " --- cannot open covariance matrix file for PDG " << pdg << ": " << filename << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
-    return false;
-  }
-  lutFile.read(reinterpret_cast<char*>(mLUTHeader[ipdg]), sizeof(lutHeader_t));
-  if (lutFile.gcount() != sizeof(lutHeader_t)) {
-    LOG(info) << " --- troubles reading covariance matrix header for PDG " << pdg << ": " << filename << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+  auto lut = std::make_unique<LutTable>();
+  if (!lut->load(filename)) {
+    LOG(info) << " --- cannot load covariance matrix table for PDG " << pdg << ": " << filename << std::endl;
     return false;
   }
-  if (mLUTHeader[ipdg]->version != LUTCOVM_VERSION) {
-    LOG(info) << " --- LUT header version mismatch: expected/detected = " << LUTCOVM_VERSION << "/" << mLUTHeader[ipdg]->version << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+  lutHeader_t* lutHeader = lut->getHeader();
+  if (lutHeader->version != LUTCOVM_VERSION) {
+    LOG(info) << " --- LUT header version mismatch: expected/detected = " << LUTCOVM_VERSION << "/" << lutHeader->version << std::endl;
     return false;
   }
   bool specialPdgCase = false;
   switch (pdg) {                         // Handle special cases
     case o2::constants::physics::kAlpha: // Special case: Allow Alpha particles to use He3 LUT
-      specialPdgCase = (mLUTHeader[ipdg]->pdg == o2::constants::physics::kHelium3);
+      specialPdgCase = (lutHeader->pdg == o2::constants::physics::kHelium3);
       if (specialPdgCase)
         LOG(info)
-          << " --- Alpha particles (PDG " << pdg << ") will use He3 LUT data (PDG " << mLUTHeader[ipdg]->pdg << ")" << std::endl;
+          << " --- Alpha particles (PDG " << pdg << ") will use He3 LUT data (PDG " << lutHeader->pdg << ")" << std::endl;
       break;
     default:
       break;
   }
-  if (mLUTHeader[ipdg]->pdg != pdg && !specialPdgCase) {
-    LOG(info) << " --- LUT header PDG mismatch: expected/detected = " << pdg << "/" << mLUTHeader[ipdg]->pdg << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+  if (lutHeader->pdg != pdg && !specialPdgCase) {
+    LOG(info) << " --- LUT header PDG mismatch: expected/detected = " << pdg << "/" << lutHeader->pdg << std::endl;
     return false;
   }
-  const int nnch = mLUTHeader[ipdg]->nchmap.nbins;
-  const int nrad = mLUTHeader[ipdg]->radmap.nbins;
-  const int neta = mLUTHeader[ipdg]->etamap.nbins;
-  const int npt = mLUTHeader[ipdg]->ptmap.nbins;
-  mLUTEntry[ipdg] = new lutEntry_t****[nnch];
-  for (int inch = 0; inch < nnch; ++inch) {
-    mLUTEntry[ipdg][inch] = new lutEntry_t***[nrad];
-    for (int irad = 0; irad < nrad; ++irad) {
-      mLUTEntry[ipdg][inch][irad] = new lutEntry_t**[neta];
-      for (int ieta = 0; ieta < neta; ++ieta) {
-        mLUTEntry[ipdg][inch][irad][ieta] = new lutEntry_t*[npt];
-        for (int ipt = 0; ipt < npt; ++ipt) {
-          mLUTEntry[ipdg][inch][irad][ieta][ipt] = new lutEntry_t;
-          lutFile.read(reinterpret_cast<char*>(mLUTEntry[ipdg][inch][irad][ieta][ipt]), sizeof(lutEntry_t));
-          if (lutFile.gcount() != sizeof(lutEntry_t)) {
-            LOG(info) << " --- troubles reading covariance matrix entry for PDG " << pdg << ": " << filename << std::endl;
-            return false;
-          }
-        }
-      }
-    }
-  }
-  LOG(info) << " --- read covariance matrix table for PDG " << pdg << ": " << filename << std::endl;
-  mLUTHeader[ipdg]->print();
-
-  lutFile.close();
+  LOG(info) << " --- read covariance matrix table for PDG " << pdg << ": " << filename << (lut->isMapped() ? " (memory-mapped)" : "") << std::endl;
+  lutHeader->print();
+  mLUT[ipdg] = std::move(lut);
   return true;
 }
 
 /*****************************************************************/
 
-lutEntry_t* TrackSmearer::getLUTEntry(const int pdg, const float nch, const float radius, const float eta, const float pt, float& interpolatedEff)
+const lutEntry_t* TrackSmearer::getLUTEntry(const int pdg, const float nch, const float radius, const float eta, const float pt, float& interpolatedEff)
 {
   const int ipdg = getIndexPDG(pdg);
-  if (!mLUTHeader[ipdg]) {
+  if (!mLUT[ipdg]) {
     return nullptr;
   }
+  const LutTable& lut = *mLUT[ipdg];
+  lutHeader_t* lutHeader = mLUT[ipdg]->getHeader();
 
-  auto inch = mLUTHeader[ipdg]->nchmap.find(nch);
-  auto irad = mLUTHeader[ipdg]->radmap.find(radius);
-  auto ieta = mLUTHeader[ipdg]->etamap.find(eta);
-  auto ipt = mLUTHeader[ipdg]->ptmap.find(pt);
+  auto inch = lutHeader->nchmap.find(nch);
+  auto irad = lutHeader->radmap.find(radius);
+  auto ieta = lutHeader->etamap.find(eta);
+  auto ipt = lutHeader->ptmap.find(pt);
+  const lutEntry_t* lutEntry = lut.getEntry(inch, irad, ieta, ipt);
 
   // Interpolate if requested
-  auto fraction = mLUTHeader[ipdg]->nchmap.fracPositionWithinBin(nch);
+  auto fraction = lutHeader->nchmap.fracPositionWithinBin(nch);
   if (mInterpolateEfficiency) {
     static constexpr float kFractionThreshold = 0.5f;
     if (fraction > kFractionThreshold) {
       switch (mWhatEfficiency) {
         case 1:
-          if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-            interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff;
+          if (inch < lutHeader->nchmap.nbins - 1) {
+            interpolatedEff = (1.5f - fraction) * lutEntry->eff + (-0.5f + fraction) * lut.getEntry(inch + 1, irad, ieta, ipt)->eff;
           } else {
-            interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+            interpolatedEff = lutEntry->eff;
           }
           break;
         case 2:
-          if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-            interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff2;
+          if (inch < lutHeader->nchmap.nbins - 1) {
+            interpolatedEff = (1.5f - fraction) * lutEntry->eff2 + (-0.5f + fraction) * lut.getEntry(inch + 1, irad, ieta, ipt)->eff2;
           } else {
-            interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+            interpolatedEff = lutEntry->eff2;
           }
           break;
         default:
           LOG(fatal) << " --- getLUTEntry: unknown efficiency type " << mWhatEfficiency;
       }
     } else {
-      float comparisonValue = mLUTHeader[ipdg]->nchmap.log ? std::log10(nch) : nch;
+      float comparisonValue = lutHeader->nchmap.log ? std::log10(nch) : nch;
       switch (mWhatEfficiency) {
         case 1:
-          if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-            interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff;
+          if (inch > 0 && comparisonValue < lutHeader->nchmap.max) {
+            interpolatedEff = (0.5f + fraction) * lutEntry->eff + (0.5f - fraction) * lut.getEntry(inch - 1, irad, ieta, ipt)->eff;
           } else {
-            interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+            interpolatedEff = lutEntry->eff;
           }
           break;
         case 2:
-          if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-            interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff2;
+          if (inch > 0 && comparisonValue < lutHeader->nchmap.max) {
+            interpolatedEff = (0.5f + fraction) * lutEntry->eff2 + (0.5f - fraction) * lut.getEntry(inch - 1, irad, ieta, ipt)->eff2;
           } else {
-            interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+            interpolatedEff = lutEntry->eff2;
           }
           break;
         default:
@@ -222,21 +368,21 @@ lutEntry_t* TrackSmearer::getLUTEntry(const int pdg, const float nch, const floa
   } else {
     switch (mWhatEfficiency) {
       case 1:
-        interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+        interpolatedEff = lutEntry->eff;
         break;
       case 2:
-        interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+        interpolatedEff = lutEntry->eff2;
         break;
       default:
         LOG(fatal) << " --- getLUTEntry: unknown efficiency type " << mWhatEfficiency;
     }
   }
-  return mLUTEntry[ipdg][inch][irad][ieta][ipt];
+  return lutEntry;
 } //;
 
 /*****************************************************************/
 
-bool TrackSmearer::smearTrack(O2Track& o2track, lutEntry_t* lutEntry, float interpolatedEff)
+bool TrackSmearer::smearTrack(O2Track& o2track, const lutEntry_t* lutEntry, float interpolatedEff)
 {
   bool isReconstructed = true;
   // generate efficiency
@@ -300,18 +446,135 @@ bool TrackSmearer::smearTrack(O2Track& o2track, int pdg, float nch)
   }
   auto eta = o2track.getEta();
   float interpolatedEff = 0.0f;
-  lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, interpolatedEff);
+  const lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, interpolatedEff);
   if (!lutEntry || !lutEntry->valid)
     return false;
   return smearTrack(o2track, lutEntry, interpolatedEff);
 }
 
+/*****************************************************************/
+
+bool TrackSmearer::smearTrack(O2Track& o2track, int pdg, float nch, int64_t collisionIndex, int64_t particleIndex)
+{
+  uint8_t isReconstructed = 0;
+  smearTracks(std::span<O2Track>(&o2track, 1), std::span<const int>(&pdg, 1), std::span<const int64_t>(&particleIndex, 1), collisionIndex, nch, std::span<uint8_t>(&isReconstructed, 1));
+  return isReconstructed;
+}
+
+/*****************************************************************/
+
+int TrackSmearer::smearTracks(std::span<O2Track> tracks, std::span<const int> pdgs, std::span<const int64_t> particleIndices, int64_t collisionIndex, float nch, std::span<uint8_t> isReconstructed)
+{
+  static constexpr int kParSize = 5;
+  static constexpr int kCovMatSize = 15;
+  static constexpr int kBlockSize = 64;
+  static constexpr int kNUniforms = 8; // 1 for the efficiency, 6 for the 5 gaussian numbers, 1 unused
+  static constexpr double kTwoPi = 6.283185307179586;
+  if (pdgs.size() != tracks.size() || particleIndices.size() != tracks.size() || isReconstructed.size() != tracks.size()) {
+    LOG(fatal) << " --- smearTracks: inconsistent sizes of the input spans";
+  }
+
+  int nReconstructed = 0;
+  const lutEntry_t* lutEntries[kBlockSize];
+  float interpolatedEffs[kBlockSize];
+  double uniforms[kBlockSize][kNUniforms];
+  double gaussians[kBlockSize][kParSize + 1];
+  for (std::size_t first = 0; first < tracks.size(); first += kBlockSize) {
+    const int n = static_cast<int>(std::min<std::size_t>(kBlockSize, tracks.size() - first));
+
+    // LUT lookup
+    for (int i = 0; i < n; ++i) {
+      const O2Track& o2track = tracks[first + i];
+      auto pt = o2track.getPt();
+      if (std::abs(pdgs[first + i]) == o2::constants::physics::kHelium3) {
+        pt *= 2.f;
+      }
+      interpolatedEffs[i] = 0.f;
+      lutEntries[i] = getLUTEntry(pdgs[first + i], nch, 0., o2track.getEta(), pt, interpolatedEffs[i]);
+    }
+
+    // random numbers of each track, keyed by (seed, collision index, particle index)
+    for (int i = 0; i < n; ++i) {
+      const uint64_t particleIndex = particleIndices[first + i];
+      const uint64_t collision = collisionIndex;
+      for (int block = 0; block < kNUniforms / 4; ++block) {
+        const PhiloxRandom::Counter counter = {static_cast<uint32_t>(block), static_cast<uint32_t>(particleIndex), static_cast<uint32_t>(collision),
+                                               static_cast<uint32_t>(((particleIndex >> 32) << 16) ^ (collision >> 32))};
+        const auto words = PhiloxRandom::generate(counter, mSeed);
+        for (int k = 0; k < 4; ++k) {
+          uniforms[i][4 * block + k] = PhiloxRandom::toUniform(words[k]);
+        }
+      }
+    }
+    // gaussian numbers (Box-Muller)
+    for (int i = 0; i < n; ++i) {
+      for (int k = 0; k < kParSize + 1; k += 2) {
+        const double radius = std::sqrt(-2. * std::log(uniforms[i][1 + k]));
+        const double angle = kTwoPi * uniforms[i][2 + k];
+        gaussians[i][k] = radius * std::cos(angle);
+        gaussians[i][k + 1] = radius * std::sin(angle);
+      }
+    }
+
+    // efficiency and smearing
+    for (int i = 0; i < n; ++i) {
+      const lutEntry_t* lutEntry = lutEntries[i];
+      O2Track& o2track = tracks[first + i];
+      isReconstructed[first + i] = 0;
+      if (!lutEntry || !lutEntry->valid) {
+        continue;
+      }
+      bool reconstructed = true;
+      if (mUseEfficiency) {
+        float eff = 0.;
+        switch (mWhatEfficiency) {
+          case 1:
+            eff = lutEntry->eff;
+            break;
+          case 2:
+            eff = lutEntry->eff2;
+            break;
+        }
+        if (mInterpolateEfficiency)
+          eff = interpolatedEffs[i];
+        if (uniforms[i][0] > eff)
+          reconstructed = false;
+      }
+      if (!reconstructed && mSkipUnreconstructed)
+        continue;
+
+      // smear the parameters in the eigenbasis of the covariance matrix and transform them back
+      double params[kParSize];
+      for (int ip = 0; ip < kParSize; ++ip) {
+        double val = 0.;
+        for (int j = 0; j < kParSize; ++j)
+          val += lutEntry->eigvec[j][ip] * o2track.getParam(j);
+        params[ip] = val + std::sqrt(lutEntry->eigval[ip]) * gaussians[i][ip];
+      }
+      for (int ip = 0; ip < kParSize; ++ip) {
+        double val = 0.;
+        for (int j = 0; j < kParSize; ++j)
+          val += lutEntry->eiginv[j][ip] * params[j];
+        o2track.setParam(val, ip);
+      }
+      if (std::fabs(o2track.getParam(2)) > 1.) {
+        LOG(info) << " --- smearTracks failed sin(phi) sanity check: " << o2track.getParam(2);
+      }
+      for (int ic = 0; ic < kCovMatSize; ++ic)
+        o2track.setCov(lutEntry->covm[ic], ic);
+      isReconstructed[first + i] = reconstructed;
+      nReconstructed += reconstructed;
+    }
+  }
+  return nReconstructed;
+}
+
 /*****************************************************************/
 // relative uncertainty on pt
 double TrackSmearer::getPtRes(const int pdg, const float nch, const float eta, const float pt)
 {
   float dummy = 0.0f;
-  lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
+  const lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
   auto val = std::sqrt(lutEntry->covm[14]) * lutEntry->pt;
   return val;
 }
@@ -321,7 +584,7 @@ double TrackSmearer::getPtRes(const int pdg, const float nch, const float eta, c
 double TrackSmearer::getEtaRes(const int pdg, const float nch, const float eta, const float pt)
 {
   float dummy = 0.0f;
-  lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
+  const lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
   auto sigmatgl = std::sqrt(lutEntry->covm[9]);                                  // sigmatgl2
   auto etaRes = std::fabs(std::sin(2.0 * std::atan(std::exp(-eta)))) * sigmatgl; // propagate tgl to eta uncertainty
   etaRes /= lutEntry->eta;                                                       // relative uncertainty
@@ -332,7 +595,7 @@ double TrackSmearer::getEtaRes(const int pdg, const float nch, const float eta,
 double TrackSmearer::getAbsPtRes(const int pdg, const float nch, const float eta, const float pt)
 {
   float dummy = 0.0f;
-  lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
+  const lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
   auto val = std::sqrt(lutEntry->covm[14]) * lutEntry->pt * lutEntry->pt;
   return val;
 }
@@ -342,7 +605,7 @@ double TrackSmearer::getAbsPtRes(const int pdg, const float nch, const float eta
 double TrackSmearer::getAbsEtaRes(const int pdg, const float nch, const float eta, const float pt)
 {
   float dummy = 0.0f;
-  lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
+  const lutEntry_t* lutEntry = getLUTEntry(pdg, nch, 0., eta, pt, dummy);
   auto sigmatgl = std::sqrt(lutEntry->covm[9]);                                  // sigmatgl2
   auto etaRes = std::fabs(std::sin(2.0 * std::atan(std::exp(-eta)))) * sigmatgl; // propagate tgl to eta uncertainty
   return etaRes;
@@ -370,7 +633,7 @@ double TrackSmearer::getEfficiency(const int pdg, const float nch, const float e
 //   return true;
 
 // #if 0
-//   lutEntry_t* lutEntry = getLUTEntry(track.PID, 0., 0., track.Eta, track.PT);
+//   const lutEntry_t* lutEntry = getLUTEntry(track.PID, 0., 0., track.Eta, track.PT);
 //   if (!lutEntry)
 //     return;
 
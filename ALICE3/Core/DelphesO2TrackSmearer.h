@@ -29,10 +29,16 @@
 
 #include <TRandom.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <span>
+#include <vector>
 
 ///////////////////////////////
 /// DelphesO2/src/lutCovm.hh //
@@ -43,6 +49,7 @@
 
 // #pragma // once
 #define LUTCOVM_VERSION 20210801
+#define LUTFLAT_VERSION 1
 
 struct map_t {
   int nbins = 1;
@@ -149,6 +156,21 @@ struct lutEntry_t {
   }
 };
 
+/// Header of the flat LUT files, which can be memory-mapped
+/// The file layout is: lutFlatHeader_t, padding up to entriesOffset, then the nch * rad * eta * pt entries
+/// in row-major order (pt fastest), i.e. the order in which the legacy .dat files store them.
+/// The entry and header sizes are stored to refuse files written with a different struct layout.
+struct lutFlatHeader_t {
+  char magic[8] = {'L', 'U', 'T', 'F', 'L', 'A', 'T', '\0'};
+  int version = LUTFLAT_VERSION;
+  int headerSize = sizeof(lutHeader_t);
+  int entrySize = sizeof(lutEntry_t);
+  int reserved = 0;
+  uint64_t nEntries = 0;
+  uint64_t entriesOffset = 0; // offset of the first entry from the beginning of the file
+  lutHeader_t lutHeader;
+};
+
 ////////////////////////////////////
 /// DelphesO2/src/TrackSmearer.hh //
 ////////////////////////////////////
@@ -171,6 +193,78 @@ namespace o2
 namespace delphes
 {
 
+/// Counter-based random number generator (Philox4x32-10)
+/// Each call returns 4 random words which only depend on the key and the counter, so that the random
+/// stream of a track can be derived from its identifiers, independently of the processing order.
+class PhiloxRandom
+{
+ public:
+  using Counter = std::array<uint32_t, 4>;
+
+  static Counter generate(Counter counter, const uint64_t key)
+  {
+    static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+    static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+    static constexpr int kRounds = 10;
+    uint32_t key0 = static_cast<uint32_t>(key);
+    uint32_t key1 = static_cast<uint32_t>(key >> 32);
+    for (int round = 0; round < kRounds; ++round) {
+      const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * counter[0];
+      const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0, static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1, static_cast<uint32_t>(product0)};
+      key0 += kWeyl0;
+      key1 += kWeyl1;
+    }
+    return counter;
+  }
+
+  /// uniform random number in (0, 1) from a random word
+  static double toUniform(const uint32_t word) { return (static_cast<double>(word) + 0.5) * (1. / 4294967296.); }
+};
+
+/// Contiguous LUT of one particle species
+/// The entries are either memory-mapped read-only from a flat LUT file, so that the pages are shared by all
+/// the processes using the same file, or read in a single block from a legacy .dat file.
+class LutTable
+{
+ public:
+  LutTable() = default;
+  ~LutTable() { reset(); }
+  LutTable(const LutTable&) = delete;
+  LutTable& operator=(const LutTable&) = delete;
+
+  /// Loads a LUT file, either flat (memory-mapped) or legacy .dat (read into memory)
+  bool load(const char* filename);
+  /// Writes the LUT in the flat format
+  bool write(const char* filename) const;
+  /// Converts a legacy .dat LUT file into a flat LUT file
+  static bool convert(const char* inFilename, const char* outFilename);
+  void reset();
+
+  lutHeader_t* getHeader() { return &mHeader; }
+  bool isMapped() const { return mMappedData != nullptr; }
+  std::size_t getNEntries() const { return mNEntries; }
+  std::size_t getIndex(const int inch, const int irad, const int ieta, const int ipt) const
+  {
+    return ((static_cast<std::size_t>(inch) * mHeader.radmap.nbins + irad) * mHeader.etamap.nbins + ieta) * mHeader.ptmap.nbins + ipt;
+  }
+  const lutEntry_t* getEntry(const int inch, const int irad, const int ieta, const int ipt) const { return mEntries + getIndex(inch, irad, ieta, ipt); }
+
+ private:
+  bool loadFlat(const char* filename);
+  bool loadLegacy(const char* filename);
+
+  lutHeader_t mHeader;
+  std::size_t mNEntries = 0;
+  const lutEntry_t* mEntries = nullptr; // points to mOwnedEntries or into the mapped file
+  std::vector<lutEntry_t> mOwnedEntries;
+  void* mMappedData = nullptr;
+  std::size_t mMappedSize = 0;
+};
+
 class TrackSmearer
 {
 
@@ -180,16 +274,25 @@ class TrackSmearer
 
   /** LUT methods **/
   bool loadTable(int pdg, const char* filename, bool forceReload = false);
-  bool hasTable(int pdg) { return (mLUTHeader[getIndexPDG(pdg)] != nullptr); } //;
+  bool hasTable(int pdg) { return (mLUT[getIndexPDG(pdg)] != nullptr); } //;
   void useEfficiency(bool val) { mUseEfficiency = val; }                       //;
   void interpolateEfficiency(bool val) { mInterpolateEfficiency = val; }       //;
   void skipUnreconstructed(bool val) { mSkipUnreconstructed = val; }           //;
   void setWhatEfficiency(int val) { mWhatEfficiency = val; }                   //;
-  lutHeader_t* getLUTHeader(int pdg) { return mLUTHeader[getIndexPDG(pdg)]; }  //;
-  lutEntry_t* getLUTEntry(const int pdg, const float nch, const float radius, const float eta, const float pt, float& interpolatedEff);
+  lutHeader_t* getLUTHeader(int pdg) { return hasTable(pdg) ? mLUT[getIndexPDG(pdg)]->getHeader() : nullptr; } //;
+  const lutEntry_t* getLUTEntry(const int pdg, const float nch, const float radius, const float eta, const float pt, float& interpolatedEff);
 
-  bool smearTrack(O2Track& o2track, lutEntry_t* lutEntry, float interpolatedEff);
+  bool smearTrack(O2Track& o2track, const lutEntry_t* lutEntry, float interpolatedEff);
   bool smearTrack(O2Track& o2track, int pdg, float nch);
+  /// Smears a track with the random stream keyed by (seed, collision index, particle index) instead of gRandom
+  bool smearTrack(O2Track& o2track, int pdg, float nch, int64_t collisionIndex, int64_t particleIndex);
+  /// Smears a batch of tracks of a collision, with the random stream of each track keyed by (seed, collision index, particle index)
+  /// The output does not depend on how the tracks are split into batches nor on the order of the batches,
+  /// and the method does not modify the smearer, so that batches can be smeared concurrently.
+  /// \param isReconstructed is set to 1 for the reconstructed tracks, and the unreconstructed tracks are not smeared if skipUnreconstructed is set
+  /// \return the number of reconstructed tracks
+  int smearTracks(std::span<O2Track> tracks, std::span<const int> pdgs, std::span<const int64_t> particleIndices, int64_t collisionIndex, float nch, std::span<uint8_t> isReconstructed);
+  void setSeed(uint64_t val) { mSeed = val; } //;
   // bool smearTrack(Track& track, bool atDCA = true); // Only in DelphesO2
   double getPtRes(const int pdg, const float nch, const float eta, const float pt);
   double getEtaRes(const int pdg, const float nch, const float eta, const float pt);
@@ -254,13 +357,13 @@ class TrackSmearer
 
  protected:
   static constexpr unsigned int nLUTs = 9; // Number of LUT available
-  lutHeader_t* mLUTHeader[nLUTs] = {nullptr};
-  lutEntry_t***** mLUTEntry[nLUTs] = {nullptr};
+  std::unique_ptr<LutTable> mLUT[nLUTs];
   bool mUseEfficiency = true;
   bool mInterpolateEfficiency = false;
   bool mSkipUnreconstructed = true; // don't smear tracks that are not reco'ed
   int mWhatEfficiency = 1;
   float mdNdEta = 1600.;
+  uint64_t mSeed = 0; // key of the counter-based random streams
 
  private:
   o2::ccdb::BasicCCDBManager* mCcdbManager = nullptr;
@@ -18,12 +18,12 @@
 #include <TEnv.h>
 #include <THashList.h>
 #include <TMath.h>
-#include <TMatrixD.h>
-#include <TMatrixDSymEigen.h>
 #include <TObject.h>
 #include <TRandom.h>
 #include <TSystem.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <map>
 #include <string>
@@ -459,6 +459,93 @@ float FastTracker::ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float
   return goodHit;
 }
 
+void FastTracker::Diagonalise(const double matrix[5][5], double eigVal[5], double eigVec[5][5])
+{
+  // eigenvalues and eigenvectors of a symmetric 5x5 matrix with the cyclic Jacobi method
+  // (see Numerical Recipes, section 11.1)
+  // The eigenvalues are sorted in decreasing order, as in TMatrixDSymEigen, and the eigenvectors are the columns of eigVec
+  static constexpr int kDim = 5;
+  static constexpr int kMaxSweeps = 50;
+  double work[kDim][kDim]; // the rotations zero its upper triangle
+  double diagonalSweepStart[kDim], diagonalUpdate[kDim];
+  for (int ip = 0; ip < kDim; ++ip) {
+    for (int iq = 0; iq < kDim; ++iq) {
+      work[ip][iq] = matrix[ip][iq];
+      eigVec[ip][iq] = (ip == iq) ? 1. : 0.;
+    }
+    diagonalSweepStart[ip] = eigVal[ip] = matrix[ip][ip];
+    diagonalUpdate[ip] = 0.;
+  }
+  auto rotate = [](double m[5][5], int i, int j, int k, int l, double s, double tau) {
+    const double g = m[i][j];
+    const double h = m[k][l];
+    m[i][j] = g - s * (h + g * tau);
+    m[k][l] = h + s * (g - h * tau);
+  };
+  for (int sweep = 0; sweep < kMaxSweeps; ++sweep) {
+    double offDiagonal = 0.;
+    for (int ip = 0; ip < kDim - 1; ++ip)
+      for (int iq = ip + 1; iq < kDim; ++iq)
+        offDiagonal += std::abs(work[ip][iq]);
+    if (offDiagonal == 0.)
+      break;
+    const double threshold = (sweep < 3) ? 0.2 * offDiagonal / (kDim * kDim) : 0.;
+    for (int ip = 0; ip < kDim - 1; ++ip) {
+      for (int iq = ip + 1; iq < kDim; ++iq) {
+        const double g = 100. * std::abs(work[ip][iq]);
+        if (sweep > 3 && std::abs(eigVal[ip]) + g == std::abs(eigVal[ip]) && std::abs(eigVal[iq]) + g == std::abs(eigVal[iq])) {
+          work[ip][iq] = 0.;
+        } else if (std::abs(work[ip][iq]) > threshold) {
+          double h = eigVal[iq] - eigVal[ip];
+          double t;
+          if (std::abs(h) + g == std::abs(h)) {
+            t = work[ip][iq] / h;
+          } else {
+            const double theta = 0.5 * h / work[ip][iq];
+            t = 1. / (std::abs(theta) + std::sqrt(1. + theta * theta));
+            if (theta < 0.)
+              t = -t;
+          }
+          const double c = 1. / std::sqrt(1 + t * t);
+          const double s = t * c;
+          const double tau = s / (1. + c);
+          h = t * work[ip][iq];
+          diagonalUpdate[ip] -= h;
+          diagonalUpdate[iq] += h;
+          eigVal[ip] -= h;
+          eigVal[iq] += h;
+          work[ip][iq] = 0.;
+          for (int j = 0; j < ip; ++j)
+            rotate(work, j, ip, j, iq, s, tau);
+          for (int j = ip + 1; j < iq; ++j)
+            rotate(work, ip, j, j, iq, s, tau);
+          for (int j = iq + 1; j < kDim; ++j)
+            rotate(work, ip, j, iq, j, s, tau);
+          for (int j = 0; j < kDim; ++j)
+            rotate(eigVec, j, ip, j, iq, s, tau);
+        }
+      }
+    }
+    for (int ip = 0; ip < kDim; ++ip) {
+      diagonalSweepStart[ip] += diagonalUpdate[ip];
+      eigVal[ip] = diagonalSweepStart[ip];
+      diagonalUpdate[ip] = 0.;
+    }
+  }
+  // sort by decreasing eigenvalue
+  for (int i = 0; i < kDim - 1; ++i) {
+    int iMax = i;
+    for (int j = i + 1; j < kDim; ++j)
+      if (eigVal[j] > eigVal[iMax])
+        iMax = j;
+    if (iMax != i) {
+      std::swap(eigVal[i], eigVal[iMax]);
+      for (int j = 0; j < kDim; ++j)
+        std::swap(eigVec[j][i], eigVec[j][iMax]);
+    }
+  }
+}
+
 // function to provide a reconstructed track from a perfect input track
 // returns number of intercepts (generic for now)
 int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackParCov& outputTrack, const float nch)
@@ -491,10 +578,7 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
   // but does not count all points in the tpc as layers which we do here
   // Loop over all the added layers to prevent crash when adding the tpc
   // Should not affect efficiency calculation
-  goodHitProbability.clear();
-  for (size_t i = 0; i < layers.size(); ++i) {
-    goodHitProbability.push_back(-1.);
-  }
+  goodHitProbability.assign(layers.size(), -1.);
   goodHitProbability[0] = 1.; // we use layer zero to accumulate
 
   // +-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+-~-<*>-~-+
@@ -607,7 +691,6 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     // get perfect data point position
     std::array<float, 3> spacePoint;
     inputTrack.getXYZGlo(spacePoint);
-    std::vector<float> thisHit = {spacePoint[0], spacePoint[1], spacePoint[2]};
 
     // towards adding cluster: move to track alpha
     float alpha = inwardTrack.getAlpha();
@@ -652,7 +735,7 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     if (layers[il].isGas())
       nGasPoints++; // count TPC/gas hits
 
-    hits.push_back(thisHit);
+    hits.insert(hits.end(), spacePoint.begin(), spacePoint.end());
 
     if (!layers[il].isInert()) { // good hit probability calculation
       float sigYCmb = o2::math_utils::sqrt(inwardTrack.getSigmaY2() + layers[il].getResolutionRPhi() * layers[il].getResolutionRPhi());
@@ -678,6 +761,8 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
   if (nIntercepts < 4)
     return nIntercepts;
 
+  TRandom* random = mRandom ? mRandom : gRandom;
+
   // generate efficiency
   float eff = 1.;
   for (size_t i = 0; i < layers.size(); i++) {
@@ -688,7 +773,7 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     eff *= iGoodHit;
   }
   if (mApplyEffCorrection) {
-    if (gRandom->Uniform() > eff)
+    if (random->Uniform() > eff)
       return -8;
   }
 
@@ -699,7 +784,6 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
   std::array<float, o2::track::kCovMatSize> covMat = {0.};
   for (int ii = 0; ii < o2::track::kCovMatSize; ii++)
     covMat[ii] = outputTrack.getCov()[ii];
-  TMatrixDSym m(5);
   double fcovm[5][5]; // double precision is needed for regularisation
 
   for (int ii = 0, k = 0; ii < 5; ++ii) {
@@ -726,10 +810,9 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
   }
 
   // Should have a valid cov matrix now
-  m.SetMatrixArray(reinterpret_cast<double*>(fcovm));
-  TMatrixDSymEigen eigen(m);
-  TMatrixD eigVec = eigen.GetEigenVectors();
-  TVectorD eigVal = eigen.GetEigenValues();
+  double eigVec[5][5];
+  double eigVal[5];
+  Diagonalise(fcovm, eigVal, eigVec);
   bool negEigVal = false;
   for (int ii = 0; ii < 5; ii++) {
     if (eigVal[ii] < 0.0f)
@@ -742,7 +825,9 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
       LOG(info) << "Printing info:";
       LOG(info) << "Kalman updates: " << nIntercepts;
       LOG(info) << "Cov matrix: ";
-      m.Print();
+      for (int ii = 0; ii < 5; ii++) {
+        LOGF(info, "%12.5e %12.5e %12.5e %12.5e %12.5e", fcovm[ii][0], fcovm[ii][1], fcovm[ii][2], fcovm[ii][3], fcovm[ii][4]);
+      }
     }
     covMatNotOK++;
     nIntercepts = -1; // mark as problematic so that it isn't used
@@ -757,16 +842,14 @@ int FastTracker::FastTrack(o2::track::TrackParCov inputTrack, o2::track::TrackPa
     for (int j = 0; j < 5; ++j)
       val += eigVec[j][ii] * outputTrack.getParam(j);
     // smear parameters according to eigenvalues
-    params_[ii] = gRandom->Gaus(val, sqrt(eigVal[ii]));
+    params_[ii] = random->Gaus(val, sqrt(eigVal[ii]));
   }
 
-  // invert eigenvector matrix
-  eigVec.Invert();
-  // transform back params vector
+  // transform back params vector, the eigenvector matrix is orthogonal so that its inverse is its transpose
   for (int ii = 0; ii < 5; ++ii) {
     float val = 0.;
     for (int j = 0; j < 5; ++j)
-      val += eigVec[j][ii] * params_[j];
+      val += eigVec[ii][j] * params_[j];
     outputTrack.setParam(val, ii);
   }
   // should make a sanity check that par[2] sin(phi) is in [-1, 1]
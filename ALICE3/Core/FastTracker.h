@@ -19,7 +19,10 @@
 #include <Framework/Logger.h>
 #include <ReconstructionDataFormats/Track.h>
 
+#include <TRandom.h>
+
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -106,8 +109,8 @@ class FastTracker
   /// \param phiStart Start angle of the dead region (in radians)
   /// \param phiEnd End angle of the dead region (in radians)
   void addDeadPhiRegionInLayer(const std::string& layerName, float phiStart, float phiEnd);
-  DetLayer GetLayer(const int layer) const { return layers[layer]; }
-  std::vector<DetLayer> GetLayers() const { return layers; }
+  const DetLayer& GetLayer(const int layer) const { return layers[layer]; }
+  std::span<const DetLayer> GetLayers() const { return layers; }
   int GetLayerIndex(const std::string& name) const;
   size_t GetNLayers() const { return layers.size(); }
   bool IsLayerInert(const int layer) const { return layers[layer].isInert(); }
@@ -161,6 +164,9 @@ class FastTracker
   float HitDensity(float radius);
   float ProbGoodChiSqHit(float radius, float searchRadiusRPhi, float searchRadiusZ);
 
+  /// Eigenvalues (decreasing) and eigenvectors (columns) of a symmetric 5x5 matrix, without heap allocations
+  static void Diagonalise(const double matrix[5][5], double eigVal[5], double eigVec[5][5]);
+
   // Setters and getters for configuration
   void SetIntegrationTime(float t) { integrationTime = t; }
   void SetMaxRadiusOfSlowDetectors(float r) { maxRadiusSlowDet = r; }
@@ -174,6 +180,7 @@ class FastTracker
   void SetApplyMSCorrection(bool b) { mApplyMSCorrection = b; }
   void SetApplyElossCorrection(bool b) { mApplyElossCorrection = b; }
   void SetApplyEffCorrection(bool b) { mApplyEffCorrection = b; }
+  void SetRandom(TRandom* random) { mRandom = random; }
 
   // Getters for the last track
   int GetNIntercepts() const { return nIntercepts; }
@@ -183,17 +190,17 @@ class FastTracker
   {
     return (layer >= 0 && static_cast<size_t>(layer) < goodHitProbability.size()) ? goodHitProbability[layer] : 0.0f;
   }
-  std::size_t GetNHits() const { return hits.size(); }
-  float GetHitX(const int i) const { return hits[i][0]; }
-  float GetHitY(const int i) const { return hits[i][1]; }
-  float GetHitZ(const int i) const { return hits[i][2]; }
+  std::size_t GetNHits() const { return hits.size() / 3; }
+  float GetHitX(const int i) const { return hits[3 * i]; }
+  float GetHitY(const int i) const { return hits[3 * i + 1]; }
+  float GetHitZ(const int i) const { return hits[3 * i + 2]; }
   uint64_t GetCovMatOK() const { return covMatOK; }
   uint64_t GetCovMatNotOK() const { return covMatNotOK; }
 
  private:
   // Definition of detector layers
   std::vector<DetLayer> layers;
-  std::vector<std::vector<float>> hits; // bookkeep last added hits
+  std::vector<float> hits; // bookkeep last added hits (x, y, z per hit)
 
   /// configuration parameters
   bool mApplyZacceptance = false;       /// check z acceptance or not
@@ -201,6 +208,7 @@ class FastTracker
   bool mApplyElossCorrection = true;    /// Apply correction for eloss (requires MS correction)
   bool mApplyEffCorrection = true;      /// Apply correction for hit efficiency
   int mVerboseLevel = 0;                /// 0: not verbose, >0 more verbose
+  TRandom* mRandom = nullptr;           //! random generator for efficiency and smearing, gRandom if not set
   const float mCrossSectionMinB = 8;    /// Minimum bias Cross section for event under study (PbPb MinBias ~ 8 Barns)
   int dNdEtaCent = 2200;                /// dN/deta e.g. at centrality 0-5% (for 5 TeV PbPb)
   int dNdEtaMinB = 1;                   /// dN/deta for minimum bias events
@@ -0,0 +1,229 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmarkFastTrackerDiagonalise.cxx
+/// \brief exec comparing the Jacobi diagonalisation of the track covariance of FastTracker (FastTracker::Diagonalise) with TMatrixDSymEigen,
+///        in accuracy and timing, on covariance matrices of tracks fitted in the 11 layers of the ALICE 3 v2 silicon tracker
+///        Usage: o2-bench-alice3-fasttracker-diagonalise [number of tracks]
+
+#include "ALICE3/Core/FastTracker.h"
+
+#include <Framework/Logger.h>
+
+#include <TMatrixD.h>
+#include <TMatrixDSym.h>
+#include <TMatrixDSymEigen.h>
+#include <TRandom3.h>
+#include <TVectorD.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+using Matrix5 = std::array<std::array<double, 5>, 5>;
+
+// Sensitive layers of FastTracker::AddSiliconALICE3v2 with the default pixel resolutions of the on-the-fly tracker:
+// radius (cm), x/X0, resolution in r-phi and z (cm)
+struct Layer {
+  double radius, x0, resRPhi, resZ;
+};
+constexpr std::array<Layer, 11> Layers{{{0.5, 0.001, 0.00025, 0.00025},
+                                        {1.2, 0.001, 0.00025, 0.00025},
+                                        {2.5, 0.001, 0.00025, 0.00025},
+                                        {3.75, 0.01, 0.001, 0.001},
+                                        {7., 0.01, 0.001, 0.001},
+                                        {12., 0.01, 0.001, 0.001},
+                                        {20., 0.01, 0.001, 0.001},
+                                        {30., 0.01, 0.001, 0.001},
+                                        {45., 0.01, 0.001, 0.001},
+                                        {60., 0.01, 0.001, 0.001},
+                                        {80., 0.01, 0.001, 0.001}}};
+constexpr double MagneticField = 20.;                // kG
+constexpr double CurvatureConstant = 0.299792458e-3; // 1/cm per kG and GeV/c
+constexpr double PionMass = 0.13957;
+
+/// Covariance of (y, z, sin(phi), tan(lambda), q/pt) at the innermost layer of a track fitted outside-in with a linearised Kalman filter
+/// (straight-line propagation with curvature, multiple scattering in the layers), rounded to float as the covariance of o2::track::TrackParCov
+Matrix5 fitCovariance(double pt, double eta)
+{
+  const double tgl = std::sinh(eta);
+  const double q2pt = 1. / pt;
+  const double curvature = CurvatureConstant * MagneticField * q2pt;
+  const double p2 = pt * pt * (1. + tgl * tgl);
+  const double beta2 = p2 / (p2 + PionMass * PionMass);
+  Matrix5 cov{};
+  const std::array<double, 5> initialErrors{1., 1., 0.1, 0.1, 10.}; // seeding at the outermost layer
+  for (int i = 0; i < 5; ++i) {
+    cov[i][i] = initialErrors[i] * initialErrors[i];
+  }
+  for (int il = Layers.size() - 1; il >= 0; --il) {
+    const double snp = std::min(0.5 * Layers[il].radius * curvature, 0.95);
+    const double csp = std::sqrt(1. - snp * snp);
+    if (il < static_cast<int>(Layers.size()) - 1) {
+      // propagation from the previous layer, cov -> F cov F^T
+      const double dx = Layers[il].radius - Layers[il + 1].radius;
+      Matrix5 jacobian{};
+      for (int i = 0; i < 5; ++i) {
+        jacobian[i][i] = 1.;
+      }
+      jacobian[0][2] = dx / (csp * csp * csp);
+      jacobian[0][4] = 0.5 * dx * dx * CurvatureConstant * MagneticField / (csp * csp * csp);
+      jacobian[1][2] = dx * tgl * snp / (csp * csp * csp);
+      jacobian[1][3] = dx / csp;
+      jacobian[2][4] = dx * CurvatureConstant * MagneticField;
+      Matrix5 tmp{}, propagated{};
+      for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+          for (int k = 0; k < 5; ++k)
+            tmp[i][j] += jacobian[i][k] * cov[k][j];
+      for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+          for (int k = 0; k < 5; ++k)
+            propagated[i][j] += tmp[i][k] * jacobian[j][k];
+      cov = propagated;
+    }
+    // multiple scattering, as in o2::track::TrackParCov::correctForMaterial
+    const double x0 = Layers[il].x0 * std::sqrt(1. + tgl * tgl) / csp;
+    const double theta2 = 0.0136 * 0.0136 / (beta2 * p2) * x0 * (1. + 0.038 * std::log(x0)) * (1. + 0.038 * std::log(x0));
+    cov[2][2] += theta2 * csp * csp * (1. + tgl * tgl);
+    cov[3][3] += theta2 * (1. + tgl * tgl) * (1. + tgl * tgl);
+    cov[4][3] += theta2 * tgl * q2pt * (1. + tgl * tgl);
+    cov[3][4] = cov[4][3];
+    cov[4][4] += theta2 * tgl * tgl * q2pt * q2pt * (1. + tgl * tgl);
+    // update with the (y, z) measurement, cov -> cov - cov H^T (H cov H^T + R)^-1 H cov
+    const double s00 = cov[0][0] + Layers[il].resRPhi * Layers[il].resRPhi;
+    const double s11 = cov[1][1] + Layers[il].resZ * Layers[il].resZ;
+    const double s01 = cov[0][1];
+    const double det = s00 * s11 - s01 * s01;
+    const double inv00 = s11 / det, inv11 = s00 / det, inv01 = -s01 / det;
+    Matrix5 updated = cov;
+    for (int i = 0; i < 5; ++i) {
+      const double k0 = cov[i][0] * inv00 + cov[i][1] * inv01;
+      const double k1 = cov[i][0] * inv01 + cov[i][1] * inv11;
+      for (int j = 0; j < 5; ++j) {
+        updated[i][j] -= k0 * cov[0][j] + k1 * cov[1][j];
+      }
+    }
+    cov = updated;
+  }
+  for (auto& row : cov) {
+    for (auto& element : row) {
+      element = static_cast<float>(element);
+    }
+  }
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < i; ++j) {
+      cov[j][i] = cov[i][j]; // exactly symmetric, as filled from the lower triangle in FastTracker::FastTrack
+    }
+  }
+  return cov;
+}
+
+double elapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const int nTracks = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  // pt log-uniform in [0.1, 20] GeV/c, |eta| < 1.5
+  TRandom3 random(1);
+  std::vector<Matrix5> covariances(nTracks);
+  for (auto& cov : covariances) {
+    const double pt = 0.1 * std::pow(200., random.Uniform());
+    cov = fitCovariance(pt, random.Uniform(-1.5, 1.5));
+  }
+
+  // accuracy: eigenvalues against TMatrixDSymEigen, residuals and orthogonality of the eigenvectors, sign of the smallest eigenvalue
+  double maxEigValDiff = 0., maxResidual = 0., maxOrthogonality = 0.;
+  int nNegativeJacobi = 0, nNegativeRoot = 0, nSignDifferent = 0;
+  for (const auto& cov : covariances) {
+    double matrix[5][5], eigVal[5], eigVec[5][5];
+    for (int i = 0; i < 5; ++i) {
+      std::copy(cov[i].begin(), cov[i].end(), matrix[i]);
+    }
+    o2::fastsim::FastTracker::Diagonalise(matrix, eigVal, eigVec);
+    TMatrixDSym m(5);
+    m.SetMatrixArray(&matrix[0][0]);
+    TMatrixDSymEigen eigen(m);
+    const TVectorD& eigValRoot = eigen.GetEigenValues();
+
+    const double norm = std::abs(eigValRoot[0]);
+    for (int k = 0; k < 5; ++k) {
+      maxEigValDiff = std::max(maxEigValDiff, std::abs(eigVal[k] - eigValRoot[k]) / norm);
+      for (int i = 0; i < 5; ++i) {
+        double residual = -eigVal[k] * eigVec[i][k];
+        for (int j = 0; j < 5; ++j) {
+          residual += matrix[i][j] * eigVec[j][k];
+        }
+        maxResidual = std::max(maxResidual, std::abs(residual) / norm);
+      }
+      for (int l = 0; l < 5; ++l) {
+        double product = 0.;
+        for (int i = 0; i < 5; ++i) {
+          product += eigVec[i][k] * eigVec[i][l];
+        }
+        maxOrthogonality = std::max(maxOrthogonality, std::abs(product - (k == l ? 1. : 0.)));
+      }
+    }
+    const bool negativeJacobi = eigVal[4] < 0.;
+    const bool negativeRoot = eigValRoot[4] < 0.;
+    nNegativeJacobi += negativeJacobi;
+    nNegativeRoot += negativeRoot;
+    nSignDifferent += negativeJacobi != negativeRoot;
+  }
+  LOGF(info, "%d covariance matrices, max |lambda - lambda ROOT| / |lambda|max = %.2e, max |A v - lambda v| / |lambda|max = %.2e, max |V^T V - 1| = %.2e",
+       nTracks, maxEigValDiff, maxResidual, maxOrthogonality);
+  LOGF(info, "negative smallest eigenvalue: Jacobi %d, TMatrixDSymEigen %d, different sign %d", nNegativeJacobi, nNegativeRoot, nSignDifferent);
+
+  // timing, including the inversion of the eigenvector matrix needed by the TMatrixDSymEigen path
+  double sum = 0.;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& cov : covariances) {
+    double matrix[5][5], eigVal[5], eigVec[5][5];
+    for (int i = 0; i < 5; ++i) {
+      std::copy(cov[i].begin(), cov[i].end(), matrix[i]);
+    }
+    o2::fastsim::FastTracker::Diagonalise(matrix, eigVal, eigVec);
+    sum += eigVal[0] + eigVec[0][0];
+  }
+  const double timeJacobi = elapsedMicroseconds(start);
+  start = std::chrono::steady_clock::now();
+  for (const auto& cov : covariances) {
+    double matrix[5][5];
+    for (int i = 0; i < 5; ++i) {
+      std::copy(cov[i].begin(), cov[i].end(), matrix[i]);
+    }
+    TMatrixDSym m(5);
+    m.SetMatrixArray(&matrix[0][0]);
+    TMatrixDSymEigen eigen(m);
+    TMatrixD eigVec = eigen.GetEigenVectors();
+    TVectorD eigVal = eigen.GetEigenValues();
+    eigVec.Invert();
+    sum -= eigVal[0] + eigVec[0][0];
+  }
+  const double timeRoot = elapsedMicroseconds(start);
+  LOGF(info, "Jacobi %.3f us, TMatrixDSymEigen %.3f us per covariance matrix (x%.1f, sink %g)", timeJacobi / nTracks, timeRoot / nTracks, timeRoot / timeJacobi, sum);
+
+  if (nSignDifferent > 0 || maxResidual > 1e-12) {
+    LOG(error) << "The Jacobi diagonalisation differs from TMatrixDSymEigen";
+    return 1;
+  }
+  return 0;
+}
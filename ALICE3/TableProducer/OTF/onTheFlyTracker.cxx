@@ -57,9 +57,12 @@
 #include <TPDGCode.h>
 #include <TRandom3.h>
 
+#include <algorithm>
 #include <array>
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -105,6 +108,8 @@ struct OnTheFlyTracker {
   Configurable<bool> enableSecondarySmearing{"enableSecondarySmearing", false, "Enable smearing of weak decay daughters"};
   Configurable<bool> enableNucleiSmearing{"enableNucleiSmearing", false, "Enable smearing of nuclei"};
   Configurable<bool> enablePrimaryVertexing{"enablePrimaryVertexing", true, "Enable primary vertexing"};
+  Configurable<bool> useKeyedSmearingRandom{"useKeyedSmearingRandom", false, "smear primaries with random numbers keyed by (seed, collision, particle) instead of gRandom, independent of the processing order"};
+  Configurable<int> nThreads{"nThreads", 1, "number of threads smearing the primaries of a collision (requires useKeyedSmearingRandom, output independent of the number of threads)"};
   Configurable<bool> interpolateLutEfficiencyVsNch{"interpolateLutEfficiencyVsNch", true, "interpolate LUT efficiency as f(Nch)"};
 
   Configurable<bool> populateTracksDCA{"populateTracksDCA", true, "populate TracksDCA table"};
@@ -286,6 +291,19 @@ struct OnTheFlyTracker {
   std::vector<cascadecandidate> cascadesAlice3;
   std::vector<v0candidate> v0sAlice3;
 
+  // Primaries smeared ahead of the particle loop, in parallel chunks (useKeyedSmearingRandom)
+  struct PrimaryTrack {
+    o2::track::TrackParCov track; // smeared in place
+    int64_t particleIndex = 0;
+    int pdg = 0;
+    bool reconstructed = false;
+    bool isSmeared = false; // not smeared ahead of the particle loop if false
+  };
+  std::vector<PrimaryTrack> primaryTracks;                                                // per particle of the collision
+  std::vector<int> primariesToSmear;                                                      // particles to smear ahead of the particle loop
+  std::vector<std::vector<std::unique_ptr<o2::fastsim::FastTracker>>> threadFastTrackers; // [configuration][thread] copies for fastTrackPrimaries
+  std::vector<std::unique_ptr<TRandom3>> threadRandoms;                                   // [thread] random generators of the copies
+
   // For TGenPhaseSpace seed
   TRandom3 rand;
   Service<o2::ccdb::BasicCCDBManager> ccdb;
@@ -361,6 +379,9 @@ struct OnTheFlyTracker {
         // smear un-reco'ed tracks if asked to do so
         mSmearer[icfg]->skipUnreconstructed(!processUnreconstructedTracks.value);
 
+        // key of the random streams used with useKeyedSmearingRandom
+        mSmearer[icfg]->setSeed(seed.value);
+
         insertHist(histPath + "hPtGenerated", "hPtGenerated", {kTH1D, {{axes.axisMomentum}}});
         insertHist(histPath + "hPhiGenerated", "hPhiGenerated", {kTH1D, {{100, 0.0f, 2 * M_PI, "#phi (rad)"}}});
 
@@ -561,6 +582,44 @@ struct OnTheFlyTracker {
     // Set seed for TGenPhaseSpace
     rand.SetSeed(seed);
     gRandom->SetSeed(seed);
+
+    if (nThreads > 1 && !useKeyedSmearingRandom) {
+      LOG(fatal) << "nThreads > 1 requires useKeyedSmearingRandom, so that the output does not depend on the processing order";
+    }
+    if (useKeyedSmearingRandom && fastPrimaryTrackerSettings.fastTrackPrimaries) {
+      // each thread fast-tracks the primaries with its own copy of the FastTracker and its own random generator
+      for (int iThread = 0; iThread < std::max(1, nThreads.value); ++iThread) {
+        threadRandoms.emplace_back(std::make_unique<TRandom3>());
+      }
+      for (const auto& tracker : fastTracker) {
+        auto& copies = threadFastTrackers.emplace_back();
+        for (const auto& threadRandom : threadRandoms) {
+          copies.emplace_back(std::make_unique<o2::fastsim::FastTracker>(*tracker));
+          copies.back()->SetRandom(threadRandom.get());
+        }
+      }
+    }
+  }
+
+  /// Smears a primary with the random stream keyed by (seed, collision, particle), with the LUTs or the FastTracker
+  /// \param iThread selects the FastTracker copy and its random generator, reseeded for each particle
+  void smearPrimary(PrimaryTrack& primary, int64_t collisionIndex, int icfg, int iThread)
+  {
+    if (!fastPrimaryTrackerSettings.fastTrackPrimaries) {
+      primary.reconstructed = mSmearer[icfg]->smearTrack(primary.track, primary.pdg, dNdEta, collisionIndex, primary.particleIndex);
+    } else {
+      static constexpr uint32_t kFastTrackerStream = 0x46545243; // separates the FastTracker seeds from the LUT smearing streams
+      const uint64_t particleIndex = primary.particleIndex;
+      const uint64_t collision = collisionIndex;
+      const auto words = o2::delphes::PhiloxRandom::generate({kFastTrackerStream, static_cast<uint32_t>(particleIndex), static_cast<uint32_t>(collision),
+                                                              static_cast<uint32_t>(((particleIndex >> 32) << 16) ^ (collision >> 32))},
+                                                             seed.value);
+      threadRandoms[iThread]->SetSeed(words[0] | 1u); // a null seed would be taken from the clock
+      const o2::track::TrackParCov o2Track(primary.track);
+      const int nHits = threadFastTrackers[icfg][iThread]->FastTrack(o2Track, primary.track, dNdEta);
+      primary.reconstructed = (nHits >= fastPrimaryTrackerSettings.minSiliconHits);
+    }
+    primary.isSmeared = true;
   }
 
   /// Function to decay the xi
@@ -726,6 +785,52 @@ struct OnTheFlyTracker {
     uint32_t multiplicityCounter = 0;
     getHist(TH1, histPath + "hLUTMultiplicity")->Fill(dNdEta);
 
+    // Smear the primaries ahead of the particle loop, in parallel chunks. The random stream of each particle only
+    // depends on (seed, collision, particle), so that the output is the same for any number of threads
+    const bool smearPrimariesKeyed = useKeyedSmearingRandom && (enablePrimarySmearing || fastPrimaryTrackerSettings.fastTrackPrimaries);
+    if (smearPrimariesKeyed) {
+      primaryTracks.assign(mcParticles.size(), PrimaryTrack{});
+      primariesToSmear.clear();
+      int iParticle = 0;
+      for (const auto& mcParticle : mcParticles) { // serial: table access and PDG database
+        auto& primary = primaryTracks[iParticle++];
+        if (!mcParticle.isPhysicalPrimary() || std::fabs(mcParticle.eta()) > maxEta || mcParticle.pt() < minPt) {
+          continue;
+        }
+        const bool isV0 = std::find(v0PDGs.begin(), v0PDGs.end(), std::abs(mcParticle.pdgCode())) != v0PDGs.end();
+        const bool longLivedToBeHandled = std::find(longLivedHandledPDGs.begin(), longLivedHandledPDGs.end(), std::abs(mcParticle.pdgCode())) != longLivedHandledPDGs.end();
+        const bool nucleiToBeHandled = std::find(nucleiPDGs.begin(), nucleiPDGs.end(), std::abs(mcParticle.pdgCode())) != nucleiPDGs.end();
+        const bool pdgsToBeHandled = longLivedToBeHandled || (enableNucleiSmearing && nucleiToBeHandled) || (cascadeDecaySettings.decayXi && mcParticle.pdgCode() == kXiMinus) || (v0DecaySettings.decayV0 && isV0);
+        if (!pdgsToBeHandled) {
+          continue;
+        }
+        if (cascadeDecaySettings.trackXi && mcParticle.pdgCode() == kXiMinus) {
+          continue; // propagated in the particle loop before being smeared
+        }
+        o2::upgrade::convertMCParticleToO2Track(mcParticle, primary.track, pdgDB);
+        primary.particleIndex = mcParticle.globalIndex();
+        primary.pdg = mcParticle.pdgCode();
+        primariesToSmear.push_back(iParticle - 1);
+      }
+      const int64_t collisionIndex = mcCollision.globalIndex();
+      const int nPrimaries = primariesToSmear.size();
+      const int nWorkers = std::clamp(nThreads.value, 1, std::max(1, nPrimaries));
+      const int chunkSize = (nPrimaries + nWorkers - 1) / nWorkers;
+      auto smearChunk = [&](int iThread) {
+        for (int i = iThread * chunkSize; i < std::min(nPrimaries, (iThread + 1) * chunkSize); ++i) {
+          smearPrimary(primaryTracks[primariesToSmear[i]], collisionIndex, icfg, iThread);
+        }
+      };
+      std::vector<std::thread> workers;
+      for (int iThread = 1; iThread < nWorkers; ++iThread) {
+        workers.emplace_back(smearChunk, iThread);
+      }
+      smearChunk(0);
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+
     // Now that the multiplicity is known, we can process the particles to smear them
     double xiDecayRadius2D = 0;
     double laDecayRadius2D = 0;
@@ -733,7 +838,9 @@ struct OnTheFlyTracker {
     std::vector<TLorentzVector> decayProducts;
     std::vector<TLorentzVector> v0DecayProducts;
     std::vector<double> xiDecayVertex, laDecayVertex, v0DecayVertex;
+    int particleCounter = 0;
     for (const auto& mcParticle : mcParticles) {
+      const int iParticle = particleCounter++;
       xiDecayRadius2D = 0;
       laDecayRadius2D = 0;
       v0DecayRadius2D = 0;
@@ -1277,7 +1384,21 @@ struct OnTheFlyTracker {
       }
 
       bool reconstructed = true;
-      if (enablePrimarySmearing && !fastPrimaryTrackerSettings.fastTrackPrimaries) {
+      if (smearPrimariesKeyed) {
+        auto& primary = primaryTracks[iParticle];
+        if (!primary.isSmeared) { // not smeared ahead of the particle loop
+          if (fastPrimaryTrackerSettings.fastTrackPrimaries) {
+            o2::upgrade::convertMCParticleToO2Track(mcParticle, primary.track, pdgDB);
+          } else {
+            primary.track = trackParCov;
+          }
+          primary.particleIndex = mcParticle.globalIndex();
+          primary.pdg = mcParticle.pdgCode();
+          smearPrimary(primary, mcCollision.globalIndex(), icfg, 0);
+        }
+        trackParCov = primary.track;
+        reconstructed = primary.reconstructed;
+      } else if (enablePrimarySmearing && !fastPrimaryTrackerSettings.fastTrackPrimaries) {
         reconstructed = mSmearer[icfg]->smearTrack(trackParCov, mcParticle.pdgCode(), dNdEta);
       } else if (fastPrimaryTrackerSettings.fastTrackPrimaries) {
         o2::track::TrackParCov o2Track;
@@ -1547,8 +1668,16 @@ struct OnTheFlyTracker {
 
     // do bookkeeping of fastTracker tracking
     if (enableSecondarySmearing) {
-      histos.fill(HIST("hCovMatOK"), 0.0f, fastTracker[icfg]->GetCovMatNotOK());
-      histos.fill(HIST("hCovMatOK"), 1.0f, fastTracker[icfg]->GetCovMatOK());
+      uint64_t covMatNotOK = fastTracker[icfg]->GetCovMatNotOK();
+      uint64_t covMatOK = fastTracker[icfg]->GetCovMatOK();
+      if (static_cast<size_t>(icfg) < threadFastTrackers.size()) {
+        for (const auto& copy : threadFastTrackers[icfg]) {
+          covMatNotOK += copy->GetCovMatNotOK();
+          covMatOK += copy->GetCovMatOK();
+        }
+      }
+      histos.fill(HIST("hCovMatOK"), 0.0f, covMatNotOK);
+      histos.fill(HIST("hCovMatOK"), 1.0f, covMatOK);
     }
   } // end process
 
@@ -0,0 +1,51 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   convertDelphesLut.cxx
+/// \brief  exec to convert DelphesO2 LUT files (.dat) into flat LUT files, memory-mapped when loaded by the TrackSmearer
+///         Usage: o2-alice3-delphes-lut-convert <input LUT> <output flat LUT>
+///
+
+#include "ALICE3/Core/DelphesO2TrackSmearer.h"
+
+#include <Framework/Logger.h>
+
+#include <cstring>
+
+using namespace o2::delphes;
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    LOG(error) << "Usage: " << argv[0] << " <input LUT> <output flat LUT>";
+    return 1;
+  }
+  if (!LutTable::convert(argv[1], argv[2])) {
+    LOG(error) << "Could not convert " << argv[1] << " to a flat LUT";
+    return 1;
+  }
+
+  // Check that the flat LUT is read back identical to the input one
+  LutTable input, output;
+  if (!input.load(argv[1]) || !output.load(argv[2]) || !output.isMapped()) {
+    LOG(error) << "Could not read back the flat LUT " << argv[2];
+    return 1;
+  }
+  if (input.getNEntries() != output.getNEntries() ||
+      std::memcmp(input.getHeader(), output.getHeader(), sizeof(lutHeader_t)) != 0 ||
+      std::memcmp(input.getEntry(0, 0, 0, 0), output.getEntry(0, 0, 0, 0), input.getNEntries() * sizeof(lutEntry_t)) != 0) {
+    LOG(error) << "Flat LUT " << argv[2] << " differs from " << argv[1];
+    return 1;
+  }
+  LOG(info) << "Flat LUT " << argv[2] << " written with " << output.getNEntries() << " entries";
+  return 0;
+}
@@ -28,9 +28,9 @@
 #include <Rtypes.h>
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
-#include <memory>
 #include <utility>
 #include <vector>
 
@@ -123,12 +123,12 @@ class CollisionAssociation
     }
   }
 
-  template <typename TTracksUnfiltered, typename TTracks, typename TAmbiTracks, typename Assoc, typename RevIndices>
-  void runAssocWithTime(o2::aod::Collisions const& collisions,
+  template <typename TCollisions, typename TTracksUnfiltered, typename TTracks, typename TAmbiTracks, typename TBCs, typename Assoc, typename RevIndices>
+  void runAssocWithTime(TCollisions const& collisions,
                         TTracksUnfiltered const& tracksUnfiltered,
                         TTracks const& tracks,
                         TAmbiTracks const& ambiguousTracks,
-                        o2::aod::BCs const& bcs,
+                        TBCs const& bcs,
                         Assoc& association,
                         RevIndices& reverseIndices)
   {
@@ -143,32 +143,37 @@ class CollisionAssociation
     if (tracks.size() > 0) {
       lastCollisionId = trackBegin.collisionId();
     }
+    // index of the first ambiguous-track entry of each track, built once to avoid scanning the ambiguous tracks for each unassigned track
+    std::vector<int> ambTrackIndexPerTrack;
+    if (mIncludeUnassigned) {
+      ambTrackIndexPerTrack.assign(tracksUnfiltered.size(), -1);
+      for (const auto& ambTrack : ambiguousTracks) {
+        int64_t trackId = -1;
+        if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
+          trackId = ambTrack.trackId();
+        } else {
+          trackId = ambTrack.template getId<TTracks>();
+        }
+        if (trackId >= 0 && trackId < static_cast<int64_t>(ambTrackIndexPerTrack.size()) && ambTrackIndexPerTrack[trackId] < 0) {
+          ambTrackIndexPerTrack[trackId] = ambTrack.globalIndex();
+        }
+      }
+    }
     auto track = trackBegin;
     for (; track != tracks.end(); ++track) {
       int64_t trackBC = -1;
       if (track.has_collision()) {
         trackBC = track.collision().bc().globalBC();
-      } else if (mIncludeUnassigned) {
-        for (const auto& ambTrack : ambiguousTracks) {
-          if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
-            if (ambTrack.trackId() == track.globalIndex()) {
-              // special check to avoid crashes (in particular on some MC datasets)
-              // related to shifts in ambiguous tracks association to bc slices (off by 1) - see https://mattermost.web.cern.ch/alice/pl/g9yaaf3tn3g4pgn7c1yex9copy
-              if (ambTrack.bcIds()[0] >= bcs.size() || ambTrack.bcIds()[1] >= bcs.size()) {
-                break;
-              }
-              if (!ambTrack.has_bc() || ambTrack.bc().size() == 0) {
-                break;
-              }
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
-          } else {
-            if (ambTrack.template getId<TTracks>() == track.globalIndex()) {
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
+      } else if (mIncludeUnassigned && ambTrackIndexPerTrack[track.globalIndex()] >= 0) {
+        auto ambTrack = ambiguousTracks.rawIteratorAt(ambTrackIndexPerTrack[track.globalIndex()]);
+        if constexpr (isCentralBarrel) {
+          // special check to avoid crashes (in particular on some MC datasets)
+          // related to shifts in ambiguous tracks association to bc slices (off by 1) - see https://mattermost.web.cern.ch/alice/pl/g9yaaf3tn3g4pgn7c1yex9copy
+          if (ambTrack.bcIds()[0] < bcs.size() && ambTrack.bcIds()[1] < bcs.size() && ambTrack.has_bc() && ambTrack.bc().size() != 0) {
+            trackBC = ambTrack.bc().begin().globalBC();
           }
+        } else {
+          trackBC = ambTrack.bc().begin().globalBC();
         }
       }
       globalBC.push_back(trackBC);
@@ -189,8 +194,9 @@ class CollisionAssociation
       trackIterationWindows.push_back(std::make_pair(trackBegin, track));
     }
 
-    // define vector of vectors to store indices of compatible collisions per track
-    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
+    // store the compatible (track, collision) pairs, converted to compressed sparse rows per track at the end
+    std::vector<int> assocTrackIds;
+    std::vector<int> assocCollIds;
 
     // loop over collisions to find time-compatible tracks
     int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
@@ -278,10 +284,8 @@ class CollisionAssociation
             LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
             association(collIdx, trackIdx);
             if (mFillTableOfCollIdsPerTrack) {
-              if (collsPerTrack[trackIdx] == nullptr) {
-                collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
-              }
-              collsPerTrack[trackIdx].get()->push_back(collIdx);
+              assocTrackIds.push_back(trackIdx);
+              assocCollIds.push_back(collIdx);
             }
           }
         }
@@ -289,15 +293,25 @@ class CollisionAssociation
     }
     // create reverse index track to collisions if enabled
     if (mFillTableOfCollIdsPerTrack) {
-      std::vector<int> empty{};
-      for (const auto& trackUnfiltered : tracksUnfiltered) {
+      // offsets and flat list of collision indices per track (stable in the order the collisions were found)
+      std::vector<int> collsPerTrackOffsets(tracksUnfiltered.size() + 1, 0);
+      for (const auto& trackIdx : assocTrackIds) {
+        ++collsPerTrackOffsets[trackIdx + 1];
+      }
+      for (std::size_t iTrack = 0; iTrack + 1 < collsPerTrackOffsets.size(); ++iTrack) {
+        collsPerTrackOffsets[iTrack + 1] += collsPerTrackOffsets[iTrack];
+      }
+      std::vector<int> collsPerTrack(assocCollIds.size());
+      std::vector<int> fillPosition(collsPerTrackOffsets.begin(), collsPerTrackOffsets.end() - 1);
+      for (std::size_t iAssoc = 0; iAssoc < assocTrackIds.size(); ++iAssoc) {
+        collsPerTrack[fillPosition[assocTrackIds[iAssoc]]++] = assocCollIds[iAssoc];
+      }
 
+      std::vector<int> collIds{};
+      for (const auto& trackUnfiltered : tracksUnfiltered) {
         const auto trackId = trackUnfiltered.globalIndex();
-        if (collsPerTrack[trackId] == nullptr) {
-          reverseIndices(empty);
-        } else {
-          reverseIndices(*collsPerTrack[trackId].get());
-        }
+        collIds.assign(collsPerTrack.begin() + collsPerTrackOffsets[trackId], collsPerTrack.begin() + collsPerTrackOffsets[trackId + 1]);
+        reverseIndices(collIds);
       }
     }
   }
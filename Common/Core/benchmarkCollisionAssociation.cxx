@@ -0,0 +1,365 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmarkCollisionAssociation.cxx
+/// \brief exec timing the time-based track-to-collision association of central-barrel tracks (CollisionAssociation::runAssocWithTime)
+///        on synthetic collision, track and ambiguous-track tables, against the previous implementation that scans the ambiguous
+///        tracks for each unassigned track, and checking that the association and the reverse indices are identical
+///        Usage: o2-bench-collision-association [number of collisions] [tracks per collision] [fraction of unassigned tracks]
+
+#include "Common/Core/CollisionAssociation.h"
+
+#include <CommonConstants/LHCConstants.h>
+#include <Framework/DataTypes.h>
+#include <Framework/Logger.h>
+
+#include <Rtypes.h>
+#include <TRandom3.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Synthetic tables, stored as columns
+struct SynthData {
+  std::vector<int64_t> bcGlobalBC;
+  std::vector<int> collBCId;
+  std::vector<float> collTime, collTimeRes;
+  std::vector<int> trackCollId;
+  std::vector<float> trackTime, trackTimeRes;
+  std::vector<uint32_t> trackFlags;
+  std::vector<bool> trackIsPVContributor;
+  std::vector<int> ambTrackId;
+  std::vector<std::array<int, 2>> ambBCIds;
+};
+
+// Row iterators with the interface of the table iterators used by runAssocWithTime
+template <typename TRow>
+struct SynthRow {
+  const SynthData* data = nullptr;
+  int64_t index = 0;
+  TRow& operator++()
+  {
+    ++index;
+    return static_cast<TRow&>(*this);
+  }
+  const TRow& operator*() const { return static_cast<const TRow&>(*this); }
+  bool operator==(const SynthRow& other) const { return index == other.index; }
+  int64_t globalIndex() const { return index; }
+  int64_t filteredIndex() const { return index; }
+  void setCursor(int64_t newIndex) { index = newIndex; }
+};
+
+struct SynthBC : SynthRow<SynthBC> {
+  int64_t globalBC() const { return data->bcGlobalBC[index]; }
+};
+
+struct SynthBCSlice {
+  const SynthData* data = nullptr;
+  int first = 0;
+  int last = -1;
+  int64_t size() const { return last - first + 1; }
+  SynthBC begin() const { return SynthBC{{data, first}}; }
+};
+
+struct SynthCollision : SynthRow<SynthCollision> {
+  float collisionTime() const { return data->collTime[index]; }
+  float collisionTimeRes() const { return data->collTimeRes[index]; }
+  SynthBC bc() const { return SynthBC{{data, data->collBCId[index]}}; }
+};
+
+struct SynthTrack : SynthRow<SynthTrack> {
+  int collisionId() const { return data->trackCollId[index]; }
+  bool has_collision() const { return collisionId() >= 0; } // o2-linter: disable=name/function-variable (table interface)
+  SynthCollision collision() const { return SynthCollision{{data, collisionId()}}; }
+  float trackTime() const { return data->trackTime[index]; }
+  float trackTimeRes() const { return data->trackTimeRes[index]; }
+  uint32_t flags() const { return data->trackFlags[index]; }
+  bool isPVContributor() const { return data->trackIsPVContributor[index]; }
+};
+
+struct SynthAmbTrack : SynthRow<SynthAmbTrack> {
+  int trackId() const { return data->ambTrackId[index]; }
+  std::array<int, 2> bcIds() const { return data->ambBCIds[index]; }
+  bool has_bc() const { return bcIds()[0] >= 0; } // o2-linter: disable=name/function-variable (table interface)
+  SynthBCSlice bc() const { return SynthBCSlice{data, bcIds()[0], bcIds()[1]}; }
+};
+
+template <typename TRow>
+struct SynthTable {
+  using iterator = TRow;
+  const SynthData* data = nullptr;
+  int64_t nRows = 0;
+  TRow begin() const { return TRow{{data, 0}}; }
+  TRow end() const { return TRow{{data, nRows}}; }
+  int64_t size() const { return nRows; }
+  TRow rawIteratorAt(int64_t index) const { return TRow{{data, index}}; }
+};
+
+// Output cursors, storing the filled rows
+struct AssocCursor {
+  std::vector<std::pair<int64_t, int64_t>> rows;
+  void operator()(int64_t collisionId, int64_t trackId) { rows.emplace_back(collisionId, trackId); }
+};
+
+struct RevIndicesCursor {
+  std::vector<std::vector<int>> rows;
+  void operator()(std::vector<int> const& collisionIds) { rows.push_back(collisionIds); }
+};
+
+/// Previous implementation of CollisionAssociation<true>::runAssocWithTime, which scans the ambiguous tracks for each unassigned track
+class CollisionAssociationScan
+{
+ public:
+  float mNumSigmaForTimeCompat{4.};
+  float mTimeMargin{500.};
+  bool mUsePvAssociation{true};
+  bool mIncludeUnassigned{true};
+  bool mFillTableOfCollIdsPerTrack{true};
+  int mBcWindowForOneSigma{115};
+
+  template <typename TCollisions, typename TTracksUnfiltered, typename TTracks, typename TAmbiTracks, typename TBCs, typename Assoc, typename RevIndices>
+  void runAssocWithTime(TCollisions const& collisions, TTracksUnfiltered const& tracksUnfiltered, TTracks const& tracks, TAmbiTracks const& ambiguousTracks, TBCs const& bcs, Assoc& association, RevIndices& reverseIndices)
+  {
+    std::vector<int64_t> globalBC;
+    std::vector<int64_t> trackBCCache;
+    std::vector<std::pair<typename TTracks::iterator, typename TTracks::iterator>> trackIterationWindows;
+    auto trackBegin = tracks.begin();
+    int lastCollisionId = 0;
+    if (tracks.size() > 0) {
+      lastCollisionId = trackBegin.collisionId();
+    }
+    auto track = trackBegin;
+    for (; track != tracks.end(); ++track) {
+      int64_t trackBC = -1;
+      if (track.has_collision()) {
+        trackBC = track.collision().bc().globalBC();
+      } else if (mIncludeUnassigned) {
+        for (const auto& ambTrack : ambiguousTracks) {
+          if (ambTrack.trackId() == track.globalIndex()) {
+            if (ambTrack.bcIds()[0] >= bcs.size() || ambTrack.bcIds()[1] >= bcs.size()) {
+              break;
+            }
+            if (!ambTrack.has_bc() || ambTrack.bc().size() == 0) {
+              break;
+            }
+            trackBC = ambTrack.bc().begin().globalBC();
+            break;
+          }
+        }
+      }
+      globalBC.push_back(trackBC);
+      trackBCCache.push_back(trackBC + track.trackTime() / o2::constants::lhc::LHCBunchSpacingNS);
+      if ((track.collisionId() < lastCollisionId) || (lastCollisionId < 0 && track.collisionId() >= 0)) {
+        if (lastCollisionId >= 0 || mIncludeUnassigned) {
+          trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+        }
+        trackBegin = track;
+      }
+      lastCollisionId = track.collisionId();
+    }
+    if (lastCollisionId >= 0 || mIncludeUnassigned) {
+      trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+    }
+
+    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
+    int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
+    for (const auto& collision : collisions) {
+      const float collTime = collision.collisionTime();
+      const float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
+      uint64_t collBC = collision.bc().globalBC();
+      for (auto& iterationWindow : trackIterationWindows) { // o2-linter: disable=const-ref-in-for-loop (iterationWindow is modified)
+        bool iteratorMoved = false;
+        const bool isAssignedTrackWindow = (iterationWindow.first != iterationWindow.second) ? iterationWindow.first.has_collision() : false;
+        for (auto trackInWindow = iterationWindow.first; trackInWindow != iterationWindow.second; ++trackInWindow) {
+          int64_t trackBC = globalBC[trackInWindow.filteredIndex()];
+          if (trackBC < 0) {
+            continue;
+          }
+          const int64_t bcOffset = trackBC - static_cast<int64_t>(collBC);
+          if (isAssignedTrackWindow) {
+            constexpr int margin = 200;
+            if (!iteratorMoved && bcOffset > -bcOffsetMax - margin) {
+              iterationWindow.first.setCursor(trackInWindow.filteredIndex());
+              iteratorMoved = true;
+            } else if (bcOffset > bcOffsetMax + margin) {
+              break;
+            }
+          }
+          int64_t bcOffsetWindow = trackBCCache[trackInWindow.filteredIndex()] - static_cast<int64_t>(collBC);
+          if (std::abs(bcOffsetWindow) > bcOffsetMax) {
+            continue;
+          }
+          float trackTime = 0;
+          float trackTimeRes = 0;
+          if (mUsePvAssociation && trackInWindow.isPVContributor()) {
+            trackTime = trackInWindow.collision().collisionTime();
+            trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS;
+          } else {
+            trackTime = trackInWindow.trackTime();
+            trackTimeRes = trackInWindow.trackTimeRes();
+          }
+          const float deltaTime = trackTime - collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
+          float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
+          float thresholdTime = 0.;
+          if (mUsePvAssociation && trackInWindow.isPVContributor()) {
+            thresholdTime = trackTimeRes;
+          } else if (TESTBIT(trackInWindow.flags(), o2::aod::track::TrackTimeResIsRange)) {
+            thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
+          } else {
+            thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
+          }
+          if (std::abs(deltaTime) < thresholdTime) {
+            const auto collIdx = collision.globalIndex();
+            const auto trackIdx = trackInWindow.globalIndex();
+            association(collIdx, trackIdx);
+            if (mFillTableOfCollIdsPerTrack) {
+              if (collsPerTrack[trackIdx] == nullptr) {
+                collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
+              }
+              collsPerTrack[trackIdx].get()->push_back(collIdx);
+            }
+          }
+        }
+      }
+    }
+    if (mFillTableOfCollIdsPerTrack) {
+      std::vector<int> empty{};
+      for (const auto& trackUnfiltered : tracksUnfiltered) {
+        const auto trackId = trackUnfiltered.globalIndex();
+        if (collsPerTrack[trackId] == nullptr) {
+          reverseIndices(empty);
+        } else {
+          reverseIndices(*collsPerTrack[trackId].get());
+        }
+      }
+    }
+  }
+};
+
+/// Fills the synthetic tables: collisions ordered in BC, their tracks ordered by collision, followed by the unassigned tracks ordered in BC.
+/// Each unassigned track has an ambiguous-track entry, as well as a fraction of the assigned tracks (ambiguous tracks ordered by track).
+/// Some ambiguous tracks have BC ranges out of the BC table or no BC, as in the datasets that motivated the BC-range check.
+SynthData generate(int nCollisions, int nTracksPerCollision, float fractionUnassigned, TRandom3& random)
+{
+  constexpr float TrackTimeRes = 100.f;       // ns, ITS-TPC tracks
+  constexpr float TrackTimeRange = 2000.f;    // ns, ITS-only tracks (time resolution given as a range)
+  constexpr double MeanBCsBetweenColls = 50.; // ~ 800 kHz interaction rate
+  SynthData data;
+  int64_t globalBC = 100000;
+  for (int iColl = 0; iColl < nCollisions; iColl++) {
+    globalBC += 1 + static_cast<int64_t>(random.Exp(MeanBCsBetweenColls));
+    data.bcGlobalBC.push_back(globalBC);
+    data.collBCId.push_back(data.bcGlobalBC.size() - 1);
+    data.collTime.push_back(random.Gaus(0., 5.));
+    data.collTimeRes.push_back(random.Uniform(5., 30.));
+  }
+  std::vector<std::pair<int64_t, int>> ambiguous; // (track, first BC)
+  auto addTrack = [&](int collisionId, int64_t bcId) {
+    const bool isRange = random.Uniform() < 0.2;
+    data.trackCollId.push_back(collisionId);
+    data.trackTime.push_back(random.Gaus(0., isRange ? TrackTimeRange / 2 : TrackTimeRes));
+    data.trackTimeRes.push_back(isRange ? TrackTimeRange : TrackTimeRes);
+    data.trackFlags.push_back(isRange ? o2::aod::track::TrackTimeResIsRange : 0u);
+    data.trackIsPVContributor.push_back(collisionId >= 0 && random.Uniform() < 0.5);
+    if (collisionId < 0 || random.Uniform() < 0.1) {
+      ambiguous.emplace_back(data.trackCollId.size() - 1, bcId);
+    }
+  };
+  const int nAssigned = std::lround(nTracksPerCollision * (1. - fractionUnassigned));
+  const int nUnassigned = nTracksPerCollision - nAssigned;
+  for (int iColl = 0; iColl < nCollisions; iColl++) {
+    for (int iTrack = 0; iTrack < nAssigned; iTrack++) {
+      addTrack(iColl, data.collBCId[iColl]);
+    }
+  }
+  for (int iColl = 0; iColl < nCollisions; iColl++) {
+    for (int iTrack = 0; iTrack < nUnassigned; iTrack++) {
+      addTrack(-1, data.collBCId[iColl]);
+    }
+  }
+  const int nBCs = data.bcGlobalBC.size();
+  for (const auto& [trackId, bcId] : ambiguous) {
+    data.ambTrackId.push_back(trackId);
+    const double flag = random.Uniform();
+    if (flag < 0.01) {
+      data.ambBCIds.push_back({nBCs, nBCs}); // out of the BC table
+    } else if (flag < 0.02) {
+      data.ambBCIds.push_back({-1, -1}); // no BC
+    } else {
+      data.ambBCIds.push_back({static_cast<int>(bcId), std::min(static_cast<int>(bcId) + 1, nBCs - 1)});
+    }
+  }
+  return data;
+}
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const int nCollisions = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const int nTracksPerCollision = argc > 2 ? std::atoi(argv[2]) : 30;
+  const float fractionUnassigned = argc > 3 ? std::atof(argv[3]) : 0.2;
+
+  TRandom3 random(1);
+  const SynthData data = generate(nCollisions, nTracksPerCollision, fractionUnassigned, random);
+  const SynthTable<SynthCollision> collisions{&data, static_cast<int64_t>(data.collTime.size())};
+  const SynthTable<SynthTrack> tracks{&data, static_cast<int64_t>(data.trackCollId.size())};
+  const SynthTable<SynthAmbTrack> ambiguousTracks{&data, static_cast<int64_t>(data.ambTrackId.size())};
+  const SynthTable<SynthBC> bcs{&data, static_cast<int64_t>(data.bcGlobalBC.size())};
+  LOGP(info, "{} collisions, {} tracks, {} ambiguous tracks", collisions.size(), tracks.size(), ambiguousTracks.size());
+
+  bool identical = true;
+  for (const bool includeUnassigned : {true, false}) {
+    for (const bool usePvAssociation : {true, false}) {
+      CollisionAssociationScan scan;
+      scan.mIncludeUnassigned = includeUnassigned;
+      scan.mUsePvAssociation = usePvAssociation;
+      AssocCursor assocScan;
+      RevIndicesCursor revIndicesScan;
+      auto start = std::chrono::steady_clock::now();
+      scan.runAssocWithTime(collisions, tracks, tracks, ambiguousTracks, bcs, assocScan, revIndicesScan);
+      const double timeScan = elapsedMilliseconds(start);
+
+      CollisionAssociation<true> indexed;
+      indexed.setIncludeUnassigned(includeUnassigned);
+      indexed.setUsePvAssociation(usePvAssociation);
+      indexed.setFillTableOfCollIdsPerTrack(true);
+      AssocCursor assocIndexed;
+      RevIndicesCursor revIndicesIndexed;
+      start = std::chrono::steady_clock::now();
+      indexed.runAssocWithTime(collisions, tracks, tracks, ambiguousTracks, bcs, assocIndexed, revIndicesIndexed);
+      const double timeIndexed = elapsedMilliseconds(start);
+
+      const bool same = assocScan.rows == assocIndexed.rows && revIndicesScan.rows == revIndicesIndexed.rows;
+      identical &= same;
+      LOGF(info, "includeUnassigned %d, usePvAssociation %d: scan %.1f ms, index %.1f ms (x%.1f), %zu associations, output %s",
+           includeUnassigned, usePvAssociation, timeScan, timeIndexed, timeScan / timeIndexed, assocIndexed.rows.size(), same ? "identical" : "DIFFERENT");
+    }
+  }
+  if (!identical) {
+    LOG(error) << "The association differs from the one of the ambiguous-track scan";
+    return 1;
+  }
+  return 0;
+}
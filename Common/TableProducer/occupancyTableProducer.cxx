@@ -311,24 +311,29 @@ struct OccupancyTableProducer {
     std::vector<std::array<int, 2>>& medianPosVec,
     const Vecs&... vectors)
   {
-    const int n = sizeof...(Vecs);                             // Number of vectors
+    constexpr int n = sizeof...(Vecs);                         // Number of vectors
     const int size = std::get<0>(std::tie(vectors...)).size(); // Size of the first vector
 
+    std::array<std::array<double, 2>, n> data; // first element is entry, second is index
     for (int i = 0; i < size; i++) {
-      std::vector<std::array<double, 2>> data; // first element is entry, second is index
       int iEntry = 0;
 
       // Lambda to iterate over all vectors
       auto collect = [&](const auto& vec) {
-        data.push_back({vec[i], static_cast<double>(iEntry)});
+        data[iEntry] = {vec[i], static_cast<double>(iEntry)};
         iEntry++;
       };
       (collect(vectors), ...); // Unpack variadic arguments and apply lambda
 
-      // Sort the data
-      std::sort(data.begin(), data.end(), [](const std::array<double, 2>& a, const std::array<double, 2>& b) {
-        return a[0] < b[0];
-      });
+      // Sort the data, insertion sort of the few entries (equal entries keep the order of the vectors)
+      for (int j = 1; j < n; j++) {
+        const auto entry = data[j];
+        int k = j - 1;
+        for (; k >= 0 && data[k][0] > entry[0]; k--) {
+          data[k + 1] = data[k];
+        }
+        data[k + 1] = entry;
+      }
 
       double median;
       int two = 2;
@@ -1289,41 +1294,63 @@ struct TrackMeanOccTableProducer {
   Configurable<bool> buildPointerTrackQAToTMOTable{"buildPointerTrackQAToTMOTable", true, "buildPointerTrackQAToTMOTable"};
   Configurable<bool> buildPointerTMOToTrackQATable{"buildPointerTMOToTrackQATable", true, "buildPointerTMOToTrackQATable"};
 
+  // occupancy vector of the current TF and its prefix sums, to get the mean occupancy of a range of bins in O(1)
+  struct OccupancyVector {
+    std::vector<float> occ;
+    std::vector<double> prefixSum; // prefixSum[i] = sum of the first i bins
+
+    void resize(std::size_t n)
+    {
+      occ.resize(n);
+      prefixSum.resize(n + 1);
+    }
+
+    template <typename It>
+    void fill(It begin, It end)
+    {
+      std::copy(begin, end, occ.begin());
+      prefixSum[0] = 0.;
+      for (std::size_t i = 0; i < occ.size(); i++) {
+        prefixSum[i + 1] = prefixSum[i] + occ[i];
+      }
+    }
+  };
+
   // vectors to be used for occupancy estimation
-  std::vector<float> occPrimUnfm80;
-
-  std::vector<float> occFV0AUnfm80;
-  std::vector<float> occFV0CUnfm80;
-  std::vector<float> occFT0AUnfm80;
-  std::vector<float> occFT0CUnfm80;
-
-  std::vector<float> occFDDAUnfm80;
-  std::vector<float> occFDDCUnfm80;
-
-  std::vector<float> occNTrackITSUnfm80;
-  std::vector<float> occNTrackTPCUnfm80;
-  std::vector<float> occNTrackTRDUnfm80;
-  std::vector<float> occNTrackTOFUnfm80;
-  std::vector<float> occNTrackSizeUnfm80;
-  std::vector<float> occNTrackTPCAUnfm80;
-  std::vector<float> occNTrackTPCCUnfm80;
-  std::vector<float> occNTrackITSTPCUnfm80;
-  std::vector<float> occNTrackITSTPCAUnfm80;
-  std::vector<float> occNTrackITSTPCCUnfm80;
-
-  std::vector<float> occMultNTracksHasITSUnfm80;
-  std::vector<float> occMultNTracksHasTPCUnfm80;
-  std::vector<float> occMultNTracksHasTOFUnfm80;
-  std::vector<float> occMultNTracksHasTRDUnfm80;
-  std::vector<float> occMultNTracksITSOnlyUnfm80;
-  std::vector<float> occMultNTracksTPCOnlyUnfm80;
-  std::vector<float> occMultNTracksITSTPCUnfm80;
-  std::vector<float> occMultAllTracksTPCOnlyUnfm80;
-
-  std::vector<float> occRobustT0V0PrimUnfm80;
-  std::vector<float> occRobustFDDT0V0PrimUnfm80;
-  std::vector<float> occRobustNtrackDetUnfm80;
-  std::vector<float> occRobustMultTableUnfm80;
+  OccupancyVector occPrimUnfm80;
+
+  OccupancyVector occFV0AUnfm80;
+  OccupancyVector occFV0CUnfm80;
+  OccupancyVector occFT0AUnfm80;
+  OccupancyVector occFT0CUnfm80;
+
+  OccupancyVector occFDDAUnfm80;
+  OccupancyVector occFDDCUnfm80;
+
+  OccupancyVector occNTrackITSUnfm80;
+  OccupancyVector occNTrackTPCUnfm80;
+  OccupancyVector occNTrackTRDUnfm80;
+  OccupancyVector occNTrackTOFUnfm80;
+  OccupancyVector occNTrackSizeUnfm80;
+  OccupancyVector occNTrackTPCAUnfm80;
+  OccupancyVector occNTrackTPCCUnfm80;
+  OccupancyVector occNTrackITSTPCUnfm80;
+  OccupancyVector occNTrackITSTPCAUnfm80;
+  OccupancyVector occNTrackITSTPCCUnfm80;
+
+  OccupancyVector occMultNTracksHasITSUnfm80;
+  OccupancyVector occMultNTracksHasTPCUnfm80;
+  OccupancyVector occMultNTracksHasTOFUnfm80;
+  OccupancyVector occMultNTracksHasTRDUnfm80;
+  OccupancyVector occMultNTracksITSOnlyUnfm80;
+  OccupancyVector occMultNTracksTPCOnlyUnfm80;
+  OccupancyVector occMultNTracksITSTPCUnfm80;
+  OccupancyVector occMultAllTracksTPCOnlyUnfm80;
+
+  OccupancyVector occRobustT0V0PrimUnfm80;
+  OccupancyVector occRobustFDDT0V0PrimUnfm80;
+  OccupancyVector occRobustNtrackDetUnfm80;
+  OccupancyVector occRobustMultTableUnfm80;
 
   std::vector<bool> processStatus;
   std::vector<bool> processInThisBlock;
@@ -1633,9 +1660,8 @@ struct TrackMeanOccTableProducer {
     bcInTF = (bc.globalBC() - bcSOR) % nBCsPerTF;
   }
 
-  float getMeanOccupancy(int bcBegin, int bcEnd, const std::vector<float>& OccVector)
+  float getMeanOccupancy(int bcBegin, int bcEnd, const OccupancyVector& OccVector)
   {
-    float sumOfBins = 0;
     int binStart, binEnd;
     if (bcBegin <= bcEnd) {
       binStart = bcBegin;
@@ -1644,16 +1670,19 @@ struct TrackMeanOccTableProducer {
       binStart = bcEnd;
       binEnd = bcBegin;
     }
-    for (int i = binStart; i <= binEnd; i++) {
-      sumOfBins += OccVector[i];
-    }
+    double sumOfBins = OccVector.prefixSum[binEnd + 1] - OccVector.prefixSum[binStart];
     float meanOccupancy = sumOfBins / static_cast<double>(binEnd - binStart + 1);
     return meanOccupancy;
   }
 
-  float getWeightedMeanOccupancy(int bcBegin, int bcEnd, const std::vector<float>& OccVector)
+  // weights of the bins of the last range used in getWeightedMeanOccupancy, shared by all occupancy estimators of a track
+  int weightBCBegin = -1;
+  int weightBCEnd = -1;
+  std::vector<float> binWeights;
+  float binWeightSum = 0;
+
+  void computeBinWeights(int bcBegin, int bcEnd)
   {
-    float sumOfBins = 0;
     int binStart, binEnd;
     // Assuming linear dependence of R on bins
     float m;      // slope of the equation
@@ -1678,19 +1707,35 @@ struct TrackMeanOccTableProducer {
       m = (245. - 90.) / (x2 - x1);
     }
     c = 245. - m * x2;
-    float weightSum = 0;
     float wr = 0;
     float r = 0;
+    binWeights.clear();
+    binWeightSum = 0;
     for (int i = binStart; i <= binEnd; i++) {
       r = m * i + c;
       wr = 125. / r;
       if (x2 == x1) {
         wr = 1.0;
       }
-      sumOfBins += OccVector[i] * wr;
-      weightSum += wr;
+      binWeights.push_back(wr);
+      binWeightSum += wr;
+    }
+    weightBCBegin = bcBegin;
+    weightBCEnd = bcEnd;
+  }
+
+  float getWeightedMeanOccupancy(int bcBegin, int bcEnd, const OccupancyVector& OccVector)
+  {
+    // the weights only depend on the range of bins, they are computed once for all occupancy estimators
+    if (bcBegin != weightBCBegin || bcEnd != weightBCEnd) {
+      computeBinWeights(bcBegin, bcEnd);
+    }
+    const int binStart = std::min(bcBegin, bcEnd);
+    float sumOfBins = 0;
+    for (std::size_t i = 0; i < binWeights.size(); i++) {
+      sumOfBins += OccVector.occ[binStart + i] * binWeights[i];
     }
-    float meanOccupancy = sumOfBins / weightSum;
+    float meanOccupancy = sumOfBins / binWeightSum;
     return meanOccupancy;
   }
 
@@ -1977,57 +2022,57 @@ struct TrackMeanOccTableProducer {
           auto occsList = occs.iteratorAt(bc.occId());
 
           if constexpr (qaMode == fillOccRobustT0V0dependentQA) {
-            std::copy(occsRobustT0V0Prim.iteratorAt(bc.occId()).occRobustT0V0PrimUnfm80().begin(), occsRobustT0V0Prim.iteratorAt(bc.occId()).occRobustT0V0PrimUnfm80().end(), occRobustT0V0PrimUnfm80.begin());
+            occRobustT0V0PrimUnfm80.fill(occsRobustT0V0Prim.iteratorAt(bc.occId()).occRobustT0V0PrimUnfm80().begin(), occsRobustT0V0Prim.iteratorAt(bc.occId()).occRobustT0V0PrimUnfm80().end());
           }
 
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccPrim) {
-            std::copy(occsList.occPrimUnfm80().begin(), occsList.occPrimUnfm80().end(), occPrimUnfm80.begin());
+            occPrimUnfm80.fill(occsList.occPrimUnfm80().begin(), occsList.occPrimUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccT0V0) {
-            std::copy(occsList.occFV0AUnfm80().begin(), occsList.occFV0AUnfm80().end(), occFV0AUnfm80.begin());
-            std::copy(occsList.occFV0CUnfm80().begin(), occsList.occFV0CUnfm80().end(), occFV0CUnfm80.begin());
-            std::copy(occsList.occFT0AUnfm80().begin(), occsList.occFT0AUnfm80().end(), occFT0AUnfm80.begin());
-            std::copy(occsList.occFT0CUnfm80().begin(), occsList.occFT0CUnfm80().end(), occFT0CUnfm80.begin());
+            occFV0AUnfm80.fill(occsList.occFV0AUnfm80().begin(), occsList.occFV0AUnfm80().end());
+            occFV0CUnfm80.fill(occsList.occFV0CUnfm80().begin(), occsList.occFV0CUnfm80().end());
+            occFT0AUnfm80.fill(occsList.occFT0AUnfm80().begin(), occsList.occFT0AUnfm80().end());
+            occFT0CUnfm80.fill(occsList.occFT0CUnfm80().begin(), occsList.occFT0CUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccFDD) {
-            std::copy(occsList.occFDDAUnfm80().begin(), occsList.occFDDAUnfm80().end(), occFDDAUnfm80.begin());
-            std::copy(occsList.occFDDCUnfm80().begin(), occsList.occFDDCUnfm80().end(), occFDDCUnfm80.begin());
+            occFDDAUnfm80.fill(occsList.occFDDAUnfm80().begin(), occsList.occFDDAUnfm80().end());
+            occFDDCUnfm80.fill(occsList.occFDDCUnfm80().begin(), occsList.occFDDCUnfm80().end());
           }
 
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccNtrackDet) {
-            std::copy(occsList.occNTrackITSUnfm80().begin(), occsList.occNTrackITSUnfm80().end(), occNTrackITSUnfm80.begin());
-            std::copy(occsList.occNTrackTPCUnfm80().begin(), occsList.occNTrackTPCUnfm80().end(), occNTrackTPCUnfm80.begin());
-            std::copy(occsList.occNTrackTRDUnfm80().begin(), occsList.occNTrackTRDUnfm80().end(), occNTrackTRDUnfm80.begin());
-            std::copy(occsList.occNTrackTOFUnfm80().begin(), occsList.occNTrackTOFUnfm80().end(), occNTrackTOFUnfm80.begin());
-            std::copy(occsList.occNTrackSizeUnfm80().begin(), occsList.occNTrackSizeUnfm80().end(), occNTrackSizeUnfm80.begin());
-            std::copy(occsList.occNTrackTPCAUnfm80().begin(), occsList.occNTrackTPCAUnfm80().end(), occNTrackTPCAUnfm80.begin());
-            std::copy(occsList.occNTrackTPCCUnfm80().begin(), occsList.occNTrackTPCCUnfm80().end(), occNTrackTPCCUnfm80.begin());
-            std::copy(occsList.occNTrackITSTPCUnfm80().begin(), occsList.occNTrackITSTPCUnfm80().end(), occNTrackITSTPCUnfm80.begin());
-            std::copy(occsList.occNTrackITSTPCAUnfm80().begin(), occsList.occNTrackITSTPCAUnfm80().end(), occNTrackITSTPCAUnfm80.begin());
-            std::copy(occsList.occNTrackITSTPCCUnfm80().begin(), occsList.occNTrackITSTPCCUnfm80().end(), occNTrackITSTPCCUnfm80.begin());
+            occNTrackITSUnfm80.fill(occsList.occNTrackITSUnfm80().begin(), occsList.occNTrackITSUnfm80().end());
+            occNTrackTPCUnfm80.fill(occsList.occNTrackTPCUnfm80().begin(), occsList.occNTrackTPCUnfm80().end());
+            occNTrackTRDUnfm80.fill(occsList.occNTrackTRDUnfm80().begin(), occsList.occNTrackTRDUnfm80().end());
+            occNTrackTOFUnfm80.fill(occsList.occNTrackTOFUnfm80().begin(), occsList.occNTrackTOFUnfm80().end());
+            occNTrackSizeUnfm80.fill(occsList.occNTrackSizeUnfm80().begin(), occsList.occNTrackSizeUnfm80().end());
+            occNTrackTPCAUnfm80.fill(occsList.occNTrackTPCAUnfm80().begin(), occsList.occNTrackTPCAUnfm80().end());
+            occNTrackTPCCUnfm80.fill(occsList.occNTrackTPCCUnfm80().begin(), occsList.occNTrackTPCCUnfm80().end());
+            occNTrackITSTPCUnfm80.fill(occsList.occNTrackITSTPCUnfm80().begin(), occsList.occNTrackITSTPCUnfm80().end());
+            occNTrackITSTPCAUnfm80.fill(occsList.occNTrackITSTPCAUnfm80().begin(), occsList.occNTrackITSTPCAUnfm80().end());
+            occNTrackITSTPCCUnfm80.fill(occsList.occNTrackITSTPCCUnfm80().begin(), occsList.occNTrackITSTPCCUnfm80().end());
           }
 
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyOccMultExtra) {
-            std::copy(occsList.occMultNTracksHasITSUnfm80().begin(), occsList.occMultNTracksHasITSUnfm80().end(), occMultNTracksHasITSUnfm80.begin());
-            std::copy(occsList.occMultNTracksHasTPCUnfm80().begin(), occsList.occMultNTracksHasTPCUnfm80().end(), occMultNTracksHasTPCUnfm80.begin());
-            std::copy(occsList.occMultNTracksHasTOFUnfm80().begin(), occsList.occMultNTracksHasTOFUnfm80().end(), occMultNTracksHasTOFUnfm80.begin());
-            std::copy(occsList.occMultNTracksHasTRDUnfm80().begin(), occsList.occMultNTracksHasTRDUnfm80().end(), occMultNTracksHasTRDUnfm80.begin());
-            std::copy(occsList.occMultNTracksITSOnlyUnfm80().begin(), occsList.occMultNTracksITSOnlyUnfm80().end(), occMultNTracksITSOnlyUnfm80.begin());
-            std::copy(occsList.occMultNTracksTPCOnlyUnfm80().begin(), occsList.occMultNTracksTPCOnlyUnfm80().end(), occMultNTracksTPCOnlyUnfm80.begin());
-            std::copy(occsList.occMultNTracksITSTPCUnfm80().begin(), occsList.occMultNTracksITSTPCUnfm80().end(), occMultNTracksITSTPCUnfm80.begin());
-            std::copy(occsList.occMultAllTracksTPCOnlyUnfm80().begin(), occsList.occMultAllTracksTPCOnlyUnfm80().end(), occMultAllTracksTPCOnlyUnfm80.begin());
+            occMultNTracksHasITSUnfm80.fill(occsList.occMultNTracksHasITSUnfm80().begin(), occsList.occMultNTracksHasITSUnfm80().end());
+            occMultNTracksHasTPCUnfm80.fill(occsList.occMultNTracksHasTPCUnfm80().begin(), occsList.occMultNTracksHasTPCUnfm80().end());
+            occMultNTracksHasTOFUnfm80.fill(occsList.occMultNTracksHasTOFUnfm80().begin(), occsList.occMultNTracksHasTOFUnfm80().end());
+            occMultNTracksHasTRDUnfm80.fill(occsList.occMultNTracksHasTRDUnfm80().begin(), occsList.occMultNTracksHasTRDUnfm80().end());
+            occMultNTracksITSOnlyUnfm80.fill(occsList.occMultNTracksITSOnlyUnfm80().begin(), occsList.occMultNTracksITSOnlyUnfm80().end());
+            occMultNTracksTPCOnlyUnfm80.fill(occsList.occMultNTracksTPCOnlyUnfm80().begin(), occsList.occMultNTracksTPCOnlyUnfm80().end());
+            occMultNTracksITSTPCUnfm80.fill(occsList.occMultNTracksITSTPCUnfm80().begin(), occsList.occMultNTracksITSTPCUnfm80().end());
+            occMultAllTracksTPCOnlyUnfm80.fill(occsList.occMultAllTracksTPCOnlyUnfm80().begin(), occsList.occMultAllTracksTPCOnlyUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustT0V0Prim) {
-            std::copy(occsList.occRobustT0V0PrimUnfm80().begin(), occsList.occRobustT0V0PrimUnfm80().end(), occRobustT0V0PrimUnfm80.begin());
+            occRobustT0V0PrimUnfm80.fill(occsList.occRobustT0V0PrimUnfm80().begin(), occsList.occRobustT0V0PrimUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustFDDT0V0Prim) {
-            std::copy(occsList.occRobustFDDT0V0PrimUnfm80().begin(), occsList.occRobustFDDT0V0PrimUnfm80().end(), occRobustFDDT0V0PrimUnfm80.begin());
+            occRobustFDDT0V0PrimUnfm80.fill(occsList.occRobustFDDT0V0PrimUnfm80().begin(), occsList.occRobustFDDT0V0PrimUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustNtrackDet) {
-            std::copy(occsList.occRobustNtrackDetUnfm80().begin(), occsList.occRobustNtrackDetUnfm80().end(), occRobustNtrackDetUnfm80.begin());
+            occRobustNtrackDetUnfm80.fill(occsList.occRobustNtrackDetUnfm80().begin(), occsList.occRobustNtrackDetUnfm80().end());
           }
           if constexpr (processMode == kProcessFullOccTableProducer || processMode == kProcessOnlyRobustMultExtra) {
-            std::copy(occsList.occRobustMultExtraTableUnfm80().begin(), occsList.occRobustMultExtraTableUnfm80().end(), occRobustMultTableUnfm80.begin());
+            occRobustMultTableUnfm80.fill(occsList.occRobustMultExtraTableUnfm80().begin(), occsList.occRobustMultExtraTableUnfm80().end());
           }
         }
 
@@ -41,6 +41,8 @@
 #include <TMatrixDfwd.h>
 #include <TRandom.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -48,6 +50,7 @@
 #include <map>
 #include <memory>
 #include <ratio>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -98,6 +101,7 @@ struct pidTPCConfigurables : o2::framework::ConfigurableGroup {
   o2::framework::Configurable<std::string> networkPathCCDB{"networkPathCCDB", "Analysis/PID/TPC/ML", "Path on CCDB"};
   o2::framework::Configurable<bool> enableNetworkOptimizations{"enableNetworkOptimizations", 1, "(bool) If the neural network correction is used, this enables GraphOptimizationLevel::ORT_ENABLE_EXTENDED in the ONNX session"};
   o2::framework::Configurable<int> networkSetNumThreads{"networkSetNumThreads", 0, "Especially important for running on a SLURM cluster. Sets the number of threads used for execution."};
+  o2::framework::Configurable<int> networkBatchSize{"networkBatchSize", 16384, "Number of tracks evaluated per call of the network. Bounds the memory used for the network inputs and outputs"};
   // Configuration flags to include and exclude particle hypotheses
   o2::framework::Configurable<int> savedEdxsCorrected{"savedEdxsCorrected", -1, {"Save table with corrected dE/dx calculated on the spot. 0: off, 1: on, -1: auto"}};
   o2::framework::Configurable<bool> useCorrecteddEdx{"useCorrecteddEdx", false, "(bool) If true, use corrected dEdx value in Nsigma calculation instead of the one in the AO2D"};
@@ -180,17 +184,15 @@ typedef struct Str_dEdx_correction {
     fMatrix.SetMatrixArray(elements);
   }
 
-  float fReal_fTPCSignalN(std::vector<float> vec1, std::vector<float> vec2)
+  float fReal_fTPCSignalN(std::span<const float> vec1, std::span<const float> vec2) const
   {
     float result = 0.f;
-    // push 1.
-    vec1.insert(vec1.begin(), 1.0);
-    vec2.insert(vec2.begin(), 1.0);
+    // the first row and column of the matrix multiply 1.
     for (int i = 0; i < fMatrix.GetNrows(); i++) {
+      double value1 = i == 0 ? 1. : (i - 1 < static_cast<int>(vec1.size()) ? vec1[i - 1] : 0.);
       for (int j = 0; j < fMatrix.GetNcols(); j++) {
         double param = fMatrix(i, j);
-        double value1 = i > static_cast<int>(vec1.size()) ? 0 : vec1[i];
-        double value2 = j > static_cast<int>(vec2.size()) ? 0 : vec2[j];
+        double value2 = j == 0 ? 1. : (j - 1 < static_cast<int>(vec2.size()) ? vec2[j - 1] : 0.);
         result += param * value1 * value2;
       }
     }
@@ -218,6 +220,21 @@ class pidTPCModule
   std::vector<int> speciesNetworkFlags = std::vector<int>(9);
   std::string networkVersion;
 
+  // Network correction evaluated in batches of networkBatchSize tracks, consumed while the tables are filled
+  static constexpr int NParticleTypes = 9;
+  std::vector<int> networkHypotheses;     // mass hypotheses evaluated by the network
+  std::vector<float> networkInput;        // input rows of the current batch
+  std::vector<float> networkOutput;       // output of the last network call
+  std::vector<float> networkPrediction;   // output of the current batch, networkBatchRows rows per mass hypothesis
+  std::vector<float> networkHadronicRate; // hadronic rate per collision (kHz)
+  float networkHadronicRateBegin = 0.f;   // hadronic rate at the beginning of the data frame (kHz)
+  float networkNClNormalization = 0.f;    // NCl normalisation of the TPC response used for the network inputs
+  uint64_t networkBatchRows = 0;          // maximum number of tracks in a batch
+  uint64_t networkFirstTrack = 0;         // network track counter of the first track of the current batch
+  uint64_t networkNTracks = 0;            // number of tracks in the current batch
+  int64_t networkTrackCursor = 0;         // next track of the table to be put in a batch
+  float networkDuration = 0.f;            // time spent in the network evaluation (ns)
+
   // To get automatically the proper Hadronic Rate
   std::string irSource = "";
   o2::common::core::CollisionSystemType::collType collsys = o2::common::core::CollisionSystemType::kCollSysUndef;
@@ -443,13 +460,9 @@ class pidTPCModule
   } // end init
 
   //__________________________________________________
-  template <typename TCCDB, typename TCCDBApi, typename M, typename T, typename B>
-  std::vector<float> createNetworkPrediction(TCCDB& ccdb, TCCDBApi& ccdbApi, soa::Join<aod::Collisions, aod::EvSels> const& collisions, M const& mults, T const& tracks, B const& bcs, const size_t size)
+  template <typename TCCDB, typename TCCDBApi, typename B>
+  void prepareNetworkPrediction(TCCDB& ccdb, TCCDBApi& ccdbApi, soa::Join<aod::Collisions, aod::EvSels> const& collisions, B const& bcs, const bool isMC)
   {
-
-    std::vector<float> network_prediction;
-
-    auto start_network_total = std::chrono::high_resolution_clock::now();
     if (pidTPCopts.autofetchNetworks) {
       const auto& bc = bcs.begin();
       // Initialise correct TPC response object before NN setup (for NCl normalisation)
@@ -503,111 +516,126 @@ class pidTPCModule
       }
     }
 
-    // Defining some network parameters
-    int input_dimensions = network.getNumInputNodes();
-    int output_dimensions = network.getNumOutputNodes();
-    const uint64_t track_prop_size = input_dimensions * size;
-    const uint64_t prediction_size = output_dimensions * size;
-
-    network_prediction = std::vector<float>(prediction_size * 9); // For each mass hypotheses
-    const float nNclNormalization = response->GetNClNormalization();
-    float duration_network = 0;
+    // Mass hypotheses evaluated by the network: only the ones corrected by the network and filled in a requested table.
+    // The MC tune on data can use any of them, depending on the PDG code of the particle
+    const std::array<bool, NParticleTypes> tableRequested = {pidTPCopts.pidFullEl == 1 || pidTPCopts.pidTinyEl == 1,
+                                                             pidTPCopts.pidFullMu == 1 || pidTPCopts.pidTinyMu == 1,
+                                                             pidTPCopts.pidFullPi == 1 || pidTPCopts.pidTinyPi == 1,
+                                                             pidTPCopts.pidFullKa == 1 || pidTPCopts.pidTinyKa == 1,
+                                                             pidTPCopts.pidFullPr == 1 || pidTPCopts.pidTinyPr == 1,
+                                                             pidTPCopts.pidFullDe == 1 || pidTPCopts.pidTinyDe == 1,
+                                                             pidTPCopts.pidFullTr == 1 || pidTPCopts.pidTinyTr == 1,
+                                                             pidTPCopts.pidFullHe == 1 || pidTPCopts.pidTinyHe == 1,
+                                                             pidTPCopts.pidFullAl == 1 || pidTPCopts.pidTinyAl == 1};
+    networkHypotheses.clear();
+    for (int i = 0; i < NParticleTypes; i++) {
+      if (speciesNetworkFlags[i] && (tableRequested[i] || isMC)) {
+        networkHypotheses.push_back(i);
+      }
+    }
 
-    std::vector<float> track_properties(track_prop_size);
-    uint64_t counter_track_props = 0;
-    int loop_counter = 0;
+    // Buffers of one batch, of bounded size and reused across the batches of the data frame
+    networkBatchRows = std::max(pidTPCopts.networkBatchSize.value, 1);
+    networkInput.assign(networkBatchRows * network.getNumInputNodes(), 0.f);
+    networkPrediction.assign(NParticleTypes * networkBatchRows * network.getNumOutputNodes(), 0.f);
+    networkNClNormalization = response->GetNClNormalization();
+    networkFirstTrack = 0;
+    networkNTracks = 0;
+    networkTrackCursor = 0;
+    networkDuration = 0.f;
 
     // To load the Hadronic rate once for each collision
-    float hadronicRateBegin = 0.;
-    std::vector<float> hadronicRateForCollision(collisions.size(), 0.0f);
+    networkHadronicRate.assign(collisions.size(), 0.0f);
     size_t i = 0;
     for (const auto& collision : collisions) {
       const auto& bc = collision.template bc_as<B>();
       if (irSource.compare("") != 0) {
-        hadronicRateForCollision[i] = mRateFetcher.fetch(ccdb.service, bc.timestamp(), bc.runNumber(), irSource) * 1.e-3;
+        networkHadronicRate[i] = mRateFetcher.fetch(ccdb.service, bc.timestamp(), bc.runNumber(), irSource) * 1.e-3;
       } else {
-        hadronicRateForCollision[i] = 0.0f;
+        networkHadronicRate[i] = 0.0f;
       }
       i++;
     }
     auto bc = bcs.begin();
     if (irSource.compare("") != 0) {
-      hadronicRateBegin = mRateFetcher.fetch(ccdb.service, bc.timestamp(), bc.runNumber(), irSource) * 1.e-3; // kHz
+      networkHadronicRateBegin = mRateFetcher.fetch(ccdb.service, bc.timestamp(), bc.runNumber(), irSource) * 1.e-3; // kHz
     } else {
-      hadronicRateBegin = 0.0f;
+      networkHadronicRateBegin = 0.0f;
     }
+  }
+
+  //__________________________________________________
+  template <typename T>
+  bool isNetworkTrack(T const& trk) const
+  {
+    return trk.hasTPC() && (!pidTPCopts.skipTPCOnly || trk.hasITS() || trk.hasTRD() || trk.hasTOF());
+  }
 
-    // Filling a std::vector<float> to be evaluated by the network
-    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on one large vector
-    static constexpr int NParticleTypes = 9;
+  //__________________________________________________
+  template <typename M, typename T>
+  void evaluateNetworkBatch(soa::Join<aod::Collisions, aod::EvSels> const& collisions, M const& mults, T const& tracks)
+  {
+    // Evaluates the network on the next networkBatchRows tracks, in the order in which the tables are filled
+    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on batches of tracks
+    const int input_dimensions = network.getNumInputNodes();
+    const int output_dimensions = network.getNumOutputNodes();
     constexpr int ExpectedInputDimensionsNNV2 = 7;
     constexpr int ExpectedInputDimensionsNNV3 = 8;
     constexpr auto NetworkVersionV2 = "2";
     constexpr auto NetworkVersionV3 = "3";
-    for (int i = 0; i < NParticleTypes; i++) { // Loop over particle number for which network correction is used
-      for (auto const& trk : tracks) {
-        if (!trk.hasTPC()) {
-          continue;
-        }
-        if (pidTPCopts.skipTPCOnly) {
-          if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
-            continue;
-          }
-        }
-        track_properties[counter_track_props] = trk.tpcInnerParam();
-        track_properties[counter_track_props + 1] = trk.tgl();
-        track_properties[counter_track_props + 2] = trk.signed1Pt();
-        track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[i];
-        track_properties[counter_track_props + 4] = trk.has_collision() ? mults[trk.collisionId()] / 11000. : 1.;
-        track_properties[counter_track_props + 5] = std::sqrt(nNclNormalization / trk.tpcNClsFound());
-        if (input_dimensions == ExpectedInputDimensionsNNV2 && networkVersion == NetworkVersionV2) {
-          track_properties[counter_track_props + 6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
-        }
-        if (input_dimensions == ExpectedInputDimensionsNNV3 && networkVersion == NetworkVersionV3) {
-          track_properties[counter_track_props + 6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
-          if (trk.has_collision()) {
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateForCollision[trk.collisionId()] / 50.;
-            }
-          } else {
-            // asign Hadronic Rate at beginning of run  if track does not belong to a collision
-            if (collsys == CollisionSystemType::kCollSyspp) {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 1500.;
-            } else {
-              track_properties[counter_track_props + 7] = hadronicRateBegin / 50.;
-            }
-          }
+
+    networkFirstTrack += networkNTracks;
+    networkNTracks = 0;
+
+    // The input rows are filled once for all mass hypotheses, only the mass changes between the network calls
+    const int64_t nTracks = tracks.size();
+    for (auto trk = tracks.rawIteratorAt(networkTrackCursor); networkTrackCursor < nTracks && networkNTracks < networkBatchRows; ++networkTrackCursor, ++trk) {
+      if (!isNetworkTrack(trk)) {
+        continue;
+      }
+      float* track_properties = networkInput.data() + networkNTracks * input_dimensions;
+      track_properties[0] = trk.tpcInnerParam();
+      track_properties[1] = trk.tgl();
+      track_properties[2] = trk.signed1Pt();
+      track_properties[4] = trk.has_collision() ? mults[trk.collisionId()] / 11000. : 1.;
+      track_properties[5] = std::sqrt(networkNClNormalization / trk.tpcNClsFound());
+      if (input_dimensions == ExpectedInputDimensionsNNV2 && networkVersion == NetworkVersionV2) {
+        track_properties[6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
+      }
+      if (input_dimensions == ExpectedInputDimensionsNNV3 && networkVersion == NetworkVersionV3) {
+        track_properties[6] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).ft0cOccupancyInTimeRange() / 60000. : 1.;
+        // asign Hadronic Rate at beginning of run if track does not belong to a collision
+        const float hadronicRate = trk.has_collision() ? networkHadronicRate[trk.collisionId()] : networkHadronicRateBegin;
+        if (collsys == CollisionSystemType::kCollSyspp) {
+          track_properties[7] = hadronicRate / 1500.;
+        } else {
+          track_properties[7] = hadronicRate / 50.;
         }
-        counter_track_props += input_dimensions;
       }
+      networkNTracks++;
+    }
+    if (networkNTracks == 0) {
+      return;
+    }
 
+    for (const int pid : networkHypotheses) {
+      for (uint64_t iRow = 0; iRow < networkNTracks; iRow++) {
+        networkInput[iRow * input_dimensions + 3] = o2::track::pid_constants::sMasses[pid];
+      }
       auto start_network_eval = std::chrono::high_resolution_clock::now();
-      float* output_network = network.evalModel(track_properties);
+      bool evalSuccess = network.evalModel(networkInput.data(), static_cast<int64_t>(networkNTracks), networkOutput);
       auto stop_network_eval = std::chrono::high_resolution_clock::now();
-      duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
-      for (uint64_t i = 0; i < prediction_size; i += output_dimensions) {
-        for (int j = 0; j < output_dimensions; j++) {
-          network_prediction[i + j + prediction_size * loop_counter] = output_network[i + j];
-        }
+      networkDuration += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
+      if (!evalSuccess || networkOutput.size() != networkNTracks * output_dimensions) {
+        LOGP(fatal, "Network evaluation failed for mass hypothesis {}: {} values returned for {} tracks", pid, networkOutput.size(), networkNTracks);
       }
-
-      counter_track_props = 0;
-      loop_counter += 1;
+      std::copy(networkOutput.begin(), networkOutput.end(), networkPrediction.begin() + networkBatchRows * output_dimensions * pid);
     }
-    track_properties.clear();
-
-    auto stop_network_total = std::chrono::high_resolution_clock::now();
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / (size * 9) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / (size * 9) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
-
-    return network_prediction;
   }
 
   //__________________________________________________
   template <typename T, typename NSF, typename NST>
-  void makePidTables(const int flagFull, NSF& tableFull, const int flagTiny, NST& tableTiny, const o2::track::PID::ID pid, const float tpcSignal, const T& trk, const int64_t multTPC, const std::vector<float>& network_prediction, const int& count_tracks, const int& tracksForNet_size)
+  void makePidTables(const int flagFull, NSF& tableFull, const int flagTiny, NST& tableTiny, const o2::track::PID::ID pid, const float tpcSignal, const T& trk, const int64_t multTPC, const uint64_t networkRow)
   {
     if (flagFull != 1 && flagTiny != 1) {
       return;
@@ -647,17 +675,17 @@ class pidTPCModule
       // Here comes the application of the network. The output--dimensions of the network determine the application: 1: mean, 2: sigma, 3: sigma asymmetric
       // For now only the option 2: sigma will be used. The other options are kept if there would be demand later on
       if (network.getNumOutputNodes() == 1) { // Expected mean correction; no sigma correction
-        nSigma = (tpcSignal - network_prediction[count_tracks + tracksForNet_size * pid] * expSignal) / expSigma;
+        nSigma = (tpcSignal - networkPrediction[networkRow + networkBatchRows * pid] * expSignal) / expSigma;
       } else if (network.getNumOutputNodes() == NumOutputNodesSymmetricSigma) { // Symmetric sigma correction
-        expSigma = (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-        nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesSymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
+        expSigma = (networkPrediction[NumOutputNodesSymmetricSigma * (networkRow + networkBatchRows * pid) + 1] - networkPrediction[NumOutputNodesSymmetricSigma * (networkRow + networkBatchRows * pid)]) * expSignal;
+        nSigma = (tpcSignal / expSignal - networkPrediction[NumOutputNodesSymmetricSigma * (networkRow + networkBatchRows * pid)]) / (networkPrediction[NumOutputNodesSymmetricSigma * (networkRow + networkBatchRows * pid) + 1] - networkPrediction[NumOutputNodesSymmetricSigma * (networkRow + networkBatchRows * pid)]);
       } else if (network.getNumOutputNodes() == NumOutputNodesAsymmetricSigma) { // Asymmetric sigma corection
-        if (tpcSignal / expSignal >= network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) {
-          expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]);
+        if (tpcSignal / expSignal >= networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)]) {
+          expSigma = (networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid) + 1] - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)]) * expSignal;
+          nSigma = (tpcSignal / expSignal - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)]) / (networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid) + 1] - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)]);
         } else {
-          expSigma = (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid)] - network_prediction[NumOutputNodesAsymmetricSigma * (count_tracks + tracksForNet_size * pid) + 2]);
+          expSigma = (networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)] - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid) + 2]) * expSignal;
+          nSigma = (tpcSignal / expSignal - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)]) / (networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid)] - networkPrediction[NumOutputNodesAsymmetricSigma * (networkRow + networkBatchRows * pid) + 2]);
         }
       } else {
         LOGF(fatal, "Network output-dimensions incompatible!");
@@ -679,14 +707,13 @@ class pidTPCModule
       return; // empty protection
     }
     auto trackiterator = tracks.begin();
-    if constexpr (requires { trackiterator.mcParticleId(); }) {
+    constexpr bool isMC = requires { trackiterator.mcParticleId(); };
+    if constexpr (isMC) {
       gRandom->SetSeed(0); // Ensure unique seed from UUID for each process call
     }
 
     // preparatory step: we need the multiplicities for each collision
     std::vector<int64_t> pidmults;
-    int64_t totalTPCtracks = 0;
-    int64_t totalTPCnotStandalone = 0;
     pidmults.resize(cols.size(), 0);
 
     // faster counting
@@ -695,10 +722,6 @@ class pidTPCModule
         if (track.collisionId() > -1) {
           pidmults[track.collisionId()]++;
         }
-        totalTPCtracks++;
-        if (track.hasITS() || track.hasTOF() || track.hasTRD()) {
-          totalTPCnotStandalone++;
-        }
       }
     }
 
@@ -732,11 +755,8 @@ class pidTPCModule
     reserveTable(pidTPCopts.pidTinyHe, products.tablePIDTinyHe);
     reserveTable(pidTPCopts.pidTinyAl, products.tablePIDTinyAl);
 
-    const uint64_t tracksForNet_size = (pidTPCopts.skipTPCOnly) ? totalTPCnotStandalone : totalTPCtracks;
-    std::vector<float> network_prediction;
-
     if (pidTPCopts.useNetworkCorrection) {
-      network_prediction = createNetworkPrediction(ccdb, ccdbApi, cols, pidmults, tracks, bcs, tracksForNet_size);
+      prepareNetworkPrediction(ccdb, ccdbApi, cols, bcs, isMC);
     }
 
     uint64_t count_tracks = 0;
@@ -836,8 +856,8 @@ class pidTPCModule
         float a1ptmbb0R = a1pt * mbb0R;
         float atglmbb0R = atgl * mbb0R;
 
-        std::vector<float> vec_occu = {fTrackOccN, fOccTPCN, fTrackOccMeanN};
-        std::vector<float> vec_track = {mbb0R, a1pt, atgl, atglmbb0R, a1ptmbb0R, side, a1pt2};
+        const std::array<float, 3> vec_occu = {fTrackOccN, fOccTPCN, fTrackOccMeanN};
+        const std::array<float, 7> vec_track = {mbb0R, a1pt, atgl, atglmbb0R, a1ptmbb0R, side, a1pt2};
 
         float fTPCSignalN_CR0 = str_dedx_correction.fReal_fTPCSignalN(vec_occu, vec_track);
 
@@ -847,7 +867,7 @@ class pidTPCModule
         else if (mbb0R1 < kMinAllowedRatio)
           mbb0R1 = kMinAllowedRatio;
 
-        std::vector<float> vec_track1 = {mbb0R1, a1pt, atgl, atgl * mbb0R1, a1pt * mbb0R1, side, a1pt2};
+        const std::array<float, 7> vec_track1 = {mbb0R1, a1pt, atgl, atgl * mbb0R1, a1pt * mbb0R1, side, a1pt2};
         float fTPCSignalN_CR1 = str_dedx_correction.fReal_fTPCSignalN(vec_occu, vec_track1);
 
         // change the signal used for PID
@@ -892,6 +912,12 @@ class pidTPCModule
         response->PrintAll();
       }
 
+      // the network is evaluated on the next batch of tracks once the current batch is consumed
+      if (pidTPCopts.useNetworkCorrection && !networkHypotheses.empty() && isNetworkTrack(trk) && count_tracks >= networkFirstTrack + networkNTracks) {
+        evaluateNetworkBatch(cols, pidmults, tracks);
+      }
+      const uint64_t networkRow = count_tracks - networkFirstTrack;
+
       // if this is a MC process function, go for MC tune on data processing
       if constexpr (requires { trk.mcParticleId(); }) {
         // Perform TuneOnData sampling for MC dE/dx
@@ -917,9 +943,9 @@ class pidTPCModule
             }
             float bg = trk.tpcInnerParam() / o2::track::pid_constants::sMasses[pid]; // estimated beta-gamma for network cutoff
 
-            if (pidTPCopts.useNetworkCorrection && speciesNetworkFlags[pid] && trk.has_collision() && bg > pidTPCopts.networkBetaGammaCutoff) {
-              auto mean = network_prediction[2 * (count_tracks + tracksForNet_size * pid)] * expSignal; // Absolute mean, i.e. the mean dE/dx value of the data in that slice, not the mean of the NSigma distribution
-              auto sigma = (network_prediction[2 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[2 * (count_tracks + tracksForNet_size * pid)]) * expSignal;
+            if (pidTPCopts.useNetworkCorrection && speciesNetworkFlags[pid] && isNetworkTrack(trk) && trk.has_collision() && bg > pidTPCopts.networkBetaGammaCutoff) {
+              auto mean = networkPrediction[2 * (networkRow + networkBatchRows * pid)] * expSignal; // Absolute mean, i.e. the mean dE/dx value of the data in that slice, not the mean of the NSigma distribution
+              auto sigma = (networkPrediction[2 * (networkRow + networkBatchRows * pid) + 1] - networkPrediction[2 * (networkRow + networkBatchRows * pid)]) * expSignal;
               if (mean < 0.f || sigma < 0.f) {
                 mcTunedTPCSignal = -999.f;
               } else {
@@ -935,8 +961,8 @@ class pidTPCModule
         }
       }
 
-      auto makePidTablesDefault = [&trk, &tpcSignalToEvaluatePID, &multTPC, &network_prediction, &count_tracks, &tracksForNet_size, this](const int flagFull, auto& tableFull, const int flagTiny, auto& tableTiny, const o2::track::PID::ID pid) {
-        this->makePidTables(flagFull, tableFull, flagTiny, tableTiny, pid, tpcSignalToEvaluatePID, trk, multTPC, network_prediction, count_tracks, tracksForNet_size);
+      auto makePidTablesDefault = [&trk, &tpcSignalToEvaluatePID, &multTPC, &networkRow, this](const int flagFull, auto& tableFull, const int flagTiny, auto& tableTiny, const o2::track::PID::ID pid) {
+        this->makePidTables(flagFull, tableFull, flagTiny, tableTiny, pid, tpcSignalToEvaluatePID, trk, multTPC, networkRow);
       };
 
       makePidTablesDefault(pidTPCopts.pidFullEl, products.tablePIDFullEl, pidTPCopts.pidTinyEl, products.tablePIDTinyEl, o2::track::PID::Electron);
@@ -949,10 +975,14 @@ class pidTPCModule
       makePidTablesDefault(pidTPCopts.pidFullHe, products.tablePIDFullHe, pidTPCopts.pidTinyHe, products.tablePIDTinyHe, o2::track::PID::Helium3);
       makePidTablesDefault(pidTPCopts.pidFullAl, products.tablePIDFullAl, pidTPCopts.pidTinyAl, products.tablePIDTinyAl, o2::track::PID::Alpha);
 
-      if (trk.hasTPC() && (!pidTPCopts.skipTPCOnly || trk.hasITS() || trk.hasTRD() || trk.hasTOF())) {
+      if (isNetworkTrack(trk)) {
         count_tracks++; // Increment network track counter only if track has TPC, and (not skipping TPConly) or (is not TPConly)
       }
     }
+
+    if (pidTPCopts.useNetworkCorrection && count_tracks > 0 && !networkHypotheses.empty()) {
+      LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << networkDuration / (count_tracks * networkHypotheses.size()) << "ns ; Total time (eval ONNX): " << networkDuration / 1000000000 << " s";
+    }
   } // end process function
 };
 
@@ -28,6 +28,7 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <numeric>
 #include <string>
@@ -137,6 +138,71 @@ auto makeCprHistSpecMap(const T& confCpr)
     {kRadius8, {confCpr.binningDeta, confCpr.binningDphistar}}};
 };
 
+// cache of the phistar of tracks at all TPC radii, indexed by the global index of the track
+// phistar only depends on the track and the magnetic field, so in the pair loops it is computed once per track
+// instead of once per pair; entries are validated with the signed pt and phi of the track, so the cache stays
+// consistent across data frames without being cleared
+class PhistarCache
+{
+ public:
+  struct Entry {
+    float signedPt = 0.f;
+    float phi = 0.f;
+    uint32_t generation = 0; // entry is valid if it matches the generation of the cache
+    std::array<float, Nradii> phistar = {0.f};
+    std::array<bool, Nradii> mask = {false};
+  };
+
+  void setChargeAbs(int chargeAbs)
+  {
+    mChargeAbs = chargeAbs;
+    mGeneration++;
+  }
+
+  void setMagField(float magField)
+  {
+    if (magField != mMagField) {
+      mMagField = magField;
+      mGeneration++; // invalidate all entries
+    }
+  }
+
+  Entry const& get(int64_t index, float signedPt, float phi)
+  {
+    if (index < 0) {
+      fillEntry(mScratch, signedPt, phi);
+      return mScratch;
+    }
+    if (static_cast<size_t>(index) >= mEntries.size()) {
+      mEntries.resize(index + 1);
+    }
+    auto& entry = mEntries[index];
+    if (entry.generation != mGeneration || entry.signedPt != signedPt || entry.phi != phi) {
+      fillEntry(entry, signedPt, phi);
+    }
+    return entry;
+  }
+
+ private:
+  void fillEntry(Entry& entry, float signedPt, float phi) const
+  {
+    entry.signedPt = signedPt;
+    entry.phi = phi;
+    entry.generation = mGeneration;
+    for (size_t i = 0; i < TpcRadii.size(); i++) {
+      auto phistar = utils::dphistar(mMagField, TpcRadii[i], mChargeAbs * signedPt, phi);
+      entry.mask[i] = phistar.has_value();
+      entry.phistar[i] = phistar.value_or(0.f);
+    }
+  }
+
+  int mChargeAbs = 0;
+  float mMagField = 0.f;
+  uint32_t mGeneration = 1;
+  std::vector<Entry> mEntries;
+  Entry mScratch;
+};
+
 template <const char* prefix>
 class CloseTrackRejection
 {
@@ -164,6 +230,10 @@ class CloseTrackRejection
 
     mChargeAbsTrack1 = std::abs(chargeAbsTrack1);
     mChargeAbsTrack2 = std::abs(chargeAbsTrack2);
+    mPhistarCache1.setChargeAbs(mChargeAbsTrack1);
+    mPhistarCache2.setChargeAbs(mChargeAbsTrack2);
+    // both tracks share the cache if their phistar is computed with the same charge
+    mSharePhistarCache = (mChargeAbsTrack1 == mChargeAbsTrack2);
 
     mCutAverage = confCpr.cutAverage.value;
     mCutAnyRadius = confCpr.cutAnyRadius.value;
@@ -195,7 +265,15 @@ class CloseTrackRejection
     }
   }
 
-  void setMagField(float magField) { mMagField = magField; }
+  void setMagField(float magField)
+  {
+    mMagField = magField;
+    mPhistarCache1.setMagField(magField);
+    mPhistarCache2.setMagField(magField);
+  }
+
+  // the phistar cache must not be shared if the tracks of the pair are not indexed in the same table
+  void setSharePhistarCache(bool share) { mSharePhistarCache = share && (mChargeAbsTrack1 == mChargeAbsTrack2); }
 
   template <typename T1, typename T2>
   void compute(T1 const& track1, T2 const& track2)
@@ -212,11 +290,13 @@ class CloseTrackRejection
 
     mDeta = track1.eta() - track2.eta();
 
+    // phistar of both tracks at all radii, computed only once per track
+    // (the first entry is copied, since the second lookup may reallocate a shared cache)
+    auto const phistar1 = mPhistarCache1.get(track1.globalIndex(), track1.signedPt(), track1.phi());
+    auto const& phistar2 = (mSharePhistarCache ? mPhistarCache1 : mPhistarCache2).get(track2.globalIndex(), track2.signedPt(), track2.phi());
     for (size_t i = 0; i < TpcRadii.size(); i++) {
-      auto phistar1 = utils::dphistar(mMagField, TpcRadii[i], mChargeAbsTrack1 * track1.signedPt(), track1.phi());
-      auto phistar2 = utils::dphistar(mMagField, TpcRadii[i], mChargeAbsTrack2 * track2.signedPt(), track2.phi());
-      if (phistar1 && phistar2) {
-        mDphistar.at(i) = RecoDecay::constrainAngle(phistar1.value() - phistar2.value(), -o2::constants::math::PI); // constrain angular difference between -pi and pi
+      if (phistar1.mask[i] && phistar2.mask[i]) {
+        mDphistar.at(i) = RecoDecay::constrainAngle(phistar1.phistar[i] - phistar2.phistar[i], -o2::constants::math::PI); // constrain angular difference between -pi and pi
         mDphistarMask.at(i) = true;
         count++;
       }
@@ -332,6 +412,10 @@ class CloseTrackRejection
   float mDeta = 0.f;
   std::array<float, Nradii> mDphistar = {0.f};
   std::array<bool, Nradii> mDphistarMask = {false};
+
+  PhistarCache mPhistarCache1;
+  PhistarCache mPhistarCache2;
+  bool mSharePhistarCache = false;
 };
 
 template <const char* prefix>
@@ -349,6 +433,7 @@ class ClosePairRejectionTrackTrack
   }
 
   void setMagField(float magField) { mCtr.setMagField(magField); }
+  void setSharePhistarCache(bool share) { mCtr.setSharePhistarCache(share); }
   template <typename T1, typename T2, typename T3>
   void setPair(T1 const& track1, T2 const& track2, T3 const& /*tracks*/)
   {
@@ -0,0 +1,175 @@
+// Copyright 2019-2025 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file mixingPool.h
+/// \brief event mixing pool kept across data frames
+/// \author anton.riedel@tum.de, TU München, anton.riedel@tum.de
+
+#ifndef PWGCF_FEMTO_CORE_MIXINGPOOL_H_
+#define PWGCF_FEMTO_CORE_MIXINGPOOL_H_
+
+#include "fairlogger/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace o2::analysis::femto
+{
+namespace mixingpool
+{
+
+// compact copy of a selected track, with the getters used by the pair hist manager and the close pair rejection
+class PoolTrack
+{
+ public:
+  PoolTrack() = default;
+  PoolTrack(float signedPt, float eta, float phi, int64_t index) : mSignedPt(signedPt), mEta(eta), mPhi(phi), mIndex(index) {}
+
+  float signedPt() const { return mSignedPt; }
+  float pt() const { return std::fabs(mSignedPt); }
+  float eta() const { return mEta; }
+  float phi() const { return mPhi; }
+  // index of the track in the pool, unique among the tracks currently stored in the pool
+  int64_t globalIndex() const { return mIndex; }
+
+ private:
+  float mSignedPt = 0.f;
+  float mEta = 0.f;
+  float mPhi = 0.f;
+  int64_t mIndex = 0;
+};
+
+// compact copy of a collision, with the getters used by the pair hist manager
+class PoolCollision
+{
+ public:
+  PoolCollision() = default;
+  PoolCollision(float magField, float mult, float cent) : mMagField(magField), mMult(mult), mCent(cent) {}
+
+  float magField() const { return mMagField; }
+  float mult() const { return mMult; }
+  float cent() const { return mCent; }
+
+ private:
+  float mMagField = 0.f;
+  float mMult = 0.f;
+  float mCent = 0.f;
+};
+
+// Pool of the last collisions of each mixing bin, kept across data frames
+// Each mixing bin is a ring buffer of depth slots, each slot holds a collision and its selected tracks.
+// The track arrays of the slots keep their capacity, so filling the pool does not allocate once it is warm.
+// Collisions with more tracks than the configured maximum are not stored, nor are collisions which would
+// make the pool exceed its maximum size.
+class TrackMixingPool
+{
+ public:
+  void init(int depth, int maxTracksPerCollision, float maxSizeMb)
+  {
+    if (depth <= 0) {
+      LOG(fatal) << "Depth of the mixing pool must be positive. Breaking...";
+    }
+    mDepth = depth;
+    mMaxTracksPerCollision = maxTracksPerCollision;
+    mMaxSize = static_cast<std::size_t>(maxSizeMb * 1024.f * 1024.f);
+    mBins.clear();
+    mSize = 0;
+    mNextIndex = 0;
+  }
+
+  // number of collisions stored for a mixing bin
+  int getNCollisions(int bin) const
+  {
+    if (bin < 0 || bin >= static_cast<int>(mBins.size())) {
+      return 0;
+    }
+    return mBins[bin].nCollisions;
+  }
+
+  // i-th collision of a mixing bin, from the oldest to the newest
+  PoolCollision const& getCollision(int bin, int i) const { return mBins[bin].slots[getSlot(bin, i)].collision; }
+  std::span<const PoolTrack> getTracks(int bin, int i) const { return mBins[bin].slots[getSlot(bin, i)].tracks; }
+
+  // add a collision and its tracks to the pool of a mixing bin, replacing the oldest collision if the pool is full
+  template <typename T1, typename T2>
+  void addCollision(int bin, T1 const& col, T2 const& tracks)
+  {
+    if (bin < 0 || tracks.size() == 0 || static_cast<int>(tracks.size()) > mMaxTracksPerCollision) {
+      return;
+    }
+    if (bin >= static_cast<int>(mBins.size())) {
+      mBins.resize(bin + 1);
+    }
+    auto& pool = mBins[bin];
+    if (pool.slots.empty()) {
+      pool.slots.resize(mDepth);
+    }
+    const int iSlot = (pool.first + pool.nCollisions) % mDepth; // oldest slot if the pool is full
+    auto& slot = pool.slots[iSlot];
+    const std::size_t nTracks = tracks.size();
+    const std::size_t nTracksReplaced = (pool.nCollisions == mDepth) ? slot.tracks.size() : 0;
+    if (mSize - nTracksReplaced * sizeof(PoolTrack) + nTracks * sizeof(PoolTrack) > mMaxSize) {
+      return;
+    }
+    mSize = mSize - nTracksReplaced * sizeof(PoolTrack) + nTracks * sizeof(PoolTrack);
+
+    // tracks of a slot get the indices of a range reserved for the slot, which only grows if needed
+    if (nTracks > slot.indexCapacity) {
+      slot.indexCapacity = std::max(nTracks, 2 * slot.indexCapacity);
+      slot.firstIndex = mNextIndex;
+      mNextIndex += static_cast<int64_t>(slot.indexCapacity);
+    }
+    slot.collision = PoolCollision(col.magField(), col.mult(), col.cent());
+    slot.tracks.clear();
+    int64_t index = slot.firstIndex;
+    for (auto const& track : tracks) {
+      slot.tracks.emplace_back(track.signedPt(), track.eta(), track.phi(), index++);
+    }
+
+    if (pool.nCollisions == mDepth) {
+      pool.first = (pool.first + 1) % mDepth;
+    } else {
+      pool.nCollisions++;
+    }
+  }
+
+ private:
+  struct Slot {
+    PoolCollision collision;
+    std::vector<PoolTrack> tracks;
+    int64_t firstIndex = 0;        // first index of the range reserved for the tracks of the slot
+    std::size_t indexCapacity = 0; // size of the reserved range
+  };
+
+  struct BinPool {
+    std::vector<Slot> slots;
+    int first = 0;       // slot of the oldest collision
+    int nCollisions = 0; // number of collisions stored
+  };
+
+  int getSlot(int bin, int i) const { return (mBins[bin].first + i) % mDepth; }
+
+  int mDepth = 5;
+  int mMaxTracksPerCollision = 0;
+  std::size_t mMaxSize = 0; // maximum size of the stored tracks in bytes
+  std::size_t mSize = 0;    // size of the stored tracks in bytes
+  int64_t mNextIndex = 0;   // first unused track index
+  std::vector<BinPool> mBins;
+};
+
+} // namespace mixingpool
+} // namespace o2::analysis::femto
+
+#endif // PWGCF_FEMTO_CORE_MIXINGPOOL_H_
@@ -20,6 +20,7 @@
 #include "PWGCF/Femto/Core/closePairRejection.h"
 #include "PWGCF/Femto/Core/collisionHistManager.h"
 #include "PWGCF/Femto/Core/kinkHistManager.h"
+#include "PWGCF/Femto/Core/mixingPool.h"
 #include "PWGCF/Femto/Core/modes.h"
 #include "PWGCF/Femto/Core/pairCleaner.h"
 #include "PWGCF/Femto/Core/pairHistManager.h"
@@ -117,6 +118,15 @@ class PairTrackTrackBuilder
     // setup mixing
     mMixingPolicy = static_cast<pairhistmanager::MixingPolicy>(confMixing.policy.value);
     mMixingDepth = confMixing.depth.value;
+    mUseMixingPool = confMixing.usePool.value;
+    if (mUseMixingPool) {
+      if constexpr (modes::isFlagSet(mode, modes::Mode::kMc)) {
+        LOG(fatal) << "Mixing pool is not supported for mc processing. Breaking...";
+      }
+      mMixingPool.init(mMixingDepth, confMixing.poolMaxTracks.value, confMixing.poolMaxSize.value);
+      // pooled tracks are not indexed in the track table
+      mCprMe.setSharePhistarCache(false);
+    }
 
     // setup rng if necessary
     if (confMixing.seed.value >= 0) {
@@ -182,6 +192,14 @@ class PairTrackTrackBuilder
   template <modes::Mode mode, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8>
   void processMixedEvent(T1 const& cols, T2& trackTable, T3& partition1, T4& partition2, T5& cache, T6& binsVtxMult, T7& binsVtxCent, T8& binsVtxMultCent)
   {
+    if (mUseMixingPool) {
+      if (mSameSpecies) {
+        processMixedEventWithPool<mode>(cols, trackTable, partition1, partition1, cache, binsVtxMult, binsVtxCent, binsVtxMultCent);
+      } else {
+        processMixedEventWithPool<mode>(cols, trackTable, partition1, partition2, cache, binsVtxMult, binsVtxCent, binsVtxMultCent);
+      }
+      return;
+    }
 
     if (mSameSpecies) {
       switch (mMixingPolicy) {
@@ -249,6 +267,25 @@ class PairTrackTrackBuilder
   }
 
  private:
+  // mix each collision with the collisions of its mixing bin stored in the pool, then add it to the pool
+  template <modes::Mode mode, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8>
+  void processMixedEventWithPool(T1 const& cols, T2& trackTable, T3& partition1, T4& partition2, T5& cache, T6& binsVtxMult, T7& binsVtxCent, T8& binsVtxMultCent)
+  {
+    switch (mMixingPolicy) {
+      case static_cast<int>(pairhistmanager::kVtxMult):
+        pairprocesshelpers::processMixedEventWithPool<mode>(cols, partition1, partition2, trackTable, cache, [&binsVtxMult](auto const& col) { return binsVtxMult.getBin({col.posZ(), col.mult()}); }, mMixingPool, mPairHistManagerMe, mCprMe);
+        break;
+      case static_cast<int>(pairhistmanager::kVtxCent):
+        pairprocesshelpers::processMixedEventWithPool<mode>(cols, partition1, partition2, trackTable, cache, [&binsVtxCent](auto const& col) { return binsVtxCent.getBin({col.posZ(), col.cent()}); }, mMixingPool, mPairHistManagerMe, mCprMe);
+        break;
+      case static_cast<int>(pairhistmanager::kVtxMultCent):
+        pairprocesshelpers::processMixedEventWithPool<mode>(cols, partition1, partition2, trackTable, cache, [&binsVtxMultCent](auto const& col) { return binsVtxMultCent.getBin({col.posZ(), col.mult(), col.cent()}); }, mMixingPool, mPairHistManagerMe, mCprMe);
+        break;
+      default:
+        LOG(fatal) << "Invalid binning policiy specifed. Breaking...";
+    }
+  }
+
   colhistmanager::CollisionHistManager mColHistManager;
   trackhistmanager::TrackHistManager<prefixTrack1> mTrackHistManager1;
   trackhistmanager::TrackHistManager<prefixTrack2> mTrackHistManager2;
@@ -262,6 +299,8 @@ class PairTrackTrackBuilder
   bool mSameSpecies = false;
   int mMixingDepth = 5;
   bool mMixIdenticalParticles = false;
+  bool mUseMixingPool = false;
+  mixingpool::TrackMixingPool mMixingPool;
 };
 
 template <const char* prefixV01,
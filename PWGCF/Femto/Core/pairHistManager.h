@@ -97,6 +97,9 @@ struct ConfMixing : o2::framework::ConfigurableGroup {
   o2::framework::Configurable<int> policy{"policy", 0, "Binning policy for mixing (alywas in combination with z-vertex) -> 0: multiplicity, -> 1: centrality, -> 2: both"};
   o2::framework::Configurable<bool> sameSpecies{"sameSpecies", false, "Enable if particle 1 and particle 2 are the same"};
   o2::framework::Configurable<int> seed{"seed", -1, "Seed to randomize particle 1 and particle 2 (if they are identical). Set to negative value to deactivate. Set to 0 to generate unique seed in time."};
+  o2::framework::Configurable<bool> usePool{"usePool", false, "Mix each collision with the last collisions (depth) of its mixing bin, kept across data frames (only track-track pairs in data)"};
+  o2::framework::Configurable<int> poolMaxTracks{"poolMaxTracks", 200, "Maximum number of particles of a collision to be stored in the mixing pool"};
+  o2::framework::Configurable<float> poolMaxSize{"poolMaxSize", 100.f, "Maximum size of the mixing pool (in MB)"};
 };
 
 struct ConfPairBinning : o2::framework::ConfigurableGroup {
@@ -451,6 +451,65 @@ void processMixedEvent(T1 const& Collisions,
   }
 }
 
+// process mixed event against a pool of the previous collisions of the same mixing bin, kept across data frames
+// as for the collision pairs of the other mixed event functions, in which collision 1 precedes collision 2,
+// particle 1 is taken from the pooled collisions and particle 2 from the current collision
+// pooled particles and particles of the current collision cannot be the same, so no pair cleaning is needed
+template <modes::Mode mode,
+          typename T1,
+          typename T2,
+          typename T3,
+          typename T4,
+          typename T5,
+          typename T6,
+          typename T7,
+          typename T8,
+          typename T9>
+void processMixedEventWithPool(T1 const& Collisions,
+                               T2& Partition1,
+                               T3& Partition2,
+                               T4 const& TrackTable,
+                               T5& cache,
+                               T6 const& getBin,
+                               T7& Pool,
+                               T8& PairHistManager,
+                               T9& CprManager)
+{
+  for (auto const& collision : Collisions) {
+    const int bin = getBin(collision);
+    if (bin < 0) {
+      continue;
+    }
+    auto sliceParticle2 = Partition2->sliceByCached(o2::aod::femtobase::stored::fColId, collision.globalIndex(), cache);
+    if (sliceParticle2.size() != 0) {
+      CprManager.setMagField(collision.magField());
+      for (int i = 0; i < Pool.getNCollisions(bin); i++) {
+        auto const& poolCollision = Pool.getCollision(bin, i);
+        if (!(std::fabs(poolCollision.magField() - collision.magField()) < o2::constants::math::Epsilon)) {
+          continue;
+        }
+        for (auto const& p1 : Pool.getTracks(bin, i)) {
+          for (auto const& p2 : sliceParticle2) {
+            // Close pair rejection
+            CprManager.setPair(p1, p2, TrackTable);
+            if (CprManager.isClosePair()) {
+              continue;
+            }
+            PairHistManager.setPair(p1, p2, poolCollision, collision);
+            CprManager.fill(PairHistManager.getKstar());
+            if (PairHistManager.checkPairCuts()) {
+              PairHistManager.template fill<mode>();
+            }
+          }
+        }
+      }
+    }
+    // add the current collision to the pool, sliced only once
+    auto sliceParticle1 = Partition1->sliceByCached(o2::aod::femtobase::stored::fColId, collision.globalIndex(), cache);
+    Pool.addCollision(bin, collision, sliceParticle1);
+  }
+}
+
 } // namespace pairprocesshelpers
 } // namespace o2::analysis::femto
 
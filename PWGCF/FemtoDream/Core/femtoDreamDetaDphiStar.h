@@ -20,6 +20,7 @@
 
 #include "Framework/HistogramRegistry.h"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -58,6 +59,7 @@ class FemtoDreamDetaDphiStar
     atWhichRadiiToSelect = atWhichRadiiToCut;
     radiiTPC = radiiTPCtoCut;
     fillQA = fillTHSparse;
+    mPhiStarCache.clear();
 
     if constexpr (mPartOneType == o2::aod::femtodreamparticle::ParticleType::kTrack && (mPartTwoType == o2::aod::femtodreamparticle::ParticleType::kTrack || mPartTwoType == o2::aod::femtodreamparticle::ParticleType::kCascadeV0Child || mPartTwoType == o2::aod::femtodreamparticle::ParticleType::kCascadeBachelor)) {
       std::string dirName = static_cast<std::string>(dirNames[0]);
@@ -772,7 +774,7 @@ class FemtoDreamDetaDphiStar
 
   float deltaPhiMax;
   float deltaEtaMax;
-  float magfield;
+  float magfield = 0.f;
   bool plotForEveryRadii = false;
   bool isMixedEventLambda = false;
   float upperQ3LimitForPlotting = 8.;
@@ -788,15 +790,25 @@ class FemtoDreamDetaDphiStar
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_eta{};
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_phi{};
 
-  ///  Calculate phi at all required radii stored in tmpRadiiTPC
-  /// Magnetic field to be provided in Tesla
+  /// phi* of a particle at all radii in tmpRadiiTPC and at radiiTPC, for a given charge, pt, phi and magnetic field
+  struct PhiStarEntry {
+    float pt = 0.f;
+    float phi = 0.f;
+    float magfield = 0.f;
+    int charge = 0;
+    bool isSet = false;
+    std::array<float, 9> phiAtRadii{};
+    float phiAtSpecificRadii = 0.f;
+  };
+  std::vector<PhiStarEntry> mPhiStarCache; ///< phi* per particle, indexed by the global index of the particle
+  std::vector<float> mTmpVec1;             ///< phi* of the first particle of the pair at all radii
+  std::vector<float> mTmpVec2;             ///< phi* of the second particle of the pair at all radii
+
+  ///  Get the charge from cutcontainer using masks
   template <typename T>
-  int PhiAtRadiiTPC(const T& part, std::vector<float>& tmpVec)
+  int getCharge(const T& part)
   {
-
-    float phi0 = part.phi();
-    // Start: Get the charge from cutcontainer using masks
-    int charge = 0.;
+    int charge = 0;
     if ((part.cut() & kSignMinusMask) == kValue0 && (part.cut() & kSignPlusMask) == kValue0) {
       charge = 0;
     } else if ((part.cut() & kSignPlusMask) == kSignPlusMask) {
@@ -806,23 +818,66 @@ class FemtoDreamDetaDphiStar
     } else {
       LOG(fatal) << "FemtoDreamDetaDphiStar: Charge bits are set wrong!";
     }
-    // End: Get the charge from cutcontainer using masks
-    float pt = part.pt();
-    for (size_t i = 0; i < 9; i++) {
-      if (runOldVersion) {
-        tmpVec.push_back(phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-      }
-      if (!runOldVersion) {
-        auto arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
-        // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-        if (std::fabs(arg) < 1) {
-          tmpVec.push_back(phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-        } else {
-          tmpVec.push_back(999);
-        }
+    return charge;
+  }
+
+  ///  Calculate phi at a given radius
+  /// Magnetic field to be provided in Tesla
+  float PhiAtRadius(int charge, float pt, float phi0, float radii)
+  {
+    float phiAtRadii = 0;
+    if (runOldVersion) {
+      phiAtRadii = phi0 - std::asin(0.3 * charge * 0.1 * magfield * radii * 0.01 / (2. * pt));
+    }
+    if (!runOldVersion) {
+      auto arg = 0.3 * charge * magfield * radii * 0.01 / (2. * pt);
+      // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
+      if (std::fabs(arg) < 1) {
+        phiAtRadii = phi0 - std::asin(0.3 * charge * magfield * radii * 0.01 / (2. * pt));
+      } else {
+        phiAtRadii = 999.;
       }
     }
-    return charge;
+    return phiAtRadii;
+  }
+
+  ///  Get phi* of a particle at all radii, computed only once per particle and magnetic field
+  /// The entries are checked against pt, phi, charge and magnetic field of the particle, so that
+  /// the cache does not need to be cleared between data frames
+  template <typename T>
+  PhiStarEntry const& getPhiStar(const T& part)
+  {
+    const auto index = part.globalIndex();
+    if (static_cast<size_t>(index) >= mPhiStarCache.size()) {
+      mPhiStarCache.resize(index + 1);
+    }
+    auto& entry = mPhiStarCache[index];
+    const int charge = getCharge(part);
+    const float pt = part.pt();
+    const float phi0 = part.phi();
+    if (entry.isSet && entry.pt == pt && entry.phi == phi0 && entry.charge == charge && entry.magfield == magfield) {
+      return entry;
+    }
+    entry.pt = pt;
+    entry.phi = phi0;
+    entry.charge = charge;
+    entry.magfield = magfield;
+    entry.isSet = true;
+    for (size_t i = 0; i < 9; i++) {
+      entry.phiAtRadii[i] = PhiAtRadius(charge, pt, phi0, tmpRadiiTPC[i]);
+    }
+    entry.phiAtSpecificRadii = PhiAtRadius(charge, pt, phi0, radiiTPC);
+    return entry;
+  }
+
+  ///  Calculate phi at all required radii stored in tmpRadiiTPC
+  /// Magnetic field to be provided in Tesla
+  template <typename T>
+  int PhiAtRadiiTPC(const T& part, std::vector<float>& tmpVec)
+  {
+    auto const& entry = getPhiStar(part);
+    tmpVec.insert(tmpVec.end(), entry.phiAtRadii.begin(), entry.phiAtRadii.end());
+    return entry.charge;
   }
 
   ///  Calculate phi at specific radii
@@ -852,35 +907,14 @@ class FemtoDreamDetaDphiStar
         pt = part.prong2Pt();
       }
     } else {
-      phi0 = part.phi();
-      // Start: Get the charge from cutcontainer using masks
-      if ((part.cut() & kSignMinusMask) == kValue0 && (part.cut() & kSignPlusMask) == kValue0) {
-        charge = 0;
-      } else if ((part.cut() & kSignPlusMask) == kSignPlusMask) {
-        charge = 1;
-      } else if ((part.cut() & kSignMinusMask) == kSignMinusMask) {
-        charge = -1;
-      } else {
-        LOG(fatal) << "FemtoDreamDetaDphiStar: Charge bits are set wrong!";
+      if (radii == radiiTPC) {
+        return getPhiStar(part).phiAtSpecificRadii;
       }
+      phi0 = part.phi();
+      charge = getCharge(part);
       pt = part.pt();
     }
-    // End: Get the charge from cutcontainer using masks
-    float phiAtRadii = 0;
-    if (runOldVersion) {
-      phiAtRadii = phi0 - std::asin(0.3 * charge * 0.1 * magfield * radii * 0.01 / (2. * pt));
-    }
-    if (!runOldVersion) {
-      auto arg = 0.3 * charge * magfield * radii * 0.01 / (2. * pt);
-      // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-      if (std::fabs(arg) < 1) {
-        phiAtRadii = phi0 - std::asin(0.3 * charge * magfield * radii * 0.01 / (2. * pt));
-      } else {
-        phiAtRadii = 999.;
-      }
-    }
-
-    return phiAtRadii;
+    return PhiAtRadius(charge, pt, phi0, radii);
   }
 
   template <typename T>
@@ -930,8 +964,10 @@ class FemtoDreamDetaDphiStar
   template <bool isHF = false, typename T1, typename T2>
   float AveragePhiStar(const T1& part1, const T2& part2, int iHist, bool* sameCharge)
   {
-    std::vector<float> tmpVec1;
-    std::vector<float> tmpVec2;
+    auto& tmpVec1 = mTmpVec1;
+    auto& tmpVec2 = mTmpVec2;
+    tmpVec1.clear();
+    tmpVec2.clear();
     auto charge1 = PhiAtRadiiTPC(part1, tmpVec1);
     if constexpr (!isHF) {
       auto charge2 = PhiAtRadiiTPC(part2, tmpVec2);
@@ -1181,11 +1181,11 @@ struct FlowTask {
         }
       }
       if (withinPtRef)
-        fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 1);
+        fGFW->FillBuffered(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 1);
       if (withinPtPOI)
-        fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 2);
+        fGFW->FillBuffered(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 2);
       if (withinPtPOI && withinPtRef)
-        fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 4);
+        fGFW->FillBuffered(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), wacc * weff, 4);
       if (cfgUsePtRef && withinPtRef)
         fillPtSums<kReco>(track, weff);
       if (!cfgUsePtRef && withinPtPOI)
@@ -1301,11 +1301,11 @@ struct FlowTask {
         }
       }
       if (withinPtRef)
-        fGFW->Fill(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 1);
+        fGFW->FillBuffered(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 1);
       if (withinPtPOI)
-        fGFW->Fill(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 2);
+        fGFW->FillBuffered(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 2);
       if (withinPtPOI && withinPtRef)
-        fGFW->Fill(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 4);
+        fGFW->FillBuffered(mcParticle.eta(), fPtAxis->FindBin(mcParticle.pt()) - 1, mcParticle.phi(), 1., 4);
       if (cfgUsePtRef && withinPtRef)
         fillPtSums<kGen>(mcParticle, 1.);
       if (!cfgUsePtRef && withinPtPOI)
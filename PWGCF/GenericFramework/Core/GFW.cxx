@@ -11,7 +11,9 @@
 
 #include "GFW.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -85,10 +87,10 @@ int GFW::CreateRegions()
     return 0;
   }
   int nRegions = 0;
+  fCumulants.reserve(fRegions.size());
   for (auto pItr = fRegions.begin(); pItr != fRegions.end(); pItr++) {
-    GFWCumulant* lCumulant = new GFWCumulant();
-    lCumulant->CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
-    fCumulants.push_back(*lCumulant);
+    fCumulants.emplace_back();
+    fCumulants.back().CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
     ++nRegions;
   }
   if (nRegions)
@@ -98,11 +100,57 @@ int GFW::CreateRegions()
 void GFW::Fill(double eta, int ptin, double phi, double weight, int mask, double SecondWeight)
 {
   // if(!fInitialized) return;
+  fEpoch++; // Q-vectors change, cached correlators are not valid anymore
   for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
     if (fRegions.at(i).EtaMin < eta && fRegions.at(i).EtaMax > eta && (fRegions.at(i).BitMask & mask))
       fCumulants.at(i).FillArray(ptin, phi, weight, SecondWeight);
   }
 };
+void GFW::Fill(int nParticles, const double* eta, const int* ptin, const double* phi, const double* weight, const int* mask, const double* SecondWeight)
+{
+  if (nParticles <= 0)
+    return;
+  fEpoch++; // Q-vectors change, cached correlators are not valid anymore
+  for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
+    const Region& lRegion = fRegions.at(i);
+    fSelPt.clear();
+    fSelPhi.clear();
+    fSelWeight.clear();
+    fSelSecondWeight.clear();
+    for (int j = 0; j < nParticles; ++j) {
+      if (!(lRegion.EtaMin < eta[j] && lRegion.EtaMax > eta[j] && (lRegion.BitMask & mask[j])))
+        continue;
+      fSelPt.push_back(ptin[j]);
+      fSelPhi.push_back(phi[j]);
+      fSelWeight.push_back(weight[j]);
+      if (SecondWeight)
+        fSelSecondWeight.push_back(SecondWeight[j]);
+    }
+    if (!fSelPt.empty())
+      fCumulants.at(i).FillArray(static_cast<int>(fSelPt.size()), fSelPt.data(), fSelPhi.data(), fSelWeight.data(), SecondWeight ? fSelSecondWeight.data() : nullptr);
+  }
+};
+void GFW::FillBuffered(double eta, int ptin, double phi, double weight, int mask, double SecondWeight)
+{
+  fBufEta.push_back(eta);
+  fBufPt.push_back(ptin);
+  fBufPhi.push_back(phi);
+  fBufWeight.push_back(weight);
+  fBufMask.push_back(mask);
+  fBufSecondWeight.push_back(SecondWeight);
+};
+void GFW::FlushBuffer()
+{
+  if (fBufPhi.empty())
+    return;
+  Fill(static_cast<int>(fBufPhi.size()), fBufEta.data(), fBufPt.data(), fBufPhi.data(), fBufWeight.data(), fBufMask.data(), fBufSecondWeight.data());
+  fBufEta.clear();
+  fBufPt.clear();
+  fBufPhi.clear();
+  fBufWeight.clear();
+  fBufMask.clear();
+  fBufSecondWeight.clear();
+};
 complex<double> GFW::TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant* r1, GFWCumulant* r2, GFWCumulant* r3)
 {
   complex<double> part1 = r1->Vec(n1, p1, ptbin);
@@ -163,8 +211,15 @@ void GFW::Clear()
 {
   if (!fInitialized)
     CreateRegions();
+  fBufEta.clear();
+  fBufPt.clear();
+  fBufPhi.clear();
+  fBufWeight.clear();
+  fBufMask.clear();
+  fBufSecondWeight.clear();
   for (auto ptr = fCumulants.begin(); ptr != fCumulants.end(); ++ptr)
     ptr->ResetQs();
+  fEpoch++;
 };
 GFW::CorrConfig GFW::GetCorrelatorConfig(string config, string head, bool ptdif)
 {
@@ -246,19 +301,24 @@ GFW::CorrConfig GFW::GetCorrelatorConfig(string config, string head, bool ptdif)
   ReturnConfig.Head = head;
   ReturnConfig.pTDif = ptdif;
   // ReturnConfig.pTbin = ptbin;
+  CompileConfig(ReturnConfig);
   fListOfCFGs.push_back(ReturnConfig);
   return ReturnConfig;
 };
 
 complex<double> GFW::Calculate(int poi, int ref, vector<int> hars, int ptbin)
 {
+  FlushBuffer();
   GFWCumulant* qref = &fCumulants.at(ref);
   GFWCumulant* qpoi = &fCumulants.at(poi);
   GFWCumulant* qovl = qpoi;
   return RecursiveCorr(qpoi, qref, qovl, ptbin, hars);
 };
-complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero)
+complex<double> GFW::Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero)
 {
+  FlushBuffer();
+  if (corconf.Book)
+    return CalculateCompiled(corconf, ptbin, SetHarmsToZero);
   // if(!fInitialized) return complex<double>(0,0); //First check if initialised, if not -- initialize, and if it fails, return
   if (corconf.Regs.size() == 0)
     return complex<double>(0, 0); // Check if we have any regions at all
@@ -293,15 +353,202 @@ complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZer
       qovl = &fCumulants.at(ovl);
     else if (ref == poi)
       qovl = qref; // If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
+    vector<int> hars = corconf.Hars.at(i);
     if (SetHarmsToZero) {
-      for (int j = 0; j < static_cast<int>(corconf.Hars.at(i).size()); j++) {
-        corconf.Hars.at(i).at(j) = 0;
+      for (int j = 0; j < static_cast<int>(hars.size()); j++) {
+        hars.at(j) = 0;
       }
     }
-    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, corconf.Hars.at(i));
+    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, hars);
   }
   return retval;
 };
+complex<double> GFW::CalculateCompiled(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero)
+{
+  // Same as Calculate, using the compiled correlators. Values of the nodes are cached until the Q-vectors change,
+  // so that the terms shared by different configurations (or pT bins) are only calculated once per event
+  if (corconf.Plan.size() == 0)
+    return complex<double>(0, 0);
+  PrepareCache(corconf.Book);
+  complex<double> retval(1, 0);
+  for (const PlanSubevent& sub : corconf.Plan) {
+    if (sub.Root < 0)
+      return complex<double>(0, 0); // no regions in the current subevent
+    int ptInd = (sub.PtInd < 0) ? ptbin : sub.PtInd;
+    GFWCumulant* qref = &fCumulants.at(sub.Ref);
+    GFWCumulant* qpoi = &fCumulants.at(sub.Poi);
+    if (!qref->IsPtBinFilled(ptInd))
+      return complex<double>(0, 0);
+    if (!qpoi->IsPtBinFilled(ptInd))
+      return complex<double>(0, 0);
+    if (qref->GetN() < sub.NRefHars)
+      return complex<double>(0, 0);
+    retval *= EvaluateNode(*corconf.Book, SetHarmsToZero ? sub.RootZero : sub.Root, ptInd);
+  }
+  return retval;
+};
+bool GFW::CompileConfig(CorrConfig& corconf)
+{
+  // Unroll the correlators of all subevents into nodes of the plan book. Configurations which RecursiveCorr
+  // cannot handle are left uncompiled, and evaluated with RecursiveCorr
+  if (corconf.Hars.size() != corconf.Regs.size() || corconf.Overlap.size() != corconf.Regs.size() || corconf.ptInd.size() != corconf.Regs.size())
+    return false;
+  for (int i = 0; i < static_cast<int>(corconf.Regs.size()); i++) {
+    if (corconf.Regs.at(i).size() > 0 && corconf.Hars.at(i).size() == 0)
+      return false;
+  }
+  if (!fPlanBook)
+    fPlanBook = std::make_shared<PlanBook>();
+  vector<PlanSubevent> plan;
+  for (int i = 0; i < static_cast<int>(corconf.Regs.size()); i++) {
+    PlanSubevent sub;
+    sub.PtInd = corconf.ptInd.at(i);
+    if (corconf.Regs.at(i).size() > 0) {
+      sub.Poi = corconf.Regs.at(i).at(0);
+      sub.Ref = (corconf.Regs.at(i).size() > 1) ? corconf.Regs.at(i).at(1) : corconf.Regs.at(i).at(0);
+      sub.NRefHars = static_cast<int>(corconf.Hars.at(i).size());
+      if (sub.Poi != sub.Ref)
+        sub.NRefHars--;
+      int ovl = corconf.Overlap.at(i);
+      if (ovl < 0 && sub.Ref == sub.Poi)
+        ovl = sub.Ref; // If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
+      vector<int> hars = corconf.Hars.at(i);
+      vector<int> pows(hars.size(), 1);
+      sub.Root = CompileCorr(*fPlanBook, sub.Poi, sub.Ref, ovl, hars, pows);
+      std::fill(hars.begin(), hars.end(), 0);
+      sub.RootZero = CompileCorr(*fPlanBook, sub.Poi, sub.Ref, ovl, hars, pows);
+    }
+    plan.push_back(sub);
+  }
+  corconf.Book = fPlanBook;
+  corconf.Plan = plan;
+  return true;
+};
+int GFW::CompileQ(PlanBook& book, int region, int har, int pow, bool usePtBin)
+{
+  vector<int> key = {0, region, har, pow, usePtBin};
+  auto it = book.NodeIndex.find(key);
+  if (it != book.NodeIndex.end())
+    return it->second;
+  PlanNode lNode;
+  lNode.Region = region;
+  lNode.Har = har;
+  lNode.Pow = pow;
+  lNode.UsePtBin = usePtBin;
+  book.Nodes.push_back(lNode);
+  book.NodeIndex[key] = static_cast<int>(book.Nodes.size()) - 1;
+  return static_cast<int>(book.Nodes.size()) - 1;
+};
+int GFW::CompileCorr(PlanBook& book, int poi, int ref, int ovl, vector<int>& hars, vector<int>& pows)
+{
+  // Follows RecursiveCorr step by step, ovl = -1 standing for no overlap. Identical sub-correlators are compiled only once
+  if ((pows.at(0) != 1) && ovl > -1)
+    poi = ovl;
+  vector<int> key = {1, poi, ref, ovl};
+  key.insert(key.end(), hars.begin(), hars.end());
+  key.insert(key.end(), pows.begin(), pows.end());
+  auto it = book.NodeIndex.find(key);
+  if (it != book.NodeIndex.end())
+    return it->second;
+  if (hars.size() < 2) {
+    int lNode = CompileQ(book, poi, hars.at(0), pows.at(0), true);
+    book.NodeIndex[key] = lNode;
+    return lNode;
+  }
+  PlanNode lNode;
+  vector<pair<double, int>> lTerms;
+  if (hars.size() < 3) {
+    lNode.First = CompileQ(book, poi, hars.at(0), pows.at(0), true);
+    lNode.Second = CompileQ(book, ref, hars.at(1), pows.at(1), true);
+    if (ovl > -1)
+      lTerms.push_back(std::make_pair(1., CompileQ(book, ovl, hars.at(0) + hars.at(1), pows.at(0) + pows.at(1), true)));
+  } else {
+    int harlast = hars.at(hars.size() - 1);
+    int powlast = pows.at(pows.size() - 1);
+    hars.erase(hars.end() - 1);
+    pows.erase(pows.end() - 1);
+    lNode.First = CompileCorr(book, poi, ref, ovl, hars, pows);
+    lNode.Second = CompileQ(book, ref, harlast, powlast, false); // RecursiveCorr takes this one from pT bin 0
+    int lDegeneracy = 1;
+    int harSize = static_cast<int>(hars.size());
+    for (int i = harSize - 1; i >= 0; i--) {
+      if (i > 2) {
+        if (hars.at(i) == hars.at(i - 1) && pows.at(i) == pows.at(i - 1)) {
+          lDegeneracy++;
+          continue;
+        }
+      }
+      hars.at(i) += harlast;
+      pows.at(i) += powlast;
+      lTerms.push_back(std::make_pair(static_cast<double>(lDegeneracy), CompileCorr(book, poi, ref, ovl, hars, pows)));
+      lDegeneracy = 1;
+      hars.at(i) -= harlast;
+      pows.at(i) -= powlast;
+    }
+    hars.push_back(harlast);
+    pows.push_back(powlast);
+  }
+  lNode.TermBegin = static_cast<int>(book.Terms.size());
+  book.Terms.insert(book.Terms.end(), lTerms.begin(), lTerms.end());
+  lNode.TermEnd = static_cast<int>(book.Terms.size());
+  book.Nodes.push_back(lNode);
+  book.NodeIndex[key] = static_cast<int>(book.Nodes.size()) - 1;
+  return static_cast<int>(book.Nodes.size()) - 1;
+};
+void GFW::PrepareCache(const std::shared_ptr<const PlanBook>& book)
+{
+  // Cache slots are set up for the nodes added to the book since the last call (or for all nodes, for a new book)
+  int nNodes = static_cast<int>(book->Nodes.size());
+  if (book == fCacheBook && nNodes == fCacheNNodes)
+    return;
+  if (book != fCacheBook) {
+    fCacheBook = book;
+    fCacheNNodes = 0;
+    fCacheOffset.clear();
+    fCacheNPt.clear();
+    fCacheEpoch.clear();
+    fCache.clear();
+  }
+  fCacheOffset.resize(nNodes, -1);
+  fCacheNPt.resize(nNodes, 1);
+  for (int i = fCacheNNodes; i < nNodes; i++) {
+    const PlanNode& lNode = book->Nodes[i];
+    if (lNode.Region > -1) { // Q-vectors are not cached, only their pT dependence is needed
+      fCacheNPt[i] = lNode.UsePtBin ? std::max(fRegions.at(lNode.Region).NpT, 1) : 1;
+      continue;
+    }
+    int nPt = std::max(fCacheNPt[lNode.First], fCacheNPt[lNode.Second]);
+    for (int t = lNode.TermBegin; t < lNode.TermEnd; t++)
+      nPt = std::max(nPt, fCacheNPt[book->Terms[t].second]);
+    fCacheNPt[i] = nPt;
+    fCacheOffset[i] = static_cast<int>(fCache.size());
+    fCache.resize(fCache.size() + nPt);
+    fCacheEpoch.resize(fCacheEpoch.size() + nPt, 0);
+  }
+  fCacheNNodes = nNodes;
+};
+complex<double> GFW::EvaluateNode(const PlanBook& book, int node, int ptbin)
+{
+  const PlanNode& lNode = book.Nodes[node];
+  if (lNode.Region > -1)
+    return fCumulants.at(lNode.Region).Vec(lNode.Har, lNode.Pow, lNode.UsePtBin ? ptbin : 0);
+  int lPt = (fCacheNPt[node] > 1) ? ptbin : 0; // Nodes not depending on the pT bin share one value
+  int lSlot = (lPt >= 0 && lPt < fCacheNPt[node]) ? fCacheOffset[node] + lPt : -1;
+  if (lSlot > -1 && fCacheEpoch[lSlot] == fEpoch)
+    return fCache[lSlot];
+  complex<double> formula = EvaluateNode(book, lNode.First, ptbin) * EvaluateNode(book, lNode.Second, ptbin);
+  for (int t = lNode.TermBegin; t < lNode.TermEnd; t++) {
+    complex<double> subtractVal = EvaluateNode(book, book.Terms[t].second, ptbin);
+    if (book.Terms[t].first != 1.)
+      subtractVal *= book.Terms[t].first;
+    formula -= subtractVal;
+  }
+  if (lSlot > -1) {
+    fCache[lSlot] = formula;
+    fCacheEpoch[lSlot] = fEpoch;
+  }
+  return formula;
+};
 vector<pair<int, vector<int>>> GFW::GetHarmonicsSingleConfig(const CorrConfig& incfg)
 {
   vector<pair<int, vector<int>>> retPair;
@@ -337,6 +584,7 @@ void GFW::InitializePowerArrays()
 };
 complex<double> GFW::Calculate(int poi, vector<int> hars)
 {
+  FlushBuffer();
   GFWCumulant* qpoi = &fCumulants.at(poi);
   return RecursiveCorr(qpoi, qpoi, qpoi, 0, hars);
 };
@@ -21,7 +21,10 @@
 
 #include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <cstdio>
+#include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,6 +46,31 @@ class GFW
     };
     void PrintStructure() { printf("%s: eta [%f.. %f].", rName.c_str(), EtaMin, EtaMax); }
   };
+  // Compiled correlators: the recursion of RecursiveCorr is unrolled once into a DAG of nodes, shared by all the
+  // configurations compiled by the same GFW. A node is either a Q-vector, or a product of two nodes minus a sum of nodes
+  struct PlanNode {
+    int Region = -1;      // Q-vector: region index (-1 for products)
+    int Har = 0;          // Q-vector: harmonic
+    int Pow = 0;          // Q-vector: power
+    bool UsePtBin = true; // Q-vector: taken in the requested pT bin (otherwise in bin 0)
+    int First = -1;       // product: first factor
+    int Second = -1;      // product: second factor
+    int TermBegin = 0;    // product: first subtracted term in PlanBook::Terms
+    int TermEnd = 0;      // product: end of the subtracted terms
+  };
+  struct PlanBook {
+    std::vector<PlanNode> Nodes;
+    std::vector<std::pair<double, int>> Terms; // (degeneracy, node) of the subtracted terms
+    std::map<std::vector<int>, int> NodeIndex; // node lookup, only used when compiling
+  };
+  struct PlanSubevent {
+    int Poi = -1;      // POI region
+    int Ref = -1;      // reference region
+    int NRefHars = 0;  // minimum number of particles in the reference region
+    int PtInd = -1;    // fixed pT bin (-1: pT bin given to Calculate)
+    int Root = -1;     // correlator node
+    int RootZero = -1; // correlator node with all harmonics set to zero
+  };
   struct CorrConfig {
     std::vector<std::vector<int>> Regs{};
     std::vector<std::vector<int>> Hars{};
@@ -50,6 +78,8 @@ class GFW
     std::vector<int> ptInd;
     bool pTDif = false;
     std::string Head = "";
+    std::shared_ptr<const PlanBook> Book; //! nodes of the compiled correlator, null if not compiled
+    std::vector<PlanSubevent> Plan;       //! compiled subevents
   };
   GFW();
   ~GFW();
@@ -61,15 +91,49 @@ class GFW
   void AddRegion(std::string refName, int lNhar, int* lNparVec, double lEtaMin, double lEtaMax, int lNpT, int BitMask);  // Legacy support, array instead of a vector
   int CreateRegions();
   void Fill(double eta, int ptin, double phi, double weight, int mask, double secondWeight = -1);
+  // Batched version of Fill, for nParticles particles at once. secondWeight can be a nullptr (no second weight)
+  void Fill(int nParticles, const double* eta, const int* ptin, const double* phi, const double* weight, const int* mask, const double* secondWeight = nullptr);
+  // Same as Fill, but the particle is only buffered. The buffer is filled in one go (batched Fill) by FlushBuffer,
+  // which is called by Calculate. Clear discards the particles not yet flushed
+  void FillBuffered(double eta, int ptin, double phi, double weight, int mask, double secondWeight = -1);
+  void FlushBuffer();
   void Clear();
-  GFWCumulant GetCumulant(int index) { return fCumulants.at(index); }
+  GFWCumulant GetCumulant(int index)
+  {
+    FlushBuffer();
+    return fCumulants.at(index);
+  }
   CorrConfig GetCorrelatorConfig(std::string config, std::string head = "", bool ptdif = false);
-  std::complex<double> Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero);
+  std::complex<double> Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero);
   void InitializePowerArrays();
 
  protected:
   bool fInitialized;
   std::vector<CorrConfig> fListOfCFGs;
+  std::shared_ptr<PlanBook> fPlanBook;        //! nodes of the correlators compiled by this GFW
+  uint64_t fEpoch = 1;                        //! incremented whenever the Q-vectors change
+  std::shared_ptr<const PlanBook> fCacheBook; //! book the node cache is set up for
+  int fCacheNNodes = 0;                       //! number of nodes of fCacheBook covered by the cache
+  std::vector<int> fCacheOffset;              //! first cache slot of each node
+  std::vector<int> fCacheNPt;                 //! number of pT bins the value of each node depends on (1: none)
+  std::vector<uint64_t> fCacheEpoch;          //! epoch of each cached value
+  std::vector<std::complex<double>> fCache;   //! cached node values, per node and pT bin
+  std::vector<double> fBufEta;                //! buffered particles (FillBuffered)
+  std::vector<int> fBufPt;                    //!
+  std::vector<double> fBufPhi;                //!
+  std::vector<double> fBufWeight;             //!
+  std::vector<int> fBufMask;                  //!
+  std::vector<double> fBufSecondWeight;       //!
+  std::vector<int> fSelPt;                    //! particles of the batched Fill selected for one region
+  std::vector<double> fSelPhi;                //!
+  std::vector<double> fSelWeight;             //!
+  std::vector<double> fSelSecondWeight;       //!
+  bool CompileConfig(CorrConfig& corconf);
+  int CompileQ(PlanBook& book, int region, int har, int pow, bool usePtBin);
+  int CompileCorr(PlanBook& book, int poi, int ref, int ovl, std::vector<int>& hars, std::vector<int>& pows);
+  void PrepareCache(const std::shared_ptr<const PlanBook>& book);
+  std::complex<double> EvaluateNode(const PlanBook& book, int node, int ptbin);
+  std::complex<double> CalculateCompiled(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero);
   std::complex<double> TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant*, GFWCumulant*, GFWCumulant*);
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars, std::vector<int>& pows); // POI, Ref. flow, overlapping region
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars);                         // POI, Ref. flow, overlapping region
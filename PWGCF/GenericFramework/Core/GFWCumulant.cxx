@@ -11,18 +11,21 @@
 
 #include "GFWCumulant.h"
 
+#include <algorithm>
 #include <vector>
 
 using std::complex;
 using std::vector;
 
-GFWCumulant::GFWCumulant() : fQvector(0),
+GFWCumulant::GFWCumulant() : fQvector(),
+                             fQOffsets(),
+                             fQStride(0),
                              fUsed(kBlank),
                              fNEntries(-1),
                              fN(1),
                              fPow(1),
                              fPt(1),
-                             fFilledPts(0),
+                             fFilledPts(),
                              fInitialized(false) {}
 
 GFWCumulant::~GFWCumulant() {}
@@ -35,53 +38,109 @@ void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWe
   else if (ptin < 0 || ptin >= fPt)
     return;
   fFilledPts[ptin] = true;
+  complex<double>* lQ = fQvector.data() + ptin * fQStride;
+  // If second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
+  // this is important when POIs are a subset of REFs and have different weights than REFs
+  double lPowFactor = (SecondWeight > 0) ? SecondWeight : weight;
+  // Harmonics are obtained recursively, (cos(n+1)phi, sin(n+1)phi) = (cos(n phi), sin(n phi)) x (cos(phi), sin(phi)),
+  // and the powers of the weights are built incrementally
+  double lCos1 = cos(phi);
+  double lSin1 = sin(phi);
+  double lCos = 1;
+  double lSin = 0;
   for (int lN = 0; lN < fN; lN++) {
-    double lSin = sin(lN * phi); // No need to recalculate for each power
-    double lCos = cos(lN * phi); // No need to recalculate for each power
+    complex<double>* lQn = lQ + fQOffsets[lN];
+    double lPrefactor = 1;
     for (int lPow = 0; lPow < PW(lN); lPow++) {
-      double lPrefactor = 0;
-      // Dont calculate it twice; multiplication is cheaper that power
-      // Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
-      // this is important when POIs are a subset of REFs and have different weights than REFs
-      if (SecondWeight > 0 && lPow > 1)
-        lPrefactor = pow(SecondWeight, lPow - 1) * weight;
-      else
-        lPrefactor = pow(weight, lPow);
-      double qsin = lPrefactor * lSin;
-      double qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow] += complex<double>(qcos, qsin);
+      lQn[lPow] += complex<double>(lPrefactor * lCos, lPrefactor * lSin);
+      lPrefactor *= (lPow == 0) ? weight : lPowFactor;
     }
+    double lCosNext = lCos * lCos1 - lSin * lSin1;
+    lSin = lSin * lCos1 + lCos * lSin1;
+    lCos = lCosNext;
   }
   Inc();
 };
-void GFWCumulant::ResetQs()
+void GFWCumulant::FillArray(int nParticles, const int* ptin, const double* phi, const double* weight, const double* SecondWeight)
 {
-  if (!fNEntries)
-    return; // If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for (int i = 0; i < fPt; i++) {
-    fFilledPts[i] = false;
+  if (!fInitialized)
+    CreateComplexVectorArray(1, 1, 1);
+  // Particles are processed in blocks of kBlockSize. The loops over the particles of a block have no dependencies,
+  // so that the harmonics and powers of the weights are computed for several particles at once (vectorized)
+  int lOffset[kBlockSize];
+  double lPhi[kBlockSize], lWeight[kBlockSize], lPowFactor[kBlockSize], lPrefactor[kBlockSize];
+  double lCos1[kBlockSize], lSin1[kBlockSize], lCos[kBlockSize], lSin[kBlockSize];
+  for (int lFirst = 0; lFirst < nParticles; lFirst += kBlockSize) {
+    int lLast = std::min(lFirst + kBlockSize, nParticles);
+    int nInBlock = 0;
+    for (int i = lFirst; i < lLast; i++) {
+      int lPt = (fPt == 1) ? 0 : ptin[i];
+      if (lPt < 0 || lPt >= fPt)
+        continue;
+      fFilledPts[lPt] = true;
+      lOffset[nInBlock] = lPt * fQStride;
+      lPhi[nInBlock] = phi[i];
+      lWeight[nInBlock] = weight[i];
+      lPowFactor[nInBlock] = (SecondWeight && SecondWeight[i] > 0) ? SecondWeight[i] : weight[i];
+      nInBlock++;
+    }
+    if (!nInBlock)
+      continue;
+    fNEntries += nInBlock;
+    bool lSameBin = true; // e.g. always the case for integrated Q-vectors
+    for (int k = 0; k < nInBlock; k++) {
+      lCos1[k] = cos(lPhi[k]);
+      lSin1[k] = sin(lPhi[k]);
+      lCos[k] = 1;
+      lSin[k] = 0;
+      lSameBin &= (lOffset[k] == lOffset[0]);
+    }
     for (int lN = 0; lN < fN; lN++) {
+      complex<double>* lQn = fQvector.data() + fQOffsets[lN];
+      for (int k = 0; k < nInBlock; k++)
+        lPrefactor[k] = 1;
       for (int lPow = 0; lPow < PW(lN); lPow++) {
-        fQvector[i][lN][lPow] = fNullQ;
+        if (lSameBin) {
+          double lSumCos = 0;
+          double lSumSin = 0;
+          for (int k = 0; k < nInBlock; k++) {
+            lSumCos += lPrefactor[k] * lCos[k];
+            lSumSin += lPrefactor[k] * lSin[k];
+          }
+          lQn[lOffset[0] + lPow] += complex<double>(lSumCos, lSumSin);
+        } else {
+          for (int k = 0; k < nInBlock; k++)
+            lQn[lOffset[k] + lPow] += complex<double>(lPrefactor[k] * lCos[k], lPrefactor[k] * lSin[k]);
+        }
+        const double* lMultiplier = (lPow == 0) ? lWeight : lPowFactor;
+        for (int k = 0; k < nInBlock; k++)
+          lPrefactor[k] *= lMultiplier[k];
+      }
+      for (int k = 0; k < nInBlock; k++) {
+        double lCosNext = lCos[k] * lCos1[k] - lSin[k] * lSin1[k];
+        lSin[k] = lSin[k] * lCos1[k] + lCos[k] * lSin1[k];
+        lCos[k] = lCosNext;
       }
     }
   }
+};
+void GFWCumulant::ResetQs()
+{
+  if (!fNEntries)
+    return; // If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
+  std::fill(fFilledPts.begin(), fFilledPts.end(), false);
+  std::fill(fQvector.begin(), fQvector.end(), fNullQ);
   fNEntries = 0;
 };
 void GFWCumulant::DestroyComplexVectorArray()
 {
   if (!fInitialized)
     return;
-  for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      delete[] fQvector[i][l_n];
-    }
-  }
-  for (int i = 0; i < fPt; i++) {
-    delete[] fQvector[i];
-  }
-  delete[] fQvector;
-  delete[] fFilledPts;
+  fQvector.clear();
+  fQvector.shrink_to_fit();
+  fQOffsets.clear();
+  fQStride = 0;
+  fFilledPts.clear();
   fInitialized = false;
   fNEntries = -1;
 };
@@ -100,17 +159,15 @@ void GFWCumulant::CreateComplexVectorArrayVarPower(int N, vector<int> PowVec, in
   fN = N;
   fPow = 0;
   fPt = Pt;
-  fFilledPts = new bool[Pt];
+  fFilledPts.assign(Pt, false);
   fPowVec = PowVec;
-  fQvector = new complex<double>**[fPt];
-  for (int i = 0; i < fPt; i++) {
-    fQvector[i] = new complex<double>*[fN];
-  }
+  fQOffsets.resize(fN);
+  fQStride = 0;
   for (int l_n = 0; l_n < fN; l_n++) {
-    for (int i = 0; i < fPt; i++) {
-      fQvector[i][l_n] = new complex<double>[PW(l_n)];
-    }
+    fQOffsets[l_n] = fQStride;
+    fQStride += PW(l_n);
   }
+  fQvector.assign(fPt * fQStride, fNullQ);
   ResetQs();
   fInitialized = true;
 };
@@ -121,12 +178,12 @@ complex<double> GFWCumulant::Vec(int n, int p, int ptbin)
   if (ptbin >= fPt || ptbin < 0)
     ptbin = 0;
   if (n >= 0)
-    return fQvector[ptbin][n][p];
-  return conj(fQvector[ptbin][-n][p]);
+    return fQvector[ptbin * fQStride + fQOffsets[n] + p];
+  return conj(fQvector[ptbin * fQStride + fQOffsets[-n] + p]);
 };
 bool GFWCumulant::IsPtBinFilled(int ptb)
 {
-  if (!fFilledPts)
+  if (fFilledPts.empty())
     return false;
   if (ptb > 0) {
     if (fPt == 1)
@@ -27,6 +27,9 @@ class GFWCumulant
   ~GFWCumulant();
   void ResetQs();
   void FillArray(int ptin, double phi, double weight = 1, double SecondWeight = -1);
+  // Batched version of FillArray, for nParticles particles at once. SecondWeight can be a nullptr (no second weight)
+  void FillArray(int nParticles, const int* ptin, const double* phi, const double* weight, const double* SecondWeight = nullptr);
+  static constexpr int kBlockSize = 16; // Number of particles processed together in the batched FillArray
   enum UsedFlags_t { kBlank = 0,
                      kFull = 1,
                      kPt = 2 };
@@ -44,7 +47,9 @@ class GFWCumulant
   void DestroyComplexVectorArray();
   std::complex<double> Vec(int, int, int ptbin = 0); // envelope class to summarize pt-dif. Q-vec getter
  protected:
-  std::complex<double>*** fQvector;
+  std::vector<std::complex<double>> fQvector; //! Q-vectors, contiguous in [ptbin][harmonic][power]
+  std::vector<int> fQOffsets;                 //! Offset of each harmonic within a pt bin
+  int fQStride;                               //! Number of Q-vectors per pt bin
   uint fUsed;
   int fNEntries;
   // Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
@@ -52,7 +57,7 @@ class GFWCumulant
   int fPow;                 //! Power
   std::vector<int> fPowVec; //! Powers array
   int fPt;                  //! fPt bins
-  bool* fFilledPts;
+  std::vector<bool> fFilledPts;
   bool fInitialized; // Arrays are initialized
   std::complex<double> fNullQ = 0;
 };
@@ -186,6 +186,8 @@ struct : ConfigurableGroup {
 // *) Q-vector:
 struct : ConfigurableGroup {
   Configurable<bool> cfCalculateQvectors{"cfCalculateQvectors", true, "calculate or not Q-vectors (all, also diff. ones). If I want only to fill control histograms, then set here false"};
+  Configurable<bool> cfUseCorrelatorCache{"cfUseCorrelatorCache", true, "calculate Test0 correlators with memoized recursion, which shares sub-results among all correlators of all orders"};
+  Configurable<bool> cfValidateCorrelatorCache{"cfValidateCorrelatorCache", false, "cross-check e-b-e each memoized correlator against standard Recursion(...)"};
 } cf_qv;
 
 // *) Multiparticle correlations:
@@ -16,6 +16,9 @@
 #ifndef PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_DATAMEMBERS_H_
 #define PWGCF_MULTIPARTICLECORRELATIONS_CORE_MUPA_DATAMEMBERS_H_
 
+#include <array>
+#include <complex>
+#include <unordered_map>
 #include <vector>
 
 // General remarks:
@@ -267,6 +270,24 @@ struct Qvector {
   TComplex fQ[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{TComplex(0., 0.)}};       //! generic Q-vector
   TComplex fQvector[gMaxHarmonic * gMaxCorrelator + 1][gMaxCorrelator + 1] = {{TComplex(0., 0.)}}; //! "integrated" Q-vector
 
+  // memoized generic correlators, see CachedCorrelator(...):
+  struct CorrelatorCacheKeyHash {
+    size_t operator()(const std::array<int, gMaxCorrelator>& key) const
+    {
+      size_t hash = 0;
+      for (const int code : key) {
+        hash = hash * 1000003u ^ static_cast<size_t>(code);
+      }
+      return hash;
+    }
+  };
+  bool fUseCorrelatorCache = true;                                                                        // calculate Test0 correlators with memoized recursion, sharing sub-results among all correlators of all orders
+  bool fValidateCorrelatorCache = false;                                                                  // cross-check e-b-e each memoized correlator against standard Recursion(...)
+  std::unordered_map<std::array<int, gMaxCorrelator>, int, CorrelatorCacheKeyHash> fCorrelatorCacheIndex; //! sorted multiset of encoded (harmonic, weight power) pairs => index in the two vectors below
+  std::vector<std::complex<double>> fCorrelatorCacheValue;                                                //! memoized generic correlators
+  std::vector<unsigned int> fCorrelatorCacheEpoch;                                                        //! value of fCorrelatorCacheCurrentEpoch when the correlator was memoized
+  unsigned int fCorrelatorCacheCurrentEpoch = 1;                                                          //! incremented each time generic Q-vectors qv.fQ are changed, see InvalidateCorrelatorCache()
+
   bool fCalculateqvectorsKineAny = false;                              // by default, it's off. It's set to true automatically if any of kine correlators is requested,
                                                                        // either for Correlations, Test0, EtaSeparations, etc.
   bool fCalculateqvectorsKine[eqvectorKine_N] = {false};               // same as above, just specifically for each enum eqvectorKine + applies only to Correlations and Test0
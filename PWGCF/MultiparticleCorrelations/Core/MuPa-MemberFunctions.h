@@ -517,6 +517,8 @@ void defaultConfiguration()
 
   // *) Q-vectors:
   qv.fCalculateQvectors = cf_qv.cfCalculateQvectors;
+  qv.fUseCorrelatorCache = cf_qv.cfUseCorrelatorCache;
+  qv.fValidateCorrelatorCache = cf_qv.cfValidateCorrelatorCache;
 
   // *) Multiparticle correlations:
   mupa.fCalculateCorrelations = cf_mupa.cfCalculateCorrelations;
@@ -5508,7 +5510,7 @@ void bookQvectorHistograms()
 
   // a) Book the profile holding flags:
   qv.fQvectorFlagsPro =
-    new TProfile("fQvectorFlagsPro", "flags for Q-vector objects", 3, 0., 3.);
+    new TProfile("fQvectorFlagsPro", "flags for Q-vector objects", 5, 0., 5.);
   qv.fQvectorFlagsPro->SetStats(false);
   qv.fQvectorFlagsPro->SetLineColor(eColor);
   qv.fQvectorFlagsPro->SetFillColor(eFillColor);
@@ -5522,6 +5524,10 @@ void bookQvectorHistograms()
     qv.fQvectorFlagsPro->Fill(1.5, gMaxHarmonic);
     qv.fQvectorFlagsPro->GetXaxis()->SetBinLabel(3, "gMaxCorrelator");
     qv.fQvectorFlagsPro->Fill(2.5, gMaxCorrelator);
+    qv.fQvectorFlagsPro->GetXaxis()->SetBinLabel(4, "fUseCorrelatorCache");
+    qv.fQvectorFlagsPro->Fill(3.5, qv.fUseCorrelatorCache);
+    qv.fQvectorFlagsPro->GetXaxis()->SetBinLabel(5, "fValidateCorrelatorCache");
+    qv.fQvectorFlagsPro->Fill(4.5, qv.fValidateCorrelatorCache);
 
     // ...
 
@@ -5538,6 +5544,12 @@ void bookQvectorHistograms()
     yAxisTitle += TString::Format("%d:gMaxCorrelator; ", 3);
     qv.fQvectorFlagsPro->Fill(2.5, static_cast<double>(gMaxCorrelator));
 
+    yAxisTitle += TString::Format("%d:fUseCorrelatorCache; ", 4);
+    qv.fQvectorFlagsPro->Fill(3.5, static_cast<double>(qv.fUseCorrelatorCache));
+
+    yAxisTitle += TString::Format("%d:fValidateCorrelatorCache; ", 5);
+    qv.fQvectorFlagsPro->Fill(4.5, static_cast<double>(qv.fValidateCorrelatorCache));
+
     // ...
 
     // *) Insanity check on the number of fields in this specially crafted y-axis title:
@@ -11824,107 +11836,117 @@ void CalculateTest0()
           delete oa; // yes, otherwise it's a memory leak
         }
 
-        switch (mo + 1) // which order? yes, mo+1
-        {
-          case 1:
-            if (ebye.fSelectedTracks < 1) {
-              return;
-            }
-            correlation = One(n[0]).Re();
-            weight = One(0).Re();
-            break;
+        // Memoized recursion, which shares sub-results among all correlators of all orders:
+        if (qv.fUseCorrelatorCache) {
+          if (ebye.fSelectedTracks < mo + 1) {
+            return;
+          }
+          int zeros[gMaxCorrelator] = {0};
+          correlation = CachedCorrelator(mo + 1, n).Re();
+          weight = CachedCorrelator(mo + 1, zeros).Re();
+        } else {
+          switch (mo + 1) // which order? yes, mo+1
+          {
+            case 1:
+              if (ebye.fSelectedTracks < 1) {
+                return;
+              }
+              correlation = One(n[0]).Re();
+              weight = One(0).Re();
+              break;
 
-          case 2:
-            if (ebye.fSelectedTracks < 2) {
-              return;
-            }
-            correlation = Two(n[0], n[1]).Re();
-            weight = Two(0, 0).Re();
-            break;
+            case 2:
+              if (ebye.fSelectedTracks < 2) {
+                return;
+              }
+              correlation = Two(n[0], n[1]).Re();
+              weight = Two(0, 0).Re();
+              break;
 
-          case 3:
-            if (ebye.fSelectedTracks < 3) {
-              return;
-            }
-            correlation = Three(n[0], n[1], n[2]).Re();
-            weight = Three(0, 0, 0).Re();
-            break;
+            case 3:
+              if (ebye.fSelectedTracks < 3) {
+                return;
+              }
+              correlation = Three(n[0], n[1], n[2]).Re();
+              weight = Three(0, 0, 0).Re();
+              break;
 
-          case 4:
-            if (ebye.fSelectedTracks < 4) {
-              return;
-            }
-            correlation = Four(n[0], n[1], n[2], n[3]).Re();
-            weight = Four(0, 0, 0, 0).Re();
-            break;
+            case 4:
+              if (ebye.fSelectedTracks < 4) {
+                return;
+              }
+              correlation = Four(n[0], n[1], n[2], n[3]).Re();
+              weight = Four(0, 0, 0, 0).Re();
+              break;
 
-          case 5:
-            if (ebye.fSelectedTracks < 5) {
-              return;
-            }
-            correlation = Five(n[0], n[1], n[2], n[3], n[4]).Re();
-            weight = Five(0, 0, 0, 0, 0).Re();
-            break;
+            case 5:
+              if (ebye.fSelectedTracks < 5) {
+                return;
+              }
+              correlation = Five(n[0], n[1], n[2], n[3], n[4]).Re();
+              weight = Five(0, 0, 0, 0, 0).Re();
+              break;
 
-          case 6:
-            if (ebye.fSelectedTracks < 6) {
-              return;
-            }
-            correlation = Six(n[0], n[1], n[2], n[3], n[4], n[5]).Re();
-            weight = Six(0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 6:
+              if (ebye.fSelectedTracks < 6) {
+                return;
+              }
+              correlation = Six(n[0], n[1], n[2], n[3], n[4], n[5]).Re();
+              weight = Six(0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 7:
-            if (ebye.fSelectedTracks < 7) {
-              return;
-            }
-            correlation = Seven(n[0], n[1], n[2], n[3], n[4], n[5], n[6]).Re();
-            weight = Seven(0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 7:
+              if (ebye.fSelectedTracks < 7) {
+                return;
+              }
+              correlation = Seven(n[0], n[1], n[2], n[3], n[4], n[5], n[6]).Re();
+              weight = Seven(0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 8:
-            if (ebye.fSelectedTracks < 8) {
-              return;
-            }
-            correlation = Eight(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]).Re();
-            weight = Eight(0, 0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 8:
+              if (ebye.fSelectedTracks < 8) {
+                return;
+              }
+              correlation = Eight(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]).Re();
+              weight = Eight(0, 0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 9:
-            if (ebye.fSelectedTracks < 9) {
-              return;
-            }
-            correlation = Nine(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8]).Re();
-            weight = Nine(0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 9:
+              if (ebye.fSelectedTracks < 9) {
+                return;
+              }
+              correlation = Nine(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8]).Re();
+              weight = Nine(0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 10:
-            if (ebye.fSelectedTracks < 10) {
-              return;
-            }
-            correlation = Ten(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9]).Re();
-            weight = Ten(0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 10:
+              if (ebye.fSelectedTracks < 10) {
+                return;
+              }
+              correlation = Ten(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9]).Re();
+              weight = Ten(0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 11:
-            if (ebye.fSelectedTracks < 11) {
-              return;
-            }
-            correlation = Eleven(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10]).Re();
-            weight = Eleven(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 11:
+              if (ebye.fSelectedTracks < 11) {
+                return;
+              }
+              correlation = Eleven(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10]).Re();
+              weight = Eleven(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          case 12:
-            if (ebye.fSelectedTracks < 12) {
-              return;
-            }
-            correlation = Twelve(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10], n[11]).Re();
-            weight = Twelve(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-            break;
+            case 12:
+              if (ebye.fSelectedTracks < 12) {
+                return;
+              }
+              correlation = Twelve(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10], n[11]).Re();
+              weight = Twelve(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+              break;
 
-          default:
-            LOGF(fatal, "\033[1;31m%s at line %d : Not supported yet: t0.fTest0Labels[mo][mi]->Data() = %s\033[0m", __FUNCTION__, __LINE__, t0.fTest0Labels[mo][mi]->Data());
-        } // switch(mo+1)
+            default:
+              LOGF(fatal, "\033[1;31m%s at line %d : Not supported yet: t0.fTest0Labels[mo][mi]->Data() = %s\033[0m", __FUNCTION__, __LINE__, t0.fTest0Labels[mo][mi]->Data());
+          } // switch(mo+1)
+        } // if (qv.fUseCorrelatorCache)
 
         // Insanity check on weight:
         if (!(weight > 0.)) {
@@ -12367,6 +12389,7 @@ void CalculateKineTest0Ndim(eqvectorKine kineVarChoice, int Ndim)
         qv.fQ[h][wp] = TComplex(qv.fqvector[kineVarChoice][b][h][wp].real(), qv.fqvector[kineVarChoice][b][h][wp].imag()); // TBI 20250601 check if there is a simpler way to initialize ROOT TComplex with C++ type 'complex'
       }
     }
+    InvalidateCorrelatorCache();
 
     if (tc.fVerbose) { // TBI 20250701 temporary check, remove eventually
       Trace(__FUNCTION__, __LINE__);
@@ -12396,71 +12419,78 @@ void CalculateKineTest0Ndim(eqvectorKine kineVarChoice, int Ndim)
             continue;
           }
 
-          switch (mo + 1) // which order? yes, mo+1
-          {
-            case 1:
-              correlation = One(n[0]).Re();
-              weight = One(0).Re();
-              break;
+          // Memoized recursion, which shares sub-results among all correlators of all orders:
+          if (qv.fUseCorrelatorCache) {
+            int zeros[gMaxCorrelator] = {0};
+            correlation = CachedCorrelator(mo + 1, n).Re();
+            weight = CachedCorrelator(mo + 1, zeros).Re();
+          } else {
+            switch (mo + 1) // which order? yes, mo+1
+            {
+              case 1:
+                correlation = One(n[0]).Re();
+                weight = One(0).Re();
+                break;
 
-            case 2:
-              correlation = Two(n[0], n[1]).Re();
-              weight = Two(0, 0).Re();
-              break;
+              case 2:
+                correlation = Two(n[0], n[1]).Re();
+                weight = Two(0, 0).Re();
+                break;
 
-            case 3:
-              correlation = Three(n[0], n[1], n[2]).Re();
-              weight = Three(0, 0, 0).Re();
-              break;
+              case 3:
+                correlation = Three(n[0], n[1], n[2]).Re();
+                weight = Three(0, 0, 0).Re();
+                break;
 
-            case 4:
-              correlation = Four(n[0], n[1], n[2], n[3]).Re();
-              weight = Four(0, 0, 0, 0).Re();
-              break;
+              case 4:
+                correlation = Four(n[0], n[1], n[2], n[3]).Re();
+                weight = Four(0, 0, 0, 0).Re();
+                break;
 
-            case 5:
-              correlation = Five(n[0], n[1], n[2], n[3], n[4]).Re();
-              weight = Five(0, 0, 0, 0, 0).Re();
-              break;
+              case 5:
+                correlation = Five(n[0], n[1], n[2], n[3], n[4]).Re();
+                weight = Five(0, 0, 0, 0, 0).Re();
+                break;
 
-            case 6:
-              correlation = Six(n[0], n[1], n[2], n[3], n[4], n[5]).Re();
-              weight = Six(0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 6:
+                correlation = Six(n[0], n[1], n[2], n[3], n[4], n[5]).Re();
+                weight = Six(0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 7:
-              correlation = Seven(n[0], n[1], n[2], n[3], n[4], n[5], n[6]).Re();
-              weight = Seven(0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 7:
+                correlation = Seven(n[0], n[1], n[2], n[3], n[4], n[5], n[6]).Re();
+                weight = Seven(0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 8:
-              correlation = Eight(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]).Re();
-              weight = Eight(0, 0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 8:
+                correlation = Eight(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]).Re();
+                weight = Eight(0, 0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 9:
-              correlation = Nine(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8]).Re();
-              weight = Nine(0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 9:
+                correlation = Nine(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8]).Re();
+                weight = Nine(0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 10:
-              correlation = Ten(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9]).Re();
-              weight = Ten(0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 10:
+                correlation = Ten(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9]).Re();
+                weight = Ten(0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 11:
-              correlation = Eleven(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10]).Re();
-              weight = Eleven(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 11:
+                correlation = Eleven(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10]).Re();
+                weight = Eleven(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            case 12:
-              correlation = Twelve(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10], n[11]).Re();
-              weight = Twelve(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
-              break;
+              case 12:
+                correlation = Twelve(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], n[10], n[11]).Re();
+                weight = Twelve(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0).Re();
+                break;
 
-            default:
-              LOGF(fatal, "\033[1;31m%s at line %d : not supported yet: %s \n\n\033[0m", __FUNCTION__, __LINE__, t0.fTest0Labels[mo][mi]->Data());
-          } // switch(mo+1)
+              default:
+                LOGF(fatal, "\033[1;31m%s at line %d : not supported yet: %s \n\n\033[0m", __FUNCTION__, __LINE__, t0.fTest0Labels[mo][mi]->Data());
+            } // switch(mo+1)
+          } // if (qv.fUseCorrelatorCache)
 
           // *) e-b-e sanity check:
           if (nl.fCalculateKineCustomNestedLoops) {
@@ -13676,6 +13706,136 @@ TComplex Recursion(int n, int* harmonic, int mult = 1, int skip = 0)
 
 //============================================================
 
+void InvalidateCorrelatorCache()
+{
+  // Invalidate all memoized generic correlators. Call it whenever generic Q-vectors qv.fQ are changed.
+  // Entries are only flagged as outdated, not deleted, so that the cache does not allocate anything
+  // when the same correlators are requested again in the next event or kine bin.
+
+  qv.fCorrelatorCacheCurrentEpoch++;
+
+} // void InvalidateCorrelatorCache()
+
+//============================================================
+
+std::complex<double> CachedGenericCorrelator(int n, const int* code)
+{
+  // Memoized generic correlator for the multiset of n (harmonic, weight power) pairs, i.e. the sum over
+  // all distinct n-tuples of particles of w1^p1 * ... * wn^pn * exp[i(h1*phi1+...+hn*phin)].
+  // Each pair is encoded as code = (h + gMaxHarmonic * gMaxCorrelator) * (gMaxCorrelator + 1) + p, and the codes are
+  // sorted, so that the same multiset is found in the cache irrespective of the ordering of harmonics.
+  // The last pair x either comes from a particle different from all others, or is merged with one of the remaining pairs y:
+  //   C(S + {x}) = Q(x) * C(S) - sum_{y in S} C(S - {y} + {(h_y + h_x, p_y + p_x)})
+  // All sub-correlators are memoized, therefore they are shared among all requested correlators of all orders.
+
+  const int nPowers = gMaxCorrelator + 1;
+  const int offset = gMaxHarmonic * gMaxCorrelator;
+
+  if (1 == n) {
+    TComplex q = Q(code[0] / nPowers - offset, code[0] % nPowers);
+    return std::complex<double>(q.Re(), q.Im());
+  }
+
+  // *) Look up the cache:
+  std::array<int, gMaxCorrelator> key = {0};
+  std::copy(code, code + n, key.begin());
+  auto it = qv.fCorrelatorCacheIndex.find(key);
+  if (it != qv.fCorrelatorCacheIndex.end() && qv.fCorrelatorCacheEpoch[it->second] == qv.fCorrelatorCacheCurrentEpoch) {
+    return qv.fCorrelatorCacheValue[it->second];
+  }
+
+  // *) Recursion:
+  const int last = code[n - 1];
+  std::complex<double> c = CachedGenericCorrelator(1, code + n - 1) * CachedGenericCorrelator(n - 1, code);
+  int merged[gMaxCorrelator] = {0};
+  for (int k = 0; k < n - 1; k++) {
+    // Identical pairs y give identical terms, so each distinct pair is used only once, with its multiplicity:
+    if (k > 0 && code[k] == code[k - 1]) {
+      continue;
+    }
+    int multiplicity = 1;
+    while (k + multiplicity < n - 1 && code[k + multiplicity] == code[k]) {
+      multiplicity++;
+    }
+    int mergedCode = (code[k] / nPowers + last / nPowers - offset) * nPowers + code[k] % nPowers + last % nPowers;
+    // S - {y} + {y + x}, kept sorted:
+    int m = 0;
+    bool inserted = false;
+    for (int i = 0; i < n - 1; i++) {
+      if (i == k) {
+        continue;
+      }
+      if (!inserted && mergedCode < code[i]) {
+        merged[m++] = mergedCode;
+        inserted = true;
+      }
+      merged[m++] = code[i];
+    }
+    if (!inserted) {
+      merged[m++] = mergedCode;
+    }
+    c -= static_cast<double>(multiplicity) * CachedGenericCorrelator(n - 1, merged);
+  }
+
+  // *) Memoize:
+  if (it == qv.fCorrelatorCacheIndex.end()) {
+    it = qv.fCorrelatorCacheIndex.emplace(key, static_cast<int>(qv.fCorrelatorCacheValue.size())).first;
+    qv.fCorrelatorCacheValue.push_back(c);
+    qv.fCorrelatorCacheEpoch.push_back(qv.fCorrelatorCacheCurrentEpoch);
+  } else {
+    qv.fCorrelatorCacheValue[it->second] = c;
+    qv.fCorrelatorCacheEpoch[it->second] = qv.fCorrelatorCacheCurrentEpoch;
+  }
+
+  return c;
+
+} // std::complex<double> CachedGenericCorrelator(int n, const int* code)
+
+//============================================================
+
+TComplex CachedCorrelator(int n, int* harmonic)
+{
+  // Generic n-particle correlation <exp[i(n1*phi1+...+nn*phin)]>, the same as Recursion(n, harmonic), but with memoized sub-results,
+  // see CachedGenericCorrelator(...). The cache is valid until generic Q-vectors are changed, see InvalidateCorrelatorCache().
+
+  if (n < 1 || n > gMaxCorrelator) {
+    LOGF(fatal, "\033[1;31m%s at line %d : n = %d is not supported\033[0m", __FUNCTION__, __LINE__, n);
+  }
+
+  const int nPowers = gMaxCorrelator + 1;
+  const int offset = gMaxHarmonic * gMaxCorrelator;
+
+  int code[gMaxCorrelator] = {0};
+  for (int i = 0; i < n; i++) {
+    if (std::abs(harmonic[i]) > gMaxHarmonic) {
+      LOGF(fatal, "\033[1;31m%s at line %d : harmonic[%d] = %d is not supported, gMaxHarmonic = %d\033[0m", __FUNCTION__, __LINE__, i, harmonic[i], gMaxHarmonic);
+    }
+    code[i] = (harmonic[i] + offset) * nPowers + 1; // all weight powers are 1 for the correlators themselves
+  }
+  std::sort(code, code + n);
+
+  std::complex<double> c = CachedGenericCorrelator(n, code);
+
+  // e-b-e cross-check against standard recursion:
+  if (qv.fValidateCorrelatorCache) {
+    int lHarmonic[gMaxCorrelator] = {0};
+    std::copy(harmonic, harmonic + n, lHarmonic);
+    TComplex recursion = Recursion(n, lHarmonic);
+    // Correlators are not normalized, so I compare them relative to the sum of weights of all n-tuples, which bounds them from above:
+    int zeroCode[gMaxCorrelator] = {0};
+    std::fill(zeroCode, zeroCode + n, offset * nPowers + 1);
+    double scale = std::abs(CachedGenericCorrelator(n, zeroCode));
+    if (scale > 0. && (std::abs(c.real() - recursion.Re()) > tc.fFloatingPointPrecision * scale || std::abs(c.imag() - recursion.Im()) > tc.fFloatingPointPrecision * scale)) {
+      LOGF(fatal, "\033[1;31m%s at line %d : memoized correlator (%e, %e) is not the same as Recursion(...) = (%e, %e), n = %d, scale = %e\033[0m", __FUNCTION__, __LINE__, c.real(), c.imag(), recursion.Re(), recursion.Im(), n, scale);
+    }
+  }
+
+  return TComplex(c.real(), c.imag());
+
+} // TComplex CachedCorrelator(int n, int* harmonic)
+
+//============================================================
+
 void ResetQ()
 {
   // Reset the components of generic Q-vectors. Use it whenever you call the
@@ -13691,6 +13851,7 @@ void ResetQ()
       qv.fQ[h][wp] = TComplex(0., 0.);
     }
   }
+  InvalidateCorrelatorCache();
 
   if (tc.fVerbose) {
     ExitFunction(__FUNCTION__);
@@ -95,7 +95,10 @@ using TracksRec_QA = TracksRec;    // if I would need additional tables for QA,
 
 #include <Riostream.h>
 
+#include <algorithm>
+#include <array>
 #include <complex>
+#include <unordered_map>
 using namespace std;
 
 // *) Enums:
@@ -0,0 +1,269 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "PWGDQ/Core/AnalysisCompiledCuts.h"
+
+#include "PWGDQ/Core/AnalysisCompositeCut.h"
+
+#include "Framework/Logger.h"
+
+#include <algorithm>
+#include <vector>
+
+//____________________________________________________________________________
+void AnalysisCompiledCuts::CompileCuts(const std::vector<AnalysisCut*>& cuts, int nFuncPoints)
+{
+  //
+  // translate the cut trees into postfix instruction lists
+  //
+  if (static_cast<int>(cuts.size()) > kMaxNCuts) {
+    LOG(fatal) << "AnalysisCompiledCuts::Compile(): Too many cuts (" << cuts.size() << "), at most " << kMaxNCuts << " are supported";
+  }
+  fProgram.clear();
+  fProgramOffsets.clear();
+  fTerms.clear();
+  fFunctions.clear();
+  fStackDepth = 1;
+
+  for (auto const& cut : cuts) {
+    fProgramOffsets.push_back(static_cast<int>(fProgram.size()));
+    int nOperands = EmitOperands(*cut, kAnd, nFuncPoints);
+    if (nOperands > 1) {
+      fProgram.push_back({kAnd, nOperands});
+    }
+  }
+  fProgramOffsets.push_back(static_cast<int>(fProgram.size()));
+
+  // compute the size of the evaluation stack
+  for (size_t icut = 0; icut + 1 < fProgramOffsets.size(); ++icut) {
+    int depth = 0;
+    for (int ins = fProgramOffsets[icut]; ins < fProgramOffsets[icut + 1]; ++ins) {
+      if (fProgram[ins].fOp == kAnd || fProgram[ins].fOp == kOr) {
+        depth -= fProgram[ins].fArg - 1;
+      } else {
+        depth++;
+      }
+      fStackDepth = std::max(fStackDepth, depth);
+    }
+  }
+  fStack.assign(fStackDepth * kBlockSize, 0);
+}
+
+//____________________________________________________________________________
+int AnalysisCompiledCuts::EmitOperands(const AnalysisCut& cut, OpCode parentOp, int nFuncPoints)
+{
+  //
+  // emit the instructions of a cut and return the number of decisions pushed on the stack;
+  //   the operands of a cut using the same boolean operator as its parent are merged into the parent
+  //
+  int nOperands = 0;
+  OpCode op = kAnd;
+  if (cut.IsA() == AnalysisCompositeCut::Class()) {
+    auto const& composite = static_cast<const AnalysisCompositeCut&>(cut);
+    op = (composite.GetUseAND() ? kAnd : kOr);
+    if (composite.GetNCuts() == 0) {
+      fProgram.push_back({(op == kAnd ? kTrue : kFalse), 0});
+      return 1;
+    }
+    for (auto const& subCut : composite.GetCutList()) {
+      nOperands += EmitOperands(subCut, op, nFuncPoints);
+    }
+    for (auto const& subCut : composite.GetCompositeCutList()) {
+      nOperands += EmitOperands(subCut, op, nFuncPoints);
+    }
+  } else {
+    if (cut.GetCuts().empty()) {
+      fProgram.push_back({kTrue, 0});
+      return 1;
+    }
+    for (auto const& cont : cut.GetCuts()) {
+      EmitTerm(cont, nFuncPoints);
+      nOperands++;
+    }
+  }
+
+  if (op == parentOp || nOperands == 1) {
+    return nOperands;
+  }
+  fProgram.push_back({op, nOperands});
+  return 1;
+}
+
+//____________________________________________________________________________
+void AnalysisCompiledCuts::EmitTerm(const AnalysisCut::CutContainer& cont, int nFuncPoints)
+{
+  //
+  // add a cut range and the instruction evaluating it
+  //
+  Term term = {cont.fVar, cont.fLow, cont.fHigh, cont.fExclude,
+               cont.fDepVar, cont.fDepLow, cont.fDepHigh, cont.fDepExclude,
+               cont.fDepVar2, cont.fDep2Low, cont.fDep2High, cont.fDep2Exclude,
+               -1, -1};
+  if (cont.fFuncLow) {
+    term.fFuncLow = AddFunction(cont.fFuncLow, cont, nFuncPoints);
+  }
+  if (cont.fFuncHigh) {
+    term.fFuncHigh = AddFunction(cont.fFuncHigh, cont, nFuncPoints);
+  }
+  fProgram.push_back({kTerm, static_cast<int>(fTerms.size())});
+  fTerms.push_back(term);
+}
+
+//____________________________________________________________________________
+int AnalysisCompiledCuts::AddFunction(TF1* func, const AnalysisCut::CutContainer& cont, int nFuncPoints)
+{
+  //
+  // tabulate a limit function over its range, restricted to the range where the cut is applied
+  //
+  TabulatedFunction table;
+  table.fFunc = func;
+  table.fXmin = func->GetXmin();
+  table.fXmax = func->GetXmax();
+  if (!cont.fDepExclude) {
+    table.fXmin = std::max(table.fXmin, cont.fDepLow);
+    table.fXmax = std::min(table.fXmax, cont.fDepHigh);
+  }
+  table.fInvStep = 0.0;
+  if (nFuncPoints >= 2 && table.fXmax > table.fXmin) {
+    table.fInvStep = (nFuncPoints - 1) / (table.fXmax - table.fXmin);
+    table.fY.resize(nFuncPoints);
+    for (int k = 0; k < nFuncPoints; ++k) {
+      table.fY[k] = func->Eval(table.fXmin + k * (table.fXmax - table.fXmin) / (nFuncPoints - 1));
+    }
+  }
+  fFunctions.push_back(table);
+  return static_cast<int>(fFunctions.size()) - 1;
+}
+
+//____________________________________________________________________________
+void AnalysisCompiledCuts::EvalTerm(const Term& term, const float* values, int stride, int n, uint8_t* decisions) const
+{
+  //
+  // evaluate a cut range for n candidates; a candidate outside the range of the dependent variables passes the cut
+  //
+  const float* x = values + term.fVar * stride;
+  if (term.fFuncLow < 0 && term.fFuncHigh < 0) {
+    const float low = term.fLow;
+    const float high = term.fHigh;
+    const bool exclude = term.fExclude;
+    for (int i = 0; i < n; ++i) {
+      decisions[i] = ((x[i] >= low && x[i] <= high) != exclude);
+    }
+    if (term.fDepVar != -1) {
+      const float* dep = values + term.fDepVar * stride;
+      const float depLow = term.fDepLow;
+      const float depHigh = term.fDepHigh;
+      const bool depExclude = term.fDepExclude;
+      for (int i = 0; i < n; ++i) {
+        decisions[i] |= ((dep[i] > depLow && dep[i] <= depHigh) == depExclude);
+      }
+    }
+    if (term.fDepVar2 != -1) {
+      const float* dep = values + term.fDepVar2 * stride;
+      const float depLow = term.fDep2Low;
+      const float depHigh = term.fDep2High;
+      const bool depExclude = term.fDep2Exclude;
+      for (int i = 0; i < n; ++i) {
+        decisions[i] |= ((dep[i] > depLow && dep[i] <= depHigh) == depExclude);
+      }
+    }
+    return;
+  }
+
+  // function limits, which always come with a dependent variable
+  const float* dep = values + term.fDepVar * stride;
+  const float* dep2 = (term.fDepVar2 != -1 ? values + term.fDepVar2 * stride : nullptr);
+  for (int i = 0; i < n; ++i) {
+    bool applied = ((dep[i] > term.fDepLow && dep[i] <= term.fDepHigh) != term.fDepExclude);
+    if (dep2) {
+      applied = applied && ((dep2[i] > term.fDep2Low && dep2[i] <= term.fDep2High) != term.fDep2Exclude);
+    }
+    if (!applied) {
+      decisions[i] = 1;
+      continue;
+    }
+    float low = (term.fFuncLow >= 0 ? fFunctions[term.fFuncLow].Eval(dep[i]) : term.fLow);
+    float high = (term.fFuncHigh >= 0 ? fFunctions[term.fFuncHigh].Eval(dep[i]) : term.fHigh);
+    decisions[i] = ((x[i] >= low && x[i] <= high) != term.fExclude);
+  }
+}
+
+//____________________________________________________________________________
+uint64_t AnalysisCompiledCuts::IsSelected(const float* values) const
+{
+  //
+  // decisions for a single candidate (a single column of all variables)
+  //
+  uint64_t decision = 0;
+  IsSelected(values, 1, 1, &decision);
+  return decision;
+}
+
+//____________________________________________________________________________
+void AnalysisCompiledCuts::IsSelected(const float* values, int nCandidates, int stride, uint64_t* decisions) const
+{
+  //
+  // decisions for nCandidates candidates; the value of variable "var" for candidate "i" is values[var * stride + i]
+  //
+  for (int first = 0; first < nCandidates; first += kBlockSize) {
+    const int n = std::min(kBlockSize, nCandidates - first);
+    const float* blockValues = values + first;
+    uint64_t* blockDecisions = decisions + first;
+    std::fill(blockDecisions, blockDecisions + n, static_cast<uint64_t>(0));
+
+    for (int icut = 0; icut < GetNCuts(); ++icut) {
+      int top = 0; // number of decisions on the stack
+      for (int ins = fProgramOffsets[icut]; ins < fProgramOffsets[icut + 1]; ++ins) {
+        const Instruction& instruction = fProgram[ins];
+        uint8_t* result = fStack.data() + top * kBlockSize;
+        switch (instruction.fOp) {
+          case kTerm:
+            EvalTerm(fTerms[instruction.fArg], blockValues, stride, n, result);
+            top++;
+            break;
+          case kAnd:
+            top -= instruction.fArg;
+            result = fStack.data() + top * kBlockSize;
+            for (int iop = 1; iop < instruction.fArg; ++iop) {
+              const uint8_t* operand = result + iop * kBlockSize;
+              for (int i = 0; i < n; ++i) {
+                result[i] &= operand[i];
+              }
+            }
+            top++;
+            break;
+          case kOr:
+            top -= instruction.fArg;
+            result = fStack.data() + top * kBlockSize;
+            for (int iop = 1; iop < instruction.fArg; ++iop) {
+              const uint8_t* operand = result + iop * kBlockSize;
+              for (int i = 0; i < n; ++i) {
+                result[i] |= operand[i];
+              }
+            }
+            top++;
+            break;
+          case kTrue:
+            std::fill(result, result + n, 1);
+            top++;
+            break;
+          case kFalse:
+            std::fill(result, result + n, 0);
+            top++;
+            break;
+        }
+      }
+      for (int i = 0; i < n; ++i) {
+        blockDecisions[i] |= (static_cast<uint64_t>(fStack[i]) << icut);
+      }
+    }
+  }
+}
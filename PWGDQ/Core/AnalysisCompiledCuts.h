@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Compiled form of a list of AnalysisCut / AnalysisCompositeCut objects
+//   The cut trees are flattened into a postfix instruction list (nested composite cuts using the same
+//   boolean operator are merged), and the TF1 limits are tabulated on a grid and linearly interpolated.
+//   The decisions of all the cuts are returned as a bit map (bit i for the i-th cut), either for a single
+//   candidate (e.g. VarManager::fgValues) or for many candidates stored column-major, i.e. the value of the
+//   variable "var" for the candidate "i" is values[var * stride + i].
+//   NOTE: Limits given by TF1 functions are interpolated on a grid of nFuncPoints points spanning the function range
+//         (restricted to the dependent variable range, when the cut is applied only inside that range).
+//         Outside the grid, or if nFuncPoints < 2, the function is evaluated exactly.
+//   NOTE: IsSelected uses an evaluation stack owned by the object: an instance must not be used concurrently
+//         from several threads (use one instance per thread).
+//
+
+#ifndef AnalysisCompiledCuts_H
+#define AnalysisCompiledCuts_H
+
+#include "PWGDQ/Core/AnalysisCut.h"
+
+#include <TF1.h>
+
+#include <cstdint>
+#include <vector>
+
+//_________________________________________________________________________
+class AnalysisCompiledCuts
+{
+ public:
+  AnalysisCompiledCuts() = default;
+  ~AnalysisCompiledCuts() = default;
+
+  static constexpr int kMaxNCuts = 64;  // maximum number of cuts, one bit each in the decision map
+  static constexpr int kBlockSize = 64; // number of candidates evaluated together
+
+  // Compile a list of cuts (plain or composite); the cut objects are not needed anymore afterwards, except for the TF1 limits
+  template <typename T>
+  void Compile(const std::vector<T*>& cuts, int nFuncPoints = 1000)
+  {
+    std::vector<AnalysisCut*> cutList(cuts.begin(), cuts.end());
+    CompileCuts(cutList, nFuncPoints);
+  }
+
+  // decisions for a single candidate
+  uint64_t IsSelected(const float* values) const;
+  // decisions for nCandidates candidates stored column-major
+  void IsSelected(const float* values, int nCandidates, int stride, uint64_t* decisions) const;
+
+  int GetNCuts() const { return static_cast<int>(fProgramOffsets.size()) - 1; }
+  int GetNInstructions() const { return static_cast<int>(fProgram.size()); }
+
+ private:
+  enum OpCode : uint8_t {
+    kTerm = 0, // push the decision of a single cut range (fTerms[arg])
+    kAnd,      // pop arg decisions, push their AND
+    kOr,       // pop arg decisions, push their OR
+    kTrue,     // push true (empty AND composite cut, or empty cut)
+    kFalse     // push false (empty OR composite cut)
+  };
+
+  struct Instruction {
+    OpCode fOp;
+    int fArg;
+  };
+
+  // a CutContainer, with the function limits replaced by indices in fFunctions
+  struct Term {
+    int fVar;
+    float fLow;
+    float fHigh;
+    bool fExclude;
+    int fDepVar;
+    float fDepLow;
+    float fDepHigh;
+    bool fDepExclude;
+    int fDepVar2;
+    float fDep2Low;
+    float fDep2High;
+    bool fDep2Exclude;
+    int fFuncLow;  // index of the function for the lower limit, -1 if constant
+    int fFuncHigh; // index of the function for the upper limit, -1 if constant
+  };
+
+  // TF1 tabulated on an equidistant grid
+  struct TabulatedFunction {
+    TF1* fFunc;
+    float fXmin;
+    float fXmax;
+    float fInvStep;
+    std::vector<float> fY;
+
+    float Eval(float x) const
+    {
+      if (fY.size() < 2 || !(x >= fXmin && x <= fXmax)) {
+        return fFunc->Eval(x);
+      }
+      float u = (x - fXmin) * fInvStep;
+      int k = static_cast<int>(u);
+      if (k > static_cast<int>(fY.size()) - 2) {
+        k = static_cast<int>(fY.size()) - 2;
+      }
+      return fY[k] + (u - k) * (fY[k + 1] - fY[k]);
+    }
+  };
+
+  void CompileCuts(const std::vector<AnalysisCut*>& cuts, int nFuncPoints);
+  int EmitOperands(const AnalysisCut& cut, OpCode parentOp, int nFuncPoints);
+  void EmitTerm(const AnalysisCut::CutContainer& cont, int nFuncPoints);
+  int AddFunction(TF1* func, const AnalysisCut::CutContainer& cont, int nFuncPoints);
+  void EvalTerm(const Term& term, const float* values, int stride, int n, uint8_t* decisions) const;
+
+  std::vector<Instruction> fProgram;         // postfix instructions of all the cuts
+  std::vector<int> fProgramOffsets;          // first instruction of each cut (plus the end)
+  std::vector<Term> fTerms;                  // cut ranges
+  std::vector<TabulatedFunction> fFunctions; // tabulated limits
+  int fStackDepth = 0;                       // maximum number of decisions on the evaluation stack
+  mutable std::vector<uint8_t> fStack;       // evaluation stack, kBlockSize decisions per entry (makes IsSelected non-reentrant)
+};
+
+#endif
@@ -42,6 +42,12 @@ HistogramManager::HistogramManager() : TNamed("", ""),
                                        fNVars(0),
                                        fUsedVars(nullptr),
                                        fVariablesMap(),
+                                       fHistClassHandles(),
+                                       fHistClassNames(),
+                                       fFillDescriptors(),
+                                       fFillDescriptorOffsets(),
+                                       fTHnVars(),
+                                       fFillDescriptorsReady(false),
                                        fUseDefaultVariableNames(false),
                                        fBinsAllocated(0),
                                        fVariableNames(nullptr),
@@ -58,6 +64,12 @@ HistogramManager::HistogramManager(const char* name, const char* title, const in
                                                                                               fNVars(maxNVars),
                                                                                               fUsedVars(),
                                                                                               fVariablesMap(),
+                                                                                              fHistClassHandles(),
+                                                                                              fHistClassNames(),
+                                                                                              fFillDescriptors(),
+                                                                                              fFillDescriptorOffsets(),
+                                                                                              fTHnVars(),
+                                                                                              fFillDescriptorsReady(false),
                                                                                               fUseDefaultVariableNames(kFALSE),
                                                                                               fBinsAllocated(0),
                                                                                               fVariableNames(),
@@ -116,6 +128,9 @@ void HistogramManager::AddHistClass(const char* histClass)
   fMainList->Add(hList);
   std::list<std::vector<int>> varList;
   fVariablesMap[histClass] = varList;
+  fHistClassHandles[histClass] = static_cast<int>(fHistClassNames.size());
+  fHistClassNames.push_back(histClass);
+  fFillDescriptorsReady = false;
 }
 
 //_________________________________________________________________
@@ -187,6 +202,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillDescriptorsReady = false;
 
   // create and configure histograms according to required options
   TH1* h = nullptr;
@@ -397,6 +413,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillDescriptorsReady = false;
 
   TH1* h = nullptr;
   switch (dimension) {
@@ -582,6 +599,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillDescriptorsReady = false;
 
   uint32_t nbins = 1;
   THnBase* h = nullptr;
@@ -675,6 +693,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   std::list varList = fVariablesMap[histClass];
   varList.push_back(varVector);
   fVariablesMap[histClass] = varList;
+  fFillDescriptorsReady = false;
 
   // get the min and max for each axis
   auto* xmin = new double[nDimensions];
@@ -741,155 +760,185 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
 }
 
 //__________________________________________________________________
-void HistogramManager::FillHistClass(const char* className, Float_t* values)
+int HistogramManager::GetHistClassHandle(const char* className) const
 {
   //
-  //  fill a class of histograms
+  // get the handle of a histogram class
   //
-
-  // get the needed histogram list
-  auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className));
-  if (!hList) {
-    // TODO: add some meaningfull error message
-    /*LOG(warn) << "HistogramManager::FillHistClass(): Histogram list " << className << " not found!";
-    LOG(warn) << "         Histogram list not filled" << endl; */
-    return;
+  auto it = fHistClassHandles.find(className);
+  if (it == fHistClassHandles.end()) {
+    return kNothing;
   }
+  return it->second;
+}
 
-  // get the corresponding std::list containng identifiers to the needed variables to be filled
-  auto const& varList = fVariablesMap[className];
-
-  TIter next(hList);
-
-  TObject* h = nullptr;
-  bool isProfile;
-  bool isTHn;
-  int dimension = 0;
-  bool isSparse = kFALSE;
-  bool isFillLabelx = kFALSE;
-  // TODO: At the moment, maximum 20 dimensions are foreseen for the THn histograms. We should make this more dynamic
-  //       But maybe its better to have it like to avoid dynamically allocating this array in the histogram loop
-  double fillValues[20] = {0.0};
-  int varX = -1, varY = -1, varZ = -1, varT = -1, varW = -1;
-
-  // loop over the histogram and std::list
-  // NOTE: these two should contain the same number of elements and be synchronized, otherwise its a mess
-  for (auto varIter = varList.begin(); varIter != varList.end(); varIter++) {
-    h = next(); // get the histogram
-    // decode information from the vector of indices
-    isProfile = ((*varIter)[0] == 1 ? true : false);
-    isTHn = ((*varIter)[1] > 0 ? true : false);
-    if (isTHn) {
-      dimension = (*varIter)[1];
-    } else {
-      dimension = (reinterpret_cast<TH1*>(h))->GetDimension();
-    }
-
-    // get the various variable indices
-    varW = (*varIter)[2];
-    if (isTHn) {
-      for (int i = 0; i < dimension; i++) {
-        fillValues[i] = values[(*varIter)[3 + i]];
-      }
-    } else {
-      varX = (*varIter)[3];
-      varY = (*varIter)[4];
-      varZ = (*varIter)[5];
-      varT = (*varIter)[6];
-      isFillLabelx = ((*varIter)[7] == 1 ? true : false);
+//__________________________________________________________________
+void HistogramManager::BuildFillDescriptors()
+{
+  //
+  // translate the histogram lists and the variable identifiers into a flat array of fill descriptors
+  //
+  fFillDescriptors.clear();
+  fFillDescriptorOffsets.clear();
+  fTHnVars.clear();
+  for (auto const& className : fHistClassNames) {
+    fFillDescriptorOffsets.push_back(static_cast<int>(fFillDescriptors.size()));
+    auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className.c_str()));
+    if (!hList) {
+      continue;
     }
-
-    if (!isTHn) {
-      switch (dimension) {
+    // NOTE: the histogram list and the std::list of variable identifiers are synchronized
+    TIter next(hList);
+    for (auto const& varVector : fVariablesMap[className]) {
+      TObject* h = next();
+      if (!h) {
+        break;
+      }
+      FillDescriptor desc{h, kFillTH1, kNothing, kNothing, kNothing, kNothing, varVector[2], 0, 0};
+      if (varVector[1] > 0) {
+        desc.kind = kFillTHn;
+        desc.nDim = varVector[1];
+        desc.varsOffset = static_cast<int>(fTHnVars.size());
+        fTHnVars.insert(fTHnVars.end(), varVector.begin() + 3, varVector.begin() + 3 + desc.nDim);
+        fFillDescriptors.push_back(desc);
+        continue;
+      }
+      bool isProfile = (varVector[0] == 1);
+      bool isFillLabelx = (varVector[7] == 1);
+      desc.varX = varVector[3];
+      desc.varY = varVector[4];
+      desc.varZ = varVector[5];
+      desc.varT = varVector[6];
+      switch ((static_cast<TH1*>(h))->GetDimension()) {
         case 1:
           if (isProfile) {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TProfile*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], values[varW]);
-              } else {
-                (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TProfile*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY]);
-              } else {
-                (reinterpret_cast<TProfile*>(h))->Fill(values[varX], values[varY]);
-              }
-            }
+            desc.kind = (isFillLabelx ? kFillProfileLabel : kFillProfile);
           } else {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH1*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varW]);
-              } else {
-                (reinterpret_cast<TH1*>(h))->Fill(values[varX], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH1*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), 1.);
-              } else {
-                (reinterpret_cast<TH1*>(h))->Fill(values[varX]);
-              }
-            }
+            desc.kind = (isFillLabelx ? kFillTH1Label : kFillTH1);
           }
           break;
         case 2:
           if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile2D*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
+            desc.kind = kFillProfile2D;
           } else {
-            if (varW > kNothing) {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH2*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], values[varW]);
-              } else {
-                (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY], values[varW]);
-              }
-            } else {
-              if (isFillLabelx) {
-                (reinterpret_cast<TH2*>(h))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], 1.);
-              } else {
-                (reinterpret_cast<TH2*>(h))->Fill(values[varX], values[varY]);
-              }
-            }
+            desc.kind = (isFillLabelx ? kFillTH2Label : kFillTH2);
           }
           break;
         case 3:
-          if (isProfile) {
-            if (varW > kNothing) {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT], values[varW]);
-            } else {
-              (reinterpret_cast<TProfile3D*>(h))->Fill(values[varX], values[varY], values[varZ], values[varT]);
-            }
-          } else {
-            if (varW > kNothing) {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ], values[varW]);
-            } else {
-              (reinterpret_cast<TH3*>(h))->Fill(values[varX], values[varY], values[varZ]);
-            }
-          }
+          desc.kind = (isProfile ? kFillProfile3D : kFillTH3);
           break;
-
         default:
-          break;
-      } // end switch
-      // end if(!isTHn)
-    } else {
-      if (varW > kNothing) {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues, values[varW]);
+          continue;
+      }
+      fFillDescriptors.push_back(desc);
+    }
+  }
+  fFillDescriptorOffsets.push_back(static_cast<int>(fFillDescriptors.size()));
+  fFillDescriptorsReady = true;
+}
+
+//__________________________________________________________________
+void HistogramManager::FillHistClass(const char* className, Float_t* values)
+{
+  //
+  //  fill a class of histograms
+  //
+  FillHistClass(GetHistClassHandle(className), values);
+}
+
+//__________________________________________________________________
+void HistogramManager::FillHistClass(int handle, Float_t* values)
+{
+  //
+  //  fill a class of histograms using its handle
+  //
+  if (handle < 0 || handle >= static_cast<int>(fHistClassNames.size())) {
+    return;
+  }
+  if (!fFillDescriptorsReady) {
+    BuildFillDescriptors();
+  }
+
+  // TODO: At the moment, maximum 20 dimensions are foreseen for the THn histograms. We should make this more dynamic
+  //       But maybe its better to have it like to avoid dynamically allocating this array in the histogram loop
+  double fillValues[20] = {0.0};
+
+  const FillDescriptor* first = fFillDescriptors.data() + fFillDescriptorOffsets[handle];
+  const FillDescriptor* last = fFillDescriptors.data() + fFillDescriptorOffsets[handle + 1];
+  for (const FillDescriptor* desc = first; desc != last; ++desc) {
+    const int varX = desc->varX, varY = desc->varY, varZ = desc->varZ, varT = desc->varT, varW = desc->varW;
+    switch (desc->kind) {
+      case kFillTH1:
+        if (varW > kNothing) {
+          (static_cast<TH1*>(desc->hist))->Fill(values[varX], values[varW]);
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues, values[varW]);
+          (static_cast<TH1*>(desc->hist))->Fill(values[varX]);
         }
-      } else {
-        if (isSparse) {
-          (reinterpret_cast<THnSparse*>(h))->Fill(fillValues);
+        break;
+      case kFillTH1Label:
+        (static_cast<TH1*>(desc->hist))->Fill(Form("%d", static_cast<int>(values[varX])), (varW > kNothing ? values[varW] : 1.));
+        break;
+      case kFillProfile:
+        if (varW > kNothing) {
+          (static_cast<TProfile*>(desc->hist))->Fill(values[varX], values[varY], values[varW]);
+        } else {
+          (static_cast<TProfile*>(desc->hist))->Fill(values[varX], values[varY]);
+        }
+        break;
+      case kFillProfileLabel:
+        if (varW > kNothing) {
+          (static_cast<TProfile*>(desc->hist))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], values[varW]);
+        } else {
+          (static_cast<TProfile*>(desc->hist))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY]);
+        }
+        break;
+      case kFillTH2:
+        if (varW > kNothing) {
+          (static_cast<TH2*>(desc->hist))->Fill(values[varX], values[varY], values[varW]);
+        } else {
+          (static_cast<TH2*>(desc->hist))->Fill(values[varX], values[varY]);
+        }
+        break;
+      case kFillTH2Label:
+        (static_cast<TH2*>(desc->hist))->Fill(Form("%d", static_cast<int>(values[varX])), values[varY], (varW > kNothing ? values[varW] : 1.));
+        break;
+      case kFillProfile2D:
+        if (varW > kNothing) {
+          (static_cast<TProfile2D*>(desc->hist))->Fill(values[varX], values[varY], values[varZ], values[varW]);
+        } else {
+          (static_cast<TProfile2D*>(desc->hist))->Fill(values[varX], values[varY], values[varZ]);
+        }
+        break;
+      case kFillTH3:
+        if (varW > kNothing) {
+          (static_cast<TH3*>(desc->hist))->Fill(values[varX], values[varY], values[varZ], values[varW]);
+        } else {
+          (static_cast<TH3*>(desc->hist))->Fill(values[varX], values[varY], values[varZ]);
+        }
+        break;
+      case kFillProfile3D:
+        if (varW > kNothing) {
+          (static_cast<TProfile3D*>(desc->hist))->Fill(values[varX], values[varY], values[varZ], values[varT], values[varW]);
+        } else {
+          (static_cast<TProfile3D*>(desc->hist))->Fill(values[varX], values[varY], values[varZ], values[varT]);
+        }
+        break;
+      case kFillTHn: {
+        const int* vars = fTHnVars.data() + desc->varsOffset;
+        for (int i = 0; i < desc->nDim; i++) {
+          fillValues[i] = values[vars[i]];
+        }
+        // THnBase::Fill serves both the THn and the THnSparse histograms
+        if (varW > kNothing) {
+          (static_cast<THnBase*>(desc->hist))->Fill(fillValues, values[varW]);
         } else {
-          (reinterpret_cast<THn*>(h))->Fill(fillValues);
+          (static_cast<THnBase*>(desc->hist))->Fill(fillValues);
         }
+        break;
       }
-    } // end else
+      default:
+        break;
+    } // end switch
   } // end loop over histograms
 }
 
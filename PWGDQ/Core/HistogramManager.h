@@ -24,6 +24,7 @@
 #include <TAxis.h>
 #include <TArrayD.h>
 
+#include <functional>
 #include <string>
 #include <map>
 #include <vector>
@@ -47,6 +48,7 @@ class HistogramManager : public TNamed
       delete fMainList;
     }
     fMainList = list;
+    fFillDescriptorsReady = false;
   }
 
   // Create a new histogram class
@@ -84,7 +86,12 @@ class HistogramManager : public TNamed
                     int nDimensions, int* vars, TArrayD* binLimits,
                     TString* axLabels = nullptr, int varW = -1, bool useSparse = kFALSE, bool isdouble = false);
 
+  // Get the handle of a histogram class, to be used in the FillHistClass(int, float*) function; -1 if the class does not exist
+  // The handles stay valid when more classes or histograms are added
+  int GetHistClassHandle(const char* className) const;
   void FillHistClass(const char* className, float* values);
+  // Fill a class of histograms using its handle, without any string lookup
+  void FillHistClass(int handle, float* values);
 
   void SetUseDefaultVariableNames(bool flag) { fUseDefaultVariableNames = flag; }
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -99,8 +106,40 @@ class HistogramManager : public TNamed
   THashList* fMainList; // master histogram list
   int fNVars;           // number of variables handled (tipically from the Variable Manager)
 
+  // kinds of histogram fill, resolved once from the histogram type and the fill options
+  enum FillKind {
+    kFillTH1 = 0,
+    kFillTH1Label,
+    kFillProfile,
+    kFillProfileLabel,
+    kFillTH2,
+    kFillTH2Label,
+    kFillProfile2D,
+    kFillTH3,
+    kFillProfile3D,
+    kFillTHn
+  };
+  // all the information needed to fill one histogram
+  struct FillDescriptor {
+    TObject* hist;  // histogram
+    int kind;       // FillKind
+    int varX;       // variable on the x axis
+    int varY;       // variable on the y axis
+    int varZ;       // variable on the z axis
+    int varT;       // variable used for profiling in case of TProfile3D
+    int varW;       // variable used for weighting
+    int nDim;       // number of dimensions of a THn
+    int varsOffset; // first axis variable of a THn in fTHnVars
+  };
+
   bool* fUsedVars;                                                  //! flags of used variables
   std::map<std::string, std::list<std::vector<int>>> fVariablesMap; //!  map holding identifiers for all variables needed by histograms
+  std::map<std::string, int, std::less<>> fHistClassHandles;        //! handle of each histogram class
+  std::vector<std::string> fHistClassNames;                         //! histogram class names, indexed by handle
+  std::vector<FillDescriptor> fFillDescriptors;                     //! fill descriptors of all histograms, grouped by class
+  std::vector<int> fFillDescriptorOffsets;                          //! first fill descriptor of each class, indexed by handle (plus the end)
+  std::vector<int> fTHnVars;                                        //! axis variables of the THn histograms
+  bool fFillDescriptorsReady;                                       //! whether the fill descriptors are up to date with the histogram definitions
 
   // various
   bool fUseDefaultVariableNames;    //! toggle the usage of default variable names and units
@@ -109,6 +148,7 @@ class HistogramManager : public TNamed
   TString* fVariableUnits;          //! variable units
 
   void MakeAxisLabels(TAxis* ax, const char* labels);
+  void BuildFillDescriptors();
 
   HistogramManager& operator=(const HistogramManager& c);
   HistogramManager(const HistogramManager& c);
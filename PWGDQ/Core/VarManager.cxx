@@ -27,30 +27,9 @@ TString VarManager::fgVariableNames[VarManager::kNVars] = {""};
 TString VarManager::fgVariableUnits[VarManager::kNVars] = {""};
 std::map<TString, int> VarManager::fgVarNamesMap;
 bool VarManager::fgUsedVars[VarManager::kNVars] = {false};
-bool VarManager::fgUsedKF = false;
-float VarManager::fgMagField = 0.5;
-float VarManager::fgzMatching = -77.5;
-float VarManager::fgzShiftFwd = 0.0;
 float VarManager::fgValues[VarManager::kNVars] = {0.0f};
-float VarManager::fgTPCInterSectorBoundary = 1.0; // cm
-int VarManager::fgITSROFbias = 0;
-int VarManager::fgITSROFlength = 100;
-int VarManager::fgITSROFBorderMarginLow = 0;
-int VarManager::fgITSROFBorderMarginHigh = 0;
-uint64_t VarManager::fgSOR = 0;
-uint64_t VarManager::fgEOR = 0;
-ROOT::Math::PxPyPzEVector VarManager::fgBeamA(0, 0, 6799.99, 6800);  // GeV, beam from A-side 4-momentum vector
-ROOT::Math::PxPyPzEVector VarManager::fgBeamC(0, 0, -6799.99, 6800); // GeV, beam from C-side 4-momentum vector
-o2::vertexing::DCAFitterN<2> VarManager::fgFitterTwoProngBarrel;
-o2::vertexing::DCAFitterN<3> VarManager::fgFitterThreeProngBarrel;
-o2::vertexing::DCAFitterN<4> VarManager::fgFitterFourProngBarrel;
-o2::vertexing::FwdDCAFitterN<2> VarManager::fgFitterTwoProngFwd;
-o2::vertexing::FwdDCAFitterN<3> VarManager::fgFitterThreeProngFwd;
-o2::globaltracking::MatchGlobalFwd VarManager::mMatching;
-std::map<VarManager::CalibObjects, TObject*> VarManager::fgCalibs;
-bool VarManager::fgRunTPCPostCalibration[4] = {false, false, false, false};
-int VarManager::fgCalibrationType = 0;                // 0 - no calibration, 1 - calibration vs (TPCncls,pIN,eta) typically for pp, 2 - calibration vs (eta,nPV,nLong,tLong) typically for PbPb
-bool VarManager::fgUseInterpolatedCalibration = true; // use interpolated calibration histograms (default: true)
+VarManager::Context VarManager::fgDefaultContext(VarManager::fgValues);
+thread_local VarManager::Context* VarManager::fgContext = &VarManager::fgDefaultContext;
 
 //__________________________________________________________________
 VarManager::VarManager() : TObject()
@@ -107,7 +86,7 @@ void VarManager::ResetValues(int startValue, int endValue, float* values)
   // reset all variables to an "innocent" value
   // NOTE: here we use -9999.0 as a neutral value, but depending on situation, this may not be the case
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   for (Int_t i = startValue; i < endValue; ++i) {
     values[i] = -9999.;
@@ -172,8 +151,8 @@ void VarManager::SetCollisionSystem(TString system, float energy)
   float beamCEnergy = energy / 2.0 * sqrt(NumberOfProtonsC * NumberOfProtonsA / NumberOfProtonsA / NumberOfProtonsC); // GeV
   float beamAMomentum = std::sqrt(beamAEnergy * beamAEnergy - NumberOfNucleonsA * NumberOfNucleonsA * MassProton * MassProton);
   float beamCMomentum = std::sqrt(beamCEnergy * beamCEnergy - NumberOfNucleonsC * NumberOfNucleonsC * MassProton * MassProton);
-  fgBeamA.SetPxPyPzE(0, 0, beamAMomentum, beamAEnergy);
-  fgBeamC.SetPxPyPzE(0, 0, -beamCMomentum, beamCEnergy);
+  fgContext->fBeamA.SetPxPyPzE(0, 0, beamAMomentum, beamAEnergy);
+  fgContext->fBeamC.SetPxPyPzE(0, 0, -beamCMomentum, beamCEnergy);
 }
 
 //__________________________________________________________________
@@ -187,8 +166,8 @@ void VarManager::SetCollisionSystem(o2::parameters::GRPLHCIFData* grplhcif)
   double beamCNucleons = grplhcif->getBeamA(o2::constants::lhc::BeamDirection::BeamC);
   double beamAMomentum = std::sqrt(beamAEnergy * beamAEnergy - beamANucleons * beamANucleons * MassProton * MassProton);
   double beamCMomentum = std::sqrt(beamCEnergy * beamCEnergy - beamCNucleons * beamCNucleons * MassProton * MassProton);
-  fgBeamA.SetPxPyPzE(0, 0, beamAMomentum, beamAEnergy);
-  fgBeamC.SetPxPyPzE(0, 0, -beamCMomentum, beamCEnergy);
+  fgContext->fBeamA.SetPxPyPzE(0, 0, beamAMomentum, beamAEnergy);
+  fgContext->fBeamC.SetPxPyPzE(0, 0, -beamCMomentum, beamCEnergy);
 }
 
 //__________________________________________________________________
@@ -222,7 +201,7 @@ double VarManager::ComputePIDcalibration(int species, double nSigmaValue)
   // species: 0 - electron, 1 - pion, 2 - kaon, 3 - proton
   // Depending on the PID calibration type, we use different types of calibration histograms
 
-  if (fgCalibrationType == 1) {
+  if (fgContext->fCalibrationType == 1) {
     // get the calibration histograms
     CalibObjects calibMean, calibSigma;
     switch (species) {
@@ -247,28 +226,28 @@ double VarManager::ComputePIDcalibration(int species, double nSigmaValue)
         return -999.0; // Return zero if species is invalid
     }
 
-    TH3F* calibMeanHist = reinterpret_cast<TH3F*>(fgCalibs[calibMean]);
-    TH3F* calibSigmaHist = reinterpret_cast<TH3F*>(fgCalibs[calibSigma]);
+    TH3F* calibMeanHist = reinterpret_cast<TH3F*>(fgContext->fCalibs[calibMean]);
+    TH3F* calibSigmaHist = reinterpret_cast<TH3F*>(fgContext->fCalibs[calibSigma]);
     if (!calibMeanHist || !calibSigmaHist) {
       LOG(fatal) << "Calibration histograms not found for species: " << species;
       return -999.0; // Return zero if histograms are not found
     }
 
     // Get the bin indices for the calibration histograms
-    int binTPCncls = calibMeanHist->GetXaxis()->FindBin(fgValues[kTPCncls]);
+    int binTPCncls = calibMeanHist->GetXaxis()->FindBin(fgContext->fValues[kTPCncls]);
     binTPCncls = (binTPCncls == 0 ? 1 : binTPCncls);
     binTPCncls = (binTPCncls > calibMeanHist->GetXaxis()->GetNbins() ? calibMeanHist->GetXaxis()->GetNbins() : binTPCncls);
-    int binPin = calibMeanHist->GetYaxis()->FindBin(fgValues[kPin]);
+    int binPin = calibMeanHist->GetYaxis()->FindBin(fgContext->fValues[kPin]);
     binPin = (binPin == 0 ? 1 : binPin);
     binPin = (binPin > calibMeanHist->GetYaxis()->GetNbins() ? calibMeanHist->GetYaxis()->GetNbins() : binPin);
-    int binEta = calibMeanHist->GetZaxis()->FindBin(fgValues[kEta]);
+    int binEta = calibMeanHist->GetZaxis()->FindBin(fgContext->fValues[kEta]);
     binEta = (binEta == 0 ? 1 : binEta);
     binEta = (binEta > calibMeanHist->GetZaxis()->GetNbins() ? calibMeanHist->GetZaxis()->GetNbins() : binEta);
 
     double mean = calibMeanHist->GetBinContent(binTPCncls, binPin, binEta);
     double sigma = calibSigmaHist->GetBinContent(binTPCncls, binPin, binEta);
     return (nSigmaValue - mean) / sigma; // Return the calibrated nSigma value
-  } else if (fgCalibrationType == 2) {
+  } else if (fgContext->fCalibrationType == 2) {
     // get the calibration histograms
     CalibObjects calibMean, calibSigma, calibStatus;
     switch (species) {
@@ -297,25 +276,25 @@ double VarManager::ComputePIDcalibration(int species, double nSigmaValue)
         return -999.0; // Return zero if species is invalid
     }
 
-    THnF* calibMeanHist = reinterpret_cast<THnF*>(fgCalibs[calibMean]);
-    THnF* calibSigmaHist = reinterpret_cast<THnF*>(fgCalibs[calibSigma]);
-    THnF* calibStatusHist = reinterpret_cast<THnF*>(fgCalibs[calibStatus]);
+    THnF* calibMeanHist = reinterpret_cast<THnF*>(fgContext->fCalibs[calibMean]);
+    THnF* calibSigmaHist = reinterpret_cast<THnF*>(fgContext->fCalibs[calibSigma]);
+    THnF* calibStatusHist = reinterpret_cast<THnF*>(fgContext->fCalibs[calibStatus]);
     if (!calibMeanHist || !calibSigmaHist || !calibStatusHist) {
       LOG(fatal) << "Calibration histograms not found for species: " << species;
       return -999.0; // Return zero if histograms are not found
     }
 
     // Get the bin indices for the calibration histograms
-    int binEta = calibMeanHist->GetAxis(0)->FindBin(fgValues[kEta]);
+    int binEta = calibMeanHist->GetAxis(0)->FindBin(fgContext->fValues[kEta]);
     binEta = (binEta == 0 ? 1 : binEta);
     binEta = (binEta > calibMeanHist->GetAxis(0)->GetNbins() ? calibMeanHist->GetAxis(0)->GetNbins() : binEta);
-    int binNpv = calibMeanHist->GetAxis(1)->FindBin(fgValues[kVtxNcontribReal]);
+    int binNpv = calibMeanHist->GetAxis(1)->FindBin(fgContext->fValues[kVtxNcontribReal]);
     binNpv = (binNpv == 0 ? 1 : binNpv);
     binNpv = (binNpv > calibMeanHist->GetAxis(1)->GetNbins() ? calibMeanHist->GetAxis(1)->GetNbins() : binNpv);
-    int binNlong = calibMeanHist->GetAxis(2)->FindBin(fgValues[kNTPCcontribLongA]);
+    int binNlong = calibMeanHist->GetAxis(2)->FindBin(fgContext->fValues[kNTPCcontribLongA]);
     binNlong = (binNlong == 0 ? 1 : binNlong);
     binNlong = (binNlong > calibMeanHist->GetAxis(2)->GetNbins() ? calibMeanHist->GetAxis(2)->GetNbins() : binNlong);
-    int binTlong = calibMeanHist->GetAxis(3)->FindBin(fgValues[kNTPCmedianTimeLongA]);
+    int binTlong = calibMeanHist->GetAxis(3)->FindBin(fgContext->fValues[kNTPCmedianTimeLongA]);
     binTlong = (binTlong == 0 ? 1 : binTlong);
     binTlong = (binTlong > calibMeanHist->GetAxis(3)->GetNbins() ? calibMeanHist->GetAxis(3)->GetNbins() : binTlong);
 
@@ -335,7 +314,7 @@ double VarManager::ComputePIDcalibration(int species, double nSigmaValue)
       case 2: // calibration constant has poor stat uncertainty, consider the user option for what to do
       case 3:
         // calibration constants have been interpolated
-        if (fgUseInterpolatedCalibration) {
+        if (fgContext->fUseInterpolatedCalibration) {
           return (nSigmaValue - mean) / sigma;
         } else {
           // return the original nSigma value
@@ -352,7 +331,7 @@ double VarManager::ComputePIDcalibration(int species, double nSigmaValue)
     }
   } else {
     // unknown calibration type, return the original nSigma value
-    LOG(fatal) << "Unknown calibration type: " << fgCalibrationType;
+    LOG(fatal) << "Unknown calibration type: " << fgContext->fCalibrationType;
     return nSigmaValue; // Return the original nSigma value
   }
 }
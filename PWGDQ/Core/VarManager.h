@@ -1039,31 +1039,31 @@ class VarManager : public TObject
 
   static void SetMagneticField(float magField)
   {
-    fgMagField = magField;
+    fgContext->fMagField = magField;
   }
 
   // Setup plane position for MFT-MCH matching
   static void SetMatchingPlane(float z)
   {
-    fgzMatching = z;
+    fgContext->fzMatching = z;
   }
 
   static float GetMatchingPlane()
   {
-    return fgzMatching;
+    return fgContext->fzMatching;
   }
 
   // Set z shift for forward tracks
   static void SetZShift(float z)
   {
-    fgzShiftFwd = z;
+    fgContext->fzShiftFwd = z;
   }
 
   // Setup the 2 prong KFParticle
   static void SetupTwoProngKFParticle(float magField)
   {
     KFParticle::SetField(magField);
-    fgUsedKF = true;
+    fgContext->fUsedKF = true;
   }
   // Setup magnetic field for muon propagation
   static void SetupMuonMagField()
@@ -1074,79 +1074,79 @@ class VarManager : public TObject
   // Setup the 2 prong DCAFitterN
   static void SetupTwoProngDCAFitter(float magField, bool propagateToPCA, float maxR, float maxDZIni, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterTwoProngBarrel.setBz(magField);
-    fgFitterTwoProngBarrel.setPropagateToPCA(propagateToPCA);
-    fgFitterTwoProngBarrel.setMaxR(maxR);
-    fgFitterTwoProngBarrel.setMaxDZIni(maxDZIni);
-    fgFitterTwoProngBarrel.setMinParamChange(minParamChange);
-    fgFitterTwoProngBarrel.setMinRelChi2Change(minRelChi2Change);
-    fgFitterTwoProngBarrel.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    fgContext->fFitterTwoProngBarrel.setBz(magField);
+    fgContext->fFitterTwoProngBarrel.setPropagateToPCA(propagateToPCA);
+    fgContext->fFitterTwoProngBarrel.setMaxR(maxR);
+    fgContext->fFitterTwoProngBarrel.setMaxDZIni(maxDZIni);
+    fgContext->fFitterTwoProngBarrel.setMinParamChange(minParamChange);
+    fgContext->fFitterTwoProngBarrel.setMinRelChi2Change(minRelChi2Change);
+    fgContext->fFitterTwoProngBarrel.setUseAbsDCA(useAbsDCA);
+    fgContext->fUsedKF = false;
   }
 
   // Setup the 2 prong FwdDCAFitterN
   static void SetupTwoProngFwdDCAFitter(float magField, bool propagateToPCA, float maxR, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterTwoProngFwd.setBz(magField);
-    fgFitterTwoProngFwd.setPropagateToPCA(propagateToPCA);
-    fgFitterTwoProngFwd.setMaxR(maxR);
-    fgFitterTwoProngFwd.setMinParamChange(minParamChange);
-    fgFitterTwoProngFwd.setMinRelChi2Change(minRelChi2Change);
-    fgFitterTwoProngFwd.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    fgContext->fFitterTwoProngFwd.setBz(magField);
+    fgContext->fFitterTwoProngFwd.setPropagateToPCA(propagateToPCA);
+    fgContext->fFitterTwoProngFwd.setMaxR(maxR);
+    fgContext->fFitterTwoProngFwd.setMinParamChange(minParamChange);
+    fgContext->fFitterTwoProngFwd.setMinRelChi2Change(minRelChi2Change);
+    fgContext->fFitterTwoProngFwd.setUseAbsDCA(useAbsDCA);
+    fgContext->fUsedKF = false;
   }
   // Use MatLayerCylSet to correct MCS in fwdtrack propagation
   static void SetupMatLUTFwdDCAFitter(o2::base::MatLayerCylSet* m)
   {
-    fgFitterTwoProngFwd.setTGeoMat(false);
-    fgFitterTwoProngFwd.setMatLUT(m);
+    fgContext->fFitterTwoProngFwd.setTGeoMat(false);
+    fgContext->fFitterTwoProngFwd.setMatLUT(m);
   }
   // Use GeometryManager to correct MCS in fwdtrack propagation
   static void SetupTGeoFwdDCAFitter()
   {
-    fgFitterTwoProngFwd.setTGeoMat(true);
+    fgContext->fFitterTwoProngFwd.setTGeoMat(true);
   }
   // No material budget in fwdtrack propagation
   static void SetupFwdDCAFitterNoCorr()
   {
-    fgFitterTwoProngFwd.setTGeoMat(false);
+    fgContext->fFitterTwoProngFwd.setTGeoMat(false);
   }
   // Setup the 3 prong KFParticle
   static void SetupThreeProngKFParticle(float magField)
   {
     KFParticle::SetField(magField);
-    fgUsedKF = true;
+    fgContext->fUsedKF = true;
   }
 
   // Setup the 3 prong DCAFitterN
   static void SetupThreeProngDCAFitter(float magField, bool propagateToPCA, float maxR, float /*maxDZIni*/, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterThreeProngBarrel.setBz(magField);
-    fgFitterThreeProngBarrel.setPropagateToPCA(propagateToPCA);
-    fgFitterThreeProngBarrel.setMaxR(maxR);
-    fgFitterThreeProngBarrel.setMinParamChange(minParamChange);
-    fgFitterThreeProngBarrel.setMinRelChi2Change(minRelChi2Change);
-    fgFitterThreeProngBarrel.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    fgContext->fFitterThreeProngBarrel.setBz(magField);
+    fgContext->fFitterThreeProngBarrel.setPropagateToPCA(propagateToPCA);
+    fgContext->fFitterThreeProngBarrel.setMaxR(maxR);
+    fgContext->fFitterThreeProngBarrel.setMinParamChange(minParamChange);
+    fgContext->fFitterThreeProngBarrel.setMinRelChi2Change(minRelChi2Change);
+    fgContext->fFitterThreeProngBarrel.setUseAbsDCA(useAbsDCA);
+    fgContext->fUsedKF = false;
   }
 
   // Setup the 4 prong KFParticle
   static void SetupFourProngKFParticle(float magField)
   {
     KFParticle::SetField(magField);
-    fgUsedKF = true;
+    fgContext->fUsedKF = true;
   }
 
   // Setup the 4 prong DCAFitterN
   static void SetupFourProngDCAFitter(float magField, bool propagateToPCA, float maxR, float /*maxDZIni*/, float minParamChange, float minRelChi2Change, bool useAbsDCA)
   {
-    fgFitterFourProngBarrel.setBz(magField);
-    fgFitterFourProngBarrel.setPropagateToPCA(propagateToPCA);
-    fgFitterFourProngBarrel.setMaxR(maxR);
-    fgFitterFourProngBarrel.setMinParamChange(minParamChange);
-    fgFitterFourProngBarrel.setMinRelChi2Change(minRelChi2Change);
-    fgFitterFourProngBarrel.setUseAbsDCA(useAbsDCA);
-    fgUsedKF = false;
+    fgContext->fFitterFourProngBarrel.setBz(magField);
+    fgContext->fFitterFourProngBarrel.setPropagateToPCA(propagateToPCA);
+    fgContext->fFitterFourProngBarrel.setMaxR(maxR);
+    fgContext->fFitterFourProngBarrel.setMinParamChange(minParamChange);
+    fgContext->fFitterFourProngBarrel.setMinRelChi2Change(minRelChi2Change);
+    fgContext->fFitterFourProngBarrel.setUseAbsDCA(useAbsDCA);
+    fgContext->fUsedKF = false;
   }
 
   static auto getEventPlane(int harm, float qnxa, float qnya)
@@ -1271,22 +1271,22 @@ class VarManager : public TObject
 
   static void SetCalibrationObject(CalibObjects calib, TObject* obj)
   {
-    fgCalibs[calib] = obj;
+    fgContext->fCalibs[calib] = obj;
     // Check whether all the needed objects for TPC postcalibration are available
-    if (fgCalibs.find(kTPCElectronMean) != fgCalibs.end() && fgCalibs.find(kTPCElectronSigma) != fgCalibs.end()) {
-      fgRunTPCPostCalibration[0] = true;
+    if (fgContext->fCalibs.find(kTPCElectronMean) != fgContext->fCalibs.end() && fgContext->fCalibs.find(kTPCElectronSigma) != fgContext->fCalibs.end()) {
+      fgContext->fRunTPCPostCalibration[0] = true;
       fgUsedVars[kTPCnSigmaEl_Corr] = true;
     }
-    if (fgCalibs.find(kTPCPionMean) != fgCalibs.end() && fgCalibs.find(kTPCPionSigma) != fgCalibs.end()) {
-      fgRunTPCPostCalibration[1] = true;
+    if (fgContext->fCalibs.find(kTPCPionMean) != fgContext->fCalibs.end() && fgContext->fCalibs.find(kTPCPionSigma) != fgContext->fCalibs.end()) {
+      fgContext->fRunTPCPostCalibration[1] = true;
       fgUsedVars[kTPCnSigmaPi_Corr] = true;
     }
-    if (fgCalibs.find(kTPCKaonMean) != fgCalibs.end() && fgCalibs.find(kTPCKaonSigma) != fgCalibs.end()) {
-      fgRunTPCPostCalibration[2] = true;
+    if (fgContext->fCalibs.find(kTPCKaonMean) != fgContext->fCalibs.end() && fgContext->fCalibs.find(kTPCKaonSigma) != fgContext->fCalibs.end()) {
+      fgContext->fRunTPCPostCalibration[2] = true;
       fgUsedVars[kTPCnSigmaKa_Corr] = true;
     }
-    if (fgCalibs.find(kTPCProtonMean) != fgCalibs.end() && fgCalibs.find(kTPCProtonSigma) != fgCalibs.end()) {
-      fgRunTPCPostCalibration[3] = true;
+    if (fgContext->fCalibs.find(kTPCProtonMean) != fgContext->fCalibs.end() && fgContext->fCalibs.find(kTPCProtonSigma) != fgContext->fCalibs.end()) {
+      fgContext->fRunTPCPostCalibration[3] = true;
       fgUsedVars[kTPCnSigmaPr_Corr] = true;
     }
   }
@@ -1296,15 +1296,15 @@ class VarManager : public TObject
     if (type < 0 || type > 2) {
       LOG(fatal) << "Invalid calibration type. Must be 0, 1, or 2.";
     }
-    fgCalibrationType = type;
-    fgUseInterpolatedCalibration = useInterpolation;
+    fgContext->fCalibrationType = type;
+    fgContext->fUseInterpolatedCalibration = useInterpolation;
   }
   static double ComputePIDcalibration(int species, double nSigmaValue);
 
   static TObject* GetCalibrationObject(CalibObjects calib)
   {
-    auto obj = fgCalibs.find(calib);
-    if (obj == fgCalibs.end()) {
+    auto obj = fgContext->fCalibs.find(calib);
+    if (obj == fgContext->fCalibs.end()) {
       return 0x0;
     } else {
       return obj->second;
@@ -1312,48 +1312,98 @@ class VarManager : public TObject
   }
   static void SetTPCInterSectorBoundary(float boundarySize)
   {
-    fgTPCInterSectorBoundary = boundarySize;
+    fgContext->fTPCInterSectorBoundary = boundarySize;
   }
   static void SetITSROFBorderselection(int bias, int length, int marginLow, int marginHigh)
   {
-    fgITSROFbias = bias;
-    fgITSROFlength = length;
-    fgITSROFBorderMarginLow = marginLow;
-    fgITSROFBorderMarginHigh = marginHigh;
+    fgContext->fITSROFbias = bias;
+    fgContext->fITSROFlength = length;
+    fgContext->fITSROFBorderMarginLow = marginLow;
+    fgContext->fITSROFBorderMarginHigh = marginHigh;
   }
 
   static void SetSORandEOR(uint64_t sor, uint64_t eor)
   {
-    fgSOR = sor;
-    fgEOR = eor;
+    fgContext->fSOR = sor;
+    fgContext->fEOR = eor;
   }
 
  public:
   VarManager();
   ~VarManager() override;
 
-  static float fgValues[kNVars]; // array holding all variables computed during analysis
+  static float fgValues[kNVars]; // array holding all variables computed during analysis (values buffer of the default context)
   static void ResetValues(int startValue = 0, int endValue = kNVars, float* values = nullptr);
 
+  // Context holding the values buffer and the per-run configuration (magnetic field, fitters, calibrations, etc.)
+  //   All the Fill* and Set* functions use the context which is current in the calling thread. By default this is
+  //   a process-wide context whose values buffer is fgValues, so the static interface works as before.
+  //   Tasks running several configurations, or filling variables from several threads, use one Context per
+  //   configuration / thread and make it current with a ContextGuard, e.g.
+  //     VarManager::Context ctx;
+  //     VarManager::ContextGuard guard(ctx);
+  //     VarManager::FillPair<...>(t1, t2); // fills ctx.fValues, using the fitters and settings of ctx
+  //   NOTE: fgUsedVars and the KFParticle magnetic field remain global, they have to be set up before any threads are started.
+  struct Context {
+    Context() : fValues(fOwnValues) {}
+    explicit Context(float* values) : fValues(values) {}
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    float fOwnValues[kNVars] = {0.0f}; // values buffer, unless an external buffer is provided
+    float* fValues;                    // array holding all variables computed during analysis
+
+    bool fUsedKF = false;
+    float fMagField = 0.5;
+    float fzMatching = -77.5;
+    float fzShiftFwd = 0.0;
+    float fTPCInterSectorBoundary = 1.0;                    // TPC inter-sector border size at the TPC outer radius, in cm
+    int fITSROFbias = 0;                                    // ITS ROF bias (from ALPIDE parameters)
+    int fITSROFlength = 100;                                // ITS ROF length (from ALPIDE parameters)
+    int fITSROFBorderMarginLow = 0;                         // ITS ROF border low margin
+    int fITSROFBorderMarginHigh = 0;                        // ITS ROF border high margin
+    uint64_t fSOR = 0;                                      // Timestamp for start of run
+    uint64_t fEOR = 0;                                      // Timestamp for end of run
+    ROOT::Math::PxPyPzEVector fBeamA{0, 0, 6799.99, 6800};  // GeV, beam from A-side 4-momentum vector
+    ROOT::Math::PxPyPzEVector fBeamC{0, 0, -6799.99, 6800}; // GeV, beam from C-side 4-momentum vector
+    o2::vertexing::DCAFitterN<2> fFitterTwoProngBarrel;
+    o2::vertexing::DCAFitterN<3> fFitterThreeProngBarrel;
+    o2::vertexing::DCAFitterN<4> fFitterFourProngBarrel;
+    o2::vertexing::FwdDCAFitterN<2> fFitterTwoProngFwd;
+    o2::vertexing::FwdDCAFitterN<3> fFitterThreeProngFwd;
+    o2::globaltracking::MatchGlobalFwd fMatching;
+
+    std::map<CalibObjects, TObject*> fCalibs;                      // map of calibration histograms
+    bool fRunTPCPostCalibration[4] = {false, false, false, false}; // 0-electron, 1-pion, 2-kaon, 3-proton
+    int fCalibrationType = 0;                                      // 0 - no calibration, 1 - calibration vs (TPCncls,pIN,eta) typically for pp, 2 - calibration vs (eta,nPV,nLong,tLong) typically for PbPb
+    bool fUseInterpolatedCalibration = true;                       // use interpolated calibration histograms (default: true)
+  };
+
+  // Makes a context current in the calling thread for the lifetime of the guard
+  class ContextGuard
+  {
+   public:
+    explicit ContextGuard(Context& context) : fPrevious(fgContext) { fgContext = &context; }
+    ~ContextGuard() { fgContext = fPrevious; }
+    ContextGuard(const ContextGuard&) = delete;
+    ContextGuard& operator=(const ContextGuard&) = delete;
+
+   private:
+    Context* fPrevious;
+  };
+
+  static Context& GetContext() { return *fgContext; }
+  static Context& GetDefaultContext() { return fgDefaultContext; }
+
  private:
   static bool fgUsedVars[kNVars]; // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
-  static bool fgUsedKF;
   static void SetVariableDependencies(); // toggle those variables on which other used variables might depend
 
-  static float fgMagField;
-  static float fgzMatching;
-  static float fgzShiftFwd;
-  static float fgCenterOfMassEnergy;        // collision energy
-  static float fgMassofCollidingParticle;   // mass of the colliding particle
-  static float fgTPCInterSectorBoundary;    // TPC inter-sector border size at the TPC outer radius, in cm
-  static int fgITSROFbias;                  // ITS ROF bias (from ALPIDE parameters)
-  static int fgITSROFlength;                // ITS ROF length (from ALPIDE parameters)
-  static int fgITSROFBorderMarginLow;       // ITS ROF border low margin
-  static int fgITSROFBorderMarginHigh;      // ITS ROF border high margin
-  static uint64_t fgSOR;                    // Timestamp for start of run
-  static uint64_t fgEOR;                    // Timestamp for end of run
-  static ROOT::Math::PxPyPzEVector fgBeamA; // beam from A-side 4-momentum vector
-  static ROOT::Math::PxPyPzEVector fgBeamC; // beam from C-side 4-momentum vector
+  static float fgCenterOfMassEnergy;      // collision energy
+  static float fgMassofCollidingParticle; // mass of the colliding particle
+
+  static Context fgDefaultContext;        //! process-wide context, using fgValues
+  static thread_local Context* fgContext; //! context current in the calling thread
 
   // static void FillEventDerived(float* values = nullptr);
   static void FillTrackDerived(float* values = nullptr);
@@ -1371,18 +1421,6 @@ class VarManager : public TObject
   template <typename T1, typename T2>
   static float LorentzTransformJpsihadroncosChi(TString Option, const T1& v1, const T2& v2);
 
-  static o2::vertexing::DCAFitterN<2> fgFitterTwoProngBarrel;
-  static o2::vertexing::DCAFitterN<3> fgFitterThreeProngBarrel;
-  static o2::vertexing::DCAFitterN<4> fgFitterFourProngBarrel;
-  static o2::vertexing::FwdDCAFitterN<2> fgFitterTwoProngFwd;
-  static o2::vertexing::FwdDCAFitterN<3> fgFitterThreeProngFwd;
-  static o2::globaltracking::MatchGlobalFwd mMatching;
-
-  static std::map<CalibObjects, TObject*> fgCalibs; // map of calibration histograms
-  static bool fgRunTPCPostCalibration[4];           // 0-electron, 1-pion, 2-kaon, 3-proton
-  static int fgCalibrationType;                     // 0 - no calibration, 1 - calibration vs (TPCncls,pIN,eta) typically for pp, 2 - calibration vs (eta,nPV,nLong,tLong) typically for PbPb
-  static bool fgUseInterpolatedCalibration;         // use interpolated calibration histograms (default: true)
-
   VarManager& operator=(const VarManager& c);
   VarManager(const VarManager& c);
 
@@ -1484,14 +1522,14 @@ KFPVertex VarManager::createKFPVertexFromCollision(const T& collision)
 template <typename T, typename C>
 o2::dataformats::GlobalFwdTrack VarManager::PropagateMuon(const T& muon, const C& collision, const int endPoint)
 {
-  o2::track::TrackParCovFwd fwdtrack = o2::aod::fwdtrackutils::getTrackParCovFwdShift(muon, fgzShiftFwd, muon);
+  o2::track::TrackParCovFwd fwdtrack = o2::aod::fwdtrackutils::getTrackParCovFwdShift(muon, fgContext->fzShiftFwd, muon);
   o2::dataformats::GlobalFwdTrack propmuon;
   if (static_cast<int>(muon.trackType()) > 2) {
     o2::dataformats::GlobalFwdTrack track;
     track.setParameters(fwdtrack.getParameters());
     track.setZ(fwdtrack.getZ());
     track.setCovariances(fwdtrack.getCovariances());
-    auto mchTrack = mMatching.FwdtoMCH(track);
+    auto mchTrack = fgContext->fMatching.FwdtoMCH(track);
 
     if (endPoint == kToVertex) {
       o2::mch::TrackExtrap::extrapToVertex(mchTrack, collision.posX(), collision.posY(), collision.posZ(), collision.covXX(), collision.covYY());
@@ -1503,17 +1541,17 @@ o2::dataformats::GlobalFwdTrack VarManager::PropagateMuon(const T& muon, const C
       o2::mch::TrackExtrap::extrapToZ(mchTrack, -505.);
     }
     if (endPoint == kToMatching) {
-      o2::mch::TrackExtrap::extrapToVertexWithoutBranson(mchTrack, fgzMatching);
+      o2::mch::TrackExtrap::extrapToVertexWithoutBranson(mchTrack, fgContext->fzMatching);
     }
 
-    auto proptrack = mMatching.MCHtoFwd(mchTrack);
+    auto proptrack = fgContext->fMatching.MCHtoFwd(mchTrack);
     propmuon.setParameters(proptrack.getParameters());
     propmuon.setZ(proptrack.getZ());
     propmuon.setCovariances(proptrack.getCovariances());
 
   } else if (static_cast<int>(muon.trackType()) < 2) {
     std::array<double, 3> dcaInfOrig{999.f, 999.f, 999.f};
-    fwdtrack.propagateToDCAhelix(fgMagField, {collision.posX(), collision.posY(), collision.posZ()}, dcaInfOrig);
+    fwdtrack.propagateToDCAhelix(fgContext->fMagField, {collision.posX(), collision.posY(), collision.posZ()}, dcaInfOrig);
     propmuon.setParameters(fwdtrack.getParameters());
     propmuon.setZ(fwdtrack.getZ());
     propmuon.setCovariances(fwdtrack.getCovariances());
@@ -1525,7 +1563,7 @@ template <typename T, typename C>
 o2::track::TrackParCovFwd VarManager::PropagateFwd(const T& track, const C& cov, float z)
 {
   o2::track::TrackParCovFwd fwdtrack = FwdToTrackPar(track, cov);
-  fwdtrack.propagateToZhelix(z, fgMagField);
+  fwdtrack.propagateToZhelix(z, fgContext->fMagField);
   return fwdtrack;
 }
 
@@ -1533,7 +1571,7 @@ template <uint32_t fillMap, typename T, typename C>
 void VarManager::FillMuonPDca(const T& muon, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
@@ -1552,7 +1590,7 @@ template <uint32_t fillMap, typename T, typename C>
 void VarManager::FillPropagateMuon(const T& muon, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((fillMap & ReducedMuonCov) > 0) {
@@ -1608,7 +1646,7 @@ template <uint32_t fillMap, typename T1, typename T2, typename C>
 void VarManager::FillGlobalMuonRefit(T1 const& muontrack, T2 const& mfttrack, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
     o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(muontrack, collision);
@@ -1616,7 +1654,7 @@ void VarManager::FillGlobalMuonRefit(T1 const& muontrack, T2 const& mfttrack, co
     double py = propmuon.getP() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
     double pz = propmuon.getP() * cos(M_PI / 2 - atan(mfttrack.tgl()));
     double pt = std::sqrt(std::pow(px, 2) + std::pow(py, 2));
-    auto mftprop = o2::aod::fwdtrackutils::getTrackParCovFwdShift(mfttrack, fgzShiftFwd);
+    auto mftprop = o2::aod::fwdtrackutils::getTrackParCovFwdShift(mfttrack, fgContext->fzShiftFwd);
     values[kX] = mftprop.getX();
     values[kY] = mftprop.getY();
     values[kZ] = mftprop.getZ();
@@ -1632,12 +1670,12 @@ template <uint32_t MuonfillMap, uint32_t MFTfillMap, typename T1, typename T2, t
 void VarManager::FillGlobalMuonRefitCov(T1 const& muontrack, T2 const& mfttrack, const C& collision, C2 const& mftcov, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if constexpr ((MuonfillMap & MuonCov) > 0) {
     if constexpr ((MFTfillMap & MFTCov) > 0) {
       o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(muontrack, collision);
-      auto mft = o2::aod::fwdtrackutils::getTrackParCovFwdShift(mfttrack, fgzShiftFwd, mftcov);
+      auto mft = o2::aod::fwdtrackutils::getTrackParCovFwdShift(mfttrack, fgContext->fzShiftFwd, mftcov);
 
       o2::dataformats::GlobalFwdTrack globalRefit = o2::aod::fwdtrackutils::refitGlobalMuonCov(propmuon, mft);
       values[kX] = globalRefit.getX();
@@ -1656,7 +1694,7 @@ template <typename T>
 void VarManager::FillTimeFrame(T const& tf, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if constexpr (T::template contains<o2::aod::BCs>()) {
     values[kTFNBCs] = tf.size();
@@ -1682,20 +1720,20 @@ template <typename T>
 void VarManager::FillBC(T const& bc, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   values[kRunNo] = bc.runNumber();
   values[kBC] = bc.globalBC();
   values[kBCOrbit] = bc.globalBC() % o2::constants::lhc::LHCMaxBunches;
   values[kTimestamp] = bc.timestamp();
-  values[kTimeFromSOR] = (fgSOR > 0 ? (bc.timestamp() - fgSOR) / 60000. : -1.0);
+  values[kTimeFromSOR] = (fgContext->fSOR > 0 ? (bc.timestamp() - fgContext->fSOR) / 60000. : -1.0);
 }
 
 template <uint32_t fillMap, typename T>
 void VarManager::FillEvent(T const& event, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((fillMap & CollisionTimestamp) > 0) {
@@ -1874,12 +1912,12 @@ void VarManager::FillEvent(T const& event, float* values)
     values[kBC] = event.globalBC();
     values[kBCOrbit] = event.globalBC() % o2::constants::lhc::LHCMaxBunches;
     values[kTimestamp] = event.timestamp();
-    values[kTimeFromSOR] = (fgSOR > 0 ? (event.timestamp() - fgSOR) / 60000. : -1.0);
+    values[kTimeFromSOR] = (fgContext->fSOR > 0 ? (event.timestamp() - fgContext->fSOR) / 60000. : -1.0);
     values[kCentVZERO] = event.centRun2V0M();
     values[kCentFT0C] = event.centFT0C();
     if (fgUsedVars[kIsNoITSROFBorderRecomputed]) {
-      uint16_t bcInITSROF = (event.globalBC() + 3564 - fgITSROFbias) % fgITSROFlength;
-      values[kIsNoITSROFBorderRecomputed] = bcInITSROF > fgITSROFBorderMarginLow && bcInITSROF < fgITSROFlength - fgITSROFBorderMarginHigh ? 1.0 : 0.0;
+      uint16_t bcInITSROF = (event.globalBC() + 3564 - fgContext->fITSROFbias) % fgContext->fITSROFlength;
+      values[kIsNoITSROFBorderRecomputed] = bcInITSROF > fgContext->fITSROFBorderMarginLow && bcInITSROF < fgContext->fITSROFlength - fgContext->fITSROFBorderMarginHigh ? 1.0 : 0.0;
     }
     if (fgUsedVars[kIsNoITSROFBorder]) {
       values[kIsNoITSROFBorder] = (event.selection_bit(o2::aod::evsel::kNoITSROFrameBorder) > 0);
@@ -2187,7 +2225,7 @@ template <typename T>
 void VarManager::FillEventFlowResoFactor(T const& hs_sp, T const& hs_ep, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if (values[kCentFT0C] >= 0.) {
@@ -2203,7 +2241,7 @@ template <typename T>
 void VarManager::FillTwoMixEventsFlowResoFactor(T const& hs_sp, T const& hs_ep, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if (values[kTwoEvCentFT0C1] >= 0.) {
@@ -2227,7 +2265,7 @@ template <typename T, typename T1, typename T2>
 void VarManager::FillTwoMixEventsCumulants(T const& h_v22ev1, T const& h_v24ev1, T const& h_v22ev2, T const& h_v24ev2, T1 const& t1, T2 const& t2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   int idx_v22ev1;
@@ -2273,7 +2311,7 @@ template <typename T>
 void VarManager::FillTwoEvents(T const& ev1, T const& ev2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   // if constexpr (T::template contains<o2::aod::Collision>()) {
   values[kTwoEvPosZ1] = ev1.posZ();
@@ -2293,7 +2331,7 @@ template <uint32_t fillMap, typename T1, typename T2>
 void VarManager::FillTwoMixEvents(T1 const& ev1, T1 const& ev2, T2 const& /*tracks1*/, T2 const& /*tracks2*/, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   values[kTwoEvPosZ1] = ev1.posZ();
   values[kTwoEvPosZ2] = ev2.posZ();
@@ -2331,7 +2369,7 @@ template <uint32_t fillMap, typename T>
 void VarManager::FillTrack(T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((fillMap & TrackMFT) > 0) {
@@ -2376,7 +2414,7 @@ void VarManager::FillTrack(T const& track, float* values)
     values[kPhi] = track.phi();
     values[kCharge] = track.sign();
     if (fgUsedVars[kPhiTPCOuter]) {
-      values[kPhiTPCOuter] = track.phi() - (track.sign() > 0 ? 1.0 : -1.0) * (TMath::PiOver2() - TMath::ACos(0.22 * fgMagField / track.pt()));
+      values[kPhiTPCOuter] = track.phi() - (track.sign() > 0 ? 1.0 : -1.0) * (TMath::PiOver2() - TMath::ACos(0.22 * fgContext->fMagField / track.pt()));
       if (values[kPhiTPCOuter] > TMath::TwoPi()) {
         values[kPhiTPCOuter] -= TMath::TwoPi();
       }
@@ -2386,8 +2424,8 @@ void VarManager::FillTrack(T const& track, float* values)
     }
     if (fgUsedVars[kTrackIsInsideTPCModule]) {
       float localSectorPhi = values[kPhiTPCOuter] - TMath::Floor(18.0 * values[kPhiTPCOuter] / TMath::TwoPi()) * (TMath::TwoPi() / 18.0);
-      float edge = fgTPCInterSectorBoundary / 2.0 / 246.6; // minimal inter-sector boundary as angle
-      float curvature = 3.0 * 3.33 * track.pt() / fgMagField * (1.0 - TMath::Sin(TMath::ACos(0.22 * fgMagField / track.pt())));
+      float edge = fgContext->fTPCInterSectorBoundary / 2.0 / 246.6; // minimal inter-sector boundary as angle
+      float curvature = 3.0 * 3.33 * track.pt() / fgContext->fMagField * (1.0 - TMath::Sin(TMath::ACos(0.22 * fgContext->fMagField / track.pt())));
       if (curvature / 2.466 > edge) {
         edge = curvature / 2.466;
       }
@@ -2615,7 +2653,7 @@ void VarManager::FillTrack(T const& track, float* values)
       }
     }
     // compute TPC postcalibrated electron nsigma based on calibration histograms from CCDB
-    if (fgUsedVars[kTPCnSigmaEl_Corr] && fgRunTPCPostCalibration[0]) {
+    if (fgUsedVars[kTPCnSigmaEl_Corr] && fgContext->fRunTPCPostCalibration[0]) {
       if (!isTPCCalibrated) {
         values[kTPCnSigmaEl_Corr] = ComputePIDcalibration(0, values[kTPCnSigmaEl]);
       } else {
@@ -2625,7 +2663,7 @@ void VarManager::FillTrack(T const& track, float* values)
     }
 
     // compute TPC postcalibrated pion nsigma if required
-    if (fgUsedVars[kTPCnSigmaPi_Corr] && fgRunTPCPostCalibration[1]) {
+    if (fgUsedVars[kTPCnSigmaPi_Corr] && fgContext->fRunTPCPostCalibration[1]) {
       if (!isTPCCalibrated) {
         values[kTPCnSigmaPi_Corr] = ComputePIDcalibration(1, values[kTPCnSigmaPi]);
       } else {
@@ -2633,7 +2671,7 @@ void VarManager::FillTrack(T const& track, float* values)
         values[kTPCnSigmaPi_Corr] = track.tpcNSigmaPi();
       }
     }
-    if (fgUsedVars[kTPCnSigmaKa_Corr] && fgRunTPCPostCalibration[2]) {
+    if (fgUsedVars[kTPCnSigmaKa_Corr] && fgContext->fRunTPCPostCalibration[2]) {
       // compute TPC postcalibrated kaon nsigma if required
       if (!isTPCCalibrated) {
         values[kTPCnSigmaKa_Corr] = ComputePIDcalibration(2, values[kTPCnSigmaKa]);
@@ -2643,7 +2681,7 @@ void VarManager::FillTrack(T const& track, float* values)
       }
     }
     // compute TPC postcalibrated proton nsigma if required
-    if (fgUsedVars[kTPCnSigmaPr_Corr] && fgRunTPCPostCalibration[3]) {
+    if (fgUsedVars[kTPCnSigmaPr_Corr] && fgContext->fRunTPCPostCalibration[3]) {
       if (!isTPCCalibrated) {
         values[kTPCnSigmaPr_Corr] = ComputePIDcalibration(3, values[kTPCnSigmaPr]);
       } else {
@@ -2724,7 +2762,7 @@ void VarManager::FillTrack(T const& track, float* values)
     values[kMuonC1Pt21Pt2] = track.c1Pt21Pt2();
   }
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & MuonCovRealign) > 0) {
-    auto muonTrack = o2::aod::fwdtrackutils::getTrackParCovFwdShift(track, fgzShiftFwd, track);
+    auto muonTrack = o2::aod::fwdtrackutils::getTrackParCovFwdShift(track, fgContext->fzShiftFwd, track);
     auto muonCov = muonTrack.getCovariances();
     values[kX] = muonTrack.getX();
     values[kY] = muonTrack.getY();
@@ -2763,12 +2801,12 @@ void VarManager::FillTrackCollision(T const& track, C const& collision, float* v
 {
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if constexpr ((fillMap & ReducedTrackBarrel) > 0 || (fillMap & TrackDCA) > 0) {
     auto trackPar = getTrackPar(track);
     std::array<float, 2> dca{1e10f, 1e10f};
-    trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+    trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca);
 
     values[kTrackDCAxy] = dca[0];
     values[kTrackDCAz] = dca[1];
@@ -2797,13 +2835,13 @@ template <uint32_t fillMap, typename T, typename C, typename M, typename P>
 void VarManager::FillTrackCollisionMatCorr(T const& track, C const& collision, M const& materialCorr, P const& propagator, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if constexpr ((fillMap & ReducedTrackBarrel) > 0 || (fillMap & TrackDCA) > 0) {
     auto trackPar = getTrackPar(track);
     std::array<float, 2> dca{1e10f, 1e10f};
     std::array<float, 3> pVec = {track.px(), track.py(), track.pz()};
-    // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+    // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca);
     propagator->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackPar, 2.f, materialCorr, &dca);
     getPxPyPz(trackPar, pVec);
 
@@ -2825,7 +2863,7 @@ template <uint32_t fillMap, typename T>
 void VarManager::FillPhoton(T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   // Quantities based on the basic table (contains just kine information and filter bits)
@@ -2857,7 +2895,7 @@ template <typename U, typename T>
 void VarManager::FillTrackMC(const U& mcStack, T const& track, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   // Quantities based on the mc particle table
@@ -2891,7 +2929,7 @@ void VarManager::FillTrackCollisionMC(T1 const& track, T2 const& MotherTrack, C
 {
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m = o2::constants::physics::MassBPlus;
@@ -3008,7 +3046,7 @@ template <uint32_t fillMap, typename T1, typename T2, typename C>
 void VarManager::FillPairPropagateMuon(T1 const& muon1, T2 const& muon2, const C& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   o2::dataformats::GlobalFwdTrack propmuon1 = PropagateMuon(muon1, collision);
   o2::dataformats::GlobalFwdTrack propmuon2 = PropagateMuon(muon2, collision);
@@ -3033,7 +3071,7 @@ template <int pairType, uint32_t fillMap, typename T1, typename T2>
 void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -3099,9 +3137,9 @@ void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
   }
 
   if (fgUsedVars[kPsiPair]) {
-    values[kDeltaPhiPair] = (t1.sign() * fgMagField > 0.) ? (v1.Phi() - v2.Phi()) : (v2.Phi() - v1.Phi());
+    values[kDeltaPhiPair] = (t1.sign() * fgContext->fMagField > 0.) ? (v1.Phi() - v2.Phi()) : (v2.Phi() - v1.Phi());
     double xipair = TMath::ACos((v1.Px() * v2.Px() + v1.Py() * v2.Py() + v1.Pz() * v2.Pz()) / v1.P() / v2.P());
-    values[kPsiPair] = (t1.sign() * fgMagField > 0.) ? TMath::ASin((v1.Theta() - v2.Theta()) / xipair) : TMath::ASin((v2.Theta() - v1.Theta()) / xipair);
+    values[kPsiPair] = (t1.sign() * fgContext->fMagField > 0.) ? TMath::ASin((v1.Theta() - v2.Theta()) / xipair) : TMath::ASin((v2.Theta() - v1.Theta()) / xipair);
   }
 
   if (fgUsedVars[kOpeningAngle]) {
@@ -3129,8 +3167,8 @@ void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
     ROOT::Math::Boost boostv12{v12.BoostToCM()};
     ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
     ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgBeamA).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgBeamC).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgContext->fBeamA).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgContext->fBeamC).Vect()).Unit()};
 
     // using positive sign convention for the first track
     ROOT::Math::XYZVectorF v_CM = (t1.sign() > 0 ? v1_CM : v2_CM);
@@ -3292,7 +3330,7 @@ template <int pairType, uint32_t fillMap, typename C, typename T1, typename T2>
 void VarManager::FillPairCollision(const C& collision, T1 const& t1, T2 const& t2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((pairType == kDecayToEE) && ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0)) {
@@ -3301,11 +3339,11 @@ void VarManager::FillPairCollision(const C& collision, T1 const& t1, T2 const& t
 
       auto trackPart1 = getTrackPar(t1);
       std::array<float, 2> dca1{1e10f, 1e10f};
-      trackPart1.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca1);
+      trackPart1.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca1);
 
       auto trackPart2 = getTrackPar(t2);
       std::array<float, 2> dca2{1e10f, 1e10f};
-      trackPart2.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca2);
+      trackPart2.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca2);
 
       // Recalculated quantities
       double dca1XY = dca1[0];
@@ -3344,7 +3382,7 @@ template <int pairType, uint32_t fillMap, typename C, typename T1, typename T2,
 void VarManager::FillPairCollisionMatCorr(C const& collision, T1 const& t1, T2 const& t2, M const& materialCorr, P const& propagator, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr ((pairType == kDecayToEE) && ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0)) {
@@ -3354,14 +3392,14 @@ void VarManager::FillPairCollisionMatCorr(C const& collision, T1 const& t1, T2 c
       auto trackPart1 = getTrackPar(t1);
       std::array<float, 2> dca1{1e10f, 1e10f};
       std::array<float, 3> pVect1 = {t1.px(), t1.py(), t1.pz()};
-      // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+      // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca);
       propagator->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackPart1, 2.f, materialCorr, &dca1);
       getPxPyPz(trackPart1, pVect1);
 
       auto trackPart2 = getTrackPar(t2);
       std::array<float, 2> dca2{1e10f, 1e10f};
       std::array<float, 3> pVect2 = {t2.px(), t2.py(), t2.pz()};
-      // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgMagField, &dca);
+      // trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, fgContext->fMagField, &dca);
       propagator->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackPart2, 2.f, materialCorr, &dca2);
       getPxPyPz(trackPart2, pVect2);
 
@@ -3403,7 +3441,7 @@ void VarManager::FillTriple(T1 const& t1, T2 const& t2, T3 const& t3, float* val
 {
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if (pairType == kTripleCandidateToEEPhoton) {
     float m1 = o2::constants::physics::MassElectron;
@@ -3477,7 +3515,7 @@ void VarManager::FillPairME(T1 const& t1, T2 const& t2, float* values)
   // Lightweight fill function called from the innermost event mixing loop
   //
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -3531,8 +3569,8 @@ void VarManager::FillPairME(T1 const& t1, T2 const& t2, float* values)
     ROOT::Math::Boost boostv12{v12.BoostToCM()};
     ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
     ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgBeamA).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgBeamC).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgContext->fBeamA).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgContext->fBeamC).Vect()).Unit()};
 
     // using positive sign convention for the first track
     ROOT::Math::XYZVectorF v_CM = (t1.sign() > 0 ? v1_CM : v2_CM);
@@ -3714,7 +3752,7 @@ template <int pairType, typename T1, typename T2>
 void VarManager::FillPairMC(T1 const& t1, T2 const& t2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -3758,8 +3796,8 @@ void VarManager::FillPairMC(T1 const& t1, T2 const& t2, float* values)
     ROOT::Math::Boost boostv12{v12.BoostToCM()};
     ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
     ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgBeamA).Vect()).Unit()};
-    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgBeamC).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(fgContext->fBeamA).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(fgContext->fBeamC).Vect()).Unit()};
 
     // using positive sign convention for the first track
     ROOT::Math::XYZVectorF v_CM = (t1.pdgCode() > 0 ? v1_CM : v2_CM);
@@ -3872,7 +3910,7 @@ template <int candidateType, typename T1, typename T2, typename T3>
 void VarManager::FillTripleMC(T1 const& t1, T2 const& t2, T3 const& t3, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr (candidateType == kTripleCandidateToEEPhoton) {
@@ -3962,7 +4000,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
   constexpr bool muonHasCov = ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0);
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   float m1 = o2::constants::physics::MassElectron;
   float m2 = o2::constants::physics::MassElectron;
@@ -3978,8 +4016,8 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
   ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), m2);
   ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = fgContext->fUsedKF;
+  if (!fgContext->fUsedKF) {
     int procCode = 0;
 
     // TODO: use trackUtilities functions to initialize the various matrices to avoid code duplication
@@ -3997,12 +4035,12 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
                                       t2.cSnpSnp(), t2.cTglY(), t2.cTglZ(), t2.cTglSnp(), t2.cTglTgl(),
                                       t2.c1PtY(), t2.c1PtZ(), t2.c1PtSnp(), t2.c1PtTgl(), t2.c1Pt21Pt2()};
       o2::track::TrackParCov pars2{t2.x(), t2.alpha(), t2pars, t2covs};
-      procCode = fgFitterTwoProngBarrel.process(pars1, pars2);
+      procCode = fgContext->fFitterTwoProngBarrel.process(pars1, pars2);
     } else if constexpr ((pairType == kDecayToMuMu) && muonHasCov) {
       // Initialize track parameters for forward
       o2::track::TrackParCovFwd pars1 = FwdToTrackPar(t1, t1);
       o2::track::TrackParCovFwd pars2 = FwdToTrackPar(t2, t2);
-      procCode = fgFitterTwoProngFwd.process(pars1, pars2);
+      procCode = fgContext->fFitterTwoProngFwd.process(pars1, pars2);
     } else {
       return;
     }
@@ -4041,11 +4079,11 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
       auto covMatrixPV = primaryVertex.getCov();
 
       if constexpr ((pairType == kDecayToEE || pairType == kDecayToKPi) && trackHasCov) {
-        secondaryVertex = fgFitterTwoProngBarrel.getPCACandidate();
-        covMatrixPCA = fgFitterTwoProngBarrel.calcPCACovMatrixFlat();
-        auto chi2PCA = fgFitterTwoProngBarrel.getChi2AtPCACandidate();
-        auto trackParVar0 = fgFitterTwoProngBarrel.getTrack(0);
-        auto trackParVar1 = fgFitterTwoProngBarrel.getTrack(1);
+        secondaryVertex = fgContext->fFitterTwoProngBarrel.getPCACandidate();
+        covMatrixPCA = fgContext->fFitterTwoProngBarrel.calcPCACovMatrixFlat();
+        auto chi2PCA = fgContext->fFitterTwoProngBarrel.getChi2AtPCACandidate();
+        auto trackParVar0 = fgContext->fFitterTwoProngBarrel.getTrack(0);
+        auto trackParVar1 = fgContext->fFitterTwoProngBarrel.getTrack(1);
         values[kVertexingChi2PCA] = chi2PCA;
         v1 = {trackParVar0.getPt(), trackParVar0.getEta(), trackParVar0.getPhi(), m1};
         v2 = {trackParVar1.getPt(), trackParVar1.getEta(), trackParVar1.getPhi(), m2};
@@ -4053,11 +4091,11 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
 
       } else if constexpr (pairType == kDecayToMuMu && muonHasCov) {
         // Get pca candidate from forward DCA fitter
-        secondaryVertex = fgFitterTwoProngFwd.getPCACandidate();
-        covMatrixPCA = fgFitterTwoProngFwd.calcPCACovMatrixFlat();
-        auto chi2PCA = fgFitterTwoProngFwd.getChi2AtPCACandidate();
-        auto trackParVar0 = fgFitterTwoProngFwd.getTrack(0);
-        auto trackParVar1 = fgFitterTwoProngFwd.getTrack(1);
+        secondaryVertex = fgContext->fFitterTwoProngFwd.getPCACandidate();
+        covMatrixPCA = fgContext->fFitterTwoProngFwd.calcPCACovMatrixFlat();
+        auto chi2PCA = fgContext->fFitterTwoProngFwd.getChi2AtPCACandidate();
+        auto trackParVar0 = fgContext->fFitterTwoProngFwd.getTrack(0);
+        auto trackParVar1 = fgContext->fFitterTwoProngFwd.getTrack(1);
         values[kVertexingChi2PCA] = chi2PCA;
         v1 = {trackParVar0.getPt(), trackParVar0.getEta(), trackParVar0.getPhi(), m1};
         v2 = {trackParVar1.getPt(), trackParVar1.getEta(), trackParVar1.getPhi(), m2};
@@ -4335,7 +4373,7 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
   bool trackHasCov = ((fillMap & ReducedTrackBarrelCov) > 0);
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m1, m2, m3;
@@ -4355,8 +4393,8 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
   ROOT::Math::PtEtaPhiMVector v3(t3.pt(), t3.eta(), t3.phi(), m3);
   ROOT::Math::PtEtaPhiMVector v123 = v1 + v2 + v3;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = fgContext->fUsedKF;
+  if (!fgContext->fUsedKF) {
     int procCode = 0;
 
     if (trackHasCov) {
@@ -4375,7 +4413,7 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
                                       t3.cSnpSnp(), t3.cTglY(), t3.cTglZ(), t3.cTglSnp(), t3.cTglTgl(),
                                       t3.c1PtY(), t3.c1PtZ(), t3.c1PtSnp(), t3.c1PtTgl(), t3.c1Pt21Pt2()};
       o2::track::TrackParCov pars3{t3.x(), t3.alpha(), t3pars, t3covs};
-      procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
+      procCode = fgContext->fFitterThreeProngBarrel.process(pars1, pars2, pars3);
     } else {
       return;
     }
@@ -4409,9 +4447,9 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
     Vec3D secondaryVertex;
 
     if constexpr (eventHasVtxCov) {
-      secondaryVertex = fgFitterThreeProngBarrel.getPCACandidate();
+      secondaryVertex = fgContext->fFitterThreeProngBarrel.getPCACandidate();
 
-      std::array<float, 6> covMatrixPCA = fgFitterThreeProngBarrel.calcPCACovMatrixFlat();
+      std::array<float, 6> covMatrixPCA = fgContext->fFitterThreeProngBarrel.calcPCACovMatrixFlat();
 
       o2::math_utils::Point3D<float> vtxXYZ(collision.posX(), collision.posY(), collision.posZ());
       std::array<float, 6> vtxCov{collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
@@ -4419,7 +4457,7 @@ void VarManager::FillTripletVertexing(C const& collision, T const& t1, T const&
       auto covMatrixPV = primaryVertex.getCov();
 
       if (fgUsedVars[kVertexingChi2PCA]) {
-        auto chi2PCA = fgFitterThreeProngBarrel.getChi2AtPCACandidate();
+        auto chi2PCA = fgContext->fFitterThreeProngBarrel.getChi2AtPCACandidate();
         values[VarManager::kVertexingChi2PCA] = chi2PCA;
       }
 
@@ -4557,7 +4595,7 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
   constexpr bool trackHasCov = ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0);
   constexpr bool muonHasCov = ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0);
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float mtrack;
@@ -4566,8 +4604,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
   int procCode = 0;
   int procCodeJpsi = 0;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = fgContext->fUsedKF;
+  if (!fgContext->fUsedKF) {
     if constexpr ((candidateType == kBcToThreeMuons) && muonHasCov) {
       mlepton1 = o2::constants::physics::MassMuon;
       mlepton2 = o2::constants::physics::MassMuon;
@@ -4577,8 +4615,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
       o2::track::TrackParCovFwd pars2 = FwdToTrackPar(lepton2, lepton2);
       o2::track::TrackParCovFwd pars3 = FwdToTrackPar(track, track);
 
-      procCode = VarManager::fgFitterThreeProngFwd.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngFwd.process(pars1, pars2);
+      procCode = fgContext->fFitterThreeProngFwd.process(pars1, pars2, pars3);
+      procCodeJpsi = fgContext->fFitterTwoProngFwd.process(pars1, pars2);
     } else if constexpr ((candidateType == kBtoJpsiEEK || candidateType == kDstarToD0KPiPi) && trackHasCov) {
       if constexpr ((candidateType == kBtoJpsiEEK) && trackHasCov) {
         mlepton1 = o2::constants::physics::MassElectron;
@@ -4604,8 +4642,8 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
                                            track.cSnpSnp(), track.cTglY(), track.cTglZ(), track.cTglSnp(), track.cTglTgl(),
                                            track.c1PtY(), track.c1PtZ(), track.c1PtSnp(), track.c1PtTgl(), track.c1Pt21Pt2()};
       o2::track::TrackParCov pars3{track.x(), track.alpha(), lepton3pars, lepton3covs};
-      procCode = VarManager::fgFitterThreeProngBarrel.process(pars1, pars2, pars3);
-      procCodeJpsi = VarManager::fgFitterTwoProngBarrel.process(pars1, pars2);
+      procCode = fgContext->fFitterThreeProngBarrel.process(pars1, pars2, pars3);
+      procCodeJpsi = fgContext->fFitterTwoProngBarrel.process(pars1, pars2);
     } else {
       return;
     }
@@ -4664,15 +4702,15 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
       auto covMatrixPV = primaryVertex.getCov();
 
       if constexpr ((candidateType == kBtoJpsiEEK || candidateType == kDstarToD0KPiPi) && trackHasCov) {
-        secondaryVertex = fgFitterThreeProngBarrel.getPCACandidate();
-        covMatrixPCA = fgFitterThreeProngBarrel.calcPCACovMatrixFlat();
+        secondaryVertex = fgContext->fFitterThreeProngBarrel.getPCACandidate();
+        covMatrixPCA = fgContext->fFitterThreeProngBarrel.calcPCACovMatrixFlat();
       } else if constexpr (candidateType == kBcToThreeMuons && muonHasCov) {
-        secondaryVertex = fgFitterThreeProngFwd.getPCACandidate();
-        covMatrixPCA = fgFitterThreeProngFwd.calcPCACovMatrixFlat();
+        secondaryVertex = fgContext->fFitterThreeProngFwd.getPCACandidate();
+        covMatrixPCA = fgContext->fFitterThreeProngFwd.calcPCACovMatrixFlat();
       }
 
       if (fgUsedVars[kVertexingChi2PCA]) {
-        auto chi2PCA = fgFitterThreeProngBarrel.getChi2AtPCACandidate();
+        auto chi2PCA = fgContext->fFitterThreeProngBarrel.getChi2AtPCACandidate();
         values[VarManager::kVertexingChi2PCA] = chi2PCA;
       }
 
@@ -4815,7 +4853,7 @@ template <typename C, typename A>
 void VarManager::FillQVectorFromGFW(C const& /*collision*/, A const& compA11, A const& compB11, A const& compC11, A const& compA21, A const& compB21, A const& compC21, A const& compA31, A const& compB31, A const& compC31, A const& compA41, A const& compB41, A const& compC41, A const& compA23, A const& compA42, float S10A, float S10B, float S10C, float S11A, float S11B, float S11C, float S12A, float S13A, float S14A, float S21A, float S22A, float S31A, float S41A, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   // Fill Qn vectors from generic flow framework for different eta gap A, B, C (n=1,2,3,4) with proper normalisation
@@ -4920,7 +4958,7 @@ template <typename C>
 void VarManager::FillQVectorFromCentralFW(C const& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float xQVecFT0a = collision.qvecFT0ARe();   // already normalised
@@ -5016,7 +5054,7 @@ template <typename C>
 void VarManager::FillSpectatorPlane(C const& collision, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   auto zncEnergy = collision.energySectorZNC();
@@ -5124,7 +5162,7 @@ void VarManager::FillPairVn(T1 const& t1, T2 const& t2, float* values)
 {
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float m1 = o2::constants::physics::MassElectron;
@@ -5180,23 +5218,23 @@ void VarManager::FillPairVn(T1 const& t1, T2 const& t2, float* values)
   values[kV2EP] = std::isnan(V2EP) || std::isinf(V2EP) ? 0. : V2EP;
   values[kWV2EP] = std::isnan(V2EP) || std::isinf(V2EP) ? 0. : 1.0;
 
-  if (std::isnan(VarManager::fgValues[VarManager::kU2Q2]) == true) {
+  if (std::isnan(fgContext->fValues[VarManager::kU2Q2]) == true) {
     values[kU2Q2] = -999.;
     values[kR2SP_AB] = -999.;
     values[kR2SP_AC] = -999.;
     values[kR2SP_BC] = -999.;
   }
-  if (std::isnan(VarManager::fgValues[VarManager::kU3Q3]) == true) {
+  if (std::isnan(fgContext->fValues[VarManager::kU3Q3]) == true) {
     values[kU3Q3] = -999.;
     values[kR3SP] = -999.;
   }
-  if (std::isnan(VarManager::fgValues[VarManager::kCos2DeltaPhi]) == true) {
+  if (std::isnan(fgContext->fValues[VarManager::kCos2DeltaPhi]) == true) {
     values[kCos2DeltaPhi] = -999.;
     values[kR2EP_AB] = -999.;
     values[kR2EP_AC] = -999.;
     values[kR2EP_BC] = -999.;
   }
-  if (std::isnan(VarManager::fgValues[VarManager::kCos3DeltaPhi]) == true) {
+  if (std::isnan(fgContext->fValues[VarManager::kCos3DeltaPhi]) == true) {
     values[kCos3DeltaPhi] = -999.;
     values[kR3EP] = -999.;
   }
@@ -5294,7 +5332,7 @@ template <typename T>
 void VarManager::FillZDC(T const& zdc, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   values[kEnergyCommonZNA] = (zdc.energyCommonZNA() > 0) ? zdc.energyCommonZNA() : -1.;
@@ -5311,7 +5349,7 @@ template <typename T1, typename T2>
 void VarManager::FillDileptonHadron(T1 const& dilepton, T2 const& hadron, float* values, float hadronMass)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if (fgUsedVars[kPairMass] || fgUsedVars[kPairPt] || fgUsedVars[kPairEta] || fgUsedVars[kPairPhi] || fgUsedVars[kPairMassDau] || fgUsedVars[kPairPtDau] || fgUsedVars[kDileptonHadronKstar]) {
@@ -5419,7 +5457,7 @@ template <typename T1, typename T2>
 void VarManager::FillDileptonPhoton(T1 const& dilepton, T2 const& photon, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
   if (fgUsedVars[kPairMass] || fgUsedVars[kPairPt] || fgUsedVars[kPairEta] || fgUsedVars[kPairPhi]) {
     ROOT::Math::PtEtaPhiMVector v1(dilepton.pt(), dilepton.eta(), dilepton.phi(), dilepton.mass());
@@ -5446,7 +5484,7 @@ template <typename T>
 void VarManager::FillHadron(T const& hadron, float* values, float hadronMass)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   ROOT::Math::PtEtaPhiMVector vhadron(hadron.pt(), hadron.eta(), hadron.phi(), hadronMass);
@@ -5461,7 +5499,7 @@ template <int partType, typename Cand, typename H, typename T>
 void VarManager::FillSingleDileptonCharmHadron(Cand const& candidate, H hfHelper, T& bdtScoreCharmHad, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if constexpr (partType == kJPsi) {
@@ -5497,7 +5535,7 @@ template <int candidateType, typename T1, typename T2, typename T3>
 void VarManager::FillDileptonTrackTrack(T1 const& dilepton, T2 const& hadron1, T3 const& hadron2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   double defaultDileptonMass = 3.096;
@@ -5559,7 +5597,7 @@ void VarManager::FillDileptonTrackTrackVertexing(C const& collision, T1 const& l
   }
 
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   float mtrack1, mtrack2;
@@ -5581,8 +5619,8 @@ void VarManager::FillDileptonTrackTrackVertexing(C const& collision, T1 const& l
   int procCodeDilepton = 0;
   int procCodeDileptonTrackTrack = 0;
 
-  values[kUsedKF] = fgUsedKF;
-  if (!fgUsedKF) {
+  values[kUsedKF] = fgContext->fUsedKF;
+  if (!fgContext->fUsedKF) {
     // create covariance matrix
     std::array<float, 5> lepton1pars = {lepton1.y(), lepton1.z(), lepton1.snp(), lepton1.tgl(), lepton1.signed1Pt()};
     std::array<float, 15> lepton1covs = {lepton1.cYY(), lepton1.cZY(), lepton1.cZZ(), lepton1.cSnpY(), lepton1.cSnpZ(),
@@ -5605,11 +5643,11 @@ void VarManager::FillDileptonTrackTrackVertexing(C const& collision, T1 const& l
                                         track2.c1PtY(), track2.c1PtZ(), track2.c1PtSnp(), track2.c1PtTgl(), track2.c1Pt21Pt2()};
     o2::track::TrackParCov pars4{track2.x(), track2.alpha(), track2pars, track2covs};
 
-    procCodeDilepton = VarManager::fgFitterTwoProngBarrel.process(pars1, pars2);
+    procCodeDilepton = fgContext->fFitterTwoProngBarrel.process(pars1, pars2);
     // create dilepton track
-    // o2::track::TrackParCov parsDilepton = VarManager::fgFitterTwoProngBarrel.createParentTrackParCov(0);
-    // procCodeDileptonTrackTrack = VarManager::fgFitterThreeProngBarrel.process(parsDilepton, pars3, pars4);
-    procCodeDileptonTrackTrack = VarManager::fgFitterFourProngBarrel.process(pars1, pars2, pars3, pars4);
+    // o2::track::TrackParCov parsDilepton = fgContext->fFitterTwoProngBarrel.createParentTrackParCov(0);
+    // procCodeDileptonTrackTrack = fgContext->fFitterThreeProngBarrel.process(parsDilepton, pars3, pars4);
+    procCodeDileptonTrackTrack = fgContext->fFitterFourProngBarrel.process(pars1, pars2, pars3, pars4);
 
     // fill values
     if (procCodeDilepton == 0 && procCodeDileptonTrackTrack == 0) {
@@ -5634,8 +5672,8 @@ void VarManager::FillDileptonTrackTrackVertexing(C const& collision, T1 const& l
     } else {
       Vec3D secondaryVertex;
       std::array<float, 6> covMatrixPCA;
-      secondaryVertex = fgFitterFourProngBarrel.getPCACandidate();
-      covMatrixPCA = fgFitterFourProngBarrel.calcPCACovMatrixFlat();
+      secondaryVertex = fgContext->fFitterFourProngBarrel.getPCACandidate();
+      covMatrixPCA = fgContext->fFitterFourProngBarrel.calcPCACovMatrixFlat();
 
       o2::math_utils::Point3D<float> vtxXYZ(collision.posX(), collision.posY(), collision.posZ());
       std::array<float, 6> vtxCov{collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
@@ -5681,7 +5719,7 @@ void VarManager::FillDileptonTrackTrackVertexing(C const& collision, T1 const& l
       values[kVertexingTauxyProjected] = values[kVertexingLxyProjected] * v1234.M() / (v1234.Pt());
       values[kVertexingTauxyzProjected] = values[kVertexingLxyzProjected] * v1234.M() / (v1234.P());
     }
-  } else if (fgUsedKF) {
+  } else if (fgContext->fUsedKF) {
     KFParticle lepton1KF; // lepton1
     KFParticle lepton2KF; // lepton2
     KFParticle KFGeoTwoLeptons;
@@ -5812,7 +5850,7 @@ template <int candidateType, typename T1, typename T2>
 void VarManager::FillQuadMC(T1 const& dilepton, T2 const& track1, T2 const& track2, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   double defaultDileptonMass = 3.096;
@@ -5873,7 +5911,7 @@ float VarManager::calculatePhiV(T1 const& t1, T2 const& t2)
   ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
   float pairPhiV = -999;
-  float bz = fgMagField;
+  float bz = fgContext->fMagField;
 
   bool swapTracks = false;
   if (v1.Pt() < v2.Pt()) { // ordering of track, pt1 > pt2
@@ -5963,7 +6001,7 @@ template <typename T1>
 void VarManager::FillBdtScore(T1 const& bdtScore, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   if (bdtScore.size() == 1) {
@@ -6003,7 +6041,7 @@ template <typename T1, typename T2, typename T3, typename T4, typename T5>
 void VarManager::FillFIT(T1 const& bc, T2 const& bcs, T3 const& ft0s, T4 const& fv0as, T5 const& fdds, float* values)
 {
   if (!values) {
-    values = fgValues;
+    values = fgContext->fValues;
   }
 
   // Initialize FIT info structure
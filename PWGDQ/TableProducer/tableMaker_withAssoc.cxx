@@ -25,6 +25,7 @@
 #include <utility>
 #include <vector>
 // other includes
+#include "PWGDQ/Core/AnalysisCompiledCuts.h"
 #include "PWGDQ/Core/AnalysisCompositeCut.h"
 #include "PWGDQ/Core/AnalysisCut.h"
 #include "PWGDQ/Core/CutsLibrary.h"
@@ -202,6 +203,7 @@ struct TableMaker {
     Configurable<std::string> fConfigEventCutsJSON{"cfgEventCutsJSON", "", "Additional event selection in JSON format"};
     Configurable<std::string> fConfigTrackCutsJSON{"cfgBarrelTrackCutsJSON", "", "Additional list of barrel track cuts in JSON format"};
     Configurable<std::string> fConfigMuonCutsJSON{"cfgMuonCutsJSON", "", "Additional list of muon cuts in JSON format"};
+    Configurable<int> fConfigCutFuncPoints{"cfgCutFuncPoints", 0, "Number of points used to tabulate the TF1 limits of the track and muon cuts (linear interpolation); < 2: exact TF1 evaluation"};
   } fConfigCuts;
 
   // Zorro selection
@@ -291,6 +293,8 @@ struct TableMaker {
   AnalysisCompositeCut* fEventCut;               //! Event selection cut
   std::vector<AnalysisCompositeCut*> fTrackCuts; //! Barrel track cuts
   std::vector<AnalysisCompositeCut*> fMuonCuts;  //! Muon track cuts
+  AnalysisCompiledCuts fTrackCutsCompiled;       //! Barrel track cuts, compiled for evaluation in the track loop
+  AnalysisCompiledCuts fMuonCutsCompiled;        //! Muon track cuts, compiled for evaluation in the muon loop
 
   bool fDoDetailedQA = false; // Bool to set detailed QA true, if QA is set true
   int fCurrentRun;            // needed to detect if the run changed and trigger update of calibrations etc.
@@ -518,6 +522,8 @@ struct TableMaker {
         fMuonCuts.push_back(reinterpret_cast<AnalysisCompositeCut*>(t));
       }
     }
+    fTrackCutsCompiled.Compile(fTrackCuts, fConfigCuts.fConfigCutFuncPoints.value);
+    fMuonCutsCompiled.Compile(fMuonCuts, fConfigCuts.fConfigCutFuncPoints.value);
 
     VarManager::SetUseVars(AnalysisCut::fgUsedVars); // provide the list of required variables so that VarManager knows what to fill
   }
@@ -1140,10 +1146,10 @@ struct TableMaker {
       }
 
       // apply track cuts and fill stats histogram
+      trackTempFilterMap = static_cast<uint32_t>(fTrackCutsCompiled.IsSelected(VarManager::fgValues));
       int i = 0;
       for (auto cut = fTrackCuts.begin(); cut != fTrackCuts.end(); cut++, i++) {
-        if ((*cut)->IsSelected(VarManager::fgValues)) {
-          trackTempFilterMap |= (static_cast<uint32_t>(1) << i);
+        if (trackTempFilterMap & (static_cast<uint32_t>(1) << i)) {
           // NOTE: the QA is filled here just for the first occurence of this track.
           //    So if there are histograms of quantities which depend on the collision association, these will not be accurate
           if (fConfigHistOutput.fConfigQA && (fTrackIndexMap.find(track.globalIndex()) == fTrackIndexMap.end())) {
@@ -1409,10 +1415,10 @@ struct TableMaker {
         fHistMan->FillHistClass("Muons_BeforeCuts", VarManager::fgValues);
       }
       // check the cuts and filters
+      trackTempFilterMap = static_cast<uint8_t>(fMuonCutsCompiled.IsSelected(VarManager::fgValues));
       int i = 0;
       for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
-        if ((*cut)->IsSelected(VarManager::fgValues)) {
-          trackTempFilterMap |= (static_cast<uint8_t>(1) << i);
+        if (trackTempFilterMap & (static_cast<uint8_t>(1) << i)) {
           // NOTE: the QA is filled here just for the first occurence of this muon, which means the current association
           //     will be skipped from histograms if this muon was already filled in the skimming map.
           //    So if there are histograms of quantities which depend on the collision association, these histograms will not be completely accurate
@@ -596,6 +596,7 @@ struct AnalysisTrackSelection {
 
   HistogramManager* fHistMan;
   std::vector<AnalysisCompositeCut*> fTrackCuts;
+  std::vector<int> fTrackCutHistHandles; // histogram class handles for each track cut, so we don't have to build their names in the track loop
 
   int fCurrentRun; // current run kept to detect run changes and trigger loading params from CCDB
 
@@ -646,6 +647,9 @@ struct AnalysisTrackSelection {
       dqhistograms::AddHistogramsFromJSON(fHistMan, fConfigAddJSONHistograms.value.c_str());  // ad-hoc histograms via JSON
       VarManager::SetUseVars(fHistMan->GetUsedVars());                                        // provide the list of required variables so that VarManager knows what to fill
       fOutputList.setObject(fHistMan->GetMainHistogramList());
+      for (auto& cut : fTrackCuts) {
+        fTrackCutHistHandles.push_back(fHistMan->GetHistClassHandle(Form("TrackBarrel_%s", cut->GetName())));
+      }
     }
 
     fCCDB->setURL(fConfigCcdbUrl.value);
@@ -726,7 +730,7 @@ struct AnalysisTrackSelection {
         if ((*cut)->IsSelected(VarManager::fgValues)) {
           filterMap |= (static_cast<uint32_t>(1) << iCut);
           if (fConfigQA) {
-            fHistMan->FillHistClass(Form("TrackBarrel_%s", (*cut)->GetName()), VarManager::fgValues);
+            fHistMan->FillHistClass(fTrackCutHistHandles[iCut], VarManager::fgValues);
           }
         }
       } // end loop over cuts
@@ -847,6 +851,7 @@ struct AnalysisMuonSelection {
 
   HistogramManager* fHistMan;
   std::vector<AnalysisCompositeCut*> fMuonCuts;
+  std::vector<int> fMuonCutHistHandles; // histogram class handles for each muon cut, so we don't have to build their names in the muon loop
 
   int fCurrentRun; // current run kept to detect run changes and trigger loading params from CCDB
 
@@ -897,6 +902,9 @@ struct AnalysisMuonSelection {
       dqhistograms::AddHistogramsFromJSON(fHistMan, fConfigAddJSONHistograms.value.c_str()); // ad-hoc histograms via JSON
       VarManager::SetUseVars(fHistMan->GetUsedVars());                                       // provide the list of required variables so that VarManager knows what to fill
       fOutputList.setObject(fHistMan->GetMainHistogramList());
+      for (auto& cut : fMuonCuts) {
+        fMuonCutHistHandles.push_back(fHistMan->GetHistClassHandle(Form("TrackMuon_%s", cut->GetName())));
+      }
     }
 
     fCCDB->setURL(fConfigCcdbUrl.value);
@@ -951,7 +959,7 @@ struct AnalysisMuonSelection {
         if ((*cut)->IsSelected(VarManager::fgValues)) {
           filterMap |= (static_cast<uint32_t>(1) << iCut);
           if (fConfigQA) {
-            fHistMan->FillHistClass(Form("TrackMuon_%s", (*cut)->GetName()), VarManager::fgValues);
+            fHistMan->FillHistClass(fMuonCutHistHandles[iCut], VarManager::fgValues);
           }
         }
       } // end loop over cuts
@@ -1300,6 +1308,9 @@ struct AnalysisSameEventPairing {
   std::map<int, std::vector<TString>> fTrackHistNames;
   std::map<int, std::vector<TString>> fMuonHistNames;
   std::map<int, std::vector<TString>> fTrackMuonHistNames;
+  // handles of the histogram classes above, so we don't have to look up their names in the pair loops
+  std::map<int, std::vector<int>> fTrackHistHandles;
+  std::map<int, std::vector<int>> fMuonHistHandles;
   std::vector<AnalysisCompositeCut> fPairCuts;
   std::vector<TString> fTrackCuts;
   std::map<std::pair<uint32_t, uint32_t>, uint32_t> fAmbiguousPairs;
@@ -1610,7 +1621,28 @@ struct AnalysisSameEventPairing {
       dqhistograms::AddHistogramsFromJSON(fHistMan, fConfigAddJSONHistograms.value.c_str());                    // ad-hoc histograms via JSON
       VarManager::SetUseVars(fHistMan->GetUsedVars());                                                          // provide the list of required variables so that VarManager knows what to fill
       fOutputList.setObject(fHistMan->GetMainHistogramList());
+
+      for (auto const& [index, names] : fTrackHistNames) {
+        for (auto const& name : names) {
+          fTrackHistHandles[index].push_back(fHistMan->GetHistClassHandle(name.Data()));
+        }
+      }
+      for (auto const& [index, names] : fMuonHistNames) {
+        for (auto const& name : names) {
+          fMuonHistHandles[index].push_back(fHistMan->GetHistClassHandle(name.Data()));
+        }
+      }
+    }
+  }
+
+  // handle of the i-th histogram class booked for a cut, or -1 (ignored by FillHistClass) if the class was not booked for the enabled process functions
+  static int getHistHandle(const std::map<int, std::vector<int>>& histHandles, int index, std::size_t i)
+  {
+    auto it = histHandles.find(index);
+    if (it == histHandles.end() || i >= it->second.size()) {
+      return -1;
     }
+    return it->second[i];
   }
 
   void initParamsFromCCDB(uint64_t timestamp, int runNumber, bool withTwoProngFitter = true)
@@ -1671,12 +1703,11 @@ struct AnalysisSameEventPairing {
     }
 
     TString cutNames = fConfigCuts.track.value;
-    std::map<int, std::vector<TString>> histNames = fTrackHistNames;
+    auto& histHandles = (TPairType == pairTypeMuMu ? fMuonHistHandles : fTrackHistHandles);
     int ncuts = fNCutsBarrel;
     int histIdxOffset = 0;
     if constexpr (TPairType == pairTypeMuMu) {
       cutNames = fConfigCuts.muon.value;
-      histNames = fMuonHistNames;
       ncuts = fNCutsMuon;
       if (fEnableMuonMixingHistos) {
         histIdxOffset = 3;
@@ -1985,66 +2016,66 @@ struct AnalysisSameEventPairing {
             if (sign1 * sign2 < 0) {
               PromptNonPromptSepTable(VarManager::fgValues[VarManager::kMass], VarManager::fgValues[VarManager::kPt], VarManager::fgValues[VarManager::kVertexingTauxyProjected], VarManager::fgValues[VarManager::kVertexingTauxyProjectedPoleJPsiMass], VarManager::fgValues[VarManager::kVertexingTauzProjected], isAmbiInBunch, isAmbiOutOfBunch, VarManager::fgValues[VarManager::kMultFT0A], VarManager::fgValues[VarManager::kMultFT0C], VarManager::fgValues[VarManager::kCentFT0M], VarManager::fgValues[VarManager::kVtxNcontribReal]);
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][0].Data(), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 0), VarManager::fgValues);
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 3 + histIdxOffset), VarManager::fgValues);
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset + 3].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 3 + histIdxOffset + 3), VarManager::fgValues);
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][3 + histIdxOffset + 6].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 3 + histIdxOffset + 6), VarManager::fgValues);
                   }
                 }
               }
               if constexpr (TPairType == VarManager::kDecayToEE) {
-                fHistMan->FillHistClass(Form("PairsBarrelSEPM_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 0), VarManager::fgValues);
                 if (isAmbiExtra) {
-                  fHistMan->FillHistClass(Form("PairsBarrelSEPM_ambiguousextra_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 3), VarManager::fgValues);
                 }
               }
             } else {
               if (sign1 > 0) {
                 if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                  fHistMan->FillHistClass(histNames[icut][1].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 1), VarManager::fgValues);
                   if (fConfigAmbiguousMuonHistograms) {
                     if (isAmbiInBunch) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 4 + histIdxOffset), VarManager::fgValues);
                     }
                     if (isAmbiOutOfBunch) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset + 3].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 4 + histIdxOffset + 3), VarManager::fgValues);
                     }
                     if (isUnambiguous) {
-                      fHistMan->FillHistClass(histNames[icut][4 + histIdxOffset + 6].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 4 + histIdxOffset + 6), VarManager::fgValues);
                     }
                   }
                 }
                 if constexpr (TPairType == VarManager::kDecayToEE) {
-                  fHistMan->FillHistClass(Form("PairsBarrelSEPP_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 1), VarManager::fgValues);
                   if (isAmbiExtra) {
-                    fHistMan->FillHistClass(Form("PairsBarrelSEPP_ambiguousextra_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 4), VarManager::fgValues);
                   }
                 }
               } else {
                 if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                  fHistMan->FillHistClass(histNames[icut][2].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 2), VarManager::fgValues);
                   if (fConfigAmbiguousMuonHistograms) {
                     if (isAmbiInBunch) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 5 + histIdxOffset), VarManager::fgValues);
                     }
                     if (isAmbiOutOfBunch) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset + 3].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 5 + histIdxOffset + 3), VarManager::fgValues);
                     }
                     if (isUnambiguous) {
-                      fHistMan->FillHistClass(histNames[icut][5 + histIdxOffset + 6].Data(), VarManager::fgValues);
+                      fHistMan->FillHistClass(getHistHandle(histHandles, icut, 5 + histIdxOffset + 6), VarManager::fgValues);
                     }
                   }
                 }
                 if constexpr (TPairType == VarManager::kDecayToEE) {
-                  fHistMan->FillHistClass(Form("PairsBarrelSEMM_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 2), VarManager::fgValues);
                   if (isAmbiExtra) {
-                    fHistMan->FillHistClass(Form("PairsBarrelSEMM_ambiguousextra_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 5), VarManager::fgValues);
                   }
                 }
               }
@@ -2054,12 +2085,12 @@ struct AnalysisSameEventPairing {
               if (!(cut.IsSelected(VarManager::fgValues))) // apply pair cuts
                 continue;
               if (sign1 * sign2 < 0) {
-                fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][0].Data(), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, ncuts + icut * ncuts + iPairCut, 0), VarManager::fgValues);
               } else {
                 if (sign1 > 0) {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][1].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, ncuts + icut * ncuts + iPairCut, 1), VarManager::fgValues);
                 } else {
-                  fHistMan->FillHistClass(histNames[ncuts + icut * ncuts + iPairCut][2].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, ncuts + icut * ncuts + iPairCut, 2), VarManager::fgValues);
                 }
               }
             } // end loop (pair cuts)
@@ -2072,7 +2103,7 @@ struct AnalysisSameEventPairing {
   template <int TPairType, uint32_t TEventFillMap, typename TAssoc1, typename TAssoc2, typename TTracks1, typename TTracks2>
   void runMixedPairing(TAssoc1 const& assocs1, TAssoc2 const& assocs2, TTracks1 const& /*tracks1*/, TTracks2 const& /*tracks2*/)
   {
-    std::map<int, std::vector<TString>> histNames = fTrackHistNames;
+    auto& histHandles = (TPairType == VarManager::kDecayToMuMu ? fMuonHistHandles : fTrackHistHandles);
     int pairSign = 0;
     int ncuts = 0;
     uint32_t twoTrackFilter = static_cast<uint32_t>(0);
@@ -2125,7 +2156,6 @@ struct AnalysisSameEventPairing {
             twoTrackFilter |= (static_cast<uint32_t>(1) << 31);
           }
           ncuts = fNCutsMuon;
-          histNames = fMuonHistNames;
 
           if (fConfigOptions.flatTables.value) {
             dimuonAllList(-999., -999., -999., -999.,
@@ -2172,58 +2202,58 @@ struct AnalysisSameEventPairing {
           isUnambiguous = !((twoTrackFilter & (static_cast<uint32_t>(1) << 28)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 29)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 30)) || (twoTrackFilter & (static_cast<uint32_t>(1) << 31)));
           if (pairSign == 0) {
             if constexpr (TPairType == VarManager::kDecayToMuMu) {
-              fHistMan->FillHistClass(histNames[icut][3].Data(), VarManager::fgValues);
+              fHistMan->FillHistClass(getHistHandle(histHandles, icut, 3), VarManager::fgValues);
               if (fConfigAmbiguousMuonHistograms) {
                 if (isAmbiInBunch) {
-                  fHistMan->FillHistClass(histNames[icut][15].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 15), VarManager::fgValues);
                 }
                 if (isAmbiOutOfBunch) {
-                  fHistMan->FillHistClass(histNames[icut][18].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 18), VarManager::fgValues);
                 }
                 if (isUnambiguous) {
-                  fHistMan->FillHistClass(histNames[icut][21].Data(), VarManager::fgValues);
+                  fHistMan->FillHistClass(getHistHandle(histHandles, icut, 21), VarManager::fgValues);
                 }
               }
             }
             if constexpr (TPairType == VarManager::kDecayToEE) {
-              fHistMan->FillHistClass(Form("PairsBarrelMEPM_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+              fHistMan->FillHistClass(getHistHandle(histHandles, icut, 6), VarManager::fgValues);
             }
           } else {
             if (pairSign > 0) {
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][4].Data(), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 4), VarManager::fgValues);
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][16].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 16), VarManager::fgValues);
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][19].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 19), VarManager::fgValues);
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][22].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 22), VarManager::fgValues);
                   }
                 }
               }
               if constexpr (TPairType == VarManager::kDecayToEE) {
-                fHistMan->FillHistClass(Form("PairsBarrelMEPP_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 7), VarManager::fgValues);
               }
             } else {
               if constexpr (TPairType == VarManager::kDecayToMuMu) {
-                fHistMan->FillHistClass(histNames[icut][5].Data(), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 5), VarManager::fgValues);
                 if (fConfigAmbiguousMuonHistograms) {
                   if (isAmbiInBunch) {
-                    fHistMan->FillHistClass(histNames[icut][17].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 17), VarManager::fgValues);
                   }
                   if (isAmbiOutOfBunch) {
-                    fHistMan->FillHistClass(histNames[icut][20].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 20), VarManager::fgValues);
                   }
                   if (isUnambiguous) {
-                    fHistMan->FillHistClass(histNames[icut][23].Data(), VarManager::fgValues);
+                    fHistMan->FillHistClass(getHistHandle(histHandles, icut, 23), VarManager::fgValues);
                   }
                 }
               }
               if constexpr (TPairType == VarManager::kDecayToEE) {
-                fHistMan->FillHistClass(Form("PairsBarrelMEMM_%s", fTrackCuts[icut].Data()), VarManager::fgValues);
+                fHistMan->FillHistClass(getHistHandle(histHandles, icut, 8), VarManager::fgValues);
               }
             }
           }
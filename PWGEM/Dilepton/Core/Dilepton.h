@@ -1309,7 +1309,8 @@ struct Dilepton {
       auto collisionIds_in_mixing_pool = emh_pos->GetCollisionIdsFromEventPool(key_bin); // pos/neg does not matter.
       // LOGF(info, "collisionIds_in_mixing_pool.size() = %d", collisionIds_in_mixing_pool.size());
 
-      for (const auto& mix_dfId_collisionId : collisionIds_in_mixing_pool) {
+      for (int mix_index = 0; mix_index < static_cast<int>(collisionIds_in_mixing_pool.size()); mix_index++) {
+        const auto& mix_dfId_collisionId = collisionIds_in_mixing_pool[mix_index];
         int mix_dfId = mix_dfId_collisionId.first;
         int mix_collisionId = mix_dfId_collisionId.second;
         if (collision.globalIndex() == mix_collisionId && ndf == mix_dfId) { // this never happens. only protection.
@@ -1323,8 +1324,8 @@ struct Dilepton {
           continue;
         }
 
-        auto posTracks_from_event_pool = emh_pos->GetTracksPerCollision(mix_dfId_collisionId);
-        auto negTracks_from_event_pool = emh_neg->GetTracksPerCollision(mix_dfId_collisionId);
+        auto posTracks_from_event_pool = emh_pos->GetTracksFromEventPool(key_bin, mix_index);
+        auto negTracks_from_event_pool = emh_neg->GetTracksFromEventPool(key_bin, mix_index); // pos/neg pools are filled together, hence same index.
         // LOGF(info, "Do event mixing: current event (%d, %d) | event pool (%d, %d), npos = %d , nneg = %d", ndf, collision.globalIndex(), mix_dfId, mix_collisionId, posTracks_from_event_pool.size(), negTracks_from_event_pool.size());
 
         for (const auto& pos : selected_posTracks_in_this_event) { // ULS mix
@@ -1169,7 +1169,8 @@ struct DileptonHadronMPC {
 
       // perform event mixing, only if at least 1 dilepton exists.
 
-      for (const auto& mix_dfId_collisionId : collisionIds_in_mixing_pool) {
+      for (int mix_index = 0; mix_index < static_cast<int>(collisionIds_in_mixing_pool.size()); mix_index++) {
+        const auto& mix_dfId_collisionId = collisionIds_in_mixing_pool[mix_index];
         int mix_dfId = mix_dfId_collisionId.first;
         int mix_collisionId = mix_dfId_collisionId.second;
         if (collision.globalIndex() == mix_collisionId && ndf == mix_dfId) { // this never happens. only protection.
@@ -1183,8 +1184,8 @@ struct DileptonHadronMPC {
           continue;
         }
 
-        auto posTracks_from_event_pool = emh_pos->GetTracksPerCollision(mix_dfId_collisionId);
-        auto negTracks_from_event_pool = emh_neg->GetTracksPerCollision(mix_dfId_collisionId);
+        auto posTracks_from_event_pool = emh_pos->GetTracksFromEventPool(key_bin, mix_index);
+        auto negTracks_from_event_pool = emh_neg->GetTracksFromEventPool(key_bin, mix_index); // pos/neg pools are filled together, hence same index.
         // LOGF(info, "posTracks_from_event_pool.size() = %d, negTracks_from_event_pool.size() = %d", posTracks_from_event_pool.size(), negTracks_from_event_pool.size());
 
         for (const auto& pos : selected_posTracks_in_this_event) { // ULS mix
@@ -1216,7 +1217,8 @@ struct DileptonHadronMPC {
         auto selected_refTracks_in_this_event = emh_ref->GetTracksPerCollision(key_df_collision);
         auto collisionIds_in_mixing_pool_hadron = emh_ref->GetCollisionIdsFromEventPool(key_bin);
 
-        for (const auto& mix_dfId_collisionId : collisionIds_in_mixing_pool_hadron) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds_in_mixing_pool_hadron.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds_in_mixing_pool_hadron[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int mix_collisionId = mix_dfId_collisionId.second;
           if (collision.globalIndex() == mix_collisionId && ndf == mix_dfId) { // this never happens. only protection.
@@ -1230,7 +1232,7 @@ struct DileptonHadronMPC {
             continue;
           }
 
-          auto refTracks_from_event_pool = emh_ref->GetTracksPerCollision(mix_dfId_collisionId);
+          auto refTracks_from_event_pool = emh_ref->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "selected_refTracks_in_this_event.size() = %d, collisionIds_in_mixing_pool_hadron.size() = %d, refTracks_from_event_pool.size() = %d", selected_refTracks_in_this_event.size(), collisionIds_in_mixing_pool_hadron.size(), refTracks_from_event_pool.size());
           for (const auto& ref1 : selected_refTracks_in_this_event) { // ref-ref mix
             for (const auto& ref2 : refTracks_from_event_pool) {
@@ -15,12 +15,19 @@
 #ifndef PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
 #define PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
 
+#include <algorithm>
 #include <map>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace o2::aod::pwgem::dilepton::utils
 {
+// Event pool with a fixed depth per mixing bin.
+// Each mixing bin T gets a dense index the first time it is seen. The pool of a bin is a block of fNdepth slots
+// in flat arrays, and each slot keeps its track array, whose capacity is reused by the collisions that
+// replace it. Tracks of the current collision U are staged until the collision is added to the pool.
+// Pool lookups return spans and the eviction of the oldest collision does not allocate.
 template <typename T, typename U, typename V>
 class EventMixingHandler
 {
@@ -28,55 +35,119 @@ class EventMixingHandler
   EventMixingHandler()
   {
     fNdepth = 0;
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
   }
 
   explicit EventMixingHandler(int ndepth)
   {
     fNdepth = ndepth;
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
   }
 
-  ~EventMixingHandler()
-  {
-    fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
-  }
+  ~EventMixingHandler() = default;
 
+  // the depth has to be set before the first mixing bin is created
   void SetNdepth(int ndepth) { fNdepth = ndepth; }
 
   void ReserveNTracksPerCollision(U key_df_collision, int ntrack)
   {
-    fMap_Tracks_per_collision[key_df_collision].reserve(ntrack);
+    SetCurrentCollision(key_df_collision);
+    fCurrentTracks.reserve(ntrack);
   }
 
   void AddTrackToEventPool(U key_df_collision, V obj)
   {
-    fMap_Tracks_per_collision[key_df_collision].emplace_back(obj);
+    SetCurrentCollision(key_df_collision);
+    fCurrentTracks.emplace_back(obj);
+  }
+
+  // dense index of a mixing bin, created if needed
+  int GetBinIndex(T key_bin)
+  {
+    if (fLastBin >= 0 && key_bin == fLastKeyBin) { // consecutive calls for the same collision
+      return fLastBin;
+    }
+    fLastKeyBin = key_bin;
+    auto it = fMapBinIndex.find(key_bin);
+    if (it != fMapBinIndex.end()) {
+      fLastBin = it->second;
+      return fLastBin;
+    }
+    int bin = static_cast<int>(fNCollisionsInPool.size());
+    fMapBinIndex.emplace(key_bin, bin);
+    fNCollisionsInPool.emplace_back(0);
+    fCollisionIds.resize(fCollisionIds.size() + fNdepth);
+    fSlotIndices.resize(fSlotIndices.size() + fNdepth);
+    fTracksPerSlot.resize(fTracksPerSlot.size() + fNdepth);
+    for (int i = 0; i < fNdepth; i++) {
+      fSlotIndices[bin * fNdepth + i] = bin * fNdepth + i;
+    }
+    fLastBin = bin;
+    return bin;
   }
 
-  std::vector<U> GetCollisionIdsFromEventPool(T key_bin) { return fMapMixBins[key_bin]; }
-  std::vector<V> GetTracksPerCollision(T key_bin, int index) { return fMap_Tracks_per_collision[fMapMixBins[key_bin][index]]; }
-  std::vector<V> GetTracksPerCollision(U key_df_collision) { return fMap_Tracks_per_collision[key_df_collision]; }
+  // collisions in the pool of a mixing bin, from the oldest to the newest
+  std::span<const U> GetCollisionIdsFromEventPool(int bin) const { return std::span<const U>(fCollisionIds.data() + bin * fNdepth, fNCollisionsInPool[bin]); }
+  std::span<const U> GetCollisionIdsFromEventPool(T key_bin) { return GetCollisionIdsFromEventPool(GetBinIndex(key_bin)); }
+
+  // tracks of the index-th collision in the pool of a mixing bin (same order as GetCollisionIdsFromEventPool)
+  std::span<const V> GetTracksFromEventPool(int bin, int index) const { return fTracksPerSlot[fSlotIndices[bin * fNdepth + index]]; }
+  std::span<const V> GetTracksFromEventPool(T key_bin, int index) { return GetTracksFromEventPool(GetBinIndex(key_bin), index); }
+
+  // tracks of the current collision, which is not yet in the pool
+  std::span<const V> GetTracksPerCollision(U key_df_collision) const
+  {
+    if (!fHasCurrentCollision || key_df_collision != fCurrentCollision) {
+      return {};
+    }
+    return fCurrentTracks;
+  }
 
   // call this function at the end of collision loop
   void AddCollisionIdAtLast(T key_bin, U key_df_collision)
   {
-    // LOGF(info, "fMapMixBins[key_bin].size() = %d", fMapMixBins[key_bin].size());
-    if (static_cast<int>(fMapMixBins[key_bin].size()) >= fNdepth) {
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].clear();
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].shrink_to_fit();
-      fMapMixBins[key_bin].erase(fMapMixBins[key_bin].begin());
+    if (fNdepth <= 0) {
+      return;
+    }
+    int bin = GetBinIndex(key_bin);
+    int first = bin * fNdepth;
+    int& ncollisions = fNCollisionsInPool[bin];
+    if (ncollisions >= fNdepth) { // evict the oldest collision and recycle its slot
+      int slot = fSlotIndices[first];
+      std::move(fCollisionIds.begin() + first + 1, fCollisionIds.begin() + first + fNdepth, fCollisionIds.begin() + first);
+      std::move(fSlotIndices.begin() + first + 1, fSlotIndices.begin() + first + fNdepth, fSlotIndices.begin() + first);
+      fSlotIndices[first + fNdepth - 1] = slot;
+      ncollisions--;
+    }
+    auto& tracks = fTracksPerSlot[fSlotIndices[first + ncollisions]];
+    tracks.clear();
+    if (fHasCurrentCollision && key_df_collision == fCurrentCollision) {
+      tracks.swap(fCurrentTracks); // the staging array takes over the capacity of the recycled slot
+      fHasCurrentCollision = false;
     }
-    fMapMixBins[key_bin].emplace_back(key_df_collision);
+    fCollisionIds[first + ncollisions] = key_df_collision;
+    ncollisions++;
   }
 
  private:
-  int fNdepth;                                           // depth of event mixing
-  std::map<T, std::vector<U>> fMapMixBins;               // map : e.g. <zbin, centbin, epbin> -> pair<df index, global collision index>
-  std::map<U, std::vector<V>> fMap_Tracks_per_collision; // map : e.g. pair<df index, global collision index> -> track array
+  void SetCurrentCollision(U key_df_collision)
+  {
+    if (!fHasCurrentCollision || key_df_collision != fCurrentCollision) { // tracks of a collision which was not added to the pool are dropped
+      fCurrentTracks.clear();
+      fCurrentCollision = key_df_collision;
+      fHasCurrentCollision = true;
+    }
+  }
+
+  int fNdepth;                                // depth of event mixing
+  std::map<T, int> fMapBinIndex;              // map : e.g. <zbin, centbin, epbin> -> dense bin index
+  T fLastKeyBin{};                            // last mixing bin looked up
+  int fLastBin{-1};                           // dense index of fLastKeyBin
+  std::vector<int> fNCollisionsInPool;        // number of collisions in the pool per bin
+  std::vector<U> fCollisionIds;               // e.g. pair<df index, global collision index>, fNdepth entries per bin, oldest first
+  std::vector<int> fSlotIndices;              // slot holding the tracks of each entry of fCollisionIds
+  std::vector<std::vector<V>> fTracksPerSlot; // track array per slot, fNdepth slots per bin
+  U fCurrentCollision{};                      // collision whose tracks are being staged
+  bool fHasCurrentCollision{false};           // whether fCurrentCollision is set
+  std::vector<V> fCurrentTracks;              // staged tracks of the current collision
 };
 } // namespace o2::aod::pwgem::dilepton::utils
 #endif // PWGEM_DILEPTON_UTILS_EVENTMIXINGHANDLER_H_
@@ -749,7 +749,8 @@ struct DiphotonHadronMPC {
       auto collisionIdsDiphoton_in_mixing_pool = emh_diphoton->GetCollisionIdsFromEventPool(key_bin);
 
       if constexpr (pairtype == PairType::kPCMPCM) { // same kinds pairing
-        for (const auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds1_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds1_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -764,7 +765,7 @@ struct DiphotonHadronMPC {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons1_from_event_pool = emh1->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (const auto& g1 : selected_photons1_in_this_event) {
@@ -780,7 +781,8 @@ struct DiphotonHadronMPC {
           }
         } // end of loop over mixed event pool between photon-photon
 
-        for (const auto& mix_dfId_collisionId : collisionIdsRef_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIdsRef_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIdsRef_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -794,7 +796,7 @@ struct DiphotonHadronMPC {
             continue;
           }
 
-          auto refTracks_from_event_pool = emh_ref->GetTracksPerCollision(mix_dfId_collisionId);
+          auto refTracks_from_event_pool = emh_ref->GetTracksFromEventPool(key_bin, mix_index);
           for (const auto& trg : selected_diphotons_in_this_event) {
             for (const auto& ref : refTracks_from_event_pool) {
               float deta = trg.eta() - ref.eta();
@@ -807,7 +809,8 @@ struct DiphotonHadronMPC {
         } // end of loop over mixed event pool between diphoton-hadron
 
       } else { // [photon1 from event1, photon2 from event2] and [photon1 from event2, photon2 from event1]
-        for (const auto& mix_dfId_collisionId : collisionIds2_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds2_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds2_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -822,7 +825,7 @@ struct DiphotonHadronMPC {
             continue;
           }
 
-          auto photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons2_from_event_pool = emh2->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), nll = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons2_from_event_pool.size());
 
           for (const auto& g1 : selected_photons1_in_this_event) {
@@ -841,7 +844,8 @@ struct DiphotonHadronMPC {
           }
         } // end of loop over mixed event pool between photon-photon
 
-        for (const auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds1_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds1_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -856,7 +860,7 @@ struct DiphotonHadronMPC {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons1_from_event_pool = emh1->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), nll = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons2_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (const auto& g1 : selected_photons2_in_this_event) {
@@ -875,7 +879,8 @@ struct DiphotonHadronMPC {
           }
         } // end of loop over mixed event pool between photon-photon
 
-        for (const auto& mix_dfId_collisionId : collisionIdsRef_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIdsRef_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIdsRef_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -889,7 +894,7 @@ struct DiphotonHadronMPC {
             continue;
           }
 
-          auto refTracks_from_event_pool = emh_ref->GetTracksPerCollision(mix_dfId_collisionId);
+          auto refTracks_from_event_pool = emh_ref->GetTracksFromEventPool(key_bin, mix_index);
           for (const auto& trg : selected_diphotons_in_this_event) {
             for (const auto& ref : refTracks_from_event_pool) {
               float deta = trg.eta() - ref.eta();
@@ -903,7 +908,8 @@ struct DiphotonHadronMPC {
       }
 
       // hadron-hadron mixed event
-      for (const auto& mix_dfId_collisionId : collisionIdsRef_in_mixing_pool) {
+      for (int mix_index = 0; mix_index < static_cast<int>(collisionIdsRef_in_mixing_pool.size()); mix_index++) {
+        const auto& mix_dfId_collisionId = collisionIdsRef_in_mixing_pool[mix_index];
         int mix_dfId = mix_dfId_collisionId.first;
         int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -917,7 +923,7 @@ struct DiphotonHadronMPC {
           continue;
         }
 
-        auto refTracks_from_event_pool = emh_ref->GetTracksPerCollision(mix_dfId_collisionId);
+        auto refTracks_from_event_pool = emh_ref->GetTracksFromEventPool(key_bin, mix_index);
         for (const auto& ref1 : selected_refTracks_in_this_event) {
           for (const auto& ref2 : refTracks_from_event_pool) {
             float deta = ref1.eta() - ref2.eta();
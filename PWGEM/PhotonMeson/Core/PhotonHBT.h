@@ -610,7 +610,8 @@ struct PhotonHBT {
       auto collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
 
       if constexpr (pairtype == ggHBTPairType::kPCMPCM) {
-        for (const auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds1_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds1_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -625,7 +626,7 @@ struct PhotonHBT {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons1_from_event_pool = emh1->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (const auto& g1 : selected_photons1_in_this_event) {
@@ -869,7 +869,8 @@ struct Pi0EtaToGammaGamma {
       auto collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
 
       if constexpr (pairtype == o2::aod::pwgem::photonmeson::photonpair::PairType::kPCMPCM || pairtype == o2::aod::pwgem::photonmeson::photonpair::PairType::kPHOSPHOS || pairtype == o2::aod::pwgem::photonmeson::photonpair::PairType::kEMCEMC) { // same kinds pairing
-        for (const auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds1_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds1_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -884,7 +885,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons1_from_event_pool = emh1->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (const auto& g1 : selected_photons1_in_this_event) {
@@ -902,7 +903,8 @@ struct Pi0EtaToGammaGamma {
         } // end of loop over mixed event pool
 
       } else { // [photon1 from event1, photon2 from event2] and [photon1 from event2, photon2 from event1]
-        for (const auto& mix_dfId_collisionId : collisionIds2_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds2_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds2_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -917,7 +919,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons2_from_event_pool = emh2->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), nll = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons2_from_event_pool.size());
 
           for (const auto& g1 : selected_photons1_in_this_event) {
@@ -935,7 +937,8 @@ struct Pi0EtaToGammaGamma {
             }
           }
         } // end of loop over mixed event pool
-        for (const auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int mix_index = 0; mix_index < static_cast<int>(collisionIds1_in_mixing_pool.size()); mix_index++) {
+          const auto& mix_dfId_collisionId = collisionIds1_in_mixing_pool[mix_index];
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -950,7 +953,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto photons1_from_event_pool = emh1->GetTracksFromEventPool(key_bin, mix_index);
           // LOGF(info, "Do event mixing: current event (%d, %d), nll = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons2_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (const auto& g1 : selected_photons2_in_this_event) {
@@ -626,7 +626,8 @@ struct TaggingPi0 {
       // auto collisionIds1_in_mixing_pool = emh1->GetCollisionIdsFromEventPool(key_bin);
       auto collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
 
-      for (const auto& mix_dfId_collisionId : collisionIds2_in_mixing_pool) {
+      for (int mix_index = 0; mix_index < static_cast<int>(collisionIds2_in_mixing_pool.size()); mix_index++) {
+        const auto& mix_dfId_collisionId = collisionIds2_in_mixing_pool[mix_index];
         int mix_dfId = mix_dfId_collisionId.first;
         int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -641,7 +642,7 @@ struct TaggingPi0 {
           continue;
         }
 
-        auto photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
+        auto photons2_from_event_pool = emh2->GetTracksFromEventPool(key_bin, mix_index);
         // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), nll = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons2_from_event_pool.size());
 
         for (const auto& g1 : selected_photons1_in_this_event) { // [photon from event1, dilepton from event2]
@@ -22,7 +22,9 @@
 
 #include "Tools/ML/MlResponse.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -33,41 +35,34 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesB0ToDPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_B0_FULL(OBJECT, FEATURE, GETTER)   \
-  case static_cast<uint8_t>(InputFeaturesB0ToDPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());              \
-    break;                                                    \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_B0_VALUE(FEATURE, VALUE)                                                                                                                                                                                                                       \
+  accessors[static_cast<uint8_t>(InputFeaturesB0ToDPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prongBachPi, [[maybe_unused]] T3 const& prongSoftPi, [[maybe_unused]] const std::vector<float>* const& mlScoresD) -> float { \
+    return VALUE;                                                                                                                                                                                                                                                   \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_B0_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_B0_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_B0_FUNC(OBJECT, FEATURE, GETTER)   \
-  case static_cast<uint8_t>(InputFeaturesB0ToDPi::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));               \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_B0_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_B0_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_B0_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_B0_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_B0(GETTER)                        \
-  case static_cast<uint8_t>(InputFeaturesB0ToDPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());          \
-    break;                                                   \
-  }
+#define SET_ACCESSOR_B0(GETTER) \
+  SET_ACCESSOR_B0_VALUE(GETTER, candidate.GETTER())
 
 //
 // Make FEATURE from an element of VECTOR at INDEX.
-#define CHECK_AND_FILL_VEC_B0_INDEX(FEATURE, VECTOR, INDEX)   \
-  case static_cast<uint8_t>(InputFeaturesB0ToDPi::FEATURE): { \
-    inputFeatures.emplace_back((VECTOR)[INDEX]);              \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_B0_INDEX(FEATURE, VECTOR, INDEX) \
+  SET_ACCESSOR_B0_VALUE(FEATURE, (VECTOR)[INDEX])
 
 namespace o2::analysis
 {
@@ -121,52 +116,17 @@ class HfMlResponseB0ToDPi : public HfMlResponse<TypeOutputScore>
                                       T2 const& prongBachPi,
                                       const std::vector<float>* mlScoresD = nullptr)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_B0(ptProng0);
-        CHECK_AND_FILL_VEC_B0(ptProng1);
-        CHECK_AND_FILL_VEC_B0(impactParameter0);
-        CHECK_AND_FILL_VEC_B0(impactParameter1);
-        CHECK_AND_FILL_VEC_B0(impactParameterProduct);
-        CHECK_AND_FILL_VEC_B0(chi2PCA);
-        CHECK_AND_FILL_VEC_B0(decayLength);
-        CHECK_AND_FILL_VEC_B0(decayLengthXY);
-        CHECK_AND_FILL_VEC_B0(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_B0(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_B0(cpa);
-        CHECK_AND_FILL_VEC_B0(cpaXY);
-        CHECK_AND_FILL_VEC_B0(maxNormalisedDeltaIP);
-        // TPC PID variable
-        CHECK_AND_FILL_VEC_B0_FULL(prongBachPi, tpcNSigmaPi1, tpcNSigmaPi);
-        // TOF PID variable
-        CHECK_AND_FILL_VEC_B0_FULL(prongBachPi, tofNSigmaPi1, tofNSigmaPi);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_B0_FUNC(prongBachPi, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-      }
-      if constexpr (withDmesMl) {
-        if constexpr (reduced) {
-          switch (idx) {
-            CHECK_AND_FILL_VEC_B0(prong0MlScoreBkg);
-            CHECK_AND_FILL_VEC_B0(prong0MlScorePrompt);
-            CHECK_AND_FILL_VEC_B0(prong0MlScoreNonprompt);
-          }
-        } else {
-          if (mlScoresD) {
-            switch (idx) {
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScoreBkg, *mlScoresD, 0);
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScorePrompt, *mlScoresD, 1);
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScoreNonprompt, *mlScoresD, 2);
-            }
-          } else {
-            LOG(fatal) << "ML scores of D not provided";
-          }
-        }
-      }
-    }
+    checkMlScoresD<withDmesMl>(mlScoresD);
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prongBachPi, nullptr, mlScoresD);
+  }
 
-    return inputFeatures;
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prongBachPi, const std::vector<float>* mlScoresD = nullptr)
+  {
+    checkMlScoresD<withDmesMl>(mlScoresD);
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prongBachPi, nullptr, mlScoresD);
   }
 
   /// Method to get the input features vector needed for ML inference
@@ -182,60 +142,120 @@ class HfMlResponseB0ToDPi : public HfMlResponse<TypeOutputScore>
                                              T3 const& prongSoftPi,
                                              const std::vector<float>* mlScoresD = nullptr)
   {
-    std::vector<float> inputFeatures;
+    checkMlScoresD<withDmesMl>(mlScoresD);
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessorsDStarPi<withDmesMl, T1, T2, T3>(), candidate, prongBachPi, prongSoftPi, mlScoresD);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2, typename T3>
+  void getInputFeaturesDStarPi(std::span<float> row, T1 const& candidate, T2 const& prongBachPi, T3 const& prongSoftPi, const std::vector<float>* mlScoresD = nullptr)
+  {
+    checkMlScoresD<withDmesMl>(mlScoresD);
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessorsDStarPi<withDmesMl, T1, T2, T3>(), candidate, prongBachPi, prongSoftPi, mlScoresD);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_B0(ptProng0);
-        CHECK_AND_FILL_VEC_B0(ptProng1);
-        CHECK_AND_FILL_VEC_B0(ptProng2);
-        CHECK_AND_FILL_VEC_B0(impactParameter0);
-        CHECK_AND_FILL_VEC_B0(impactParameter1);
-        CHECK_AND_FILL_VEC_B0(impactParameter2);
-        CHECK_AND_FILL_VEC_B0(impactParameterProngSqSum);
-        CHECK_AND_FILL_VEC_B0(chi2PCA);
-        CHECK_AND_FILL_VEC_B0(decayLength);
-        CHECK_AND_FILL_VEC_B0(decayLengthXY);
-        CHECK_AND_FILL_VEC_B0(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_B0(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_B0(cpa);
-        CHECK_AND_FILL_VEC_B0(cpaXY);
-        CHECK_AND_FILL_VEC_B0(maxNormalisedDeltaIP);
-        // TPC PID variable
-        CHECK_AND_FILL_VEC_B0_FULL(prongBachPi, tpcNSigmaPiBachPi, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_B0_FULL(prongSoftPi, tpcNSigmaPiSoftPi, tpcNSigmaPiSoftPi);
-        // TOF PID variable
-        CHECK_AND_FILL_VEC_B0_FULL(prongBachPi, tofNSigmaPiBachPi, tofNSigmaPi);
-        CHECK_AND_FILL_VEC_B0_FULL(prongSoftPi, tofNSigmaPiSoftPi, tofNSigmaPiSoftPi);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_B0_FUNC(prongBachPi, tpcTofNSigmaPiBachPi, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_B0_FUNC(prongSoftPi, tpcTofNSigmaPiSoftPi, o2::pid_tpc_tof_utils::getTpcTofNSigmaSoftPi);
+ protected:
+  /// Method to get the table of accessors to the input features of B0 → D∓ π± candidates, built at compile time for each candidate type
+  /// \note the accessors share the signature of the B0 → D*∓ π± ones, without soft pion (nullptr)
+  template <bool withDmesMl, typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2, std::nullptr_t, const std::vector<float>*> const& getFeatureAccessors()
+  {
+    using T3 = std::nullptr_t;
+    static constexpr MlFeatureAccessors<T1, T2, T3, const std::vector<float>*> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T3, const std::vector<float>*> accessors{};
+      SET_ACCESSOR_B0(ptProng0);
+      SET_ACCESSOR_B0(ptProng1);
+      SET_ACCESSOR_B0(impactParameter0);
+      SET_ACCESSOR_B0(impactParameter1);
+      SET_ACCESSOR_B0(impactParameterProduct);
+      SET_ACCESSOR_B0(chi2PCA);
+      SET_ACCESSOR_B0(decayLength);
+      SET_ACCESSOR_B0(decayLengthXY);
+      SET_ACCESSOR_B0(decayLengthNormalised);
+      SET_ACCESSOR_B0(decayLengthXYNormalised);
+      SET_ACCESSOR_B0(cpa);
+      SET_ACCESSOR_B0(cpaXY);
+      SET_ACCESSOR_B0(maxNormalisedDeltaIP);
+      // TPC PID variable
+      SET_ACCESSOR_B0_FULL(prongBachPi, tpcNSigmaPi1, tpcNSigmaPi);
+      // TOF PID variable
+      SET_ACCESSOR_B0_FULL(prongBachPi, tofNSigmaPi1, tofNSigmaPi);
+      // Combined PID variables
+      SET_ACCESSOR_B0_FUNC(prongBachPi, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
+      if constexpr (withDmesMl) {
+        if constexpr (reduced) {
+          SET_ACCESSOR_B0(prong0MlScoreBkg);
+          SET_ACCESSOR_B0(prong0MlScorePrompt);
+          SET_ACCESSOR_B0(prong0MlScoreNonprompt);
+        } else {
+          SET_ACCESSOR_B0_INDEX(prong0MlScoreBkg, *mlScoresD, 0);
+          SET_ACCESSOR_B0_INDEX(prong0MlScorePrompt, *mlScoresD, 1);
+          SET_ACCESSOR_B0_INDEX(prong0MlScoreNonprompt, *mlScoresD, 2);
+        }
       }
+      return accessors;
+    }();
+    return Accessors;
+  }
+
+  /// Method to get the table of accessors to the input features of B0 → D*∓ π± candidates, built at compile time for each candidate type
+  template <bool withDmesMl, typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, T3, const std::vector<float>*> const& getFeatureAccessorsDStarPi()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, T3, const std::vector<float>*> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T3, const std::vector<float>*> accessors{};
+      SET_ACCESSOR_B0(ptProng0);
+      SET_ACCESSOR_B0(ptProng1);
+      SET_ACCESSOR_B0(ptProng2);
+      SET_ACCESSOR_B0(impactParameter0);
+      SET_ACCESSOR_B0(impactParameter1);
+      SET_ACCESSOR_B0(impactParameter2);
+      SET_ACCESSOR_B0(impactParameterProngSqSum);
+      SET_ACCESSOR_B0(chi2PCA);
+      SET_ACCESSOR_B0(decayLength);
+      SET_ACCESSOR_B0(decayLengthXY);
+      SET_ACCESSOR_B0(decayLengthNormalised);
+      SET_ACCESSOR_B0(decayLengthXYNormalised);
+      SET_ACCESSOR_B0(cpa);
+      SET_ACCESSOR_B0(cpaXY);
+      SET_ACCESSOR_B0(maxNormalisedDeltaIP);
+      // TPC PID variable
+      SET_ACCESSOR_B0_FULL(prongBachPi, tpcNSigmaPiBachPi, tpcNSigmaPi);
+      SET_ACCESSOR_B0_FULL(prongSoftPi, tpcNSigmaPiSoftPi, tpcNSigmaPiSoftPi);
+      // TOF PID variable
+      SET_ACCESSOR_B0_FULL(prongBachPi, tofNSigmaPiBachPi, tofNSigmaPi);
+      SET_ACCESSOR_B0_FULL(prongSoftPi, tofNSigmaPiSoftPi, tofNSigmaPiSoftPi);
+      // Combined PID variables
+      SET_ACCESSOR_B0_FUNC(prongBachPi, tpcTofNSigmaPiBachPi, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
+      SET_ACCESSOR_B0_FUNC(prongSoftPi, tpcTofNSigmaPiSoftPi, o2::pid_tpc_tof_utils::getTpcTofNSigmaSoftPi);
       if constexpr (withDmesMl) {
         if constexpr (reduced) {
-          switch (idx) {
-            CHECK_AND_FILL_VEC_B0(prong0MlScoreBkg);
-            CHECK_AND_FILL_VEC_B0(prong0MlScorePrompt);
-            CHECK_AND_FILL_VEC_B0(prong0MlScoreNonprompt);
-          }
+          SET_ACCESSOR_B0(prong0MlScoreBkg);
+          SET_ACCESSOR_B0(prong0MlScorePrompt);
+          SET_ACCESSOR_B0(prong0MlScoreNonprompt);
         } else {
-          if (mlScoresD) {
-            switch (idx) {
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScoreBkg, *mlScoresD, 0);
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScorePrompt, *mlScoresD, 1);
-              CHECK_AND_FILL_VEC_B0_INDEX(prong0MlScoreNonprompt, *mlScoresD, 2);
-            }
-          } else {
-            LOG(fatal) << "ML scores of D not provided";
-          }
+          SET_ACCESSOR_B0_INDEX(prong0MlScoreBkg, *mlScoresD, 0);
+          SET_ACCESSOR_B0_INDEX(prong0MlScorePrompt, *mlScoresD, 1);
+          SET_ACCESSOR_B0_INDEX(prong0MlScoreNonprompt, *mlScoresD, 2);
         }
       }
-    }
+      return accessors;
+    }();
+    return Accessors;
+  }
 
-    return inputFeatures;
+  /// Method to check that the ML scores of the D meson are provided when needed
+  template <bool withDmesMl>
+  static void checkMlScoresD(const std::vector<float>* mlScoresD)
+  {
+    if constexpr (withDmesMl && !reduced) {
+      if (!mlScoresD) {
+        LOG(fatal) << "ML scores of D not provided";
+      }
+    }
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -277,8 +297,9 @@ class HfMlResponseB0ToDPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_B0
-#undef CHECK_AND_FILL_VEC_B0_FULL
-#undef CHECK_AND_FILL_VEC_B0_FUNC
-#undef CHECK_AND_FILL_VEC_B0
+#undef SET_ACCESSOR_B0_VALUE
+#undef SET_ACCESSOR_B0_FULL
+#undef SET_ACCESSOR_B0_FUNC
+#undef SET_ACCESSOR_B0
 
 #endif // PWGHF_CORE_HFMLRESPONSEB0TODPI_H_
@@ -24,6 +24,7 @@
 #include <CommonConstants/PhysicsConstants.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -34,44 +35,33 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesBplusToD0Pi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0Pi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                  \
-    break;                                                        \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_BPLUS_VALUE(FEATURE, VALUE)                                                                                                                                                                                           \
+  accessors[static_cast<uint8_t>(InputFeaturesBplusToD0Pi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& candidateD0, [[maybe_unused]] int const& pdgCode, [[maybe_unused]] T3 const& prong1) -> float { \
+    return VALUE;                                                                                                                                                                                                                          \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_BPLUS_FUNC(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0Pi::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                   \
-    break;                                                        \
-  }
+#define SET_ACCESSOR_BPLUS_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_BPLUS(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0Pi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());              \
-    break;                                                       \
-  }
+#define SET_ACCESSOR_BPLUS(GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(GETTER, candidate.GETTER())
 
 // where OBJECT is named candidateD , FEATURE = GETTER and INDEX is the index of the vector
-#define CHECK_AND_FILL_VEC_D0_INDEX(FEATURE, GETTER1, GETTER2, INDEX) \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0Pi::FEATURE): {     \
-    if (pdgCode == o2::constants::physics::Pdg::kD0) {                \
-      inputFeatures.emplace_back((candidateD0.GETTER1())[INDEX]);     \
-    } else {                                                          \
-      inputFeatures.emplace_back((candidateD0.GETTER2())[INDEX]);     \
-    }                                                                 \
-    break;                                                            \
-  }
+#define SET_ACCESSOR_D0_INDEX(FEATURE, GETTER1, GETTER2, INDEX) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, pdgCode == o2::constants::physics::Pdg::kD0 ? (candidateD0.GETTER1())[INDEX] : (candidateD0.GETTER2())[INDEX])
 
 namespace o2::analysis
 {
@@ -117,63 +107,73 @@ class HfMlResponseBplusToD0Pi : public HfMlResponse<TypeOutputScore>
                                       int const& pdgCode,
                                       T3 const& prong1)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<withDmesMl, T1, T2, T3>(), candidate, candidateD0, pdgCode, prong1);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2, typename T3>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& candidateD0, int const& pdgCode, T3 const& prong1)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<withDmesMl, T1, T2, T3>(), candidate, candidateD0, pdgCode, prong1);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <bool withDmesMl, typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, int, T3> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, int, T3> Accessors = [] {
+      MlFeatureAccessors<T1, T2, int, T3> accessors{};
       if constexpr (withDmesMl) {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BPLUS(ptProng0);
-          CHECK_AND_FILL_VEC_BPLUS(ptProng1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter0);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BPLUS(chi2PCA);
-          CHECK_AND_FILL_VEC_BPLUS(decayLength);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(cpa);
-          CHECK_AND_FILL_VEC_BPLUS(cpaXY);
-          CHECK_AND_FILL_VEC_BPLUS(maxNormalisedDeltaIP);
-          CHECK_AND_FILL_VEC_D0_INDEX(prong0MlProbBkg, mlProbD0, mlProbD0bar, 0);
-          CHECK_AND_FILL_VEC_D0_INDEX(prong0MlProbPrompt, mlProbD0, mlProbD0bar, 1);
-          CHECK_AND_FILL_VEC_D0_INDEX(prong0MlProbNonPrompt, mlProbD0, mlProbD0bar, 2);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BPLUS(ptProng0);
+        SET_ACCESSOR_BPLUS(ptProng1);
+        SET_ACCESSOR_BPLUS(impactParameter0);
+        SET_ACCESSOR_BPLUS(impactParameter1);
+        SET_ACCESSOR_BPLUS(impactParameterProduct);
+        SET_ACCESSOR_BPLUS(chi2PCA);
+        SET_ACCESSOR_BPLUS(decayLength);
+        SET_ACCESSOR_BPLUS(decayLengthXY);
+        SET_ACCESSOR_BPLUS(decayLengthNormalised);
+        SET_ACCESSOR_BPLUS(decayLengthXYNormalised);
+        SET_ACCESSOR_BPLUS(cpa);
+        SET_ACCESSOR_BPLUS(cpaXY);
+        SET_ACCESSOR_BPLUS(maxNormalisedDeltaIP);
+        SET_ACCESSOR_D0_INDEX(prong0MlProbBkg, mlProbD0, mlProbD0bar, 0);
+        SET_ACCESSOR_D0_INDEX(prong0MlProbPrompt, mlProbD0, mlProbD0bar, 1);
+        SET_ACCESSOR_D0_INDEX(prong0MlProbNonPrompt, mlProbD0, mlProbD0bar, 2);
+        // TPC PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       } else {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BPLUS(ptProng0);
-          CHECK_AND_FILL_VEC_BPLUS(ptProng1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter0);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BPLUS(chi2PCA);
-          CHECK_AND_FILL_VEC_BPLUS(decayLength);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(cpa);
-          CHECK_AND_FILL_VEC_BPLUS(cpaXY);
-          CHECK_AND_FILL_VEC_BPLUS(maxNormalisedDeltaIP);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BPLUS(ptProng0);
+        SET_ACCESSOR_BPLUS(ptProng1);
+        SET_ACCESSOR_BPLUS(impactParameter0);
+        SET_ACCESSOR_BPLUS(impactParameter1);
+        SET_ACCESSOR_BPLUS(impactParameterProduct);
+        SET_ACCESSOR_BPLUS(chi2PCA);
+        SET_ACCESSOR_BPLUS(decayLength);
+        SET_ACCESSOR_BPLUS(decayLengthXY);
+        SET_ACCESSOR_BPLUS(decayLengthNormalised);
+        SET_ACCESSOR_BPLUS(decayLengthXYNormalised);
+        SET_ACCESSOR_BPLUS(cpa);
+        SET_ACCESSOR_BPLUS(cpaXY);
+        SET_ACCESSOR_BPLUS(maxNormalisedDeltaIP);
+        // TPC PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       }
-    }
-
-    return inputFeatures;
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -206,8 +206,9 @@ class HfMlResponseBplusToD0Pi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_BPLUS
-#undef CHECK_AND_FILL_VEC_BPLUS_FULL
-#undef CHECK_AND_FILL_VEC_BPLUS_FUNC
-#undef CHECK_AND_FILL_VEC_BPLUS
+#undef SET_ACCESSOR_BPLUS_VALUE
+#undef SET_ACCESSOR_BPLUS_FULL
+#undef SET_ACCESSOR_BPLUS_FUNC
+#undef SET_ACCESSOR_BPLUS
 
 #endif // PWGHF_CORE_HFMLRESPONSEBPLUSTOD0PI_H_
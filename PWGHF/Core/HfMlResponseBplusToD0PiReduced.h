@@ -22,6 +22,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -32,33 +33,29 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesBplusToD0PiReduced::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)           \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0PiReduced::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                         \
-    break;                                                               \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_BPLUS_VALUE(FEATURE, VALUE)                                                                                                                     \
+  accessors[static_cast<uint8_t>(InputFeaturesBplusToD0PiReduced::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong1) -> float { \
+    return VALUE;                                                                                                                                                    \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_BPLUS_FUNC(OBJECT, FEATURE, GETTER)           \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0PiReduced::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                          \
-    break;                                                               \
-  }
+#define SET_ACCESSOR_BPLUS_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_BPLUS(GETTER)                                \
-  case static_cast<uint8_t>(InputFeaturesBplusToD0PiReduced::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());                     \
-    break;                                                              \
-  }
+#define SET_ACCESSOR_BPLUS(GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -102,63 +99,73 @@ class HfMlResponseBplusToD0PiReduced : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong1)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prong1)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
+
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <bool withDmesMl, typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2> Accessors = [] {
+      MlFeatureAccessors<T1, T2> accessors{};
       if constexpr (withDmesMl) {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BPLUS(ptProng0);
-          CHECK_AND_FILL_VEC_BPLUS(ptProng1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter0);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BPLUS(chi2PCA);
-          CHECK_AND_FILL_VEC_BPLUS(decayLength);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(cpa);
-          CHECK_AND_FILL_VEC_BPLUS(cpaXY);
-          CHECK_AND_FILL_VEC_BPLUS(maxNormalisedDeltaIP);
-          CHECK_AND_FILL_VEC_BPLUS(prong0MlScoreBkg);
-          CHECK_AND_FILL_VEC_BPLUS(prong0MlScorePrompt);
-          CHECK_AND_FILL_VEC_BPLUS(prong0MlScoreNonprompt);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BPLUS(ptProng0);
+        SET_ACCESSOR_BPLUS(ptProng1);
+        SET_ACCESSOR_BPLUS(impactParameter0);
+        SET_ACCESSOR_BPLUS(impactParameter1);
+        SET_ACCESSOR_BPLUS(impactParameterProduct);
+        SET_ACCESSOR_BPLUS(chi2PCA);
+        SET_ACCESSOR_BPLUS(decayLength);
+        SET_ACCESSOR_BPLUS(decayLengthXY);
+        SET_ACCESSOR_BPLUS(decayLengthNormalised);
+        SET_ACCESSOR_BPLUS(decayLengthXYNormalised);
+        SET_ACCESSOR_BPLUS(cpa);
+        SET_ACCESSOR_BPLUS(cpaXY);
+        SET_ACCESSOR_BPLUS(maxNormalisedDeltaIP);
+        SET_ACCESSOR_BPLUS(prong0MlScoreBkg);
+        SET_ACCESSOR_BPLUS(prong0MlScorePrompt);
+        SET_ACCESSOR_BPLUS(prong0MlScoreNonprompt);
+        // TPC PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       } else {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BPLUS(ptProng0);
-          CHECK_AND_FILL_VEC_BPLUS(ptProng1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter0);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameter1);
-          CHECK_AND_FILL_VEC_BPLUS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BPLUS(chi2PCA);
-          CHECK_AND_FILL_VEC_BPLUS(decayLength);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BPLUS(cpa);
-          CHECK_AND_FILL_VEC_BPLUS(cpaXY);
-          CHECK_AND_FILL_VEC_BPLUS(maxNormalisedDeltaIP);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BPLUS(ptProng0);
+        SET_ACCESSOR_BPLUS(ptProng1);
+        SET_ACCESSOR_BPLUS(impactParameter0);
+        SET_ACCESSOR_BPLUS(impactParameter1);
+        SET_ACCESSOR_BPLUS(impactParameterProduct);
+        SET_ACCESSOR_BPLUS(chi2PCA);
+        SET_ACCESSOR_BPLUS(decayLength);
+        SET_ACCESSOR_BPLUS(decayLengthXY);
+        SET_ACCESSOR_BPLUS(decayLengthNormalised);
+        SET_ACCESSOR_BPLUS(decayLengthXYNormalised);
+        SET_ACCESSOR_BPLUS(cpa);
+        SET_ACCESSOR_BPLUS(cpaXY);
+        SET_ACCESSOR_BPLUS(maxNormalisedDeltaIP);
+        // TPC PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_BPLUS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_BPLUS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       }
-    }
-
-    return inputFeatures;
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -191,8 +198,9 @@ class HfMlResponseBplusToD0PiReduced : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_BPLUS
-#undef CHECK_AND_FILL_VEC_BPLUS_FULL
-#undef CHECK_AND_FILL_VEC_BPLUS_FUNC
-#undef CHECK_AND_FILL_VEC_BPLUS
+#undef SET_ACCESSOR_BPLUS_VALUE
+#undef SET_ACCESSOR_BPLUS_FULL
+#undef SET_ACCESSOR_BPLUS_FUNC
+#undef SET_ACCESSOR_BPLUS
 
 #endif // PWGHF_CORE_HFMLRESPONSEBPLUSTOD0PIREDUCED_H_
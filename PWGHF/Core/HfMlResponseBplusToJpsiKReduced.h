@@ -24,6 +24,7 @@
 #include <CommonConstants/PhysicsConstants.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -34,41 +35,34 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)            \
-  case static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                          \
-    break;                                                                \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_BPLUS_VALUE(FEATURE, VALUE)                                                                                                                      \
+  accessors[static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong1) -> float { \
+    return VALUE;                                                                                                                                                     \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_BPLUS_FUNC(OBJECT, FEATURE, GETTER)            \
-  case static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                           \
-    break;                                                                \
-  }
+#define SET_ACCESSOR_BPLUS_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_BPLUS(GETTER)                                 \
-  case static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());                      \
-    break;                                                               \
-  }
+#define SET_ACCESSOR_BPLUS(GETTER) \
+  SET_ACCESSOR_BPLUS_VALUE(GETTER, candidate.GETTER())
 
-// Specific case of CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate, FEATURE = GETTER, and args are needed
-#define CHECK_AND_FILL_VEC_BPLUS_WITH_ARGS(GETTER, ARGS...)              \
-  case static_cast<uint8_t>(InputFeaturesBplusToJpsiKReduced::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER(ARGS));                  \
-    break;                                                               \
-  }
+#define SET_ACCESSOR_BPLUS_WITH_ARGS(GETTER, ARGS...) \
+  SET_ACCESSOR_BPLUS_VALUE(GETTER, candidate.GETTER(ARGS))
 
 namespace o2::analysis
 {
@@ -112,39 +106,51 @@ class HfMlResponseBplusToJpsiKReduced : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong1)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_BPLUS(ptProng0);
-        CHECK_AND_FILL_VEC_BPLUS(ptProng1);
-        CHECK_AND_FILL_VEC_BPLUS(impactParameter0);
-        CHECK_AND_FILL_VEC_BPLUS(impactParameter1);
-        CHECK_AND_FILL_VEC_BPLUS(impactParameter2);
-        CHECK_AND_FILL_VEC_BPLUS(impactParameterProduct);
-        CHECK_AND_FILL_VEC_BPLUS(impactParameterProductJpsi);
-        CHECK_AND_FILL_VEC_BPLUS(chi2PCA);
-        CHECK_AND_FILL_VEC_BPLUS(decayLength);
-        CHECK_AND_FILL_VEC_BPLUS(decayLengthXY);
-        CHECK_AND_FILL_VEC_BPLUS(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_BPLUS(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_BPLUS(cpa);
-        CHECK_AND_FILL_VEC_BPLUS(cpaXY);
-        CHECK_AND_FILL_VEC_BPLUS(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_BPLUS_WITH_ARGS(ctXY, std::array{o2::constants::physics::MassMuon, o2::constants::physics::MassMuon, o2::constants::physics::MassKPlus});
-        // TPC PID variable
-        CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tpcNSigmaKa1, tpcNSigmaKa);
-        // TOF PID variable
-        CHECK_AND_FILL_VEC_BPLUS_FULL(prong1, tofNSigmaKa1, tofNSigmaKa);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_BPLUS_FUNC(prong1, tpcTofNSigmaKa1, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2>(), candidate, prong1);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prong1)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2>(), candidate, prong1);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2> Accessors = [] {
+      MlFeatureAccessors<T1, T2> accessors{};
+      SET_ACCESSOR_BPLUS(ptProng0);
+      SET_ACCESSOR_BPLUS(ptProng1);
+      SET_ACCESSOR_BPLUS(impactParameter0);
+      SET_ACCESSOR_BPLUS(impactParameter1);
+      SET_ACCESSOR_BPLUS(impactParameter2);
+      SET_ACCESSOR_BPLUS(impactParameterProduct);
+      SET_ACCESSOR_BPLUS(impactParameterProductJpsi);
+      SET_ACCESSOR_BPLUS(chi2PCA);
+      SET_ACCESSOR_BPLUS(decayLength);
+      SET_ACCESSOR_BPLUS(decayLengthXY);
+      SET_ACCESSOR_BPLUS(decayLengthNormalised);
+      SET_ACCESSOR_BPLUS(decayLengthXYNormalised);
+      SET_ACCESSOR_BPLUS(cpa);
+      SET_ACCESSOR_BPLUS(cpaXY);
+      SET_ACCESSOR_BPLUS(maxNormalisedDeltaIP);
+      SET_ACCESSOR_BPLUS_WITH_ARGS(ctXY, std::array{o2::constants::physics::MassMuon, o2::constants::physics::MassMuon, o2::constants::physics::MassKPlus});
+      // TPC PID variable
+      SET_ACCESSOR_BPLUS_FULL(prong1, tpcNSigmaKa1, tpcNSigmaKa);
+      // TOF PID variable
+      SET_ACCESSOR_BPLUS_FULL(prong1, tofNSigmaKa1, tofNSigmaKa);
+      // Combined PID variables
+      SET_ACCESSOR_BPLUS_FUNC(prong1, tpcTofNSigmaKa1, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -177,8 +183,9 @@ class HfMlResponseBplusToJpsiKReduced : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_BPLUS
-#undef CHECK_AND_FILL_VEC_BPLUS_FULL
-#undef CHECK_AND_FILL_VEC_BPLUS_FUNC
-#undef CHECK_AND_FILL_VEC_BPLUS
+#undef SET_ACCESSOR_BPLUS_VALUE
+#undef SET_ACCESSOR_BPLUS_FULL
+#undef SET_ACCESSOR_BPLUS_FUNC
+#undef SET_ACCESSOR_BPLUS
 
 #endif // PWGHF_CORE_HFMLRESPONSEBPLUSTOJPSIKREDUCED_H_
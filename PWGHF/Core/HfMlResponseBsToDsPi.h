@@ -22,6 +22,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -32,33 +33,29 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesBsToDsPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_BS_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesBsToDsPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());               \
-    break;                                                     \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_BS_VALUE(FEATURE, VALUE)                                                                                                              \
+  accessors[static_cast<uint8_t>(InputFeaturesBsToDsPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong1) -> float { \
+    return VALUE;                                                                                                                                          \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_BS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_BS_FUNC(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesBsToDsPi::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                \
-    break;                                                     \
-  }
+#define SET_ACCESSOR_BS_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BS_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_BS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_BS(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesBsToDsPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_BS(GETTER) \
+  SET_ACCESSOR_BS_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -102,59 +99,69 @@ class HfMlResponseBsToDsPi : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong1)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prong1)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
+
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <bool withDmesMl, typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2> Accessors = [] {
+      MlFeatureAccessors<T1, T2> accessors{};
       if constexpr (withDmesMl) {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BS(ptProng0);
-          CHECK_AND_FILL_VEC_BS(ptProng1);
-          CHECK_AND_FILL_VEC_BS(impactParameter0);
-          CHECK_AND_FILL_VEC_BS(impactParameter1);
-          CHECK_AND_FILL_VEC_BS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BS(chi2PCA);
-          CHECK_AND_FILL_VEC_BS(decayLength);
-          CHECK_AND_FILL_VEC_BS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BS(cpa);
-          CHECK_AND_FILL_VEC_BS(cpaXY);
-          CHECK_AND_FILL_VEC_BS(maxNormalisedDeltaIP);
-          CHECK_AND_FILL_VEC_BS(prong0MlScoreBkg);
-          CHECK_AND_FILL_VEC_BS(prong0MlScorePrompt);
-          CHECK_AND_FILL_VEC_BS(prong0MlScoreNonprompt);
-          //  Pion PID variables
-          CHECK_AND_FILL_VEC_BS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          CHECK_AND_FILL_VEC_BS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          CHECK_AND_FILL_VEC_BS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BS(ptProng0);
+        SET_ACCESSOR_BS(ptProng1);
+        SET_ACCESSOR_BS(impactParameter0);
+        SET_ACCESSOR_BS(impactParameter1);
+        SET_ACCESSOR_BS(impactParameterProduct);
+        SET_ACCESSOR_BS(chi2PCA);
+        SET_ACCESSOR_BS(decayLength);
+        SET_ACCESSOR_BS(decayLengthXY);
+        SET_ACCESSOR_BS(decayLengthNormalised);
+        SET_ACCESSOR_BS(decayLengthXYNormalised);
+        SET_ACCESSOR_BS(cpa);
+        SET_ACCESSOR_BS(cpaXY);
+        SET_ACCESSOR_BS(maxNormalisedDeltaIP);
+        SET_ACCESSOR_BS(prong0MlScoreBkg);
+        SET_ACCESSOR_BS(prong0MlScorePrompt);
+        SET_ACCESSOR_BS(prong0MlScoreNonprompt);
+        //  Pion PID variables
+        SET_ACCESSOR_BS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        SET_ACCESSOR_BS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        SET_ACCESSOR_BS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       } else {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_BS(ptProng0);
-          CHECK_AND_FILL_VEC_BS(ptProng1);
-          CHECK_AND_FILL_VEC_BS(impactParameter0);
-          CHECK_AND_FILL_VEC_BS(impactParameter1);
-          CHECK_AND_FILL_VEC_BS(impactParameterProduct);
-          CHECK_AND_FILL_VEC_BS(chi2PCA);
-          CHECK_AND_FILL_VEC_BS(decayLength);
-          CHECK_AND_FILL_VEC_BS(decayLengthXY);
-          CHECK_AND_FILL_VEC_BS(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_BS(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_BS(cpa);
-          CHECK_AND_FILL_VEC_BS(cpaXY);
-          CHECK_AND_FILL_VEC_BS(maxNormalisedDeltaIP);
-          // Pion PID variables
-          CHECK_AND_FILL_VEC_BS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          CHECK_AND_FILL_VEC_BS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          CHECK_AND_FILL_VEC_BS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_BS(ptProng0);
+        SET_ACCESSOR_BS(ptProng1);
+        SET_ACCESSOR_BS(impactParameter0);
+        SET_ACCESSOR_BS(impactParameter1);
+        SET_ACCESSOR_BS(impactParameterProduct);
+        SET_ACCESSOR_BS(chi2PCA);
+        SET_ACCESSOR_BS(decayLength);
+        SET_ACCESSOR_BS(decayLengthXY);
+        SET_ACCESSOR_BS(decayLengthNormalised);
+        SET_ACCESSOR_BS(decayLengthXYNormalised);
+        SET_ACCESSOR_BS(cpa);
+        SET_ACCESSOR_BS(cpaXY);
+        SET_ACCESSOR_BS(maxNormalisedDeltaIP);
+        // Pion PID variables
+        SET_ACCESSOR_BS_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        SET_ACCESSOR_BS_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        SET_ACCESSOR_BS_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       }
-    }
-
-    return inputFeatures;
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -185,8 +192,9 @@ class HfMlResponseBsToDsPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_BS
-#undef CHECK_AND_FILL_VEC_BS_FULL
-#undef CHECK_AND_FILL_VEC_BS_FUNC
-#undef CHECK_AND_FILL_VEC_BS
+#undef SET_ACCESSOR_BS_VALUE
+#undef SET_ACCESSOR_BS_FULL
+#undef SET_ACCESSOR_BS_FUNC
+#undef SET_ACCESSOR_BS
 
 #endif // PWGHF_CORE_HFMLRESPONSEBSTODSPI_H_
@@ -24,6 +24,7 @@
 #include <CommonConstants/PhysicsConstants.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -34,41 +35,34 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_BS_FULL(OBJECT, FEATURE, GETTER)              \
-  case static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                         \
-    break;                                                               \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_BS_VALUE(FEATURE, VALUE)                                                                                                                                                           \
+  accessors[static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong1, [[maybe_unused]] T3 const& prong2) -> float { \
+    return VALUE;                                                                                                                                                                                       \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_BS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_BS_FUNC(OBJECT, FEATURE, GETTER)              \
-  case static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                          \
-    break;                                                               \
-  }
+#define SET_ACCESSOR_BS_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_BS_VALUE(FEATURE, GETTER(OBJECT))
 
-// Specific case of CHECK_AND_FILL_VEC_BS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_BS(GETTER)                                   \
-  case static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());                     \
-    break;                                                              \
-  }
+#define SET_ACCESSOR_BS(GETTER) \
+  SET_ACCESSOR_BS_VALUE(GETTER, candidate.GETTER())
 
-// Specific case of CHECK_AND_FILL_VEC_BPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_BPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER and args are needed
-#define CHECK_AND_FILL_VEC_BS_WITH_ARGS(GETTER, ARGS...)                \
-  case static_cast<uint8_t>(InputFeaturesBsToJpsiPhiReduced::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER(ARGS));                 \
-    break;                                                              \
-  }
+#define SET_ACCESSOR_BS_WITH_ARGS(GETTER, ARGS...) \
+  SET_ACCESSOR_BS_VALUE(GETTER, candidate.GETTER(ARGS))
 
 namespace o2::analysis
 {
@@ -118,47 +112,59 @@ class HfMlResponseBsToJpsiPhiReduced : public HfMlResponse<TypeOutputScore>
                                       T2 const& prong1,
                                       T3 const& prong2)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_BS(ptProng0);
-        CHECK_AND_FILL_VEC_BS(ptProng1);
-        CHECK_AND_FILL_VEC_BS(impactParameter0);
-        CHECK_AND_FILL_VEC_BS(impactParameter1);
-        CHECK_AND_FILL_VEC_BS(impactParameter2);
-        CHECK_AND_FILL_VEC_BS(impactParameter3);
-        CHECK_AND_FILL_VEC_BS(impactParameterProduct);
-        CHECK_AND_FILL_VEC_BS(impactParameterProductJpsi);
-        CHECK_AND_FILL_VEC_BS(impactParameterProductPhi);
-        CHECK_AND_FILL_VEC_BS(chi2PCA);
-        CHECK_AND_FILL_VEC_BS(decayLength);
-        CHECK_AND_FILL_VEC_BS(decayLengthXY);
-        CHECK_AND_FILL_VEC_BS(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_BS(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_BS(cpa);
-        CHECK_AND_FILL_VEC_BS(cpaXY);
-        CHECK_AND_FILL_VEC_BS(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_BS_WITH_ARGS(ctXY, std::array{o2::constants::physics::MassMuon, o2::constants::physics::MassMuon, o2::constants::physics::MassKPlus, o2::constants::physics::MassKPlus});
-        // TPC PID variable
-        CHECK_AND_FILL_VEC_BS_FULL(prong1, tpcNSigmaKa0, tpcNSigmaKa);
-        // TOF PID variable
-        CHECK_AND_FILL_VEC_BS_FULL(prong1, tofNSigmaKa0, tofNSigmaKa);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_BS_FUNC(prong1, tpcTofNSigmaKa0, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
-        // TPC PID variable
-        CHECK_AND_FILL_VEC_BS_FULL(prong2, tpcNSigmaKa1, tpcNSigmaKa);
-        // TOF PID variable
-        CHECK_AND_FILL_VEC_BS_FULL(prong2, tofNSigmaKa1, tofNSigmaKa);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_BS_FUNC(prong2, tpcTofNSigmaKa1, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2, T3>(), candidate, prong1, prong2);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2, typename T3>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prong1, T3 const& prong2)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2, T3>(), candidate, prong1, prong2);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, T3> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, T3> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T3> accessors{};
+      SET_ACCESSOR_BS(ptProng0);
+      SET_ACCESSOR_BS(ptProng1);
+      SET_ACCESSOR_BS(impactParameter0);
+      SET_ACCESSOR_BS(impactParameter1);
+      SET_ACCESSOR_BS(impactParameter2);
+      SET_ACCESSOR_BS(impactParameter3);
+      SET_ACCESSOR_BS(impactParameterProduct);
+      SET_ACCESSOR_BS(impactParameterProductJpsi);
+      SET_ACCESSOR_BS(impactParameterProductPhi);
+      SET_ACCESSOR_BS(chi2PCA);
+      SET_ACCESSOR_BS(decayLength);
+      SET_ACCESSOR_BS(decayLengthXY);
+      SET_ACCESSOR_BS(decayLengthNormalised);
+      SET_ACCESSOR_BS(decayLengthXYNormalised);
+      SET_ACCESSOR_BS(cpa);
+      SET_ACCESSOR_BS(cpaXY);
+      SET_ACCESSOR_BS(maxNormalisedDeltaIP);
+      SET_ACCESSOR_BS_WITH_ARGS(ctXY, std::array{o2::constants::physics::MassMuon, o2::constants::physics::MassMuon, o2::constants::physics::MassKPlus, o2::constants::physics::MassKPlus});
+      // TPC PID variable
+      SET_ACCESSOR_BS_FULL(prong1, tpcNSigmaKa0, tpcNSigmaKa);
+      // TOF PID variable
+      SET_ACCESSOR_BS_FULL(prong1, tofNSigmaKa0, tofNSigmaKa);
+      // Combined PID variables
+      SET_ACCESSOR_BS_FUNC(prong1, tpcTofNSigmaKa0, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
+      // TPC PID variable
+      SET_ACCESSOR_BS_FULL(prong2, tpcNSigmaKa1, tpcNSigmaKa);
+      // TOF PID variable
+      SET_ACCESSOR_BS_FULL(prong2, tofNSigmaKa1, tofNSigmaKa);
+      // Combined PID variables
+      SET_ACCESSOR_BS_FUNC(prong2, tpcTofNSigmaKa1, o2::pid_tpc_tof_utils::getTpcTofNSigmaKa1);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -199,8 +205,9 @@ class HfMlResponseBsToJpsiPhiReduced : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_BS
-#undef CHECK_AND_FILL_VEC_BS_FULL
-#undef CHECK_AND_FILL_VEC_BS_FUNC
-#undef CHECK_AND_FILL_VEC_BS
+#undef SET_ACCESSOR_BS_VALUE
+#undef SET_ACCESSOR_BS_FULL
+#undef SET_ACCESSOR_BS_FUNC
+#undef SET_ACCESSOR_BS
 
 #endif // PWGHF_CORE_HFMLRESPONSEBSTOJPSIPHIREDUCED_H_
@@ -25,6 +25,7 @@
 #include <CommonConstants/PhysicsConstants.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -35,85 +36,54 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)   \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());              \
-    break;                                                    \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_D0_VALUE(FEATURE, VALUE)                                                                                                               \
+  accessors[static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] int const& pdgCode) -> float { \
+    return VALUE;                                                                                                                                           \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_D0_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_D0_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_D0_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_D0(GETTER)                        \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());          \
-    break;                                                   \
-  }
+#define SET_ACCESSOR_D0(GETTER) \
+  SET_ACCESSOR_D0_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_D0_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of HfHelper
-#define CHECK_AND_FILL_VEC_D0_HFHELPER(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {   \
-    inputFeatures.emplace_back(HfHelper::GETTER(OBJECT));       \
-    break;                                                      \
-  }
+#define SET_ACCESSOR_D0_HFHELPER(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_D0_VALUE(FEATURE, HfHelper::GETTER(OBJECT))
 
-// Variation of CHECK_AND_FILL_VEC_D0_HFHELPER(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_D0_HFHELPER(OBJECT, FEATURE, GETTER)
 // where GETTER1 and GETTER2 are methods of HfHelper, and the variable
 // is filled depending on whether it is a D0 or a D0bar
-#define CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {                    \
-    if (pdgCode == o2::constants::physics::kD0) {                                \
-      inputFeatures.emplace_back(HfHelper::GETTER1(OBJECT));                     \
-    } else {                                                                     \
-      inputFeatures.emplace_back(HfHelper::GETTER2(OBJECT));                     \
-    }                                                                            \
-    break;                                                                       \
-  }
+#define SET_ACCESSOR_D0_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_D0_VALUE(FEATURE, pdgCode == o2::constants::physics::kD0 ? HfHelper::GETTER1(OBJECT) : HfHelper::GETTER2(OBJECT))
 
-// Variation of CHECK_AND_FILL_VEC_D0_HFHELPER(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_D0_HFHELPER(OBJECT, FEATURE, GETTER)
 // where GETTER1 and GETTER2 are methods of HfHelper, and the variable
 // is filled depending on whether it is a D0 or a D0bar
-#define CHECK_AND_FILL_VEC_D0_OBJECT_HFHELPER_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {                           \
-    if (pdgCode == o2::constants::physics::kD0) {                                       \
-      inputFeatures.emplace_back(OBJECT1.GETTER());                                     \
-    } else {                                                                            \
-      inputFeatures.emplace_back(OBJECT2.GETTER());                                     \
-    }                                                                                   \
-    break;                                                                              \
-  }
+#define SET_ACCESSOR_D0_OBJECT_HFHELPER_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
+  SET_ACCESSOR_D0_VALUE(FEATURE, pdgCode == o2::constants::physics::kD0 ? OBJECT1.GETTER() : OBJECT2.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
+// Variation of SET_ACCESSOR_D0_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
 // where GETTER1 and GETTER2 are methods of the OBJECT, and the variable
 // is filled depending on whether it is a D0 or a D0bar
-#define CHECK_AND_FILL_VEC_D0_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {           \
-    if (pdgCode == o2::constants::physics::kD0) {                       \
-      inputFeatures.emplace_back(OBJECT.GETTER1());                     \
-    } else {                                                            \
-      inputFeatures.emplace_back(OBJECT.GETTER2());                     \
-    }                                                                   \
-    break;                                                              \
-  }
+#define SET_ACCESSOR_D0_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_D0_VALUE(FEATURE, pdgCode == o2::constants::physics::kD0 ? OBJECT.GETTER1() : OBJECT.GETTER2())
 
-// Variation of CHECK_AND_FILL_VEC_D0_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
+// Variation of SET_ACCESSOR_D0_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
 // where GETTER1 and GETTER2 are methods of the OBJECT, the variable
 // is filled depending on whether it is a D0 or a D0bar
 // and INDEX is the index of the vector
-#define CHECK_AND_FILL_VEC_D0_ML(OBJECT, FEATURE, GETTER1, GETTER2, INDEX) \
-  case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {              \
-    if constexpr (usingMl) {                                               \
-      if (pdgCode == o2::constants::physics::kD0) {                        \
-        inputFeatures.emplace_back(OBJECT.GETTER1()[INDEX]);               \
-      } else {                                                             \
-        inputFeatures.emplace_back(OBJECT.GETTER2()[INDEX]);               \
-      }                                                                    \
-    }                                                                      \
-    break;                                                                 \
+#define SET_ACCESSOR_D0_ML(OBJECT, FEATURE, GETTER1, GETTER2, INDEX)                                                            \
+  if constexpr (usingMl) {                                                                                                      \
+    SET_ACCESSOR_D0_VALUE(FEATURE, pdgCode == o2::constants::physics::kD0 ? OBJECT.GETTER1()[INDEX] : OBJECT.GETTER2()[INDEX]); \
   }
 
 namespace o2::analysis
@@ -181,66 +151,78 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
   template <bool usingMl = false, typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate, int const& pdgCode)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<usingMl, T1>(), candidate, pdgCode);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_D0(chi2PCA);
-        CHECK_AND_FILL_VEC_D0(decayLength);
-        CHECK_AND_FILL_VEC_D0(decayLengthXY);
-        CHECK_AND_FILL_VEC_D0(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_D0(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_D0(ptProng0);
-        CHECK_AND_FILL_VEC_D0(ptProng1);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_D0(impactParameterZ0);
-        CHECK_AND_FILL_VEC_D0(impactParameterZ1);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcPi0, /*getter*/ nSigTpcPi0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcKa0, /*getter*/ nSigTpcKa0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcPi1, /*getter*/ nSigTpcPi1);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcKa1, /*getter*/ nSigTpcKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcPiExpPi, nSigTpcPi0, nSigTpcPi1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcKaExpPi, nSigTpcKa0, nSigTpcKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcPiExpKa, nSigTpcPi1, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcKaExpKa, nSigTpcKa1, nSigTpcKa0);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTofPi0, /*getter*/ nSigTofPi0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTofKa0, /*getter*/ nSigTofKa0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTofPi1, /*getter*/ nSigTofPi1);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTofKa1, /*getter*/ nSigTofKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTofPiExpPi, nSigTofPi0, nSigTofPi1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTofKaExpPi, nSigTofKa0, nSigTofKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTofPiExpKa, nSigTofPi1, nSigTofPi0);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTofKaExpKa, nSigTofKa1, nSigTofKa0);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcTofPi0, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcTofKa0, tpcTofNSigmaKa0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcTofPi1, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, nSigTpcTofKa1, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcTofPiExpPi, tpcTofNSigmaPi0, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcTofKaExpPi, tpcTofNSigmaKa0, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcTofPiExpKa, tpcTofNSigmaPi1, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_D0_SIGNED(candidate, nSigTpcTofKaExpKa, tpcTofNSigmaKa1, tpcTofNSigmaKa0);
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool usingMl = false, typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, int const& pdgCode)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<usingMl, T1>(), candidate, pdgCode);
+  }
 
-        CHECK_AND_FILL_VEC_D0_ML(candidate, bdtOutputBkg, mlProbD0, mlProbD0bar, 0);
-        CHECK_AND_FILL_VEC_D0_ML(candidate, bdtOutputNonPrompt, mlProbD0, mlProbD0bar, 1);
-        CHECK_AND_FILL_VEC_D0_ML(candidate, bdtOutputPrompt, mlProbD0, mlProbD0bar, 2);
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <bool usingMl, typename T1>
+  static MlFeatureAccessors<T1, int> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, int> Accessors = [] {
+      MlFeatureAccessors<T1, int> accessors{};
+      SET_ACCESSOR_D0(chi2PCA);
+      SET_ACCESSOR_D0(decayLength);
+      SET_ACCESSOR_D0(decayLengthXY);
+      SET_ACCESSOR_D0(decayLengthNormalised);
+      SET_ACCESSOR_D0(decayLengthXYNormalised);
+      SET_ACCESSOR_D0(ptProng0);
+      SET_ACCESSOR_D0(ptProng1);
+      SET_ACCESSOR_D0_FULL(candidate, impactParameterXY0, impactParameter0);
+      SET_ACCESSOR_D0_FULL(candidate, impactParameterXY1, impactParameter1);
+      SET_ACCESSOR_D0(impactParameterZ0);
+      SET_ACCESSOR_D0(impactParameterZ1);
+      // TPC PID variables
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcPi0, /*getter*/ nSigTpcPi0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcKa0, /*getter*/ nSigTpcKa0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcPi1, /*getter*/ nSigTpcPi1);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcKa1, /*getter*/ nSigTpcKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcPiExpPi, nSigTpcPi0, nSigTpcPi1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcKaExpPi, nSigTpcKa0, nSigTpcKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcPiExpKa, nSigTpcPi1, nSigTpcPi0);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcKaExpKa, nSigTpcKa1, nSigTpcKa0);
+      // TOF PID variables
+      SET_ACCESSOR_D0_FULL(candidate, nSigTofPi0, /*getter*/ nSigTofPi0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTofKa0, /*getter*/ nSigTofKa0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTofPi1, /*getter*/ nSigTofPi1);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTofKa1, /*getter*/ nSigTofKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTofPiExpPi, nSigTofPi0, nSigTofPi1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTofKaExpPi, nSigTofKa0, nSigTofKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTofPiExpKa, nSigTofPi1, nSigTofPi0);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTofKaExpKa, nSigTofKa1, nSigTofKa0);
+      // Combined PID variables
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcTofPi0, tpcTofNSigmaPi0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcTofKa0, tpcTofNSigmaKa0);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcTofPi1, tpcTofNSigmaPi1);
+      SET_ACCESSOR_D0_FULL(candidate, nSigTpcTofKa1, tpcTofNSigmaKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcTofPiExpPi, tpcTofNSigmaPi0, tpcTofNSigmaPi1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcTofKaExpPi, tpcTofNSigmaKa0, tpcTofNSigmaKa1);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcTofPiExpKa, tpcTofNSigmaPi1, tpcTofNSigmaPi0);
+      SET_ACCESSOR_D0_SIGNED(candidate, nSigTpcTofKaExpKa, tpcTofNSigmaKa1, tpcTofNSigmaKa0);
 
-        CHECK_AND_FILL_VEC_D0(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterProduct, impactParameterProduct);
-        CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(candidate, cosThetaStar, cosThetaStarD0, cosThetaStarD0bar);
-        CHECK_AND_FILL_VEC_D0(cpa);
-        CHECK_AND_FILL_VEC_D0(cpaXY);
-        CHECK_AND_FILL_VEC_D0_HFHELPER(candidate, ct, ctD0);
-      }
-    }
+      SET_ACCESSOR_D0_ML(candidate, bdtOutputBkg, mlProbD0, mlProbD0bar, 0);
+      SET_ACCESSOR_D0_ML(candidate, bdtOutputNonPrompt, mlProbD0, mlProbD0bar, 1);
+      SET_ACCESSOR_D0_ML(candidate, bdtOutputPrompt, mlProbD0, mlProbD0bar, 2);
 
-    return inputFeatures;
+      SET_ACCESSOR_D0(maxNormalisedDeltaIP);
+      SET_ACCESSOR_D0_FULL(candidate, impactParameterProduct, impactParameterProduct);
+      SET_ACCESSOR_D0_HFHELPER_SIGNED(candidate, cosThetaStar, cosThetaStarD0, cosThetaStarD0bar);
+      SET_ACCESSOR_D0(cpa);
+      SET_ACCESSOR_D0(cpaXY);
+      SET_ACCESSOR_D0_HFHELPER(candidate, ct, ctD0);
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -300,11 +282,12 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_D0
-#undef CHECK_AND_FILL_VEC_D0_FULL
-#undef CHECK_AND_FILL_VEC_D0
-#undef CHECK_AND_FILL_VEC_D0_HFHELPER
-#undef CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED
-#undef CHECK_AND_FILL_VEC_D0_OBJECT_HFHELPER_SIGNED
-#undef CHECK_AND_FILL_VEC_D0_ML
+#undef SET_ACCESSOR_D0_VALUE
+#undef SET_ACCESSOR_D0_FULL
+#undef SET_ACCESSOR_D0
+#undef SET_ACCESSOR_D0_HFHELPER
+#undef SET_ACCESSOR_D0_HFHELPER_SIGNED
+#undef SET_ACCESSOR_D0_OBJECT_HFHELPER_SIGNED
+#undef SET_ACCESSOR_D0_ML
 
 #endif // PWGHF_CORE_HFMLRESPONSED0TOKPI_H_
@@ -21,6 +21,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -31,23 +32,23 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesDplusToPiKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_DPLUS_FULL(OBJECT, FEATURE, GETTER)     \
-  case static_cast<uint8_t>(InputFeaturesDplusToPiKPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                   \
-    break;                                                         \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_DPLUS_VALUE(FEATURE, VALUE)                                                           \
+  accessors[static_cast<uint8_t>(InputFeaturesDplusToPiKPi::FEATURE)] = [](T1 const& candidate) -> float { \
+    return VALUE;                                                                                          \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_DPLUS_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_DPLUS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_DPLUS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_DPLUS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_DPLUS(GETTER)                          \
-  case static_cast<uint8_t>(InputFeaturesDplusToPiKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());               \
-    break;                                                        \
-  }
+#define SET_ACCESSOR_DPLUS(GETTER) \
+  SET_ACCESSOR_DPLUS_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -108,55 +109,67 @@ class HfMlResponseDplusToPiKPi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_DPLUS(ptProng0);
-        CHECK_AND_FILL_VEC_DPLUS(ptProng1);
-        CHECK_AND_FILL_VEC_DPLUS(ptProng2);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, impactParameterXY2, impactParameter2);
-        CHECK_AND_FILL_VEC_DPLUS(impactParameterZ0);
-        CHECK_AND_FILL_VEC_DPLUS(impactParameterZ1);
-        CHECK_AND_FILL_VEC_DPLUS(impactParameterZ2);
-        CHECK_AND_FILL_VEC_DPLUS(decayLength);
-        CHECK_AND_FILL_VEC_DPLUS(decayLengthXY);
-        CHECK_AND_FILL_VEC_DPLUS(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_DPLUS(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_DPLUS(cpa);
-        CHECK_AND_FILL_VEC_DPLUS(cpaXY);
-        CHECK_AND_FILL_VEC_DPLUS(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_DPLUS(chi2PCA);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_DPLUS_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1> Accessors = [] {
+      MlFeatureAccessors<T1> accessors{};
+      SET_ACCESSOR_DPLUS(ptProng0);
+      SET_ACCESSOR_DPLUS(ptProng1);
+      SET_ACCESSOR_DPLUS(ptProng2);
+      SET_ACCESSOR_DPLUS_FULL(candidate, impactParameterXY0, impactParameter0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, impactParameterXY1, impactParameter1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, impactParameterXY2, impactParameter2);
+      SET_ACCESSOR_DPLUS(impactParameterZ0);
+      SET_ACCESSOR_DPLUS(impactParameterZ1);
+      SET_ACCESSOR_DPLUS(impactParameterZ2);
+      SET_ACCESSOR_DPLUS(decayLength);
+      SET_ACCESSOR_DPLUS(decayLengthXY);
+      SET_ACCESSOR_DPLUS(decayLengthNormalised);
+      SET_ACCESSOR_DPLUS(decayLengthXYNormalised);
+      SET_ACCESSOR_DPLUS(cpa);
+      SET_ACCESSOR_DPLUS(cpaXY);
+      SET_ACCESSOR_DPLUS(maxNormalisedDeltaIP);
+      SET_ACCESSOR_DPLUS(chi2PCA);
+      // TPC PID variables
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
+      // TOF PID variables
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
+      // Combined PID variables
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
+      SET_ACCESSOR_DPLUS_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -205,7 +218,8 @@ class HfMlResponseDplusToPiKPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_DPLUS
-#undef CHECK_AND_FILL_VEC_DPLUS_FULL
-#undef CHECK_AND_FILL_VEC_DPLUS
+#undef SET_ACCESSOR_DPLUS_VALUE
+#undef SET_ACCESSOR_DPLUS_FULL
+#undef SET_ACCESSOR_DPLUS
 
 #endif // PWGHF_CORE_HFMLRESPONSEDPLUSTOPIKPI_H_
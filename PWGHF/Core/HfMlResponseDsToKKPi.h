@@ -22,6 +22,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -32,69 +33,45 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_DS_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());               \
-    break;                                                     \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_DS_VALUE(FEATURE, VALUE)                                                                                                                      \
+  accessors[static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] bool const& caseDsToKKPi) -> float { \
+    return VALUE;                                                                                                                                                  \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_DS_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_DS_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_DS_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_DS_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_DS(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_DS(GETTER) \
+  SET_ACCESSOR_DS_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_DS_FULL(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_DS_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of HfHelper
-#define CHECK_AND_FILL_VEC_DS_HFHELPER(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE): {  \
-    inputFeatures.emplace_back(HfHelper::GETTER(OBJECT));       \
-    break;                                                      \
-  }
+#define SET_ACCESSOR_DS_HFHELPER(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_DS_VALUE(FEATURE, HfHelper::GETTER(OBJECT))
 
-// Variation of CHECK_AND_FILL_VEC_DS_HFHELPER(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_DS_HFHELPER(OBJECT, FEATURE, GETTER)
 // where GETTER1 and GETTER2 are methods of HfHelper, and the variable
 // is filled depending on whether it is a DsToKKPi or a DsToPiKK
-#define CHECK_AND_FILL_VEC_DS_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE): {                   \
-    if (caseDsToKKPi) {                                                          \
-      inputFeatures.emplace_back(HfHelper::GETTER1(OBJECT));                     \
-    } else {                                                                     \
-      inputFeatures.emplace_back(HfHelper::GETTER2(OBJECT));                     \
-    }                                                                            \
-    break;                                                                       \
-  }
+#define SET_ACCESSOR_DS_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_DS_VALUE(FEATURE, caseDsToKKPi ? HfHelper::GETTER1(OBJECT) : HfHelper::GETTER2(OBJECT))
 
-// Variation of CHECK_AND_FILL_VEC_DS_HFHELPER(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_DS_HFHELPER(OBJECT, FEATURE, GETTER)
 // where OBJECT1 and OBJECT2 are the objects from which we call the GETTER method, and the variable
 // is filled depending on whether it is a DsToKKPi or a DsToPiKK
-#define CHECK_AND_FILL_VEC_DS_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE): {                 \
-    if (caseDsToKKPi) {                                                        \
-      inputFeatures.emplace_back(OBJECT1.GETTER());                            \
-    } else {                                                                   \
-      inputFeatures.emplace_back(OBJECT2.GETTER());                            \
-    }                                                                          \
-    break;                                                                     \
-  }
+#define SET_ACCESSOR_DS_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
+  SET_ACCESSOR_DS_VALUE(FEATURE, caseDsToKKPi ? OBJECT1.GETTER() : OBJECT2.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_DS_OBJECT_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
+// Variation of SET_ACCESSOR_DS_OBJECT_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
 // where GETTER1 and GETTER2 are methods of the OBJECT
-#define CHECK_AND_FILL_VEC_DS_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesDsToKKPi::FEATURE): {          \
-    if (caseDsToKKPi) {                                                 \
-      inputFeatures.emplace_back(OBJECT.GETTER1());                     \
-    } else {                                                            \
-      inputFeatures.emplace_back(OBJECT.GETTER2());                     \
-    }                                                                   \
-    break;                                                              \
-  }
+#define SET_ACCESSOR_DS_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_DS_VALUE(FEATURE, caseDsToKKPi ? OBJECT.GETTER1() : OBJECT.GETTER2())
 
 namespace o2::analysis
 {
@@ -164,66 +141,78 @@ class HfMlResponseDsToKKPi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate, bool const caseDsToKKPi)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate, caseDsToKKPi);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_DS(chi2PCA);
-        CHECK_AND_FILL_VEC_DS(decayLength);
-        CHECK_AND_FILL_VEC_DS(decayLengthXY);
-        CHECK_AND_FILL_VEC_DS(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_DS(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_DS(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_DS(cpa);
-        CHECK_AND_FILL_VEC_DS(cpaXY);
-        CHECK_AND_FILL_VEC_DS(ptProng0);
-        CHECK_AND_FILL_VEC_DS(ptProng1);
-        CHECK_AND_FILL_VEC_DS(ptProng2);
-        CHECK_AND_FILL_VEC_DS(impactParameterXY);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, impactParameterXY2, impactParameter2);
-        CHECK_AND_FILL_VEC_DS(impactParameterZ0);
-        CHECK_AND_FILL_VEC_DS(impactParameterZ1);
-        CHECK_AND_FILL_VEC_DS(impactParameterZ2);
-        // TPC and TOF PID variables
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcPi0, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcPi1, nSigTpcPi1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcPi2, nSigTpcPi2);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcKa0, nSigTpcKa0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcKa1, nSigTpcKa1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcKa2, nSigTpcKa2);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofPi0, nSigTofPi0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofPi1, nSigTofPi1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofPi2, nSigTofPi2);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofKa0, nSigTofKa0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofKa1, nSigTofKa1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTofKa2, nSigTofKa2);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTpcKaExpKa0, nSigTpcKa0, nSigTpcKa2);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTpcPiExpPi2, nSigTpcPi2, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTofKaExpKa0, nSigTofKa0, nSigTofKa2);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTofPiExpPi2, nSigTofPi2, nSigTofPi0);
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, bool const caseDsToKKPi)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate, caseDsToKKPi);
+  }
 
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofPi0, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofPi1, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofPi2, tpcTofNSigmaPi2);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofKa0, tpcTofNSigmaKa0);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofKa1, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_DS_FULL(candidate, nSigTpcTofKa2, tpcTofNSigmaKa2);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTpcTofKaExpKa0, tpcTofNSigmaKa0, tpcTofNSigmaKa2);
-        CHECK_AND_FILL_VEC_DS_SIGNED(candidate, nSigTpcTofPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1, bool> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, bool> Accessors = [] {
+      MlFeatureAccessors<T1, bool> accessors{};
+      SET_ACCESSOR_DS(chi2PCA);
+      SET_ACCESSOR_DS(decayLength);
+      SET_ACCESSOR_DS(decayLengthXY);
+      SET_ACCESSOR_DS(decayLengthNormalised);
+      SET_ACCESSOR_DS(decayLengthXYNormalised);
+      SET_ACCESSOR_DS(maxNormalisedDeltaIP);
+      SET_ACCESSOR_DS(cpa);
+      SET_ACCESSOR_DS(cpaXY);
+      SET_ACCESSOR_DS(ptProng0);
+      SET_ACCESSOR_DS(ptProng1);
+      SET_ACCESSOR_DS(ptProng2);
+      SET_ACCESSOR_DS(impactParameterXY);
+      SET_ACCESSOR_DS_FULL(candidate, impactParameterXY0, impactParameter0);
+      SET_ACCESSOR_DS_FULL(candidate, impactParameterXY1, impactParameter1);
+      SET_ACCESSOR_DS_FULL(candidate, impactParameterXY2, impactParameter2);
+      SET_ACCESSOR_DS(impactParameterZ0);
+      SET_ACCESSOR_DS(impactParameterZ1);
+      SET_ACCESSOR_DS(impactParameterZ2);
+      // TPC and TOF PID variables
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcPi0, nSigTpcPi0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcPi1, nSigTpcPi1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcPi2, nSigTpcPi2);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcKa0, nSigTpcKa0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcKa1, nSigTpcKa1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcKa2, nSigTpcKa2);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofPi0, nSigTofPi0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofPi1, nSigTofPi1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofPi2, nSigTofPi2);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofKa0, nSigTofKa0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofKa1, nSigTofKa1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTofKa2, nSigTofKa2);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTpcKaExpKa0, nSigTpcKa0, nSigTpcKa2);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTpcPiExpPi2, nSigTpcPi2, nSigTpcPi0);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTofKaExpKa0, nSigTofKa0, nSigTofKa2);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTofPiExpPi2, nSigTofPi2, nSigTofPi0);
 
-        // Ds specific variables
-        CHECK_AND_FILL_VEC_DS_HFHELPER_SIGNED(candidate, absCos3PiK, absCos3PiKDsToKKPi, absCos3PiKDsToPiKK);
-        CHECK_AND_FILL_VEC_DS_HFHELPER_SIGNED(candidate, deltaMassPhi, deltaMassPhiDsToKKPi, deltaMassPhiDsToPiKK);
-      }
-    }
+      // Combined PID variables
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofPi0, tpcTofNSigmaPi0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofPi1, tpcTofNSigmaPi1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofPi2, tpcTofNSigmaPi2);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofKa0, tpcTofNSigmaKa0);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofKa1, tpcTofNSigmaKa1);
+      SET_ACCESSOR_DS_FULL(candidate, nSigTpcTofKa2, tpcTofNSigmaKa2);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTpcTofKaExpKa0, tpcTofNSigmaKa0, tpcTofNSigmaKa2);
+      SET_ACCESSOR_DS_SIGNED(candidate, nSigTpcTofPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
 
-    return inputFeatures;
+      // Ds specific variables
+      SET_ACCESSOR_DS_HFHELPER_SIGNED(candidate, absCos3PiK, absCos3PiKDsToKKPi, absCos3PiKDsToPiKK);
+      SET_ACCESSOR_DS_HFHELPER_SIGNED(candidate, deltaMassPhi, deltaMassPhiDsToKKPi, deltaMassPhiDsToPiKK);
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -282,10 +271,11 @@ class HfMlResponseDsToKKPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_DS
-#undef CHECK_AND_FILL_VEC_DS_FULL
-#undef CHECK_AND_FILL_VEC_DS
-#undef CHECK_AND_FILL_VEC_DS_HFHELPER
-#undef CHECK_AND_FILL_VEC_DS_HFHELPER_SIGNED
-#undef CHECK_AND_FILL_VEC_D0_OBJECT_HFHELPER_SIGNED
+#undef SET_ACCESSOR_DS_VALUE
+#undef SET_ACCESSOR_DS_FULL
+#undef SET_ACCESSOR_DS
+#undef SET_ACCESSOR_DS_HFHELPER
+#undef SET_ACCESSOR_DS_HFHELPER_SIGNED
+#undef SET_ACCESSOR_D0_OBJECT_HFHELPER_SIGNED
 
 #endif // PWGHF_CORE_HFMLRESPONSEDSTOKKPI_H_
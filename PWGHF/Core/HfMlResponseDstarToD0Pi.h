@@ -23,6 +23,7 @@
 #include <CommonConstants/PhysicsConstants.h>
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -33,67 +34,43 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_DSTAR_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                  \
-    break;                                                        \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_DSTAR_VALUE(FEATURE, VALUE)                                                                                                                       \
+  accessors[static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] bool const& swapDzeroDaus) -> float { \
+    return VALUE;                                                                                                                                                      \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_DSTAR_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_DSTAR_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_DSTAR_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_DSTAR_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_DSTAR(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());              \
-    break;                                                       \
-  }
+#define SET_ACCESSOR_DSTAR(GETTER) \
+  SET_ACCESSOR_DSTAR_VALUE(GETTER, candidate.GETTER())
 
-// Specific case of CHECK_AND_FILL_VEC_DSTAR_FULL(OBJECT, FEATURE, GETTER)
+// Specific case of SET_ACCESSOR_DSTAR_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE != GETTER
-#define CHECK_AND_FILL_VEC_DSTAR_GETTER(FEATURE, GETTER)          \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURE): { \
-    inputFeatures.emplace_back(candidate.GETTER());               \
-    break;                                                        \
-  }
+#define SET_ACCESSOR_DSTAR_GETTER(FEATURE, GETTER) \
+  SET_ACCESSOR_DSTAR_VALUE(FEATURE, candidate.GETTER())
 
-// Very specific case of CHECK_AND_FILL_VEC_DSTAR_FULL(OBJECT, FEATURE, GETTER)
+// Very specific case of SET_ACCESSOR_DSTAR_FULL(OBJECT, FEATURE, GETTER)
 // Use for push back different value for D*+ or D*- candidate
-#define CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(POSGETTER, NEGGETTER, FEATURENAME, SWAP) \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURENAME): {                \
-    if (candidate.signSoftPi() > 0 || !SWAP) {                                       \
-      inputFeatures.emplace_back(candidate.POSGETTER());                             \
-    } else {                                                                         \
-      inputFeatures.emplace_back(candidate.NEGGETTER());                             \
-    }                                                                                \
-    break;                                                                           \
-  }
+#define SET_ACCESSOR_DSTAR_CHARGEBASE(POSGETTER, NEGGETTER, FEATURENAME, SWAP) \
+  SET_ACCESSOR_DSTAR_VALUE(FEATURENAME, candidate.signSoftPi() > 0 || !SWAP ? candidate.POSGETTER() : candidate.NEGGETTER())
 
-// Very specific case of CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(OBJECT, FEATURE, GETTER)
+// Very specific case of SET_ACCESSOR_DSTAR_CHARGEBASE(OBJECT, FEATURE, GETTER)
 // Use for push back different value for D*+ or D*- candidate getting the correct feature from two different objects (tracks)
-#define CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE_FROMOBJECT(OBJECTPOS, OBJECTNEG, FEATURENAME, GETTER, SWAP) \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURENAME): {                                   \
-    if (candidate.signSoftPi() > 0 || !SWAP) {                                                          \
-      inputFeatures.emplace_back(OBJECTPOS.GETTER());                                                   \
-    } else {                                                                                            \
-      inputFeatures.emplace_back(OBJECTNEG.GETTER());                                                   \
-    }                                                                                                   \
-    break;                                                                                              \
-  }
+#define SET_ACCESSOR_DSTAR_CHARGEBASE_FROMOBJECT(OBJECTPOS, OBJECTNEG, FEATURENAME, GETTER, SWAP) \
+  SET_ACCESSOR_DSTAR_VALUE(FEATURENAME, candidate.signSoftPi() > 0 || !SWAP ? OBJECTPOS.GETTER() : OBJECTNEG.GETTER())
 
-// Very specific case of CHECK_AND_FILL_VEC_DSTAR_FULL(OBJECT, FEATURE, GETTER)
+// Very specific case of SET_ACCESSOR_DSTAR_FULL(OBJECT, FEATURE, GETTER)
 // Use for push back deltaMassD0 for D*+ or D*- candidate
-#define CHECK_AND_FILL_VEC_DSTAR_DELTA_MASS_D0(FEATURENAME)                                  \
-  case static_cast<uint8_t>(InputFeaturesDstarToD0Pi::FEATURENAME): {                        \
-    if (candidate.signSoftPi() > 0) {                                                        \
-      inputFeatures.emplace_back(candidate.invMassD0() - o2::constants::physics::MassD0);    \
-    } else {                                                                                 \
-      inputFeatures.emplace_back(candidate.invMassD0Bar() - o2::constants::physics::MassD0); \
-    }                                                                                        \
-    break;                                                                                   \
-  }
+#define SET_ACCESSOR_DSTAR_DELTA_MASS_D0(FEATURENAME) \
+  SET_ACCESSOR_DSTAR_VALUE(FEATURENAME, candidate.signSoftPi() > 0 ? candidate.invMassD0() - o2::constants::physics::MassD0 : candidate.invMassD0Bar() - o2::constants::physics::MassD0)
 
 namespace o2::analysis
 {
@@ -166,62 +143,74 @@ class HfMlResponseDstarToD0Pi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate, bool swapDzeroDaus = true)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_DSTAR(chi2PCAD0);
-        CHECK_AND_FILL_VEC_DSTAR(decayLengthD0);
-        CHECK_AND_FILL_VEC_DSTAR(decayLengthXYD0);
-        CHECK_AND_FILL_VEC_DSTAR(decayLengthNormalisedD0);
-        CHECK_AND_FILL_VEC_DSTAR(decayLengthXYNormalisedD0);
-        CHECK_AND_FILL_VEC_DSTAR(cpaD0);
-        CHECK_AND_FILL_VEC_DSTAR(cpaXYD0);
-        CHECK_AND_FILL_VEC_DSTAR(deltaIPNormalisedMaxD0);
-        CHECK_AND_FILL_VEC_DSTAR(impactParameterProductD0);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(ptProng0, ptProng1, ptProng0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(ptProng1, ptProng0, ptProng1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR(ptSoftPi);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameter0, impactParameter1, impactParameter0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameter1, impactParameter0, impactParameter1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterZ0, impactParameterZ1, impactParameterZ0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterZ1, impactParameterZ0, impactParameterZ1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR(impParamSoftPi);
-        CHECK_AND_FILL_VEC_DSTAR(impParamZSoftPi);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterNormalised0, impactParameterNormalised1, impactParameterNormalised0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterNormalised1, impactParameterNormalised0, impactParameterNormalised1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterZNormalised0, impactParameterZNormalised1, impactParameterZNormalised0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(impactParameterZNormalised1, impactParameterZNormalised0, impactParameterZNormalised1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR(normalisedImpParamSoftPi);
-        CHECK_AND_FILL_VEC_DSTAR(normalisedImpParamZSoftPi);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(cosThetaStarD0, cosThetaStarD0Bar, cosThetaStarD0, true);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(invMassD0, invMassD0Bar, massD0, true);
-        CHECK_AND_FILL_VEC_DSTAR_DELTA_MASS_D0(deltaMassD0);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTpcPi0, nSigTpcPi1, nSigmaTPCPiPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTpcKa0, nSigTpcKa1, nSigmaTPCKaPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTofPi0, nSigTofPi1, nSigmaTOFPiPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTofKa0, nSigTofKa1, nSigmaTOFKaPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(tpcTofNSigmaPi0, tpcTofNSigmaPi1, nSigmaTPCTOFPiPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(tpcTofNSigmaKa0, tpcTofNSigmaKa1, nSigmaTPCTOFKaPr0, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTpcPi1, nSigTpcPi0, nSigmaTPCPiPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTpcKa1, nSigTpcKa0, nSigmaTPCKaPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTofPi1, nSigTofPi0, nSigmaTOFPiPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(nSigTofKa1, nSigTofKa0, nSigmaTOFKaPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(tpcTofNSigmaPi1, tpcTofNSigmaPi0, nSigmaTPCTOFPiPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE(tpcTofNSigmaKa1, tpcTofNSigmaKa0, nSigmaTPCTOFKaPr1, swapDzeroDaus);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTPCPiPrSoftPi, nSigTpcPi2);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTPCKaPrSoftPi, nSigTpcKa2);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTOFPiPrSoftPi, nSigTofPi2);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTOFKaPrSoftPi, nSigTofKa2);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTPCTOFPiPrSoftPi, tpcTofNSigmaPi2);
-        CHECK_AND_FILL_VEC_DSTAR_GETTER(nSigmaTPCTOFKaPrSoftPi, tpcTofNSigmaKa2);
-      }
-    }
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate, swapDzeroDaus);
+  }
 
-    return inputFeatures;
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, bool swapDzeroDaus = true)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate, swapDzeroDaus);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1, bool> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, bool> Accessors = [] {
+      MlFeatureAccessors<T1, bool> accessors{};
+      SET_ACCESSOR_DSTAR(chi2PCAD0);
+      SET_ACCESSOR_DSTAR(decayLengthD0);
+      SET_ACCESSOR_DSTAR(decayLengthXYD0);
+      SET_ACCESSOR_DSTAR(decayLengthNormalisedD0);
+      SET_ACCESSOR_DSTAR(decayLengthXYNormalisedD0);
+      SET_ACCESSOR_DSTAR(cpaD0);
+      SET_ACCESSOR_DSTAR(cpaXYD0);
+      SET_ACCESSOR_DSTAR(deltaIPNormalisedMaxD0);
+      SET_ACCESSOR_DSTAR(impactParameterProductD0);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(ptProng0, ptProng1, ptProng0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(ptProng1, ptProng0, ptProng1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR(ptSoftPi);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameter0, impactParameter1, impactParameter0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameter1, impactParameter0, impactParameter1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterZ0, impactParameterZ1, impactParameterZ0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterZ1, impactParameterZ0, impactParameterZ1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR(impParamSoftPi);
+      SET_ACCESSOR_DSTAR(impParamZSoftPi);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterNormalised0, impactParameterNormalised1, impactParameterNormalised0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterNormalised1, impactParameterNormalised0, impactParameterNormalised1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterZNormalised0, impactParameterZNormalised1, impactParameterZNormalised0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(impactParameterZNormalised1, impactParameterZNormalised0, impactParameterZNormalised1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR(normalisedImpParamSoftPi);
+      SET_ACCESSOR_DSTAR(normalisedImpParamZSoftPi);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(cosThetaStarD0, cosThetaStarD0Bar, cosThetaStarD0, true);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(invMassD0, invMassD0Bar, massD0, true);
+      SET_ACCESSOR_DSTAR_DELTA_MASS_D0(deltaMassD0);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTpcPi0, nSigTpcPi1, nSigmaTPCPiPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTpcKa0, nSigTpcKa1, nSigmaTPCKaPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTofPi0, nSigTofPi1, nSigmaTOFPiPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTofKa0, nSigTofKa1, nSigmaTOFKaPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(tpcTofNSigmaPi0, tpcTofNSigmaPi1, nSigmaTPCTOFPiPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(tpcTofNSigmaKa0, tpcTofNSigmaKa1, nSigmaTPCTOFKaPr0, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTpcPi1, nSigTpcPi0, nSigmaTPCPiPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTpcKa1, nSigTpcKa0, nSigmaTPCKaPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTofPi1, nSigTofPi0, nSigmaTOFPiPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(nSigTofKa1, nSigTofKa0, nSigmaTOFKaPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(tpcTofNSigmaPi1, tpcTofNSigmaPi0, nSigmaTPCTOFPiPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_CHARGEBASE(tpcTofNSigmaKa1, tpcTofNSigmaKa0, nSigmaTPCTOFKaPr1, swapDzeroDaus);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTPCPiPrSoftPi, nSigTpcPi2);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTPCKaPrSoftPi, nSigTpcKa2);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTOFPiPrSoftPi, nSigTofPi2);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTOFKaPrSoftPi, nSigTofKa2);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTPCTOFPiPrSoftPi, tpcTofNSigmaPi2);
+      SET_ACCESSOR_DSTAR_GETTER(nSigmaTPCTOFKaPrSoftPi, tpcTofNSigmaKa2);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -279,10 +268,11 @@ class HfMlResponseDstarToD0Pi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_DSTAR
-#undef CHECK_AND_FILL_VEC_DSTAR_FULL
-#undef CHECK_AND_FILL_VEC_DSTAR
-#undef CHECK_AND_FILL_VEC_DSTAR_CHARGEBASE
-#undef CHECK_AND_FILL_VEC_DSTAR_DELTA_MASS_D0
-#undef CHECK_AND_FILL_VEC_DSTAR_GETTER
+#undef SET_ACCESSOR_DSTAR_VALUE
+#undef SET_ACCESSOR_DSTAR_FULL
+#undef SET_ACCESSOR_DSTAR
+#undef SET_ACCESSOR_DSTAR_CHARGEBASE
+#undef SET_ACCESSOR_DSTAR_DELTA_MASS_D0
+#undef SET_ACCESSOR_DSTAR_GETTER
 
 #endif // PWGHF_CORE_HFMLRESPONSEDSTARTOD0PI_H_
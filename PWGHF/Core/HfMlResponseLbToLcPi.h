@@ -22,6 +22,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -32,33 +33,29 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesLbToLcPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_LB_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesLbToLcPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());               \
-    break;                                                     \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_LB_VALUE(FEATURE, VALUE)                                                                                                              \
+  accessors[static_cast<uint8_t>(InputFeaturesLbToLcPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& prong1) -> float { \
+    return VALUE;                                                                                                                                          \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_LB_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LB_VALUE(FEATURE, OBJECT.GETTER())
+
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
 // by calling the GETTER function taking OBJECT in argument
-#define CHECK_AND_FILL_VEC_LB_FUNC(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesLbToLcPi::FEATURE): { \
-    inputFeatures.emplace_back(GETTER(OBJECT));                \
-    break;                                                     \
-  }
+#define SET_ACCESSOR_LB_FUNC(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LB_VALUE(FEATURE, GETTER(OBJECT))
 
 // Specific case of (OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_LB(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesLbToLcPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_LB(GETTER) \
+  SET_ACCESSOR_LB_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -102,63 +99,73 @@ class HfMlResponseLbToLcPi : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong1)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <bool withDmesMl, typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& prong1)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<withDmesMl, T1, T2>(), candidate, prong1);
+  }
+
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <bool withDmesMl, typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2> Accessors = [] {
+      MlFeatureAccessors<T1, T2> accessors{};
       if constexpr (withDmesMl) {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_LB(ptProng0);
-          CHECK_AND_FILL_VEC_LB(ptProng1);
-          CHECK_AND_FILL_VEC_LB(impactParameter0);
-          CHECK_AND_FILL_VEC_LB(impactParameter1);
-          CHECK_AND_FILL_VEC_LB(impactParameterProduct);
-          CHECK_AND_FILL_VEC_LB(chi2PCA);
-          CHECK_AND_FILL_VEC_LB(decayLength);
-          CHECK_AND_FILL_VEC_LB(decayLengthXY);
-          CHECK_AND_FILL_VEC_LB(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_LB(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_LB(cpa);
-          CHECK_AND_FILL_VEC_LB(cpaXY);
-          CHECK_AND_FILL_VEC_LB(maxNormalisedDeltaIP);
-          CHECK_AND_FILL_VEC_LB(prong0MlScoreBkg);
-          CHECK_AND_FILL_VEC_LB(prong0MlScorePrompt);
-          CHECK_AND_FILL_VEC_LB(prong0MlScoreNonprompt);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_LB_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_LB_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_LB_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_LB(ptProng0);
+        SET_ACCESSOR_LB(ptProng1);
+        SET_ACCESSOR_LB(impactParameter0);
+        SET_ACCESSOR_LB(impactParameter1);
+        SET_ACCESSOR_LB(impactParameterProduct);
+        SET_ACCESSOR_LB(chi2PCA);
+        SET_ACCESSOR_LB(decayLength);
+        SET_ACCESSOR_LB(decayLengthXY);
+        SET_ACCESSOR_LB(decayLengthNormalised);
+        SET_ACCESSOR_LB(decayLengthXYNormalised);
+        SET_ACCESSOR_LB(cpa);
+        SET_ACCESSOR_LB(cpaXY);
+        SET_ACCESSOR_LB(maxNormalisedDeltaIP);
+        SET_ACCESSOR_LB(prong0MlScoreBkg);
+        SET_ACCESSOR_LB(prong0MlScorePrompt);
+        SET_ACCESSOR_LB(prong0MlScoreNonprompt);
+        // TPC PID variable
+        SET_ACCESSOR_LB_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_LB_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_LB_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       } else {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_LB(ptProng0);
-          CHECK_AND_FILL_VEC_LB(ptProng1);
-          CHECK_AND_FILL_VEC_LB(impactParameter0);
-          CHECK_AND_FILL_VEC_LB(impactParameter1);
-          CHECK_AND_FILL_VEC_LB(impactParameterProduct);
-          CHECK_AND_FILL_VEC_LB(chi2PCA);
-          CHECK_AND_FILL_VEC_LB(decayLength);
-          CHECK_AND_FILL_VEC_LB(decayLengthXY);
-          CHECK_AND_FILL_VEC_LB(decayLengthNormalised);
-          CHECK_AND_FILL_VEC_LB(decayLengthXYNormalised);
-          CHECK_AND_FILL_VEC_LB(cpa);
-          CHECK_AND_FILL_VEC_LB(cpaXY);
-          CHECK_AND_FILL_VEC_LB(maxNormalisedDeltaIP);
-          // TPC PID variable
-          CHECK_AND_FILL_VEC_LB_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-          // TOF PID variable
-          CHECK_AND_FILL_VEC_LB_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-          // Combined PID variables
-          CHECK_AND_FILL_VEC_LB_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
-        }
+        SET_ACCESSOR_LB(ptProng0);
+        SET_ACCESSOR_LB(ptProng1);
+        SET_ACCESSOR_LB(impactParameter0);
+        SET_ACCESSOR_LB(impactParameter1);
+        SET_ACCESSOR_LB(impactParameterProduct);
+        SET_ACCESSOR_LB(chi2PCA);
+        SET_ACCESSOR_LB(decayLength);
+        SET_ACCESSOR_LB(decayLengthXY);
+        SET_ACCESSOR_LB(decayLengthNormalised);
+        SET_ACCESSOR_LB(decayLengthXYNormalised);
+        SET_ACCESSOR_LB(cpa);
+        SET_ACCESSOR_LB(cpaXY);
+        SET_ACCESSOR_LB(maxNormalisedDeltaIP);
+        // TPC PID variable
+        SET_ACCESSOR_LB_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+        // TOF PID variable
+        SET_ACCESSOR_LB_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+        // Combined PID variables
+        SET_ACCESSOR_LB_FUNC(prong1, tpcTofNSigmaPi1, o2::pid_tpc_tof_utils::getTpcTofNSigmaPi1);
       }
-    }
-
-    return inputFeatures;
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -191,8 +198,9 @@ class HfMlResponseLbToLcPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_LB
-#undef CHECK_AND_FILL_VEC_LB_FULL
-#undef CHECK_AND_FILL_VEC_LB_FUNC
-#undef CHECK_AND_FILL_VEC_LB
+#undef SET_ACCESSOR_LB_VALUE
+#undef SET_ACCESSOR_LB_FULL
+#undef SET_ACCESSOR_LB_FUNC
+#undef SET_ACCESSOR_LB
 
 #endif // PWGHF_CORE_HFMLRESPONSELBTOLCPI_H_
@@ -23,6 +23,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -33,31 +34,28 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesLcToK0sP::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_LC_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesLcToK0sP::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());               \
-    break;                                                     \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_LC_VALUE(FEATURE, VALUE)                                                                                                            \
+  accessors[static_cast<uint8_t>(InputFeaturesLcToK0sP::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& bach) -> float { \
+    return VALUE;                                                                                                                                        \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_LC_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_LC_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LC_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_LC_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_LC(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesLcToK0sP::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_LC(GETTER) \
+  SET_ACCESSOR_LC_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_LC_FULL(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_LC_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of HfHelper
-#define CHECK_AND_FILL_VEC_LC_HFHELPER(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesLcToK0sP::FEATURE): {  \
-    inputFeatures.emplace_back(HfHelper::GETTER(OBJECT));       \
-    break;                                                      \
-  }
+#define SET_ACCESSOR_LC_HFHELPER(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LC_VALUE(FEATURE, HfHelper::GETTER(OBJECT))
 
 namespace o2::analysis
 {
@@ -112,51 +110,63 @@ class HfMlResponseLcToK0sP : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& bach)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_LC(chi2PCA);
-        CHECK_AND_FILL_VEC_LC(rSecondaryVertex);
-        CHECK_AND_FILL_VEC_LC(decayLength);
-        CHECK_AND_FILL_VEC_LC(decayLengthXY);
-        CHECK_AND_FILL_VEC_LC(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_LC(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_LC(impactParameterNormalised0);
-        CHECK_AND_FILL_VEC_LC(ptProng0);
-        CHECK_AND_FILL_VEC_LC(impactParameterNormalised1);
-        CHECK_AND_FILL_VEC_LC(ptProng1);
-        CHECK_AND_FILL_VEC_LC(impactParameter0);
-        CHECK_AND_FILL_VEC_LC(impactParameter1);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, v0Radius, v0radius);
-        CHECK_AND_FILL_VEC_LC(v0cosPA);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, v0MLambda, mLambda);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, v0MAntiLambda, mAntiLambda);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, v0MK0Short, mK0Short);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, v0MGamma, mGamma);
-        CHECK_AND_FILL_VEC_LC_HFHELPER(candidate, ctV0, ctV0K0s);
-        // CHECK_AND_FILL_VEC_LC_HFHELPER(candidate, ctV0, ctV0Lambda);
-        CHECK_AND_FILL_VEC_LC(dcaV0daughters);
-        CHECK_AND_FILL_VEC_LC(ptV0Pos);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, dcaPosToPV, dcapostopv);
-        CHECK_AND_FILL_VEC_LC(ptV0Neg);
-        CHECK_AND_FILL_VEC_LC_FULL(candidate, dcaNegToPV, dcanegtopv);
-        CHECK_AND_FILL_VEC_LC(cpa);
-        CHECK_AND_FILL_VEC_LC(cpaXY);
-        CHECK_AND_FILL_VEC_LC_HFHELPER(candidate, ct, ctLc);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_LC_FULL(bach, nSigmaTpcPr0, tpcNSigmaPr);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_LC_FULL(bach, nSigmaTofPr0, tofNSigmaPr);
-        // Combined nSigma variable
-        CHECK_AND_FILL_VEC_LC_FULL(bach, nSigmaTpcTofPr0, tpcTofNSigmaPr);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2>(), candidate, bach);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& bach)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2>(), candidate, bach);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2>
+  static MlFeatureAccessors<T1, T2> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2> Accessors = [] {
+      MlFeatureAccessors<T1, T2> accessors{};
+      SET_ACCESSOR_LC(chi2PCA);
+      SET_ACCESSOR_LC(rSecondaryVertex);
+      SET_ACCESSOR_LC(decayLength);
+      SET_ACCESSOR_LC(decayLengthXY);
+      SET_ACCESSOR_LC(decayLengthNormalised);
+      SET_ACCESSOR_LC(decayLengthXYNormalised);
+      SET_ACCESSOR_LC(impactParameterNormalised0);
+      SET_ACCESSOR_LC(ptProng0);
+      SET_ACCESSOR_LC(impactParameterNormalised1);
+      SET_ACCESSOR_LC(ptProng1);
+      SET_ACCESSOR_LC(impactParameter0);
+      SET_ACCESSOR_LC(impactParameter1);
+      SET_ACCESSOR_LC_FULL(candidate, v0Radius, v0radius);
+      SET_ACCESSOR_LC(v0cosPA);
+      SET_ACCESSOR_LC_FULL(candidate, v0MLambda, mLambda);
+      SET_ACCESSOR_LC_FULL(candidate, v0MAntiLambda, mAntiLambda);
+      SET_ACCESSOR_LC_FULL(candidate, v0MK0Short, mK0Short);
+      SET_ACCESSOR_LC_FULL(candidate, v0MGamma, mGamma);
+      SET_ACCESSOR_LC_HFHELPER(candidate, ctV0, ctV0K0s);
+      // SET_ACCESSOR_LC_HFHELPER(candidate, ctV0, ctV0Lambda);
+      SET_ACCESSOR_LC(dcaV0daughters);
+      SET_ACCESSOR_LC(ptV0Pos);
+      SET_ACCESSOR_LC_FULL(candidate, dcaPosToPV, dcapostopv);
+      SET_ACCESSOR_LC(ptV0Neg);
+      SET_ACCESSOR_LC_FULL(candidate, dcaNegToPV, dcanegtopv);
+      SET_ACCESSOR_LC(cpa);
+      SET_ACCESSOR_LC(cpaXY);
+      SET_ACCESSOR_LC_HFHELPER(candidate, ct, ctLc);
+      // TPC PID variables
+      SET_ACCESSOR_LC_FULL(bach, nSigmaTpcPr0, tpcNSigmaPr);
+      // TOF PID variables
+      SET_ACCESSOR_LC_FULL(bach, nSigmaTofPr0, tofNSigmaPr);
+      // Combined nSigma variable
+      SET_ACCESSOR_LC_FULL(bach, nSigmaTpcTofPr0, tpcTofNSigmaPr);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -200,8 +210,9 @@ class HfMlResponseLcToK0sP : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_LC
-#undef CHECK_AND_FILL_VEC_LC_FULL
-#undef CHECK_AND_FILL_VEC_LC
-#undef CHECK_AND_FILL_VEC_LC_HFHELPER
+#undef SET_ACCESSOR_LC_VALUE
+#undef SET_ACCESSOR_LC_FULL
+#undef SET_ACCESSOR_LC
+#undef SET_ACCESSOR_LC_HFHELPER
 
 #endif // PWGHF_CORE_HFMLRESPONSELCTOK0SP_H_
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -34,56 +35,39 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {    \
-    inputFeatures.emplace_back(OBJECT.GETTER());                  \
-    break;                                                        \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_LCTOPKPI_VALUE(FEATURE, VALUE)                                                                                                                \
+  accessors[static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] bool const& caseLcToPKPi) -> float { \
+    return VALUE;                                                                                                                                                  \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LCTOPKPI_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_LCTOPKPI(GETTER)                   \
-  case static_cast<uint8_t>(InputFeaturesLcToPKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
-  }
+#define SET_ACCESSOR_LCTOPKPI(GETTER) \
+  SET_ACCESSOR_LCTOPKPI_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of HfHelper
-#define CHECK_AND_FILL_VEC_LCTOPKPI_HFHELPER(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {        \
-    inputFeatures.emplace_back(HfHelper::GETTER(OBJECT));             \
-    break;                                                            \
-  }
+#define SET_ACCESSOR_LCTOPKPI_HFHELPER(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_LCTOPKPI_VALUE(FEATURE, HfHelper::GETTER(OBJECT))
 
-// Variation of CHECK_AND_FILL_VEC_LCTOPKPI_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_LCTOPKPI_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER)
 // where OBJECT1 and OBJECT2 are the objects from which we call the GETTER method, and the variable
 // is filled depending on whether it is a LcToPKPi or a LcToPiKP
-#define CHECK_AND_FILL_VEC_LCTOPKPI_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {                       \
-    if (caseLcToPKPi) {                                                              \
-      inputFeatures.emplace_back(OBJECT1.GETTER());                                  \
-    } else {                                                                         \
-      inputFeatures.emplace_back(OBJECT2.GETTER());                                  \
-    }                                                                                \
-    break;                                                                           \
-  }
+#define SET_ACCESSOR_LCTOPKPI_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
+  SET_ACCESSOR_LCTOPKPI_VALUE(FEATURE, caseLcToPKPi ? OBJECT1.GETTER() : OBJECT2.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_LCTOPKPI_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
+// Variation of SET_ACCESSOR_LCTOPKPI_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
 // where GETTER1 and GETTER2 are methods of the OBJECT
-#define CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {                \
-    if (caseLcToPKPi) {                                                       \
-      inputFeatures.emplace_back(OBJECT.GETTER1());                           \
-    } else {                                                                  \
-      inputFeatures.emplace_back(OBJECT.GETTER2());                           \
-    }                                                                         \
-    break;                                                                    \
-  }
+#define SET_ACCESSOR_LCTOPKPI_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_LCTOPKPI_VALUE(FEATURE, caseLcToPKPi ? OBJECT.GETTER1() : OBJECT.GETTER2())
 
 namespace o2::analysis
 {
@@ -168,86 +152,94 @@ class HfMlResponseLcToPKPi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate, bool const caseLcToPKPi)
   {
-    std::vector<float> inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate, caseLcToPKPi);
+  }
 
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng0);
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng1);
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY2, impactParameter2);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ0);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ1);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ2);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLength);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXY);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_LCTOPKPI(cpa);
-        CHECK_AND_FILL_VEC_LCTOPKPI(cpaXY);
-        CHECK_AND_FILL_VEC_LCTOPKPI(chi2PCA);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPr0, nSigTpcPr0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPr1, nSigTpcPr1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPr2, nSigTpcPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tpcNSigmaPrExpPr0, nSigTpcPr0, nSigTpcPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tpcNSigmaPiExpPi2, nSigTpcPi2, nSigTpcPi0);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPr0, nSigTofPr0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPr1, nSigTofPr1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPr2, nSigTofPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tofNSigmaPrExpPr0, nSigTofPr0, nSigTofPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tofNSigmaPiExpPi2, nSigTofPi2, nSigTofPi0);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr0, tpcTofNSigmaPr0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr1, tpcTofNSigmaPr1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr2, tpcTofNSigmaPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tpcTofNSigmaPrExpPr0, tpcTofNSigmaPr0, tpcTofNSigmaPr2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, tpcTofNSigmaPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
-      }
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, bool const caseLcToPKPi)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate, caseLcToPKPi);
+  }
+
+ protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1, bool> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, bool> Accessors = [] {
+      MlFeatureAccessors<T1, bool> accessors{};
+      SET_ACCESSOR_LCTOPKPI(ptProng0);
+      SET_ACCESSOR_LCTOPKPI(ptProng1);
+      SET_ACCESSOR_LCTOPKPI(ptProng2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, impactParameterXY0, impactParameter0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, impactParameterXY1, impactParameter1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, impactParameterXY2, impactParameter2);
+      SET_ACCESSOR_LCTOPKPI(impactParameterZ0);
+      SET_ACCESSOR_LCTOPKPI(impactParameterZ1);
+      SET_ACCESSOR_LCTOPKPI(impactParameterZ2);
+      SET_ACCESSOR_LCTOPKPI(decayLength);
+      SET_ACCESSOR_LCTOPKPI(decayLengthXY);
+      SET_ACCESSOR_LCTOPKPI(decayLengthXYNormalised);
+      SET_ACCESSOR_LCTOPKPI(cpa);
+      SET_ACCESSOR_LCTOPKPI(cpaXY);
+      SET_ACCESSOR_LCTOPKPI(chi2PCA);
+      // TPC PID variables
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPr0, nSigTpcPr0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPr1, nSigTpcPr1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPr2, nSigTpcPr2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tpcNSigmaPrExpPr0, nSigTpcPr0, nSigTpcPr2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tpcNSigmaPiExpPi2, nSigTpcPi2, nSigTpcPi0);
+      // TOF PID variables
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPr0, nSigTofPr0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPr1, nSigTofPr1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPr2, nSigTofPr2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tofNSigmaPrExpPr0, nSigTofPr0, nSigTofPr2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tofNSigmaPiExpPi2, nSigTofPi2, nSigTofPi0);
+      // Combined PID variables
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr0, tpcTofNSigmaPr0);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr1, tpcTofNSigmaPr1);
+      SET_ACCESSOR_LCTOPKPI_FULL(candidate, tpcTofNSigmaPr2, tpcTofNSigmaPr2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tpcTofNSigmaPrExpPr0, tpcTofNSigmaPr0, tpcTofNSigmaPr2);
+      SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, tpcTofNSigmaPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
       if constexpr (reconstructionType == aod::hf_cand::VertexerType::KfParticle) {
-        switch (idx) {
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfChi2PrimProton, kfChi2PrimProng0, kfChi2PrimProng2);
-          CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, kfChi2PrimKaon, kfChi2PrimProng1);
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfChi2PrimPion, kfChi2PrimProng2, kfChi2PrimProng0);
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfChi2GeoKaonPion, kfChi2GeoProng1Prong2, kfChi2GeoProng0Prong1);
-          CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, kfChi2GeoProtonPion, kfChi2GeoProng0Prong2);
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfChi2GeoProtonKaon, kfChi2GeoProng0Prong1, kfChi2GeoProng1Prong2);
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfDcaKaonPion, kfDcaProng1Prong2, kfDcaProng0Prong1);
-          CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, kfDcaProtonPion, kfDcaProng0Prong2);
-          CHECK_AND_FILL_VEC_LCTOPKPI_SIGNED(candidate, kfDcaProtonKaon, kfDcaProng0Prong1, kfDcaProng1Prong2);
-          CHECK_AND_FILL_VEC_LCTOPKPI(kfChi2Geo);
-          CHECK_AND_FILL_VEC_LCTOPKPI(kfChi2Topo);
-          case static_cast<uint8_t>(InputFeaturesLcToPKPi::kfDecayLengthNormalised): {
-            inputFeatures.emplace_back(candidate.kfDecayLength() / candidate.kfDecayLengthError());
-            break;
-          }
-        }
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfChi2PrimProton, kfChi2PrimProng0, kfChi2PrimProng2);
+        SET_ACCESSOR_LCTOPKPI_FULL(candidate, kfChi2PrimKaon, kfChi2PrimProng1);
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfChi2PrimPion, kfChi2PrimProng2, kfChi2PrimProng0);
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfChi2GeoKaonPion, kfChi2GeoProng1Prong2, kfChi2GeoProng0Prong1);
+        SET_ACCESSOR_LCTOPKPI_FULL(candidate, kfChi2GeoProtonPion, kfChi2GeoProng0Prong2);
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfChi2GeoProtonKaon, kfChi2GeoProng0Prong1, kfChi2GeoProng1Prong2);
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfDcaKaonPion, kfDcaProng1Prong2, kfDcaProng0Prong1);
+        SET_ACCESSOR_LCTOPKPI_FULL(candidate, kfDcaProtonPion, kfDcaProng0Prong2);
+        SET_ACCESSOR_LCTOPKPI_SIGNED(candidate, kfDcaProtonKaon, kfDcaProng0Prong1, kfDcaProng1Prong2);
+        SET_ACCESSOR_LCTOPKPI(kfChi2Geo);
+        SET_ACCESSOR_LCTOPKPI(kfChi2Topo);
+        SET_ACCESSOR_LCTOPKPI_VALUE(kfDecayLengthNormalised, candidate.kfDecayLength() / candidate.kfDecayLengthError());
       }
-    }
-    return inputFeatures;
+      return accessors;
+    }();
+    return Accessors;
   }
 
- protected:
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -326,9 +318,10 @@ class HfMlResponseLcToPKPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_LCTOPKPI
-#undef CHECK_AND_FILL_VEC_LCTOPKPI_FULL
-#undef CHECK_AND_FILL_VEC_LCTOPKPI
-#undef CHECK_AND_FILL_VEC_LCTOPKPI_HFHELPER
-#undef CHECK_AND_FILL_VEC_LCTOPKPI_OBJECT_SIGNED
+#undef SET_ACCESSOR_LCTOPKPI_VALUE
+#undef SET_ACCESSOR_LCTOPKPI_FULL
+#undef SET_ACCESSOR_LCTOPKPI
+#undef SET_ACCESSOR_LCTOPKPI_HFHELPER
+#undef SET_ACCESSOR_LCTOPKPI_OBJECT_SIGNED
 
 #endif // PWGHF_CORE_HFMLRESPONSELCTOPKPI_H_
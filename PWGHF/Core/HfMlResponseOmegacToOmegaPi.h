@@ -22,6 +22,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -32,31 +33,28 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesOmegacToOmegaPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_OMEGAC0_FULL(OBJECT, FEATURE, GETTER)      \
-  case static_cast<uint8_t>(InputFeaturesOmegacToOmegaPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                      \
-    break;                                                            \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_OMEGAC0_VALUE(FEATURE, VALUE)                                                                                                                                                                                                       \
+  accessors[static_cast<uint8_t>(InputFeaturesOmegacToOmegaPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& lamProngPi, [[maybe_unused]] T2 const& cascProng, [[maybe_unused]] T3 const& charmBaryonProng) -> float { \
+    return VALUE;                                                                                                                                                                                                                                        \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_OMEGAC0_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_OMEGAC0_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_OMEGAC0_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_OMEGAC0_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_OMEGAC0(GETTER)                           \
-  case static_cast<uint8_t>(InputFeaturesOmegacToOmegaPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());                  \
-    break;                                                           \
-  }
+#define SET_ACCESSOR_OMEGAC0(GETTER) \
+  SET_ACCESSOR_OMEGAC0_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_OMEGAC0_FULL(OBJECT, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_OMEGAC0_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of HfHelper
-#define CHECK_AND_FILL_VEC_OMEGAC0_HFHELPER(OBJECT, FEATURE, GETTER)  \
-  case static_cast<uint8_t>(InputFeaturesOmegacToOmegaPi::FEATURE): { \
-    inputFeatures.emplace_back(HfHelper::GETTER(OBJECT));             \
-    break;                                                            \
-  }
+#define SET_ACCESSOR_OMEGAC0_HFHELPER(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_OMEGAC0_VALUE(FEATURE, HfHelper::GETTER(OBJECT))
 namespace o2::analysis
 {
 enum class InputFeaturesOmegacToOmegaPi : uint8_t {
@@ -103,41 +101,53 @@ class HfMlResponseOmegacToOmegaPi : public HfMlResponse<TypeOutputScore>
   template <typename T1, typename T2, typename T3>
   std::vector<float> getInputFeatures(T1 const& candidate, T2 const& lamProngPi, T2 const& cascProng, T3 const& charmBaryonProng)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, cosPaOmegacToPv, cosPACharmBaryon);
-        CHECK_AND_FILL_VEC_OMEGAC0(kfDcaXYPiFromOmegac);
-        CHECK_AND_FILL_VEC_OMEGAC0(chi2TopoPiFromOmegacToPv);
-        CHECK_AND_FILL_VEC_OMEGAC0(dcaCharmBaryonDau);
-        CHECK_AND_FILL_VEC_OMEGAC0(invMassCascade);
-        CHECK_AND_FILL_VEC_OMEGAC0(massCascChi2OverNdf);
-        CHECK_AND_FILL_VEC_OMEGAC0(kfDcaXYCascToPv);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, cosPaCascToPv, cosPACasc);
-        CHECK_AND_FILL_VEC_OMEGAC0(cosThetaStarPiFromOmegac);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, chi2NdfTopoOmegacToPv, chi2TopoOmegacToPv);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, ldlCasc, cascldl);
-        CHECK_AND_FILL_VEC_OMEGAC0(dcaCascDau);
-        CHECK_AND_FILL_VEC_OMEGAC0(cosPaCascToOmegac);
-        CHECK_AND_FILL_VEC_OMEGAC0(decayLenXYCasc);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, ldlOmegac, omegacldl);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, chi2NdfTopoCascToOmegac, chi2TopoCascToOmegac);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(candidate, chi2NdfTopoCascToPv, chi2TopoCascToPv);
-        CHECK_AND_FILL_VEC_OMEGAC0(chi2GeoOmegac);
-        CHECK_AND_FILL_VEC_OMEGAC0(chi2GeoCasc);
-
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(lamProngPi, nSigmaTPCPiFromV0, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(cascProng, nSigmaTPCKaFromCasc, tpcNSigmaKa);
-        CHECK_AND_FILL_VEC_OMEGAC0_FULL(charmBaryonProng, nSigmaTPCPiFromOmegac, tpcNSigmaPi);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProng, charmBaryonProng);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2, typename T3>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& lamProngPi, T2 const& cascProng, T3 const& charmBaryonProng)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProng, charmBaryonProng);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, T2, T3> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, T2, T3> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T2, T3> accessors{};
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, cosPaOmegacToPv, cosPACharmBaryon);
+      SET_ACCESSOR_OMEGAC0(kfDcaXYPiFromOmegac);
+      SET_ACCESSOR_OMEGAC0(chi2TopoPiFromOmegacToPv);
+      SET_ACCESSOR_OMEGAC0(dcaCharmBaryonDau);
+      SET_ACCESSOR_OMEGAC0(invMassCascade);
+      SET_ACCESSOR_OMEGAC0(massCascChi2OverNdf);
+      SET_ACCESSOR_OMEGAC0(kfDcaXYCascToPv);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, cosPaCascToPv, cosPACasc);
+      SET_ACCESSOR_OMEGAC0(cosThetaStarPiFromOmegac);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, chi2NdfTopoOmegacToPv, chi2TopoOmegacToPv);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, ldlCasc, cascldl);
+      SET_ACCESSOR_OMEGAC0(dcaCascDau);
+      SET_ACCESSOR_OMEGAC0(cosPaCascToOmegac);
+      SET_ACCESSOR_OMEGAC0(decayLenXYCasc);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, ldlOmegac, omegacldl);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, chi2NdfTopoCascToOmegac, chi2TopoCascToOmegac);
+      SET_ACCESSOR_OMEGAC0_FULL(candidate, chi2NdfTopoCascToPv, chi2TopoCascToPv);
+      SET_ACCESSOR_OMEGAC0(chi2GeoOmegac);
+      SET_ACCESSOR_OMEGAC0(chi2GeoCasc);
+
+      // TPC PID variables
+      SET_ACCESSOR_OMEGAC0_FULL(lamProngPi, nSigmaTPCPiFromV0, tpcNSigmaPi);
+      SET_ACCESSOR_OMEGAC0_FULL(cascProng, nSigmaTPCKaFromCasc, tpcNSigmaKa);
+      SET_ACCESSOR_OMEGAC0_FULL(charmBaryonProng, nSigmaTPCPiFromOmegac, tpcNSigmaPi);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -174,7 +184,8 @@ class HfMlResponseOmegacToOmegaPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_OMEGAC0
-#undef CHECK_AND_FILL_VEC_OMEGAC0_FULL
-#undef CHECK_AND_FILL_VEC_OMEGAC0
-#undef CHECK_AND_FILL_VEC_OMEGAC0_HFHELPER
+#undef SET_ACCESSOR_OMEGAC0_VALUE
+#undef SET_ACCESSOR_OMEGAC0_FULL
+#undef SET_ACCESSOR_OMEGAC0
+#undef SET_ACCESSOR_OMEGAC0_HFHELPER
 #endif // PWGHF_CORE_HFMLRESPONSEOMEGACTOOMEGAPI_H_
@@ -21,6 +21,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -31,22 +32,22 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesXic0ToXiPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_XIC0TOXIPI_FULL(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesXic0ToXiPi::FEATURE): {    \
-    inputFeatures.emplace_back(OBJECT.GETTER());                    \
-    break;                                                          \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_XIC0TOXIPI_VALUE(FEATURE, VALUE)                                                                                                                                                                                                   \
+  accessors[static_cast<uint8_t>(InputFeaturesXic0ToXiPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& lamProngPi, [[maybe_unused]] T2 const& cascProngPi, [[maybe_unused]] T3 const& charmBaryonProngPi) -> float { \
+    return VALUE;                                                                                                                                                                                                                                       \
   }
 
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_XIC0TOXIPI_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_XIC0TOXIPI_VALUE(FEATURE, OBJECT.GETTER())
+
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_XIC0TOXIPI(GETTER)                   \
-  case static_cast<uint8_t>(InputFeaturesXic0ToXiPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());             \
-    break;                                                      \
-  }
+#define SET_ACCESSOR_XIC0TOXIPI(GETTER) \
+  SET_ACCESSOR_XIC0TOXIPI_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -80,31 +81,43 @@ class HfMlResponseXic0ToXiPi : public HfMlResponse<TypeOutputScore>
   // std::vector<float> getInputFeatures(T1 const& candidate)
   std::vector<float> getInputFeatures(T1 const& candidate, T2 const& lamProngPi, T2 const& cascProngPi, T3 const& charmBaryonProngPi)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        // PID variables
-        CHECK_AND_FILL_VEC_XIC0TOXIPI_FULL(lamProngPi, tpcNSigmaPiFromLambda, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI_FULL(cascProngPi, tpcNSigmaPiFromCasc, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI_FULL(charmBaryonProngPi, tpcNSigmaPiFromCharmBaryon, tpcNSigmaPi);
-        // DCA
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(dcaCascDau);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(dcaCharmBaryonDau);
-        // CosPA
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(cosPACharmBaryon);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(cosPACasc);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(cosPAV0);
-        // ImpactPar
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(impactParBachFromCharmBaryonXY);
-        CHECK_AND_FILL_VEC_XIC0TOXIPI(impactParCascXY);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProngPi, charmBaryonProngPi);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2, typename T3>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& lamProngPi, T2 const& cascProngPi, T3 const& charmBaryonProngPi)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProngPi, charmBaryonProngPi);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, T2, T3> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, T2, T3> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T2, T3> accessors{};
+      // PID variables
+      SET_ACCESSOR_XIC0TOXIPI_FULL(lamProngPi, tpcNSigmaPiFromLambda, tpcNSigmaPi);
+      SET_ACCESSOR_XIC0TOXIPI_FULL(cascProngPi, tpcNSigmaPiFromCasc, tpcNSigmaPi);
+      SET_ACCESSOR_XIC0TOXIPI_FULL(charmBaryonProngPi, tpcNSigmaPiFromCharmBaryon, tpcNSigmaPi);
+      // DCA
+      SET_ACCESSOR_XIC0TOXIPI(dcaCascDau);
+      SET_ACCESSOR_XIC0TOXIPI(dcaCharmBaryonDau);
+      // CosPA
+      SET_ACCESSOR_XIC0TOXIPI(cosPACharmBaryon);
+      SET_ACCESSOR_XIC0TOXIPI(cosPACasc);
+      SET_ACCESSOR_XIC0TOXIPI(cosPAV0);
+      // ImpactPar
+      SET_ACCESSOR_XIC0TOXIPI(impactParBachFromCharmBaryonXY);
+      SET_ACCESSOR_XIC0TOXIPI(impactParCascXY);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -125,7 +138,8 @@ class HfMlResponseXic0ToXiPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_XIC0TOXIPI
-#undef CHECK_AND_FILL_VEC_XIC0TOXIPI_FULL
-#undef CHECK_AND_FILL_VEC_XIC0TOXIPI
+#undef SET_ACCESSOR_XIC0TOXIPI_VALUE
+#undef SET_ACCESSOR_XIC0TOXIPI_FULL
+#undef SET_ACCESSOR_XIC0TOXIPI
 
 #endif // PWGHF_CORE_HFMLRESPONSEXIC0TOXIPI_H_
@@ -21,6 +21,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -31,22 +32,22 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesXic0ToXiPiKf::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_XIC0TOXIPIKF_FULL(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesXic0ToXiPiKf::FEATURE): {    \
-    inputFeatures.emplace_back(OBJECT.GETTER());                      \
-    break;                                                            \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_XIC0TOXIPIKF_VALUE(FEATURE, VALUE)                                                                                                                                                                                                   \
+  accessors[static_cast<uint8_t>(InputFeaturesXic0ToXiPiKf::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] T2 const& lamProngPi, [[maybe_unused]] T2 const& cascProngPi, [[maybe_unused]] T3 const& charmBaryonProngPi) -> float { \
+    return VALUE;                                                                                                                                                                                                                                         \
   }
 
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_XIC0TOXIPIKF_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_XIC0TOXIPIKF_VALUE(FEATURE, OBJECT.GETTER())
+
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_XIC0TOXIPIKF(GETTER)                   \
-  case static_cast<uint8_t>(InputFeaturesXic0ToXiPiKf::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());               \
-    break;                                                        \
-  }
+#define SET_ACCESSOR_XIC0TOXIPIKF(GETTER) \
+  SET_ACCESSOR_XIC0TOXIPIKF_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -84,38 +85,50 @@ class HfMlResponseXic0ToXiPiKf : public HfMlResponse<TypeOutputScore>
   // std::vector<float> getInputFeatures(T1 const& candidate)
   std::vector<float> getInputFeatures(T1 const& candidate, T2 const& lamProngPi, T2 const& cascProngPi, T3 const& charmBaryonProngPi)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        // PID variables
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF_FULL(lamProngPi, tpcNSigmaPiFromLambda, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF_FULL(cascProngPi, tpcNSigmaPiFromCasc, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF_FULL(charmBaryonProngPi, tpcNSigmaPiFromCharmBaryon, tpcNSigmaPi);
-        // DCA
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(dcaCascDau);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(dcaCharmBaryonDau);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(kfDcaXYPiFromXic);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(kfDcaXYCascToPv);
-        // Chi2Geo
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(cascChi2OverNdf);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(xicChi2OverNdf);
-        // ldl
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(cascldl);
-        // Chi2Topo
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(chi2TopoCascToPv);
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(chi2TopoCascToXic);
-        // CosPa
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(cosPaCascToXic);
-        // Decay length
-        CHECK_AND_FILL_VEC_XIC0TOXIPIKF(decayLenXYCasc);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProngPi, charmBaryonProngPi);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1, typename T2, typename T3>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, T2 const& lamProngPi, T2 const& cascProngPi, T3 const& charmBaryonProngPi)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1, T2, T3>(), candidate, lamProngPi, cascProngPi, charmBaryonProngPi);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1, typename T2, typename T3>
+  static MlFeatureAccessors<T1, T2, T2, T3> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, T2, T2, T3> Accessors = [] {
+      MlFeatureAccessors<T1, T2, T2, T3> accessors{};
+      // PID variables
+      SET_ACCESSOR_XIC0TOXIPIKF_FULL(lamProngPi, tpcNSigmaPiFromLambda, tpcNSigmaPi);
+      SET_ACCESSOR_XIC0TOXIPIKF_FULL(cascProngPi, tpcNSigmaPiFromCasc, tpcNSigmaPi);
+      SET_ACCESSOR_XIC0TOXIPIKF_FULL(charmBaryonProngPi, tpcNSigmaPiFromCharmBaryon, tpcNSigmaPi);
+      // DCA
+      SET_ACCESSOR_XIC0TOXIPIKF(dcaCascDau);
+      SET_ACCESSOR_XIC0TOXIPIKF(dcaCharmBaryonDau);
+      SET_ACCESSOR_XIC0TOXIPIKF(kfDcaXYPiFromXic);
+      SET_ACCESSOR_XIC0TOXIPIKF(kfDcaXYCascToPv);
+      // Chi2Geo
+      SET_ACCESSOR_XIC0TOXIPIKF(cascChi2OverNdf);
+      SET_ACCESSOR_XIC0TOXIPIKF(xicChi2OverNdf);
+      // ldl
+      SET_ACCESSOR_XIC0TOXIPIKF(cascldl);
+      // Chi2Topo
+      SET_ACCESSOR_XIC0TOXIPIKF(chi2TopoCascToPv);
+      SET_ACCESSOR_XIC0TOXIPIKF(chi2TopoCascToXic);
+      // CosPa
+      SET_ACCESSOR_XIC0TOXIPIKF(cosPaCascToXic);
+      // Decay length
+      SET_ACCESSOR_XIC0TOXIPIKF(decayLenXYCasc);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -141,7 +154,8 @@ class HfMlResponseXic0ToXiPiKf : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_XIC0TOXIPIKF
-#undef CHECK_AND_FILL_VEC_XIC0TOXIPIKF_FULL
-#undef CHECK_AND_FILL_VEC_XIC0TOXIPIKF
+#undef SET_ACCESSOR_XIC0TOXIPIKF_VALUE
+#undef SET_ACCESSOR_XIC0TOXIPIKF_FULL
+#undef SET_ACCESSOR_XIC0TOXIPIKF
 
 #endif // PWGHF_CORE_HFMLRESPONSEXIC0TOXIPIKF_H_
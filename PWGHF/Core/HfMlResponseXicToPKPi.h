@@ -21,6 +21,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -31,49 +32,35 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesXicToPKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_XIC_FULL(OBJECT, FEATURE, GETTER)    \
-  case static_cast<uint8_t>(InputFeaturesXicToPKPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());                \
-    break;                                                      \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_XIC_VALUE(FEATURE, VALUE)                                                                                                                       \
+  accessors[static_cast<uint8_t>(InputFeaturesXicToPKPi::FEATURE)] = []([[maybe_unused]] T1 const& candidate, [[maybe_unused]] bool const& caseXicToPKPi) -> float { \
+    return VALUE;                                                                                                                                                    \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_XIC_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_XIC_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_XIC_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_XIC_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_XIC(GETTER)                         \
-  case static_cast<uint8_t>(InputFeaturesXicToPKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());            \
-    break;                                                     \
-  }
+#define SET_ACCESSOR_XIC(GETTER) \
+  SET_ACCESSOR_XIC_VALUE(GETTER, candidate.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_XIC_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER)
+// Variation of SET_ACCESSOR_XIC_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER)
 // where OBJECT1 and OBJECT2 are the objects from which we call the GETTER method, and the variable
 // is filled depending on whether it is a XicToPKPi or a XicToPiKP
-#define CHECK_AND_FILL_VEC_XIC_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesXicToPKPi::FEATURE): {                 \
-    if (caseXicToPKPi) {                                                        \
-      inputFeatures.emplace_back(OBJECT1.GETTER());                             \
-    } else {                                                                    \
-      inputFeatures.emplace_back(OBJECT2.GETTER());                             \
-    }                                                                           \
-    break;                                                                      \
-  }
+#define SET_ACCESSOR_XIC_OBJECT_SIGNED(OBJECT1, OBJECT2, FEATURE, GETTER) \
+  SET_ACCESSOR_XIC_VALUE(FEATURE, caseXicToPKPi ? OBJECT1.GETTER() : OBJECT2.GETTER())
 
-// Variation of CHECK_AND_FILL_VEC_XIC_OBJECT_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
+// Variation of SET_ACCESSOR_XIC_OBJECT_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2)
 // where GETTER1 and GETTER2 are methods of the OBJECT, and used
 // depending on whether the candidate is a XicToPKPi or a XicToPiKP
-#define CHECK_AND_FILL_VEC_XIC_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
-  case static_cast<uint8_t>(InputFeaturesXicToPKPi::FEATURE): {          \
-    if (caseXicToPKPi) {                                                 \
-      inputFeatures.emplace_back(OBJECT.GETTER1());                      \
-    } else {                                                             \
-      inputFeatures.emplace_back(OBJECT.GETTER2());                      \
-    }                                                                    \
-    break;                                                               \
-  }
+#define SET_ACCESSOR_XIC_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
+  SET_ACCESSOR_XIC_VALUE(FEATURE, caseXicToPKPi ? OBJECT.GETTER1() : OBJECT.GETTER2())
 
 namespace o2::analysis
 {
@@ -146,68 +133,80 @@ class HfMlResponseXicToPKPi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate, bool const caseXicToPKPi)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_XIC(ptProng0);
-        CHECK_AND_FILL_VEC_XIC(ptProng1);
-        CHECK_AND_FILL_VEC_XIC(ptProng2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, impactParameterXY2, impactParameter2);
-        CHECK_AND_FILL_VEC_XIC(impactParameterZ0);
-        CHECK_AND_FILL_VEC_XIC(impactParameterZ1);
-        CHECK_AND_FILL_VEC_XIC(impactParameterZ2);
-        CHECK_AND_FILL_VEC_XIC(decayLength);
-        CHECK_AND_FILL_VEC_XIC(decayLengthXY);
-        CHECK_AND_FILL_VEC_XIC(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_XIC(cpa);
-        CHECK_AND_FILL_VEC_XIC(cpaXY);
-        CHECK_AND_FILL_VEC_XIC(chi2PCA);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPr0, nSigTpcPr0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPr1, nSigTpcPr1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPr2, nSigTpcPr2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tpcNSigmaPrExpPr0, nSigTpcPr0, nSigTpcPr2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tpcNSigmaPiExpPi2, nSigTpcPi2, nSigTpcPi0);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPr0, nSigTofPr0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPr1, nSigTofPr1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPr2, nSigTofPr2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tofNSigmaPrExpPr0, nSigTofPr0, nSigTofPr2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tofNSigmaPiExpPi2, nSigTofPi2, nSigTofPi0);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPr0, tpcTofNSigmaPr0);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPr1, tpcTofNSigmaPr1);
-        CHECK_AND_FILL_VEC_XIC_FULL(candidate, tpcTofNSigmaPr2, tpcTofNSigmaPr2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tpcTofNSigmaPrExpPr0, tpcTofNSigmaPr0, tpcTofNSigmaPr2);
-        CHECK_AND_FILL_VEC_XIC_SIGNED(candidate, tpcTofNSigmaPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
-      }
-    }
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate, caseXicToPKPi);
+  }
 
-    return inputFeatures;
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate, bool const caseXicToPKPi)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate, caseXicToPKPi);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1, bool> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1, bool> Accessors = [] {
+      MlFeatureAccessors<T1, bool> accessors{};
+      SET_ACCESSOR_XIC(ptProng0);
+      SET_ACCESSOR_XIC(ptProng1);
+      SET_ACCESSOR_XIC(ptProng2);
+      SET_ACCESSOR_XIC_FULL(candidate, impactParameterXY0, impactParameter0);
+      SET_ACCESSOR_XIC_FULL(candidate, impactParameterXY1, impactParameter1);
+      SET_ACCESSOR_XIC_FULL(candidate, impactParameterXY2, impactParameter2);
+      SET_ACCESSOR_XIC(impactParameterZ0);
+      SET_ACCESSOR_XIC(impactParameterZ1);
+      SET_ACCESSOR_XIC(impactParameterZ2);
+      SET_ACCESSOR_XIC(decayLength);
+      SET_ACCESSOR_XIC(decayLengthXY);
+      SET_ACCESSOR_XIC(decayLengthXYNormalised);
+      SET_ACCESSOR_XIC(cpa);
+      SET_ACCESSOR_XIC(cpaXY);
+      SET_ACCESSOR_XIC(chi2PCA);
+      // TPC PID variables
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPr0, nSigTpcPr0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaKa0, nSigTpcKa0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPi0, nSigTpcPi0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPr1, nSigTpcPr1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaKa1, nSigTpcKa1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPi1, nSigTpcPi1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPr2, nSigTpcPr2);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaKa2, nSigTpcKa2);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcNSigmaPi2, nSigTpcPi2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tpcNSigmaPrExpPr0, nSigTpcPr0, nSigTpcPr2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tpcNSigmaPiExpPi2, nSigTpcPi2, nSigTpcPi0);
+      // TOF PID variables
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPr0, nSigTofPr0);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaKa0, nSigTofKa0);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPi0, nSigTofPi0);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPr1, nSigTofPr1);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaKa1, nSigTofKa1);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPi1, nSigTofPi1);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPr2, nSigTofPr2);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaKa2, nSigTofKa2);
+      SET_ACCESSOR_XIC_FULL(candidate, tofNSigmaPi2, nSigTofPi2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tofNSigmaPrExpPr0, nSigTofPr0, nSigTofPr2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tofNSigmaPiExpPi2, nSigTofPi2, nSigTofPi0);
+      // Combined PID variables
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPi0, tpcTofNSigmaPi0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPi1, tpcTofNSigmaPi1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPi2, tpcTofNSigmaPi2);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaKa0, tpcTofNSigmaKa0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaKa1, tpcTofNSigmaKa1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaKa2, tpcTofNSigmaKa2);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPr0, tpcTofNSigmaPr0);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPr1, tpcTofNSigmaPr1);
+      SET_ACCESSOR_XIC_FULL(candidate, tpcTofNSigmaPr2, tpcTofNSigmaPr2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tpcTofNSigmaPrExpPr0, tpcTofNSigmaPr0, tpcTofNSigmaPr2);
+      SET_ACCESSOR_XIC_SIGNED(candidate, tpcTofNSigmaPiExpPi2, tpcTofNSigmaPi2, tpcTofNSigmaPi0);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -269,8 +268,9 @@ class HfMlResponseXicToPKPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_XIC
-#undef CHECK_AND_FILL_VEC_XIC_FULL
-#undef CHECK_AND_FILL_VEC_XIC
-#undef CHECK_AND_FILL_VEC_XIC_OBJECT_SIGNED
+#undef SET_ACCESSOR_XIC_VALUE
+#undef SET_ACCESSOR_XIC_FULL
+#undef SET_ACCESSOR_XIC
+#undef SET_ACCESSOR_XIC_OBJECT_SIGNED
 
 #endif // PWGHF_CORE_HFMLRESPONSEXICTOPKPI_H_
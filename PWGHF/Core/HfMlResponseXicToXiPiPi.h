@@ -21,6 +21,7 @@
 #include "Tools/ML/MlResponse.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 // Fill the map of available input features
@@ -31,23 +32,23 @@
     #FEATURE, static_cast<uint8_t>(InputFeaturesXicToXiPiPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
-// matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
-// by calling the corresponding GETTER from OBJECT
-#define CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL(OBJECT, FEATURE, GETTER) \
-  case static_cast<uint8_t>(InputFeaturesXicToXiPiPi::FEATURE): {    \
-    inputFeatures.emplace_back(OBJECT.GETTER());                     \
-    break;                                                           \
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns VALUE, computed from the arguments of getInputFeatures
+#define SET_ACCESSOR_XICTOXIPIPI_VALUE(FEATURE, VALUE)                                                    \
+  accessors[static_cast<uint8_t>(InputFeaturesXicToXiPiPi::FEATURE)] = [](T1 const& candidate) -> float { \
+    return VALUE;                                                                                         \
   }
 
-// Specific case of CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL(OBJECT, FEATURE, GETTER)
+// Set the accessor to FEATURE in the table of accessors to the input features
+// the accessor returns the FEATURE's value
+// by calling the corresponding GETTER from OBJECT
+#define SET_ACCESSOR_XICTOXIPIPI_FULL(OBJECT, FEATURE, GETTER) \
+  SET_ACCESSOR_XICTOXIPIPI_VALUE(FEATURE, OBJECT.GETTER())
+
+// Specific case of SET_ACCESSOR_XICTOXIPIPI_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
-#define CHECK_AND_FILL_VEC_XICTOXIPIPI(GETTER)                   \
-  case static_cast<uint8_t>(InputFeaturesXicToXiPiPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());              \
-    break;                                                       \
-  }
+#define SET_ACCESSOR_XICTOXIPIPI(GETTER) \
+  SET_ACCESSOR_XICTOXIPIPI_VALUE(GETTER, candidate.GETTER())
 
 namespace o2::analysis
 {
@@ -106,53 +107,65 @@ class HfMlResponseXicToXiPiPi : public HfMlResponse<TypeOutputScore>
   template <typename T1>
   std::vector<float> getInputFeatures(T1 const& candidate)
   {
-    std::vector<float> inputFeatures;
-
-    for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(ptProng0);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(ptProng1);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(ptProng2);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(chi2PCA);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(decayLength);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(decayLengthXY);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpa);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpaXY);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpaXi);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpaXYXi);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpaLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(cpaXYLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL(candidate, impactParameterXi, impactParameter0);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL(candidate, impactParameterPi0, impactParameter1);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL(candidate, impactParameterPi1, impactParameter2);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(invMassXi);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(invMassLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaXiDaughters);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaV0Daughters);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaPosToPV);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaNegToPV);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaBachelorToPV);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaXYCascToPV);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(dcaZCascToPV);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTpcPiFromXicPlus0);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTpcPiFromXicPlus1);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTpcBachelorPi);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTpcPiFromLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTpcPrFromLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTofPiFromXicPlus0);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTofPiFromXicPlus1);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTofBachelorPi);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTofPiFromLambda);
-        CHECK_AND_FILL_VEC_XICTOXIPIPI(nSigTofPrFromLambda);
-      }
-    }
-
-    return inputFeatures;
+    return MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(getFeatureAccessors<T1>(), candidate);
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  template <typename T1>
+  void getInputFeatures(std::span<float> row, T1 const& candidate)
+  {
+    MlResponse<TypeOutputScore>::getInputFeaturesFromAccessors(row, getFeatureAccessors<T1>(), candidate);
   }
 
  protected:
+  /// Method to get the table of accessors to the input features, built at compile time for each candidate type
+  template <typename T1>
+  static MlFeatureAccessors<T1> const& getFeatureAccessors()
+  {
+    static constexpr MlFeatureAccessors<T1> Accessors = [] {
+      MlFeatureAccessors<T1> accessors{};
+      SET_ACCESSOR_XICTOXIPIPI(ptProng0);
+      SET_ACCESSOR_XICTOXIPIPI(ptProng1);
+      SET_ACCESSOR_XICTOXIPIPI(ptProng2);
+      SET_ACCESSOR_XICTOXIPIPI(chi2PCA);
+      SET_ACCESSOR_XICTOXIPIPI(decayLength);
+      SET_ACCESSOR_XICTOXIPIPI(decayLengthNormalised);
+      SET_ACCESSOR_XICTOXIPIPI(decayLengthXY);
+      SET_ACCESSOR_XICTOXIPIPI(decayLengthXYNormalised);
+      SET_ACCESSOR_XICTOXIPIPI(cpa);
+      SET_ACCESSOR_XICTOXIPIPI(cpaXY);
+      SET_ACCESSOR_XICTOXIPIPI(cpaXi);
+      SET_ACCESSOR_XICTOXIPIPI(cpaXYXi);
+      SET_ACCESSOR_XICTOXIPIPI(cpaLambda);
+      SET_ACCESSOR_XICTOXIPIPI(cpaXYLambda);
+      SET_ACCESSOR_XICTOXIPIPI_FULL(candidate, impactParameterXi, impactParameter0);
+      SET_ACCESSOR_XICTOXIPIPI_FULL(candidate, impactParameterPi0, impactParameter1);
+      SET_ACCESSOR_XICTOXIPIPI_FULL(candidate, impactParameterPi1, impactParameter2);
+      SET_ACCESSOR_XICTOXIPIPI(invMassXi);
+      SET_ACCESSOR_XICTOXIPIPI(invMassLambda);
+      SET_ACCESSOR_XICTOXIPIPI(dcaXiDaughters);
+      SET_ACCESSOR_XICTOXIPIPI(dcaV0Daughters);
+      SET_ACCESSOR_XICTOXIPIPI(dcaPosToPV);
+      SET_ACCESSOR_XICTOXIPIPI(dcaNegToPV);
+      SET_ACCESSOR_XICTOXIPIPI(dcaBachelorToPV);
+      SET_ACCESSOR_XICTOXIPIPI(dcaXYCascToPV);
+      SET_ACCESSOR_XICTOXIPIPI(dcaZCascToPV);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTpcPiFromXicPlus0);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTpcPiFromXicPlus1);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTpcBachelorPi);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTpcPiFromLambda);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTpcPrFromLambda);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTofPiFromXicPlus0);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTofPiFromXicPlus1);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTofBachelorPi);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTofPiFromLambda);
+      SET_ACCESSOR_XICTOXIPIPI(nSigTofPrFromLambda);
+      return accessors;
+    }();
+    return Accessors;
+  }
+
   /// Method to fill the map of available input features
   void setAvailableInputFeatures()
   {
@@ -199,7 +212,8 @@ class HfMlResponseXicToXiPiPi : public HfMlResponse<TypeOutputScore>
 } // namespace o2::analysis
 
 #undef FILL_MAP_XICTOXIPIPI
-#undef CHECK_AND_FILL_VEC_XICTOXIPIPI_FULL
-#undef CHECK_AND_FILL_VEC_XICTOXIPIPI
+#undef SET_ACCESSOR_XICTOXIPIPI_VALUE
+#undef SET_ACCESSOR_XICTOXIPIPI_FULL
+#undef SET_ACCESSOR_XICTOXIPIPI
 
 #endif // PWGHF_CORE_HFMLRESPONSEXICTOXIPIPI_H_
@@ -28,6 +28,7 @@
 #include "PWGHF/Utils/utilsAnalysis.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsEvSelHf.h"
+#include "PWGHF/Utils/utilsPvRefit.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 
 #include "Common/CCDB/TriggerAliases.h"
@@ -87,6 +88,7 @@
 using namespace o2;
 using namespace o2::analysis;
 using namespace o2::hf_evsel;
+using namespace o2::hf_pv_refit;
 using namespace o2::aod;
 using namespace o2::hf_centrality;
 using namespace o2::framework;
@@ -270,6 +272,8 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
     Configurable<bool> doPvRefit{"doPvRefit", false, "do PV refit excluding the considered track"};
     Configurable<bool> fillHistograms{"fillHistograms", true, "fill histograms"};
     Configurable<bool> debugPvRefit{"debugPvRefit", false, "debug lines for primary vertex refit"};
+    Configurable<bool> useIncrementalPvRefit{"useIncrementalPvRefit", false, "remove the tracks from the PV fit with a down-date of the fit of all contributors (approximation, see utilsPvRefit.h) instead of a full PVertexer refit"};
+    Configurable<bool> validateIncrementalPvRefit{"validateIncrementalPvRefit", false, "run both the PVertexer refit (used for the output) and the incremental refit and fill their differences"};
     // Configurable<double> bz{"bz", 5., "bz field"};
     // quality cut
     Configurable<bool> doCutQuality{"doCutQuality", true, "apply quality cuts"};
@@ -325,6 +329,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   o2::base::MatLayerCylSet* lut{};
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
   int runNumber{};
+  PvRefitter pvRefitter; // PV contributors of the current collision, for the incremental PV refit
 
   using TracksWithSelAndDca = soa::Join<aod::TracksWCovDcaExtra, aod::TrackSelection>;
   using TracksWithSelAndDcaAndPidTpc = soa::Join<aod::TracksWCovDcaExtra, aod::TrackSelection, aod::pidTPCFullPr, aod::pidTPCFullKa, aod::pidTPCFullDe>;
@@ -442,6 +447,16 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
         registry.add("PvRefit/hPvRefitZChi2Minus1", "PV refit with #it{#chi}^{2}==#minus1", kTH2D, {axisCollisionZ, axisCollisionZOriginal});
         registry.add("PvRefit/hNContribPvRefitNotDoable", "N. contributors for PV refit not doable", kTH1D, {axisCollisionNContrib});
         registry.add("PvRefit/hNContribPvRefitChi2Minus1", "N. contributors original PV for PV refit #it{#chi}^{2}==#minus1", kTH1D, {axisCollisionNContrib});
+        if (config.validateIncrementalPvRefit) {
+          const AxisSpec axisValidationDelta{200, -0.01f, 0.01f, ""};
+          registry.add("PvRefit/Validation/hDeltaXvsNContrib", "PVertexer refit #minus incremental refit;;#Delta x_{PV} (cm)", kTH2D, {axisCollisionNContrib, axisValidationDelta});
+          registry.add("PvRefit/Validation/hDeltaYvsNContrib", "PVertexer refit #minus incremental refit;;#Delta y_{PV} (cm)", kTH2D, {axisCollisionNContrib, axisValidationDelta});
+          registry.add("PvRefit/Validation/hDeltaZvsNContrib", "PVertexer refit #minus incremental refit;;#Delta z_{PV} (cm)", kTH2D, {axisCollisionNContrib, axisValidationDelta});
+          registry.add("PvRefit/Validation/hDeltaChi2vsNContrib", "PVertexer refit #minus incremental refit;;#Delta #chi^{2}", kTH2D, {axisCollisionNContrib, {200, -2.f, 2.f, ""}});
+          registry.add("PvRefit/Validation/hDeltaDcaXYvsNContrib", "PVertexer refit #minus incremental refit;;#Delta DCA_{xy} (cm)", kTH2D, {axisCollisionNContrib, axisValidationDelta});
+          registry.add("PvRefit/Validation/hDeltaDcaZvsNContrib", "PVertexer refit #minus incremental refit;;#Delta DCA_{z} (cm)", kTH2D, {axisCollisionNContrib, axisValidationDelta});
+          registry.add("PvRefit/Validation/hNContribFailed", "N. contributors original PV for PV refits with only one #it{#chi}^{2}==#minus1", kTH1D, {axisCollisionNContrib});
+        }
       }
 
       ccdb->setURL(config.ccdbUrl);
@@ -753,6 +768,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   /// \param pvCoord is an array containing the coordinates of the refitted PV
   /// \param pvCovMatrix is an array containing the covariance matrix values of the refitted PV
   /// \param dcaXYdcaZ is an array containing the dcaXY and dcaZ of trackToRemove with respect to the refitted PV
+  /// \note pvRefitter must be set with the PV contributors of the current collision and, for the incremental refit, prepared for it
   template <typename TTrack>
   void performPvRefitTrack(aod::Collision const& collision,
                            aod::BCsWithTimestamps const&,
@@ -763,7 +779,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
                            std::array<float, 6>& pvCovMatrix,
                            std::array<float, 2>& dcaXYdcaZ)
   {
-    std::vector<bool> vecPvRefitContributorUsed(vecPvContributorGlobId.size(), true);
+    std::vector<bool> vecPvRefitContributorUsed{};
 
     /// Prepare the vertex refitting
     // set the magnetic field from CCDB
@@ -800,11 +816,17 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
     primVtx.setY(collision.posY());
     primVtx.setZ(collision.posZ());
     primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    // configure PVertexer
+    // configure PVertexer, unless the incremental refit prepared once per collision is used
+    // (in validation mode the PVertexer refit is used and the incremental refit is only compared to it)
+    const bool useIncrementalRefit = config.useIncrementalPvRefit && !config.validateIncrementalPvRefit;
     o2::vertexing::PVertexer vertexer;
-    o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
-    vertexer.init();
-    const bool pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+    bool pvRefitDoable = pvRefitter.isRefitDoable();
+    if (!useIncrementalRefit) {
+      o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
+      vertexer.init();
+      pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+      vecPvRefitContributorUsed.assign(vecPvContributorGlobId.size(), true);
+    }
     if (!pvRefitDoable) {
       LOG(info) << "Not enough tracks accepted for the refit";
       if (config.doPvRefit && config.fillHistograms) {
@@ -826,15 +848,21 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
     bool recalcImpPar = false;
     if (config.doPvRefit && pvRefitDoable) {
       recalcImpPar = true;
-      const auto trackIterator = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackToRemove.globalIndex()); /// track global index
-      if (trackIterator != vecPvContributorGlobId.end()) {
+      const int entry = pvRefitter.getEntry(trackToRemove.globalIndex()); /// track global index
+      if (entry >= 0) {
 
         /// this track contributed to the PV fit: let's do the refit without it
-        const int entry = std::distance(vecPvContributorGlobId.begin(), trackIterator);
-
-        vecPvRefitContributorUsed[entry] = false; /// remove the track from the PV refitting
-
-        const auto primVtxRefitted = vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
+        o2::dataformats::PrimaryVertex primVtxRefitted;
+        if (useIncrementalRefit) {
+          primVtxRefitted = pvRefitter.refitVertex(std::array{entry}); // vertex down-date
+        } else {
+          vecPvRefitContributorUsed[entry] = false;                                   /// remove the track from the PV refitting
+          primVtxRefitted = vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
+          vecPvRefitContributorUsed[entry] = true;                                    /// restore the track for the next PV refitting (probably not necessary here)
+          if (config.validateIncrementalPvRefit && config.fillHistograms && pvRefitter.isRefitDoable()) {
+            validateIncrementalPvRefit(primVtxRefitted, pvRefitter.refitVertex(std::array{entry}), collision.numContrib(), trackToRemove);
+          }
+        }
         // LOG(info) << "refit " << cnt << "/" << ntr << " result = " << primVtxRefitted.asString();
         if (config.debugPvRefit) {
           LOG(info) << "refit for track with global index " << static_cast<int>(trackToRemove.globalIndex()) << " " << primVtxRefitted.asString();
@@ -857,8 +885,6 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
           registry.fill(HIST("PvRefit/hChi2vsNContrib"), primVtxRefitted.getNContributors(), primVtxRefitted.getChi2());
         }
 
-        vecPvRefitContributorUsed[entry] = true; /// restore the track for the next PV refitting (probably not necessary here)
-
         if (recalcImpPar) {
           // fill the histograms for refitted PV with good Chi2
           const double deltaX = primVtx.getX() - primVtxRefitted.getX();
@@ -926,6 +952,41 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
     }
   } /// end of performPvRefitTrack function
 
+  /// Compares the incremental PV refit with the PVertexer one for the same removed track
+  /// \param primVtxRefitted is the PV refitted with PVertexer
+  /// \param primVtxDownDated is the PV refitted with the incremental down-date
+  /// \param nContribOriginal is the number of contributors of the original PV
+  /// \param trackRemoved is the track removed from both refits
+  template <typename TTrack>
+  void validateIncrementalPvRefit(o2::dataformats::PrimaryVertex const& primVtxRefitted,
+                                  o2::dataformats::PrimaryVertex const& primVtxDownDated,
+                                  const int nContribOriginal,
+                                  TTrack const& trackRemoved)
+  {
+    if ((primVtxRefitted.getChi2() < 0) != (primVtxDownDated.getChi2() < 0)) {
+      registry.fill(HIST("PvRefit/Validation/hNContribFailed"), nContribOriginal);
+      return;
+    }
+    if (primVtxRefitted.getChi2() < 0) {
+      return;
+    }
+    registry.fill(HIST("PvRefit/Validation/hDeltaXvsNContrib"), nContribOriginal, primVtxRefitted.getX() - primVtxDownDated.getX());
+    registry.fill(HIST("PvRefit/Validation/hDeltaYvsNContrib"), nContribOriginal, primVtxRefitted.getY() - primVtxDownDated.getY());
+    registry.fill(HIST("PvRefit/Validation/hDeltaZvsNContrib"), nContribOriginal, primVtxRefitted.getZ() - primVtxDownDated.getZ());
+    registry.fill(HIST("PvRefit/Validation/hDeltaChi2vsNContrib"), nContribOriginal, primVtxRefitted.getChi2() - primVtxDownDated.getChi2());
+
+    // DCA of the removed track with respect to the two refitted PVs, with the same propagation used for the output
+    auto trackParRefit = getTrackPar(trackRemoved);
+    auto trackParDownDate = trackParRefit;
+    std::array dcaRefit{-999.f, -999.f};
+    std::array dcaDownDate{-999.f, -999.f};
+    if (o2::base::Propagator::Instance()->propagateToDCABxByBz({primVtxRefitted.getX(), primVtxRefitted.getY(), primVtxRefitted.getZ()}, trackParRefit, 2.f, noMatCorr, &dcaRefit) &&
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({primVtxDownDated.getX(), primVtxDownDated.getY(), primVtxDownDated.getZ()}, trackParDownDate, 2.f, noMatCorr, &dcaDownDate)) {
+      registry.fill(HIST("PvRefit/Validation/hDeltaDcaXYvsNContrib"), nContribOriginal, dcaRefit[0] - dcaDownDate[0]);
+      registry.fill(HIST("PvRefit/Validation/hDeltaDcaZvsNContrib"), nContribOriginal, dcaRefit[1] - dcaDownDate[1]);
+    }
+  }
+
   /// Selection tag for tracks
   /// \tparam TTracks is the type of the track table
   /// \param collision is the collision iterator
@@ -946,6 +1007,12 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
                        std::vector<std::array<float, 6>>& pvRefitPvCovMatrixPerTrack)
   {
     const auto thisCollId = collision.globalIndex();
+
+    /// retrieve PV contributors for the current collision, once for all the tracks
+    std::vector<int64_t> vecPvContributorGlobId{};
+    std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov{};
+    bool isPvContributorListFilled{false};
+
     for (const auto& trackId : trackIndicesCollision) {
       int statusProng = BIT(CandidateType::NCandidateTypes) - 1; // all bits on
       const auto track = trackId.template track_as<TTracks>();
@@ -961,13 +1028,24 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
         pvRefitPvCoord = {collision.posX(), collision.posY(), collision.posZ()};
         pvRefitPvCovMatrix = {collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
 
-        /// retrieve PV contributors for the current collision
-        std::vector<int64_t> vecPvContributorGlobId{};
-        std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov{};
-
-        for (const auto& contributor : pvContrCollision) {
-          vecPvContributorGlobId.push_back(contributor.globalIndex());
-          vecPvContributorTrackParCov.push_back(getTrackParCov(contributor));
+        if (!isPvContributorListFilled) {
+          vecPvContributorGlobId.reserve(pvContrCollision.size());
+          vecPvContributorTrackParCov.reserve(pvContrCollision.size());
+          for (const auto& contributor : pvContrCollision) {
+            vecPvContributorGlobId.push_back(contributor.globalIndex());
+            vecPvContributorTrackParCov.push_back(getTrackParCov(contributor));
+          }
+          pvRefitter.setContributors(vecPvContributorGlobId);
+          if (config.useIncrementalPvRefit || config.validateIncrementalPvRefit) {
+            // fit of all the contributors, from which each track is then removed
+            const auto bc = collision.bc_as<o2::aod::BCsWithTimestamps>();
+            initCCDB(bc, runNumber, ccdb, config.isRun2 ? config.ccdbPathGrp : config.ccdbPathGrpMag, lut, config.isRun2);
+            o2::dataformats::VertexBase primVtx;
+            primVtx.setXYZ(collision.posX(), collision.posY(), collision.posZ());
+            primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+            pvRefitter.prepareVertexRefit(vecPvContributorTrackParCov, primVtx, o2::base::Propagator::Instance()->getNominalBz());
+          }
+          isPvContributorListFilled = true;
         }
         if (config.debugPvRefit) {
           LOG(info) << "### vecPvContributorGlobId.size()=" << vecPvContributorGlobId.size() << ", vecPvContributorTrackParCov.size()=" << vecPvContributorTrackParCov.size() << ", N. original contributors=" << collision.numContrib();
@@ -1202,6 +1280,7 @@ struct HfTrackIndexSkimCreator {
     Configurable<bool> doDstar{"doDstar", false, "do D* candidates"};
     Configurable<bool> debug{"debug", false, "debug mode"};
     Configurable<bool> debugPvRefit{"debugPvRefit", false, "debug lines for primary vertex refit"};
+    Configurable<bool> useIncrementalPvRefit{"useIncrementalPvRefit", false, "remove the tracks from the PV fit with a down-date of the fit of all contributors (approximation, see utilsPvRefit.h) instead of a full PVertexer refit"};
     Configurable<bool> fillHistograms{"fillHistograms", true, "fill histograms"};
     // Configurable<int> nCollsMax{"nCollsMax", -1, "Max collisions per file"}; //can be added to run over limited collisions per file - for tesing purposes
     // preselection
@@ -1281,6 +1360,7 @@ struct HfTrackIndexSkimCreator {
   o2::base::MatLayerCylSet* lut{};
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
   int runNumber{};
+  PvRefitter pvRefitter; // PV contributors of the current collision, for the incremental PV refit
 
   // int nColls{0}; //can be added to run over limited collisions per file - for tesing purposes
 
@@ -1322,6 +1402,18 @@ struct HfTrackIndexSkimCreator {
   Partition<FilteredTrackAssocSel> positiveSoftPions = aod::hf_sel_track::isPositive == true && ((aod::hf_sel_track::isSelProng & static_cast<uint32_t>(BIT(CandidateType::CandDstar))) != 0u);
   Partition<FilteredTrackAssocSel> negativeSoftPions = aod::hf_sel_track::isPositive == false && ((aod::hf_sel_track::isSelProng & static_cast<uint32_t>(BIT(CandidateType::CandDstar))) != 0u);
 
+  /// Track parameters, momenta and DCAs of the selected tracks of a collision, at the collision PV
+  /// Entries are in the same order as the sliced track indices, so that pair and triplet loops can read them by position
+  struct TrackCacheAtPv {
+    std::vector<o2::track::TrackParCov> trackParCov{};
+    std::vector<std::array<float, 3>> pVec{};
+    std::vector<std::array<float, 2>> dcaInfo{};
+  };
+  TrackCacheAtPv trackCachePos{};         // positive tracks for 2- and 3-prongs
+  TrackCacheAtPv trackCacheNeg{};         // negative tracks for 2- and 3-prongs
+  TrackCacheAtPv trackCacheSoftPionPos{}; // positive soft pions for D*
+  TrackCacheAtPv trackCacheSoftPionNeg{}; // negative soft pions for D*
+
   // QA of PV refit
   ConfigurableAxis axisPvRefitDeltaX{"axisPvRefitDeltaX", {1000, -0.5f, 0.5f}, "DeltaX binning PV refit"};
   ConfigurableAxis axisPvRefitDeltaY{"axisPvRefitDeltaY", {1000, -0.5f, 0.5f}, "DeltaY binning PV refit"};
@@ -1945,6 +2037,7 @@ struct HfTrackIndexSkimCreator {
   /// \param vecCandPvContributorGlobId is a vector containing the global indices of daughter tracks that contributed to the original PV refit
   /// \param pvCoord is a vector where to store X, Y and Z values of refitted PV
   /// \param pvCovMatrix is a vector where to store the covariance matrix values of refitted PV
+  /// \note pvRefitter must be set with the PV contributors of the current collision and, for the incremental refit, prepared for it
   void performPvRefitCandProngs(SelectedCollisions::iterator const& collision,
                                 aod::BCsWithTimestamps const&,
                                 std::vector<int64_t> const& vecPvContributorGlobId,
@@ -1953,7 +2046,7 @@ struct HfTrackIndexSkimCreator {
                                 std::array<float, 3>& pvCoord,
                                 std::array<float, 6>& pvCovMatrix)
   {
-    std::vector<bool> vecPvRefitContributorUsed(vecPvContributorGlobId.size(), true);
+    std::vector<bool> vecPvRefitContributorUsed{};
 
     /// Prepare the vertex refitting
     // set the magnetic field from CCDB
@@ -1966,11 +2059,15 @@ struct HfTrackIndexSkimCreator {
     primVtx.setY(collision.posY());
     primVtx.setZ(collision.posZ());
     primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    // configure PVertexer
+    // configure PVertexer, unless the incremental refit prepared once per collision is used
     o2::vertexing::PVertexer vertexer;
-    o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
-    vertexer.init();
-    const bool pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+    bool pvRefitDoable = pvRefitter.isRefitDoable();
+    if (!config.useIncrementalPvRefit) {
+      o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
+      vertexer.init();
+      pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+      vecPvRefitContributorUsed.assign(vecPvContributorGlobId.size(), true);
+    }
     if (!pvRefitDoable) {
       LOG(info) << "Not enough tracks accepted for the refit";
       if ((doprocess2And3ProngsWithPvRefit || doprocess2And3ProngsWithPvRefitWithPidForHfFiltersBdt) && config.fillHistograms) {
@@ -1989,12 +2086,15 @@ struct HfTrackIndexSkimCreator {
       }
       bool recalcPvRefit = true;
       int nCandContr = 0;
-      for (const uint64_t myGlobalID : vecCandPvContributorGlobId) {                                              // o2-linter: disable=const-ref-in-for-loop (small type)
-        auto trackIterator = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), myGlobalID); /// track global index
-        if (trackIterator != vecPvContributorGlobId.end()) {
+      std::array entriesToRemove{-1, -1, -1}; // up to 3 daughters
+      for (std::size_t iProng{0u}; iProng < vecCandPvContributorGlobId.size(); ++iProng) {
+        const int entry = pvRefitter.getEntry(vecCandPvContributorGlobId[iProng]); /// track global index
+        if (entry >= 0) {
+          entriesToRemove[nCandContr] = entry;
           /// this is a contributor, let's remove it for the PV refit
-          const int entry = std::distance(vecPvContributorGlobId.begin(), trackIterator);
-          vecPvRefitContributorUsed[entry] = false; /// remove the track from the PV refitting
+          if (!config.useIncrementalPvRefit) {
+            vecPvRefitContributorUsed[entry] = false; /// remove the track from the PV refitting
+          }
           nCandContr++;
         }
       }
@@ -2003,7 +2103,7 @@ struct HfTrackIndexSkimCreator {
       if (config.debugPvRefit) {
         LOG(info) << "### PV refit after removing " << nCandContr << " tracks";
       }
-      auto primVtxRefitted = vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
+      const auto primVtxRefitted = config.useIncrementalPvRefit ? pvRefitter.refitVertex(entriesToRemove) : vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
       // LOG(info) << "refit " << cnt << "/" << ntr << " result = " << primVtxRefitted.asString();
       // LOG(info) << "refit for track with global index " << static_cast<int>(myTrack.globalIndex()) << " " << primVtxRefitted.asString();
       if (primVtxRefitted.getChi2() < 0) {
@@ -2067,6 +2167,36 @@ struct HfTrackIndexSkimCreator {
 
   } /// end of performPvRefitCandProngs function
 
+  /// Method to fill the cache of track parameters at the PV of a collision
+  /// \param collision is the collision
+  /// \param trackIndices are the sliced track indices of the collision
+  /// \param trackCache is the cache to be filled
+  /// \note Tracks which do not belong by default to this collision are propagated to its PV, once per collision
+  template <typename TTracks, typename TTrackIndices>
+  void fillTrackCacheAtPv(SelectedCollisions::iterator const& collision, TTrackIndices const& trackIndices, TrackCacheAtPv& trackCache)
+  {
+    const auto thisCollId = collision.globalIndex();
+    trackCache.trackParCov.clear();
+    trackCache.pVec.clear();
+    trackCache.dcaInfo.clear();
+    trackCache.trackParCov.reserve(trackIndices.size());
+    trackCache.pVec.reserve(trackIndices.size());
+    trackCache.dcaInfo.reserve(trackIndices.size());
+    for (const auto& trackIndex : trackIndices) {
+      const auto track = trackIndex.template track_as<TTracks>();
+      auto trackParVar = getTrackParCov(track);
+      std::array pVecTrack{track.pVector()};
+      std::array dcaInfo{track.dcaXY(), track.dcaZ()};
+      if (thisCollId != track.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVar, 2.f, noMatCorr, &dcaInfo);
+        getPxPyPz(trackParVar, pVecTrack);
+      }
+      trackCache.trackParCov.push_back(trackParVar);
+      trackCache.pVec.push_back(pVecTrack);
+      trackCache.dcaInfo.push_back(dcaInfo);
+    }
+  }
+
   template <bool DoPvRefit, bool UsePidForHfFiltersBdt, typename TTracks>
   void run2And3Prongs(SelectedCollisions const& collisions,
                       aod::BCsWithTimestamps const& bcWithTimeStamps,
@@ -2117,6 +2247,16 @@ struct HfTrackIndexSkimCreator {
           }
         }
         vecPvRefitContributorUsed = std::vector<bool>(vecPvContributorGlobId.size(), true);
+        pvRefitter.setContributors(vecPvContributorGlobId);
+        if (config.useIncrementalPvRefit) {
+          // fit of all the contributors, from which the candidate daughters are then removed
+          const auto bc = collision.bc_as<o2::aod::BCsWithTimestamps>();
+          initCCDB(bc, runNumber, ccdb, config.isRun2 ? config.ccdbPathGrp : config.ccdbPathGrpMag, lut, config.isRun2);
+          o2::dataformats::VertexBase primVtx;
+          primVtx.setXYZ(collision.posX(), collision.posY(), collision.posZ());
+          primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+          pvRefitter.prepareVertexRefit(vecPvContributorTrackParCov, primVtx, o2::base::Propagator::Instance()->getNominalBz());
+        }
       }
 
       // auto centrality = collision.centV0M(); //FIXME add centrality when option for variations to the process function appears
@@ -2158,10 +2298,17 @@ struct HfTrackIndexSkimCreator {
 
       const auto thisCollId = collision.globalIndex();
 
-      // first loop over positive tracks
+      // track indices of this collision, with their parameters at the PV cached once for all the combinations
       const auto groupedTrackIndicesPos1 = positiveFor2And3Prongs->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+      const auto groupedTrackIndicesNeg1 = negativeFor2And3Prongs->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+      fillTrackCacheAtPv<TTracks>(collision, groupedTrackIndicesPos1, trackCachePos);
+      fillTrackCacheAtPv<TTracks>(collision, groupedTrackIndicesNeg1, trackCacheNeg);
+      bool isTrackCacheSoftPionFilled{false};
+
+      // first loop over positive tracks
       int lastFilledD0 = -1; // index to be filled in table for D* mesons
-      for (auto trackIndexPos1 = groupedTrackIndicesPos1.begin(); trackIndexPos1 != groupedTrackIndicesPos1.end(); ++trackIndexPos1) {
+      int iTrackPos1{0};
+      for (auto trackIndexPos1 = groupedTrackIndicesPos1.begin(); trackIndexPos1 != groupedTrackIndicesPos1.end(); ++trackIndexPos1, ++iTrackPos1) {
         const auto trackPos1 = trackIndexPos1.template track_as<TTracks>();
 
         // retrieve the selection flag that corresponds to this collision
@@ -2169,17 +2316,13 @@ struct HfTrackIndexSkimCreator {
         const bool sel2ProngStatusPos = TESTBIT(isSelProngPos1, CandidateType::Cand2Prong);
         const bool sel3ProngStatusPos1 = TESTBIT(isSelProngPos1, CandidateType::Cand3Prong);
 
-        auto trackParVarPos1 = getTrackParCov(trackPos1);
-        std::array pVecTrackPos1{trackPos1.pVector()};
-        std::array dcaInfoPos1{trackPos1.dcaXY(), trackPos1.dcaZ()};
-        if (thisCollId != trackPos1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-          o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos1, 2.f, noMatCorr, &dcaInfoPos1);
-          getPxPyPz(trackParVarPos1, pVecTrackPos1);
-        }
+        const auto& trackParVarPos1 = trackCachePos.trackParCov[iTrackPos1];
+        const auto& pVecTrackPos1 = trackCachePos.pVec[iTrackPos1];
+        const auto& dcaInfoPos1 = trackCachePos.dcaInfo[iTrackPos1];
 
         // first loop over negative tracks
-        const auto groupedTrackIndicesNeg1 = negativeFor2And3Prongs->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-        for (auto trackIndexNeg1 = groupedTrackIndicesNeg1.begin(); trackIndexNeg1 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg1) {
+        int iTrackNeg1{0};
+        for (auto trackIndexNeg1 = groupedTrackIndicesNeg1.begin(); trackIndexNeg1 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg1, ++iTrackNeg1) {
           const auto trackNeg1 = trackIndexNeg1.template track_as<TTracks>();
 
           // retrieve the selection flag that corresponds to this collision
@@ -2187,13 +2330,9 @@ struct HfTrackIndexSkimCreator {
           const bool sel2ProngStatusNeg = TESTBIT(isSelProngNeg1, CandidateType::Cand2Prong);
           const bool sel3ProngStatusNeg1 = TESTBIT(isSelProngNeg1, CandidateType::Cand3Prong);
 
-          auto trackParVarNeg1 = getTrackParCov(trackNeg1);
-          std::array pVecTrackNeg1{trackNeg1.pVector()};
-          std::array dcaInfoNeg1{trackNeg1.dcaXY(), trackNeg1.dcaZ()};
-          if (thisCollId != trackNeg1.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg1, 2.f, noMatCorr, &dcaInfoNeg1);
-            getPxPyPz(trackParVarNeg1, pVecTrackNeg1);
-          }
+          const auto& trackParVarNeg1 = trackCacheNeg.trackParCov[iTrackNeg1];
+          const auto& pVecTrackNeg1 = trackCacheNeg.pVec[iTrackNeg1];
+          const auto& dcaInfoNeg1 = trackCacheNeg.dcaInfo[iTrackNeg1];
 
           uint isSelected2ProngCand = n2ProngBit; // bitmap for checking status of two-prong candidates (1 is true, 0 is rejected)
 
@@ -2241,11 +2380,11 @@ struct HfTrackIndexSkimCreator {
                     registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                   }
                   int nCandContr = 2;
-                  auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                  auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
+                  const int trackFirstEntry = pvRefitter.getEntry(trackPos1.globalIndex());
+                  const int trackSecondEntry = pvRefitter.getEntry(trackNeg1.globalIndex());
                   bool isTrackFirstContr = true;
                   bool isTrackSecondContr = true;
-                  if (trackFirstIt == vecPvContributorGlobId.end()) {
+                  if (trackFirstEntry < 0) {
                     /// This track did not contribute to the original PV refit
                     if (config.debugPvRefit) {
                       LOG(info) << "--- [2 Prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2253,7 +2392,7 @@ struct HfTrackIndexSkimCreator {
                     nCandContr--;
                     isTrackFirstContr = false;
                   }
-                  if (trackSecondIt == vecPvContributorGlobId.end()) {
+                  if (trackSecondEntry < 0) {
                     /// This track did not contribute to the original PV refit
                     if (config.debugPvRefit) {
                       LOG(info) << "--- [2 Prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2402,7 +2541,8 @@ struct HfTrackIndexSkimCreator {
 
           if (config.do3Prong && is2ProngCandidateGoodFor3Prong) { // if 3 prongs are enabled and the first 2 tracks are selected for the 3-prong channels
             // second loop over positive tracks
-            for (auto trackIndexPos2 = trackIndexPos1 + 1; trackIndexPos2 != groupedTrackIndicesPos1.end(); ++trackIndexPos2) {
+            int iTrackPos2{iTrackPos1 + 1};
+            for (auto trackIndexPos2 = trackIndexPos1 + 1; trackIndexPos2 != groupedTrackIndicesPos1.end(); ++trackIndexPos2, ++iTrackPos2) {
 
               uint isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexPos2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2420,16 +2560,12 @@ struct HfTrackIndexSkimCreator {
               }
 
               const auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
-              auto trackParVarPos2 = getTrackParCov(trackPos2);
-              std::array dcaInfoPos2{trackPos2.dcaXY(), trackPos2.dcaZ()};
+              const auto& trackParVarPos2 = trackCachePos.trackParCov[iTrackPos2];
+              const auto& dcaInfoPos2 = trackCachePos.dcaInfo[iTrackPos2];
 
               // preselection of 3-prong candidates
               if (isSelected3ProngCand) {
-                std::array pVecTrackPos2{trackPos2.pVector()};
-                if (thisCollId != trackPos2.collisionId()) { // this is not the "default" collision for this track and we still did not re-propagate it, we have to re-propagate it
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos2, 2.f, noMatCorr, &dcaInfoPos2);
-                  getPxPyPz(trackParVarPos2, pVecTrackPos2);
-                }
+                const auto& pVecTrackPos2 = trackCachePos.pVec[iTrackPos2];
 
                 if (config.debug) {
                   for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
@@ -2456,13 +2592,13 @@ struct HfTrackIndexSkimCreator {
                   registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                 }
                 int nCandContr = 3;
-                auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
-                auto trackThirdIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos2.globalIndex());
+                const int trackFirstEntry = pvRefitter.getEntry(trackPos1.globalIndex());
+                const int trackSecondEntry = pvRefitter.getEntry(trackNeg1.globalIndex());
+                const int trackThirdEntry = pvRefitter.getEntry(trackPos2.globalIndex());
                 bool isTrackFirstContr = true;
                 bool isTrackSecondContr = true;
                 bool isTrackThirdContr = true;
-                if (trackFirstIt == vecPvContributorGlobId.end()) {
+                if (trackFirstEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2470,7 +2606,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackFirstContr = false;
                 }
-                if (trackSecondIt == vecPvContributorGlobId.end()) {
+                if (trackSecondEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2478,7 +2614,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackSecondContr = false;
                 }
-                if (trackThirdIt == vecPvContributorGlobId.end()) {
+                if (trackThirdEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos2 with globalIndex " << trackPos2.globalIndex() << " was not a PV contributor";
@@ -2658,7 +2794,8 @@ struct HfTrackIndexSkimCreator {
             }
 
             // second loop over negative tracks
-            for (auto trackIndexNeg2 = trackIndexNeg1 + 1; trackIndexNeg2 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg2) {
+            int iTrackNeg2{iTrackNeg1 + 1};
+            for (auto trackIndexNeg2 = trackIndexNeg1 + 1; trackIndexNeg2 != groupedTrackIndicesNeg1.end(); ++trackIndexNeg2, ++iTrackNeg2) {
 
               int isSelected3ProngCand = n3ProngBit;
               if (!TESTBIT(trackIndexNeg2.isSelProng(), CandidateType::Cand3Prong)) { // continue immediately
@@ -2676,16 +2813,12 @@ struct HfTrackIndexSkimCreator {
               }
 
               auto trackNeg2 = trackIndexNeg2.template track_as<TTracks>();
-              auto trackParVarNeg2 = getTrackParCov(trackNeg2);
-              std::array dcaInfoNeg2{trackNeg2.dcaXY(), trackNeg2.dcaZ()};
+              const auto& trackParVarNeg2 = trackCacheNeg.trackParCov[iTrackNeg2];
+              const auto& dcaInfoNeg2 = trackCacheNeg.dcaInfo[iTrackNeg2];
 
               // preselection of 3-prong candidates
               if (isSelected3ProngCand) {
-                std::array pVecTrackNeg2{trackNeg2.pVector()};
-                if (thisCollId != trackNeg2.collisionId()) { // this is not the "default" collision for this track and we still did not re-propagate it, we have to re-propagate it
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg2, 2.f, noMatCorr, &dcaInfoNeg2);
-                  getPxPyPz(trackParVarNeg2, pVecTrackNeg2);
-                }
+                const auto& pVecTrackNeg2 = trackCacheNeg.pVec[iTrackNeg2];
 
                 if (config.debug) {
                   for (int iDecay3P = 0; iDecay3P < kN3ProngDecays; iDecay3P++) {
@@ -2712,13 +2845,13 @@ struct HfTrackIndexSkimCreator {
                   registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                 }
                 int nCandContr = 3;
-                auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
-                auto trackThirdIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg2.globalIndex());
+                const int trackFirstEntry = pvRefitter.getEntry(trackPos1.globalIndex());
+                const int trackSecondEntry = pvRefitter.getEntry(trackNeg1.globalIndex());
+                const int trackThirdEntry = pvRefitter.getEntry(trackNeg2.globalIndex());
                 bool isTrackFirstContr = true;
                 bool isTrackSecondContr = true;
                 bool isTrackThirdContr = true;
-                if (trackFirstIt == vecPvContributorGlobId.end()) {
+                if (trackFirstEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2726,7 +2859,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackFirstContr = false;
                 }
-                if (trackSecondIt == vecPvContributorGlobId.end()) {
+                if (trackSecondEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2734,7 +2867,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackSecondContr = false;
                 }
-                if (trackThirdIt == vecPvContributorGlobId.end()) {
+                if (trackThirdEntry < 0) {
                   /// This track did not contribute to the original PV refit
                   if (config.debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg2 with globalIndex " << trackNeg2.globalIndex() << " was not a PV contributor";
@@ -2917,21 +3050,23 @@ struct HfTrackIndexSkimCreator {
 
           if (config.doDstar && TESTBIT(isSelected2ProngCand, hf_cand_2prong::DecayType::D0ToPiK) && (pt2Prong + config.ptTolerance) * 1.2 > config.binsPtDstarToD0Pi->at(0) && whichHypo2Prong[kN2ProngDecays] != 0) { // o2-linter: disable="magic-number" (see comment below)
                                                                                                                                                                                                                         // if D* enabled and pt of the D0 is larger than the minimum of the D* one within 20% (D* and D0 momenta are very similar, always within 20% according to PYTHIA8)
+            auto groupedTrackIndicesSoftPionsPos = positiveSoftPions->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+            auto groupedTrackIndicesSoftPionsNeg = negativeSoftPions->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+            if (!isTrackCacheSoftPionFilled) { // soft pions are propagated at most once per collision, only if needed
+              fillTrackCacheAtPv<TTracks>(collision, groupedTrackIndicesSoftPionsPos, trackCacheSoftPionPos);
+              fillTrackCacheAtPv<TTracks>(collision, groupedTrackIndicesSoftPionsNeg, trackCacheSoftPionNeg);
+              isTrackCacheSoftPionFilled = true;
+            }
+
             // second loop over positive tracks
             if (TESTBIT(whichHypo2Prong[kN2ProngDecays], 0) && (!config.applyKaonPidIn3Prongs || TESTBIT(trackIndexNeg1.isIdentifiedPid(), ChannelKaonPid))) { // only for D0 candidates; moreover if kaon PID enabled, apply to the negative track
-              auto groupedTrackIndicesSoftPionsPos = positiveSoftPions->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-              for (auto trackIndexPos2 = groupedTrackIndicesSoftPionsPos.begin(); trackIndexPos2 != groupedTrackIndicesSoftPionsPos.end(); ++trackIndexPos2) {
+              int iTrackPos2{0};
+              for (auto trackIndexPos2 = groupedTrackIndicesSoftPionsPos.begin(); trackIndexPos2 != groupedTrackIndicesSoftPionsPos.end(); ++trackIndexPos2, ++iTrackPos2) {
                 if (trackIndexPos2 == trackIndexPos1) {
                   continue;
                 }
                 auto trackPos2 = trackIndexPos2.template track_as<TTracks>();
-                std::array pVecTrackPos2{trackPos2.pVector()};
-                if (thisCollId != trackPos2.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-                  auto trackParVarPos2 = getTrackParCov(trackPos2);
-                  std::array dcaInfoPos2{trackPos2.dcaXY(), trackPos2.dcaZ()};
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarPos2, 2.f, noMatCorr, &dcaInfoPos2);
-                  getPxPyPz(trackParVarPos2, pVecTrackPos2);
-                }
+                const auto& pVecTrackPos2 = trackCacheSoftPionPos.pVec[iTrackPos2];
 
                 uint8_t isSelectedDstar{0};
                 uint8_t cutStatus{BIT(kNCutsDstar) - 1};
@@ -2956,19 +3091,13 @@ struct HfTrackIndexSkimCreator {
 
             // second loop over negative tracks
             if (TESTBIT(whichHypo2Prong[kN2ProngDecays], 1) && (!config.applyKaonPidIn3Prongs || TESTBIT(trackIndexPos1.isIdentifiedPid(), ChannelKaonPid))) { // only for D0bar candidates; moreover if kaon PID enabled, apply to the positive track
-              auto groupedTrackIndicesSoftPionsNeg = negativeSoftPions->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-              for (auto trackIndexNeg2 = groupedTrackIndicesSoftPionsNeg.begin(); trackIndexNeg2 != groupedTrackIndicesSoftPionsNeg.end(); ++trackIndexNeg2) {
+              int iTrackNeg2{0};
+              for (auto trackIndexNeg2 = groupedTrackIndicesSoftPionsNeg.begin(); trackIndexNeg2 != groupedTrackIndicesSoftPionsNeg.end(); ++trackIndexNeg2, ++iTrackNeg2) {
                 if (trackIndexNeg1 == trackIndexNeg2) {
                   continue;
                 }
                 auto trackNeg2 = trackIndexNeg2.template track_as<TTracks>();
-                std::array pVecTrackNeg2{trackNeg2.pVector()};
-                if (thisCollId != trackNeg2.collisionId()) { // this is not the "default" collision for this track, we have to re-propagate it
-                  auto trackParVarNeg2 = getTrackParCov(trackNeg2);
-                  std::array dcaInfoNeg2{trackNeg2.dcaXY(), trackNeg2.dcaZ()};
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParVarNeg2, 2.f, noMatCorr, &dcaInfoNeg2);
-                  getPxPyPz(trackParVarNeg2, pVecTrackNeg2);
-                }
+                const auto& pVecTrackNeg2 = trackCacheSoftPionNeg.pVec[iTrackNeg2];
 
                 uint8_t isSelectedDstar{0};
                 uint8_t cutStatus{BIT(kNCutsDstar) - 1};
@@ -0,0 +1,237 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsPvRefit.h
+/// \brief Incremental primary-vertex refit excluding a few contributors, for HF track and candidate preselections
+///
+/// The PV contributors of a collision are linearised once at the reconstructed PV and their
+/// contributions to the normal equations of the vertex fit are stored per track. Removing 1-3
+/// tracks is then a down-date of the accumulated 3x3 weight matrix and residual vector, followed
+/// by a 3x3 inversion, instead of a full o2::vertexing::PVertexer refit.
+///
+/// The result is an approximation of PVertexer::refitVertex: the Tukey weights of the tracks are
+/// frozen at the original PV and the tracks are treated as straight lines around their point of
+/// closest approach. The differences with respect to the full refit are therefore of the order of
+/// the vertex displacement times the track curvature and of the weight changes induced by the
+/// removed tracks. It is therefore only used when requested (useIncrementalPvRefit in the HF skim).
+///
+/// No tolerance is guaranteed. The residuals with respect to PVertexer::refitVertex have to be measured
+/// on the data set of interest with validateIncrementalPvRefit in the HF track selection, which runs both
+/// refits on the same collisions and fills the differences of the vertex position, of the chi2 and of the
+/// DCA of the removed track versus the number of contributors (PvRefit/Validation).
+
+#ifndef PWGHF_UTILS_UTILSPVREFIT_H_
+#define PWGHF_UTILS_UTILSPVREFIT_H_
+
+#include <DetectorsVertexing/PVertexerParams.h>
+#include <ReconstructionDataFormats/PrimaryVertex.h>
+#include <ReconstructionDataFormats/Track.h>
+#include <ReconstructionDataFormats/Vertex.h>
+
+#include <Math/SMatrix.h>
+
+#include <algorithm> // std::min, std::max
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::hf_pv_refit
+{
+
+class PvRefitter
+{
+ public:
+  static constexpr int MinContributors{2}; // minimum number of contributors to refit a vertex
+
+  /// Sets the PV contributors of a collision and builds the lookup table from track global index to contributor entry
+  /// \param globalIds are the global indices of the PV contributors
+  /// \note the lookup table spans the range of global indices of the contributors, which are grouped per collision
+  void setContributors(std::vector<int64_t> const& globalIds)
+  {
+    mEntryOfTrack.clear();
+    mFirstGlobalId = 0;
+    if (globalIds.empty()) {
+      return;
+    }
+    int64_t minGlobalId = globalIds.front();
+    int64_t maxGlobalId = globalIds.front();
+    for (const auto globalId : globalIds) {
+      minGlobalId = std::min(minGlobalId, globalId);
+      maxGlobalId = std::max(maxGlobalId, globalId);
+    }
+    mFirstGlobalId = minGlobalId;
+    mEntryOfTrack.assign(maxGlobalId - minGlobalId + 1, -1);
+    for (std::size_t iEntry{0u}; iEntry < globalIds.size(); ++iEntry) {
+      mEntryOfTrack[globalIds[iEntry] - minGlobalId] = static_cast<int>(iEntry);
+    }
+  }
+
+  /// \return the contributor entry of a track, or -1 if the track is not a PV contributor
+  /// \param globalId is the global index of the track
+  int getEntry(const int64_t globalId) const
+  {
+    const int64_t index = globalId - mFirstGlobalId;
+    if (index < 0 || index >= static_cast<int64_t>(mEntryOfTrack.size())) {
+      return -1;
+    }
+    return mEntryOfTrack[index];
+  }
+
+  /// Linearises the PV contributors at the reconstructed PV and accumulates the normal equations of the vertex fit
+  /// \param primVtx is the reconstructed PV, used as linearisation point
+  /// \param tracks are the PV contributors, in the same order as the global indices given to setContributors
+  /// \param bz is the magnetic field used to propagate the tracks to their point of closest approach to the PV
+  /// \return true if the refit is doable, i.e. enough contributors are accepted
+  bool prepareVertexRefit(std::vector<o2::track::TrackParCov> const& tracks, o2::dataformats::VertexBase const& primVtx, const float bz)
+  {
+    const auto tukey = o2::vertexing::PVertexerParams::Instance().tukey;
+    const double chi2Max = tukey * tukey;
+    mPrimVtx = primVtx;
+    mTrackTerms.assign(tracks.size(), TrackTerms{});
+    mSumWeightMatrix = SMatrix33Sym{};
+    mSumGradient = {0., 0., 0.};
+    mSumChi2 = 0.;
+    mNContributors = 0;
+    for (std::size_t iTrack{0u}; iTrack < tracks.size(); ++iTrack) {
+      auto trackParCov = tracks[iTrack];
+      if (!trackParCov.propagateToDCA(primVtx, bz)) {
+        continue;
+      }
+      // residuals in the tracking frame, linear in the displacement u of the vertex from primVtx:
+      // d = d0 + C u, with the track approximated by its tangent at the point of closest approach
+      const double snp = trackParCov.getSnp();
+      const double csp = std::sqrt((1. - snp) * (1. + snp));
+      const double slopeY = snp / csp;
+      const double slopeZ = trackParCov.getTgl() / csp;
+      const double cosAlpha = std::cos(trackParCov.getAlpha());
+      const double sinAlpha = std::sin(trackParCov.getAlpha());
+      const double xVtxLoc = primVtx.getX() * cosAlpha + primVtx.getY() * sinAlpha;
+      const double yVtxLoc = -primVtx.getX() * sinAlpha + primVtx.getY() * cosAlpha;
+      const double dx = xVtxLoc - trackParCov.getX();
+      const std::array<double, 2> residual0{trackParCov.getY() + slopeY * dx - yVtxLoc, trackParCov.getZ() + slopeZ * dx - primVtx.getZ()};
+      const std::array<std::array<double, 3>, 2> derivatives{{{slopeY * cosAlpha + sinAlpha, slopeY * sinAlpha - cosAlpha, 0.},
+                                                              {slopeZ * cosAlpha, slopeZ * sinAlpha, -1.}}};
+      // inverse of the track covariance in y, z
+      const double sigmaY2 = trackParCov.getSigmaY2();
+      const double sigmaZY = trackParCov.getSigmaZY();
+      const double sigmaZ2 = trackParCov.getSigmaZ2();
+      const double det = sigmaY2 * sigmaZ2 - sigmaZY * sigmaZY;
+      if (det <= 0.) {
+        continue;
+      }
+      const std::array<std::array<double, 2>, 2> weight{{{sigmaZ2 / det, -sigmaZY / det}, {-sigmaZY / det, sigmaY2 / det}}};
+      const std::array<double, 2> weightedResidual0{weight[0][0] * residual0[0] + weight[0][1] * residual0[1], weight[1][0] * residual0[0] + weight[1][1] * residual0[1]};
+      const double chi2 = residual0[0] * weightedResidual0[0] + residual0[1] * weightedResidual0[1];
+      // Tukey bisquare weight, as in PVertexer, evaluated at the original PV
+      if (chi2 >= chi2Max) {
+        continue;
+      }
+      const double tukeyWeight = (1. - chi2 / chi2Max) * (1. - chi2 / chi2Max);
+
+      auto& terms = mTrackTerms[iTrack];
+      terms.isUsed = true;
+      terms.chi2 = tukeyWeight * chi2;
+      for (int i{0}; i < 3; ++i) {
+        terms.gradient[i] = tukeyWeight * (derivatives[0][i] * weightedResidual0[0] + derivatives[1][i] * weightedResidual0[1]);
+        for (int j{0}; j <= i; ++j) {
+          double element{0.};
+          for (int k{0}; k < 2; ++k) {
+            for (int l{0}; l < 2; ++l) {
+              element += derivatives[k][i] * weight[k][l] * derivatives[l][j];
+            }
+          }
+          terms.weightMatrix(i, j) = tukeyWeight * element;
+        }
+      }
+      mSumWeightMatrix += terms.weightMatrix;
+      for (int i{0}; i < 3; ++i) {
+        mSumGradient[i] += terms.gradient[i];
+      }
+      mSumChi2 += terms.chi2;
+      ++mNContributors;
+    }
+    return isRefitDoable();
+  }
+
+  /// \return true if enough contributors were accepted by prepareVertexRefit
+  bool isRefitDoable() const { return mNContributors >= MinContributors; }
+
+  /// Refits the PV excluding some contributors
+  /// \param entries are the contributor entries of the tracks to be removed (see getEntry), negative entries are ignored
+  /// \return the refitted vertex, with negative chi2 if the refit failed
+  template <std::size_t N>
+  o2::dataformats::PrimaryVertex refitVertex(std::array<int, N> const& entries) const
+  {
+    o2::dataformats::PrimaryVertex vtxRefitted;
+    vtxRefitted.setXYZ(mPrimVtx.getX(), mPrimVtx.getY(), mPrimVtx.getZ());
+    vtxRefitted.setCov(mPrimVtx.getSigmaX2(), mPrimVtx.getSigmaXY(), mPrimVtx.getSigmaY2(), mPrimVtx.getSigmaXZ(), mPrimVtx.getSigmaYZ(), mPrimVtx.getSigmaZ2());
+    vtxRefitted.setChi2(-1.f);
+
+    auto weightMatrix = mSumWeightMatrix;
+    std::array<double, 3> gradient = mSumGradient;
+    double chi2 = mSumChi2;
+    int nContributors = mNContributors;
+    for (const auto entry : entries) {
+      if (entry < 0 || !mTrackTerms[entry].isUsed) {
+        continue;
+      }
+      const auto& terms = mTrackTerms[entry];
+      weightMatrix -= terms.weightMatrix;
+      for (int i{0}; i < 3; ++i) {
+        gradient[i] -= terms.gradient[i];
+      }
+      chi2 -= terms.chi2;
+      --nContributors;
+    }
+    vtxRefitted.setNContributors(nContributors);
+    if (nContributors < MinContributors || !weightMatrix.Invert()) {
+      return vtxRefitted;
+    }
+    // minimum of the chi2: u = -W^-1 g, chi2 = chi2_0 - g^T W^-1 g
+    std::array<double, 3> displacement{};
+    for (int i{0}; i < 3; ++i) {
+      for (int j{0}; j < 3; ++j) {
+        displacement[i] -= weightMatrix(i, j) * gradient[j];
+      }
+      chi2 += displacement[i] * gradient[i];
+    }
+    vtxRefitted.setXYZ(mPrimVtx.getX() + displacement[0], mPrimVtx.getY() + displacement[1], mPrimVtx.getZ() + displacement[2]);
+    vtxRefitted.setCov(weightMatrix(0, 0), weightMatrix(0, 1), weightMatrix(1, 1), weightMatrix(0, 2), weightMatrix(1, 2), weightMatrix(2, 2));
+    vtxRefitted.setChi2(std::max(chi2, 0.));
+    return vtxRefitted;
+  }
+
+ private:
+  using SMatrix33Sym = ROOT::Math::SMatrix<double, 3, 3, ROOT::Math::MatRepSym<double, 3>>;
+
+  /// Contribution of one PV contributor to the normal equations of the vertex fit
+  struct TrackTerms {
+    SMatrix33Sym weightMatrix{};                // C^T W C
+    std::array<double, 3> gradient{0., 0., 0.}; // C^T W d0
+    double chi2{0.};                            // d0^T W d0
+    bool isUsed{false};                         // accepted in the fit
+  };
+
+  o2::dataformats::VertexBase mPrimVtx{}; // linearisation point
+  std::vector<TrackTerms> mTrackTerms{};  // per-contributor terms
+  SMatrix33Sym mSumWeightMatrix{};        // sum of the weight matrices of the accepted contributors
+  std::array<double, 3> mSumGradient{};   // sum of the gradients of the accepted contributors
+  double mSumChi2{0.};                    // sum of the chi2 of the accepted contributors at the linearisation point
+  int mNContributors{0};                  // number of accepted contributors
+  std::vector<int> mEntryOfTrack{};       // contributor entry per track global index (offset by mFirstGlobalId)
+  int64_t mFirstGlobalId{0};              // smallest global index of the contributors
+};
+
+} // namespace o2::hf_pv_refit
+
+#endif // PWGHF_UTILS_UTILSPVREFIT_H_
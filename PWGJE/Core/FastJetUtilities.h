@@ -33,39 +33,41 @@ enum class JetConstituentStatus {
 namespace fastjetutilities
 {
 
-// Class defined to store additional info which is passed to the FastJet object
-class fastjet_user_info : public fastjet::PseudoJet::UserInfoBase
+// The status and the index of each constituent are encoded in the user_index of its PseudoJet, so that no
+// additional object has to be allocated per constituent: user_index = index * 2^NConstituentStatusBits + status.
+// Indices must therefore be smaller than 2^29 in absolute value. PseudoJets which are not constituents (e.g. ghosts)
+// keep the default user_index -1, which decodes to an invalid status.
+constexpr int NConstituentStatusBits = 2;
+
+/**
+ * Get the status of a constituent (see JetConstituentStatus)
+ *
+ * @param constituent constituent pseudojet
+ */
+inline int getConstituentStatus(const fastjet::PseudoJet& constituent)
 {
-  int status; // the status of each particle (Options are: TrueParticle (final state particles in generator event which arent special), HFParticle (heavy-flavour particle of interest in generator event), ThermalParticle (particles belonging to the thermal backgound), DecaySisterParticle (other particles poduced in the decay resulting in a non-prompt heavy-flavour particle of interest))
-  int index;  // a number unique to each particle in the event
-
- public:
-  fastjet_user_info()
-  {
-    status = -9;
-    index = -9;
-  }
-  fastjet_user_info(int _status, int _index)
-  {
-    status = _status;
-    index = _index;
-  }
-  ~fastjet_user_info() = default;
-  void setStatus(int set) { status = set; }
-  void setIndex(int set) { index = set; }
-  int getStatus() const { return status; }
-  int getIndex() const { return index; }
-};
+  return constituent.user_index() & ((1 << NConstituentStatusBits) - 1);
+}
+
+/**
+ * Get the global index of a constituent
+ *
+ * @param constituent constituent pseudojet
+ */
+inline int getConstituentIndex(const fastjet::PseudoJet& constituent)
+{
+  return constituent.user_index() >> NConstituentStatusBits;
+}
 
 /**
- * Set the fastjet_user_info object when filling the jet constituents.
+ * Encode the status and index of the last constituent in its user_index when filling the jet constituents.
  *
  * @param constituents vector of constituents to be clustered.
  * @param index global index of constituent
  * @param status status of constituent type
  */
 
-void setFastJetUserInfo(std::vector<fastjet::PseudoJet>& constituents, int index = -99999999, int status = static_cast<int>(JetConstituentStatus::track));
+void setFastJetUserIndex(std::vector<fastjet::PseudoJet>& constituents, int index = -99999999, int status = static_cast<int>(JetConstituentStatus::track));
 
 /**
  * Add track as a pseudojet object to the fastjet vector
@@ -85,7 +87,7 @@ void fillTracks(const T& constituent, std::vector<fastjet::PseudoJet>& constitue
     auto energy = std::sqrt((constituent.p() * constituent.p()) + (mass * mass));
     constituents.emplace_back(constituent.px(), constituent.py(), constituent.pz(), energy);
   }
-  setFastJetUserInfo(constituents, index, status);
+  setFastJetUserIndex(constituents, index, status);
 }
 
 /**
@@ -120,7 +122,7 @@ void fillClusters(const T& constituent, std::vector<fastjet::PseudoJet>& constit
     float constituentPt = constituentEnergy / std::cosh(constituent.eta());
     constituents.emplace_back(constituentPt * std::cos(constituent.phi()), constituentPt * std::sin(constituent.phi()), constituentPt * std::sinh(constituent.eta()), constituentEnergy);
   }
-  setFastJetUserInfo(constituents, index, status);
+  setFastJetUserIndex(constituents, index, status);
 }
 
 }; // namespace fastjetutilities
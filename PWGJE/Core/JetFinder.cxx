@@ -16,11 +16,16 @@
 
 #include "PWGJE/Core/JetFinder.h"
 
+#include <fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh>
 #include <fastjet/ClusterSequenceArea.hh>
+#include <fastjet/ClusterSequenceAreaBase.hh>
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/Selector.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
 #include <vector>
 
 /// Sets the jet finding parameters
@@ -70,3 +75,218 @@ fastjet::ClusterSequenceArea JetFinder::findJets(std::vector<fastjet::PseudoJet>
   }
   return clusterSeq;
 }
+
+/// Performs jet finding for several jet radii
+/// \note with active areas and a single ghost repetition, the ghosts are generated once and shared by all radii.
+///       With the Cambridge/Aachen algorithm the merging sequence does not depend on R, so all radii are
+///       obtained from a single clustering at the largest radius, as exclusive jets with dcut = (R/Rmax)^2
+/// \param inputParticles vector of input particles/tracks
+/// \param jetRadii jet radii
+/// \param jets vector of jets to be filled for each radius
+/// \return ClusterSequenceArea objects needed to access constituents, one per radius (entries may point to the same object)
+std::vector<std::shared_ptr<fastjet::ClusterSequenceAreaBase>> JetFinder::findJets(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRadii, std::vector<std::vector<fastjet::PseudoJet>>& jets)
+{
+  std::vector<std::shared_ptr<fastjet::ClusterSequenceAreaBase>> clusterSeqs;
+  jets.assign(jetRadii.size(), std::vector<fastjet::PseudoJet>());
+  if (jetRadii.empty()) {
+    return clusterSeqs;
+  }
+  const float jetRInput = jetR;
+
+  // without explicit ghosts, the radii are clustered one after the other
+  if ((areaType != fastjet::active_area && areaType != fastjet::active_area_explicit_ghosts) || ghostRepeatN != 1) {
+    for (std::size_t iR = 0; iR < jetRadii.size(); iR++) {
+      jetR = jetRadii[iR];
+      clusterSeqs.push_back(std::make_shared<fastjet::ClusterSequenceArea>(findJets(inputParticles, jets[iR])));
+    }
+    jetR = jetRInput;
+    return clusterSeqs;
+  }
+
+  // the ghosts are generated once, for the largest radius, since the ghost area specification does not depend on R
+  const double jetRMax = *std::max_element(jetRadii.begin(), jetRadii.end());
+  jetR = jetRMax;
+  setParams();
+  if (isReclustering) {
+    jetR = jetR / 5.0;
+  }
+  ghosts.clear();
+  ghostAreaSpec.add_ghosts(ghosts);
+  const double ghostAreaActual = ghostAreaSpec.actual_ghost_area();
+  const fastjet::Selector selRealJets = !fastjet::SelectorIsPureGhost();
+
+  std::shared_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> clusterSeqRMax;
+  if (algorithm == fastjet::cambridge_algorithm) {
+    clusterSeqRMax = std::make_shared<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(inputParticles, jetDef, ghosts, ghostAreaActual);
+  }
+  for (std::size_t iR = 0; iR < jetRadii.size(); iR++) {
+    jetR = jetRadii[iR];
+    setParams();
+    if (isReclustering) {
+      jetR = jetR / 5.0;
+    }
+    if (clusterSeqRMax) {
+      // for R == Rmax the dcut would be 1, i.e. the C/A beam distance, for which exclusive_jets counts every step as a merging
+      jets[iR] = jetRadii[iR] < jetRMax ? clusterSeqRMax->exclusive_jets((jetRadii[iR] / jetRMax) * (jetRadii[iR] / jetRMax)) : clusterSeqRMax->inclusive_jets();
+      clusterSeqs.push_back(clusterSeqRMax);
+    } else {
+      auto clusterSeq = std::make_shared<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(inputParticles, jetDef, ghosts, ghostAreaActual);
+      jets[iR] = clusterSeq->inclusive_jets();
+      clusterSeqs.push_back(clusterSeq);
+    }
+    jets[iR] = (selRealJets && selJets)(jets[iR]);
+    jets[iR] = fastjet::sorted_by_pt(jets[iR]);
+  }
+  jetR = jetRInput;
+  return clusterSeqs;
+}
+
+/// Performs jet finding on an event without candidates for several jet radii and keeps the cluster sequences,
+/// so that the event in which some particles are replaced by a candidate can then be obtained with findJetsWithCandidate
+/// \param inputParticles vector of input particles/tracks
+/// \param jetRadii jet radii
+/// \return false if the area definition does not allow to recluster parts of the event
+bool JetFinder::clusterBaseEvent(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRadii)
+{
+  baseEventJets.clear();
+  baseParticles.clear();
+  if ((areaType != fastjet::active_area && areaType != fastjet::active_area_explicit_ghosts) || ghostRepeatN != 1 || jetRadii.empty()) {
+    return false;
+  }
+  const float jetRInput = jetR;
+  jetR = *std::max_element(jetRadii.begin(), jetRadii.end());
+  setParams();
+  jetR = jetRInput;
+  ghosts.clear();
+  ghostAreaSpec.add_ghosts(ghosts);
+  baseGhostArea = ghostAreaSpec.actual_ghost_area();
+  baseParticles = inputParticles;
+  const int nParticles = baseParticles.size();
+
+  baseEventJets.resize(jetRadii.size());
+  for (std::size_t iR = 0; iR < jetRadii.size(); iR++) {
+    auto& base = baseEventJets[iR];
+    jetR = jetRadii[iR];
+    setParams();
+    base.jetR = jetDef.R();
+    jetR = jetRInput;
+    base.clusterSeq = std::make_shared<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(baseParticles, jetDef, ghosts, baseGhostArea);
+    base.jets = base.clusterSeq->inclusive_jets();
+    base.jetIndices.assign(nParticles + ghosts.size(), -1);
+    base.constituentIndices.assign(base.jets.size(), std::vector<int>());
+    base.ranges.assign(base.jets.size(), {0., 0., 0., -1.});
+    for (std::size_t iJet = 0; iJet < base.jets.size(); iJet++) {
+      double rapMin = 0., rapMax = 0., phiRef = 0., dPhiMin = 0., dPhiMax = 0.;
+      bool hasRealConstituents = false;
+      for (const auto& constituent : base.jets[iJet].constituents()) {
+        const int index = constituent.cluster_hist_index(); // the input particles and then the ghosts are the first entries of the history
+        base.jetIndices[index] = iJet;
+        base.constituentIndices[iJet].push_back(index);
+        if (index >= nParticles) {
+          continue;
+        }
+        if (!hasRealConstituents) {
+          rapMin = rapMax = constituent.rap();
+          phiRef = constituent.phi();
+          hasRealConstituents = true;
+          continue;
+        }
+        const double dPhi = std::remainder(constituent.phi() - phiRef, 2. * M_PI);
+        rapMin = std::min(rapMin, constituent.rap());
+        rapMax = std::max(rapMax, constituent.rap());
+        dPhiMin = std::min(dPhiMin, dPhi);
+        dPhiMax = std::max(dPhiMax, dPhi);
+      }
+      if (hasRealConstituents) {
+        const double phiHalfWidth = 0.5 * (dPhiMax - dPhiMin);
+        base.ranges[iJet] = {rapMin, rapMax, phiRef + 0.5 * (dPhiMin + dPhiMax), phiHalfWidth < 0.5 * M_PI ? phiHalfWidth : M_PI}; // the phi of a sum of momenta spread over more than pi is not bounded
+      }
+    }
+  }
+  return true;
+}
+
+/// Performs jet finding on the event given to clusterBaseEvent, after replacing some of its particles by a candidate
+/// \param candidate candidate pseudojet
+/// \param removedParticles indices of the particles replaced by the candidate in the input particles of the base event
+/// \param iR index of the jet radius in the radii given to clusterBaseEvent
+/// \param jets vector of jets to be filled
+/// \return ClusterSequenceArea object of the reclustered region
+std::shared_ptr<fastjet::ClusterSequenceAreaBase> JetFinder::findJetsWithCandidate(const fastjet::PseudoJet& candidate, const std::vector<int>& removedParticles, std::size_t iR, std::vector<fastjet::PseudoJet>& jets)
+{
+  jets.clear();
+  const auto& base = baseEventJets.at(iR);
+  const int nParticles = baseParticles.size();
+  const float jetRInput = jetR;
+  jetR = base.jetR;
+  if (isReclustering) {
+    jetR = jetR / 5.0;
+  }
+  setParams();
+  jetR = jetRInput;
+
+  isRemovedParticle.assign(nParticles, false);
+  isRegionJet.assign(base.jets.size(), false);
+  for (const auto index : removedParticles) {
+    isRemovedParticle[index] = true;
+    if (base.jetIndices[index] >= 0) {
+      isRegionJet[base.jetIndices[index]] = true;
+    }
+  }
+
+  std::shared_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> clusterSeq;
+  const double jetR2 = base.jetR * base.jetR;
+  bool isRegionComplete = false;
+  while (!isRegionComplete) {
+    regionParticles.clear();
+    regionGhosts.clear();
+    regionParticles.push_back(candidate);
+    for (std::size_t iJet = 0; iJet < base.jets.size(); iJet++) {
+      if (!isRegionJet[iJet]) {
+        continue;
+      }
+      for (const auto index : base.constituentIndices[iJet]) {
+        if (index >= nParticles) {
+          regionGhosts.push_back(ghosts[index - nParticles]);
+        } else if (!isRemovedParticle[index]) {
+          regionParticles.push_back(baseParticles[index]);
+        }
+      }
+    }
+    clusterSeq = std::make_shared<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(regionParticles, jetDef, regionGhosts, baseGhostArea);
+
+    // ghosts do not change the momenta of the objects they merge with, so only objects with real constituents are checked
+    isRegionComplete = true;
+    for (const auto& object : clusterSeq->jets()) {
+      if (clusterSeq->is_pure_ghost(object)) {
+        continue;
+      }
+      const double rap = object.rap();
+      const double phi = object.phi();
+      for (std::size_t iJet = 0; iJet < base.jets.size(); iJet++) {
+        const auto& range = base.ranges[iJet];
+        if (isRegionJet[iJet] || range[3] < 0.) {
+          continue;
+        }
+        const double dRap = std::max({0., range[0] - rap, rap - range[1]});
+        const double dPhi = std::max(0., std::abs(std::remainder(phi - range[2], 2. * M_PI)) - range[3]);
+        if (dRap * dRap + dPhi * dPhi < jetR2) {
+          isRegionJet[iJet] = true;
+          isRegionComplete = false;
+        }
+      }
+    }
+  }
+
+  for (std::size_t iJet = 0; iJet < base.jets.size(); iJet++) {
+    if (!isRegionJet[iJet]) {
+      jets.push_back(base.jets[iJet]);
+    }
+  }
+  for (const auto& jet : clusterSeq->inclusive_jets()) {
+    jets.push_back(jet);
+  }
+  jets = (!fastjet::SelectorIsPureGhost() && selJets)(jets);
+  jets = fastjet::sorted_by_pt(jets);
+  return clusterSeq;
+}
@@ -19,7 +19,9 @@
 #define PWGJE_CORE_JETFINDER_H_
 
 #include <fastjet/AreaDefinition.hh>
+#include <fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh>
 #include <fastjet/ClusterSequenceArea.hh>
+#include <fastjet/ClusterSequenceAreaBase.hh>
 #include <fastjet/GhostedAreaSpec.hh>
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
@@ -27,6 +29,9 @@
 
 #include <Rtypes.h>
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include <math.h>
@@ -94,7 +99,57 @@ class JetFinder
   /// \return ClusterSequenceArea object needed to access constituents
   fastjet::ClusterSequenceArea findJets(std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets); // ideally find a way of passing the cluster sequence as a reeference
 
+  /// Performs jet finding for several jet radii
+  /// \note with active areas and a single ghost repetition, the ghosts are generated once and shared by all radii.
+  ///       With the Cambridge/Aachen algorithm the merging sequence does not depend on R, so all radii are
+  ///       obtained from a single clustering at the largest radius, as exclusive jets with dcut = (R/Rmax)^2
+  /// \param inputParticles vector of input particles/tracks
+  /// \param jetRadii jet radii
+  /// \param jets vector of jets to be filled for each radius
+  /// \return ClusterSequenceArea objects needed to access constituents, one per radius (entries may point to the same object)
+  std::vector<std::shared_ptr<fastjet::ClusterSequenceAreaBase>> findJets(std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRadii, std::vector<std::vector<fastjet::PseudoJet>>& jets);
+
+  /// Performs jet finding on an event without candidates for several jet radii and keeps the cluster sequences,
+  /// so that the event in which some particles are replaced by a candidate can then be obtained with findJetsWithCandidate
+  /// \note requires active areas with a single ghost repetition, as the ghosts are shared by all the reclusterings
+  /// \param inputParticles vector of input particles/tracks
+  /// \param jetRadii jet radii
+  /// \return false if the area definition does not allow to recluster parts of the event
+  bool clusterBaseEvent(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<double>& jetRadii);
+
+  /// Performs jet finding on the event given to clusterBaseEvent, after replacing some of its particles by a candidate
+  /// \note only the jets of the base event containing the removed particles, and the jets which can merge with them or with
+  ///       the candidate, are reclustered. Two objects can only merge if they are closer than R in (y, phi), and the objects of a
+  ///       jet stay within the (y, phi) range of its constituents, so the region is grown until none of its objects is closer
+  ///       than R to the range of the real constituents of any other jet. The jets are then those of a full clustering of the
+  ///       event, apart from the assignment of ghosts at the border of the region
+  /// \param candidate candidate pseudojet
+  /// \param removedParticles indices of the particles replaced by the candidate in the input particles of the base event
+  /// \param iR index of the jet radius in the radii given to clusterBaseEvent
+  /// \param jets vector of jets to be filled
+  /// \return ClusterSequenceArea object of the reclustered region. The other jets belong to the cluster sequence of the base event, which is kept until the next call to clusterBaseEvent
+  std::shared_ptr<fastjet::ClusterSequenceAreaBase> findJetsWithCandidate(const fastjet::PseudoJet& candidate, const std::vector<int>& removedParticles, std::size_t iR, std::vector<fastjet::PseudoJet>& jets);
+
  private:
+  /// Jets of the base event for one radius, see clusterBaseEvent
+  struct BaseEventJets {
+    double jetR = 0.;
+    std::shared_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> clusterSeq;
+    std::vector<fastjet::PseudoJet> jets;             // inclusive jets, including pure ghost jets
+    std::vector<int> jetIndices;                      // jet of each input particle, followed by the ghosts
+    std::vector<std::vector<int>> constituentIndices; // input particles and ghosts (offset by the number of input particles) of each jet
+    std::vector<std::array<double, 4>> ranges;        // minimum and maximum rapidity, central phi and phi half width of the real constituents of each jet (negative half width for pure ghost jets)
+  };
+
+  std::vector<fastjet::PseudoJet> ghosts;          //! ghosts shared by all radii in multi-radius jet finding
+  std::vector<fastjet::PseudoJet> baseParticles;   //! input particles of the base event
+  std::vector<BaseEventJets> baseEventJets;        //! jets of the base event per radius
+  double baseGhostArea = 0.;                       //! actual ghost area of the base event ghosts
+  std::vector<char> isRemovedParticle;             //! flags the particles replaced by the candidate
+  std::vector<char> isRegionJet;                   //! flags the base event jets in the reclustered region
+  std::vector<fastjet::PseudoJet> regionParticles; //! particles of the reclustered region
+  std::vector<fastjet::PseudoJet> regionGhosts;    //! ghosts of the reclustered region
+
   ClassDefNV(JetFinder, 1);
 };
 
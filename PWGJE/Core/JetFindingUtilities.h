@@ -284,6 +284,53 @@ bool analyseV0s(std::vector<fastjet::PseudoJet>& inputParticles, T const& v0s, f
   }
 }
 
+/**
+ * Fills the jet tables with a jet and its constituents
+ *
+ * @param jet jet to be stored
+ * @param R jet radius
+ * @param collision the collision within which the jet was found
+ * @param jetsTable output table of jets
+ * @param constituentsTable output table of jet constituents
+ */
+template <typename T, typename U, typename V>
+void fillJetTables(const fastjet::PseudoJet& jet, double R, T const& collision, U& jetsTable, V& constituentsTable)
+{
+  std::vector<int> tracks;
+  std::vector<int> cands;
+  std::vector<int> clusters;
+  jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
+            jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
+  for (const auto& constituent : sorted_by_pt(jet.constituents())) { // ghosts have no valid status and are skipped
+    auto constituentStatus = fastjetutilities::getConstituentStatus(constituent);
+    if (constituentStatus == static_cast<int>(JetConstituentStatus::track)) {
+      tracks.push_back(fastjetutilities::getConstituentIndex(constituent));
+    }
+    if (constituentStatus == static_cast<int>(JetConstituentStatus::cluster)) {
+      clusters.push_back(fastjetutilities::getConstituentIndex(constituent));
+    }
+    if (constituentStatus == static_cast<int>(JetConstituentStatus::candidate)) {
+      cands.push_back(fastjetutilities::getConstituentIndex(constituent));
+    }
+  }
+  constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+}
+
+/**
+ * Checks whether a jet contains a candidate
+ *
+ * @param jet jet to be checked
+ */
+inline bool isCandidateJet(const fastjet::PseudoJet& jet)
+{
+  for (const auto& constituent : jet.constituents()) {
+    if (fastjetutilities::getConstituentStatus(constituent) == static_cast<int>(JetConstituentStatus::candidate)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
+      return true;
+    }
+  }
+  return false;
+}
+
 /**
  * Performs jet finding and fills jet tables
  *
@@ -301,47 +348,54 @@ void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputPartic
   auto jetRValues = static_cast<std::vector<double>>(jetRadius);
   jetFinder.jetPtMin = jetPtMin;
   jetFinder.jetPtMax = jetPtMax;
-  for (auto R : jetRValues) {
-    jetFinder.jetR = R;
-    std::vector<fastjet::PseudoJet> jets;
-    fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJets(inputParticles, jets));
-    for (const auto& jet : jets) {
+  std::vector<std::vector<fastjet::PseudoJet>> jetsPerR;
+  auto clusterSeqs = jetFinder.findJets(inputParticles, jetRValues, jetsPerR); // keeps the cluster sequences alive while the constituents are accessed
+  for (std::size_t iR = 0; iR < jetRValues.size(); iR++) {
+    auto R = jetRValues[iR];
+    for (const auto& jet : jetsPerR[iR]) {
       if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
         continue;
       }
       if (fillThnSparse) {
         thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi()); // important for normalisation in V0Jet analyses to store all jets, including those that aren't V0s
       }
-      if (doCandidateJetFinding) {
-        bool isCandidateJet = false;
-        for (const auto& constituent : jet.constituents()) {
-          auto constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
-          if (constituentStatus == static_cast<int>(JetConstituentStatus::candidate)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
-            isCandidateJet = true;
-            break;
-          }
-        }
-        if (!isCandidateJet) {
-          continue;
-        }
+      if (doCandidateJetFinding && !isCandidateJet(jet)) {
+        continue;
       }
-      std::vector<int> tracks;
-      std::vector<int> cands;
-      std::vector<int> clusters;
-      jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
-                jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
-      for (const auto& constituent : sorted_by_pt(jet.constituents())) {
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
-          tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::cluster)) {
-          clusters.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidate)) {
-          cands.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
+      fillJetTables(jet, R, collision, jetsTable, constituentsTable);
+    }
+  }
+}
+
+/**
+ * Performs jet finding on the event given to JetFinder::clusterBaseEvent after replacing some of its particles by a candidate, and fills the jet tables with the jets containing the candidate
+ *
+ * @param jetFinder JetFinder object which carries jet finding parameters and the jets of the base event
+ * @param candidate candidate pseudojet
+ * @param removedParticles indices of the particles replaced by the candidate in the input particles of the base event
+ * @param jetRadius jet finding radii, as given to JetFinder::clusterBaseEvent
+ * @param collision the collision within which jets are being found
+ * @param jetsTable output table of jets
+ * @param constituentsTable output table of jet constituents
+ */
+template <typename T, typename U, typename V>
+void findJetsWithCandidate(JetFinder& jetFinder, const fastjet::PseudoJet& candidate, const std::vector<int>& removedParticles, std::vector<double> jetRadius, float jetAreaFractionMin, T const& collision, U& jetsTable, V& constituentsTable, std::shared_ptr<THn> thnSparseJet, bool fillThnSparse)
+{
+  std::vector<fastjet::PseudoJet> jets;
+  for (std::size_t iR = 0; iR < jetRadius.size(); iR++) {
+    auto R = jetRadius[iR];
+    auto clusterSeq = jetFinder.findJetsWithCandidate(candidate, removedParticles, iR, jets); // keeps the reclustered region alive while the constituents are accessed
+    for (const auto& jet : jets) {
+      if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
+        continue;
+      }
+      if (fillThnSparse) {
+        thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi());
+      }
+      if (!isCandidateJet(jet)) {
+        continue;
       }
-      constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+      fillJetTables(jet, R, collision, jetsTable, constituentsTable);
     }
   }
 }
@@ -31,11 +31,14 @@
 #include <RtypesCore.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <ostream>
 #include <stdexcept>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <math.h>
@@ -416,6 +419,55 @@ auto constexpr getConstituentId(T const& track)
   }
 }
 
+// pT of the candidates of the base jet shared with the tag jet; only the leading candidate of each jet is considered
+template <bool isCandidate, bool jetsBaseIsMc, bool jetsTagIsMc, typename U, typename P, typename R, typename S>
+float getCandidatePtSum(U const& candidatesBase, P const& candidatesTag, R const& fullTracksBase, S const& fullTracksTag)
+{
+  float ptSum = 0.;
+  if constexpr (isCandidate) {
+    if constexpr (jetsTagIsMc) {
+      for (auto const& candidateBase : candidatesBase) {
+        if (jetcandidateutilities::isMatchedCandidate(candidateBase)) {
+          const auto candidateBaseMcId = jetcandidateutilities::matchedParticleId(candidateBase, fullTracksBase, fullTracksTag);
+          for (auto const& candidateTag : candidatesTag) {
+            const auto candidateTagId = candidateTag.mcParticleId();
+            if (candidateBaseMcId == candidateTagId) {
+              ptSum += candidateBase.pt();
+            }
+            break; // should only be one
+          }
+        }
+        break;
+      }
+    } else if constexpr (jetsBaseIsMc) {
+      for (auto const& candidateTag : candidatesTag) {
+        if (jetcandidateutilities::isMatchedCandidate(candidateTag)) {
+          const auto candidateTagMcId = jetcandidateutilities::matchedParticleId(candidateTag, fullTracksTag, fullTracksBase);
+          for (auto const& candidateBase : candidatesBase) {
+            const auto candidateBaseId = candidateBase.mcParticleId();
+            if (candidateTagMcId == candidateBaseId) {
+              ptSum += candidateTag.pt();
+            }
+            break; // should only be one
+          }
+        }
+        break;
+      }
+    } else {
+      for (auto const& candidateBase : candidatesBase) {
+        for (auto const& candidateTag : candidatesTag) {
+          if (candidateBase.globalIndex() == candidateTag.globalIndex()) {
+            ptSum += candidateBase.pt();
+          }
+          break; // should only be one
+        }
+        break;
+      }
+    }
+  }
+  return ptSum;
+}
+
 template <bool isEMCAL, bool isCandidate, bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename O, typename P, typename Q, typename R, typename S>
 float getPtSum(T const& tracksBase, U const& candidatesBase, V const& clustersBase, O const& tracksTag, P const& candidatesTag, Q const& clustersTag, R const& fullTracksBase, S const& fullTracksTag)
 {
@@ -474,47 +526,7 @@ float getPtSum(T const& tracksBase, U const& candidatesBase, V const& clustersBa
       }
     }
   }
-  if constexpr (isCandidate) {
-    if constexpr (jetsTagIsMc) {
-      for (auto const& candidateBase : candidatesBase) {
-        if (jetcandidateutilities::isMatchedCandidate(candidateBase)) {
-          const auto candidateBaseMcId = jetcandidateutilities::matchedParticleId(candidateBase, fullTracksBase, fullTracksTag);
-          for (auto const& candidateTag : candidatesTag) {
-            const auto candidateTagId = candidateTag.mcParticleId();
-            if (candidateBaseMcId == candidateTagId) {
-              ptSum += candidateBase.pt();
-            }
-            break; // should only be one
-          }
-        }
-        break;
-      }
-    } else if constexpr (jetsBaseIsMc) {
-      for (auto const& candidateTag : candidatesTag) {
-        if (jetcandidateutilities::isMatchedCandidate(candidateTag)) {
-          const auto candidateTagMcId = jetcandidateutilities::matchedParticleId(candidateTag, fullTracksTag, fullTracksBase);
-          for (auto const& candidateBase : candidatesBase) {
-            const auto candidateBaseId = candidateBase.mcParticleId();
-            if (candidateTagMcId == candidateBaseId) {
-              ptSum += candidateTag.pt();
-            }
-            break; // should only be one
-          }
-        }
-        break;
-      }
-    } else {
-      for (auto const& candidateBase : candidatesBase) {
-        for (auto const& candidateTag : candidatesTag) {
-          if (candidateBase.globalIndex() == candidateTag.globalIndex()) {
-            ptSum += candidateBase.pt();
-          }
-          break; // should only be one
-        }
-        break;
-      }
-    }
-  }
+  ptSum += getCandidatePtSum<isCandidate, jetsBaseIsMc, jetsTagIsMc>(candidatesBase, candidatesTag, fullTracksBase, fullTracksTag);
   return ptSum;
 }
 
@@ -532,40 +544,198 @@ auto getConstituents(T const& jet, U const& /*constituents*/)
   }
 }
 
+/**
+ * Constituents of a jet used to compute the pT shared with the jets of the other collection, see getPtSum
+ */
+struct JetConstituentKeys {
+  std::vector<int64_t> trackIds;           // ids used for matching with the other collection (see getConstituentId), sorted
+  std::vector<float> trackPts;             // pT of the tracks, same order as trackIds
+  std::vector<int64_t> clusterParticleIds; // MC particle ids of the clusters, grouped per cluster
+  std::vector<int> clusterOffsets;         // first entry of each cluster in clusterParticleIds, plus the end
+  std::vector<float> clusterPts;           // pT of the clusters
+  std::vector<int64_t> clusterIdsSorted;   // sorted MC particle ids of all the clusters
+};
+
+/**
+ * Fills the matching keys of the constituents of a jet
+ *
+ * @param keys keys to be filled
+ * @param tracks tracks of the jet
+ * @param clusters clusters of the jet, only used with EMCAL clusters matched to a MC collection
+ */
+template <bool isEMCAL, bool otherIsMc, typename T, typename U>
+void fillConstituentKeys(JetConstituentKeys& keys, T const& tracks, U const& clusters)
+{
+  std::vector<std::pair<int64_t, float>> sortedTracks;
+  for (const auto& track : tracks) {
+    sortedTracks.emplace_back(getConstituentId<otherIsMc>(track), track.pt());
+  }
+  std::sort(sortedTracks.begin(), sortedTracks.end());
+  keys.trackIds.clear();
+  keys.trackPts.clear();
+  for (const auto& [id, pt] : sortedTracks) {
+    keys.trackIds.push_back(id);
+    keys.trackPts.push_back(pt);
+  }
+  keys.clusterParticleIds.clear();
+  keys.clusterOffsets.assign(1, 0);
+  keys.clusterPts.clear();
+  keys.clusterIdsSorted.clear();
+  if constexpr (isEMCAL && otherIsMc) {
+    for (const auto& cluster : clusters) {
+      for (const auto& clusterParticleId : cluster.mcParticlesIds()) {
+        if (clusterParticleId != -1) {
+          keys.clusterParticleIds.push_back(clusterParticleId);
+        }
+      }
+      keys.clusterOffsets.push_back(keys.clusterParticleIds.size());
+      keys.clusterPts.push_back(cluster.energy() / std::cosh(cluster.eta()));
+    }
+    keys.clusterIdsSorted = keys.clusterParticleIds;
+    std::sort(keys.clusterIdsSorted.begin(), keys.clusterIdsSorted.end());
+  }
+}
+
+/**
+ * Computes the pT of the track and cluster constituents of the base jet shared with the tag jet, as getPtSum, from the sorted constituent keys
+ */
+template <bool isEMCAL, bool jetsBaseIsMc, bool jetsTagIsMc>
+float getPtSum(JetConstituentKeys const& keysBase, JetConstituentKeys const& keysTag)
+{
+  float ptSum = 0.;
+  std::size_t iTag = 0;
+  std::size_t iClusterTag = 0;
+  for (std::size_t iBase = 0; iBase < keysBase.trackIds.size(); iBase++) {
+    const auto trackBaseId = keysBase.trackIds[iBase];
+    while (iTag < keysTag.trackIds.size() && keysTag.trackIds[iTag] < trackBaseId) {
+      iTag++;
+    }
+    if (trackBaseId != -1 && iTag < keysTag.trackIds.size() && keysTag.trackIds[iTag] == trackBaseId) {
+      ptSum += keysBase.trackPts[iBase];
+      continue;
+    }
+    if constexpr (isEMCAL && jetsBaseIsMc) { // MC particles not matched to a track of the tag jet are matched to its clusters
+      while (iClusterTag < keysTag.clusterIdsSorted.size() && keysTag.clusterIdsSorted[iClusterTag] < trackBaseId) {
+        iClusterTag++;
+      }
+      if (trackBaseId != -1 && iClusterTag < keysTag.clusterIdsSorted.size() && keysTag.clusterIdsSorted[iClusterTag] == trackBaseId) {
+        ptSum += keysBase.trackPts[iBase];
+      }
+    }
+  }
+  if constexpr (isEMCAL && jetsTagIsMc) {
+    for (std::size_t iCluster = 0; iCluster < keysBase.clusterPts.size(); iCluster++) {
+      for (int iParticle = keysBase.clusterOffsets[iCluster]; iParticle < keysBase.clusterOffsets[iCluster + 1]; iParticle++) {
+        if (std::binary_search(keysTag.trackIds.begin(), keysTag.trackIds.end(), keysBase.clusterParticleIds[iParticle])) {
+          ptSum += keysBase.clusterPts[iCluster];
+          break;
+        }
+      }
+    }
+  }
+  return ptSum;
+}
+
+/**
+ * Shared pT of all the pairs of base and tag jets of a collision, see getPtSum. The pairs of jets with different radii are set to -1.
+ */
+struct JetPtOverlap {
+  std::vector<int> jetsBaseGlobalIndex; // base jets, in the order of the per collision table
+  std::vector<int> jetsTagGlobalIndex;  // tag jets, in the order of the per collision table
+  std::vector<float> ptSumBase;         // pT of the base jet constituents shared with the tag jet, jetsTagGlobalIndex.size() entries per base jet
+  std::vector<float> ptSumTag;          // pT of the tag jet constituents shared with the base jet, same layout as ptSumBase
+
+  float getPtSumBase(std::size_t iJetBase, std::size_t iJetTag) const { return ptSumBase[iJetBase * jetsTagGlobalIndex.size() + iJetTag]; }
+  float getPtSumTag(std::size_t iJetBase, std::size_t iJetTag) const { return ptSumTag[iJetBase * jetsTagGlobalIndex.size() + iJetTag]; }
+};
+
+/**
+ * Computes the shared pT of all the pairs of base and tag jets of a collision with the same radius.
+ * The constituent keys of each jet are sorted once, and each pair is then a linear merge of the keys.
+ */
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O, typename P, typename Q>
-void MatchPt(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingPt, V const& tracksBase, M const& candidatesBase, N const& clustersBase, O const& tracksTag, P const& candidatesTag, Q const& clustersTag, float minPtFraction)
+void getPtOverlap(T const& jetsBasePerCollision, U const& jetsTagPerCollision, JetPtOverlap& overlap, V const& tracksBase, M const& candidatesBase, N const& clustersBase, O const& tracksTag, P const& candidatesTag, Q const& clustersTag)
+{
+  constexpr bool IsEMCAL{jetfindingutilities::isEMCALClusterTable<N>() || jetfindingutilities::isEMCALClusterTable<Q>()};
+  constexpr bool IsCandidate{(jetcandidateutilities::isCandidateTable<M>() || jetcandidateutilities::isCandidateMcTable<M>()) && (jetcandidateutilities::isCandidateTable<P>() || jetcandidateutilities::isCandidateMcTable<P>())};
+
+  overlap.jetsBaseGlobalIndex.clear();
+  overlap.jetsTagGlobalIndex.clear();
+  std::vector<JetConstituentKeys> keysBase;
+  std::vector<JetConstituentKeys> keysTag;
+  std::vector<int> jetsTagR;
+  for (const auto& jetTag : jetsTagPerCollision) {
+    overlap.jetsTagGlobalIndex.push_back(jetTag.globalIndex());
+    jetsTagR.push_back(std::round(jetTag.r()));
+    keysTag.emplace_back();
+    fillConstituentKeys<IsEMCAL, jetsBaseIsMc>(keysTag.back(), getConstituents(jetTag, tracksTag), getConstituents(jetTag, clustersTag));
+  }
+  const std::size_t nJetsTag = overlap.jetsTagGlobalIndex.size();
+  overlap.ptSumBase.assign(jetsBasePerCollision.size() * nJetsTag, -1.);
+  overlap.ptSumTag.assign(jetsBasePerCollision.size() * nJetsTag, -1.);
+
+  std::size_t iJetBase = 0;
+  for (const auto& jetBase : jetsBasePerCollision) {
+    overlap.jetsBaseGlobalIndex.push_back(jetBase.globalIndex());
+    keysBase.emplace_back();
+    fillConstituentKeys<IsEMCAL, jetsTagIsMc>(keysBase.back(), getConstituents(jetBase, tracksBase), getConstituents(jetBase, clustersBase));
+    std::size_t iJetTag = 0;
+    for (const auto& jetTag : jetsTagPerCollision) {
+      if (std::round(jetBase.r()) != jetsTagR[iJetTag]) {
+        iJetTag++;
+        continue;
+      }
+      float ptSumBase = getPtSum<IsEMCAL, jetsBaseIsMc, jetsTagIsMc>(keysBase.back(), keysTag[iJetTag]);
+      float ptSumTag = getPtSum<IsEMCAL, jetsTagIsMc, jetsBaseIsMc>(keysTag[iJetTag], keysBase.back());
+      if constexpr (IsCandidate) {
+        auto jetBaseCandidates = getConstituents(jetBase, candidatesBase);
+        auto jetTagCandidates = getConstituents(jetTag, candidatesTag);
+        ptSumBase += getCandidatePtSum<IsCandidate, jetsBaseIsMc, jetsTagIsMc>(jetBaseCandidates, jetTagCandidates, tracksBase, tracksTag);
+        ptSumTag += getCandidatePtSum<IsCandidate, jetsTagIsMc, jetsBaseIsMc>(jetTagCandidates, jetBaseCandidates, tracksTag, tracksBase);
+      }
+      overlap.ptSumBase[iJetBase * nJetsTag + iJetTag] = ptSumBase;
+      overlap.ptSumTag[iJetBase * nJetsTag + iJetTag] = ptSumTag;
+      iJetTag++;
+    }
+    iJetBase++;
+  }
+}
+
+// pt matching from the shared pT of all the pairs of jets of a collision
+template <typename T, typename U>
+void MatchPt(T const& jetsBasePerCollision, U const& jetsTagPerCollision, JetPtOverlap const& overlap, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingPt, float minPtFraction)
 {
-  float ptSumBase;
-  float ptSumTag;
+  std::size_t iJetBase = 0;
   for (const auto& jetBase : jetsBasePerCollision) {
-    auto jetBaseTracks = getConstituents(jetBase, tracksBase);
-    auto jetBaseClusters = getConstituents(jetBase, clustersBase);
-    auto jetBaseCandidates = getConstituents(jetBase, candidatesBase);
+    std::size_t iJetTag = 0;
     for (const auto& jetTag : jetsTagPerCollision) {
       if (std::round(jetBase.r()) != std::round(jetTag.r())) {
+        iJetTag++;
         continue;
       }
-      auto jetTagTracks = getConstituents(jetTag, tracksTag);
-      auto jetTagClusters = getConstituents(jetTag, clustersTag);
-      auto jetTagCandidates = getConstituents(jetTag, candidatesTag);
-
-      constexpr bool IsEMCAL{jetfindingutilities::isEMCALClusterTable<N>() || jetfindingutilities::isEMCALClusterTable<Q>()};
-      constexpr bool IsCandidate{(jetcandidateutilities::isCandidateTable<M>() || jetcandidateutilities::isCandidateMcTable<M>()) && (jetcandidateutilities::isCandidateTable<P>() || jetcandidateutilities::isCandidateMcTable<P>())};
-      ptSumBase = getPtSum<IsEMCAL, IsCandidate, jetsBaseIsMc, jetsTagIsMc>(jetBaseTracks, jetBaseCandidates, jetBaseClusters, jetTagTracks, jetTagCandidates, jetTagClusters, tracksBase, tracksTag);
-      ptSumTag = getPtSum<IsEMCAL, IsCandidate, jetsTagIsMc, jetsBaseIsMc>(jetTagTracks, jetTagCandidates, jetTagClusters, jetBaseTracks, jetBaseCandidates, jetBaseClusters, tracksTag, tracksBase);
-      if (ptSumBase > jetBase.pt() * minPtFraction) {
+      if (overlap.getPtSumBase(iJetBase, iJetTag) > jetBase.pt() * minPtFraction) {
         baseToTagMatchingPt[jetBase.globalIndex()].push_back(jetTag.globalIndex());
       }
-      if (ptSumTag > jetTag.pt() * minPtFraction) {
+      if (overlap.getPtSumTag(iJetBase, iJetTag) > jetTag.pt() * minPtFraction) {
         tagToBaseMatchingPt[jetTag.globalIndex()].push_back(jetBase.globalIndex());
       }
+      iJetTag++;
     }
+    iJetBase++;
   }
 }
 
+template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O, typename P, typename Q>
+void MatchPt(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingPt, V const& tracksBase, M const& candidatesBase, N const& clustersBase, O const& tracksTag, P const& candidatesTag, Q const& clustersTag, float minPtFraction)
+{
+  JetPtOverlap overlap;
+  getPtOverlap<jetsBaseIsMc, jetsTagIsMc>(jetsBasePerCollision, jetsTagPerCollision, overlap, tracksBase, candidatesBase, clustersBase, tracksTag, candidatesTag, clustersTag);
+  MatchPt(jetsBasePerCollision, jetsTagPerCollision, overlap, baseToTagMatchingPt, tagToBaseMatchingPt, minPtFraction);
+}
+
 // function that calls all the Match functions
 template <bool jetsBaseIsMc, bool jetsTagIsMc, typename T, typename U, typename V, typename M, typename N, typename O, typename P, typename R>
-void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& candidatesBase, M const& tracksBase, N const& clustersBase, O const& candidatesTag, P const& tracksTag, R const& clustersTag, bool doMatchingGeo, bool doMatchingHf, bool doMatchingPt, float maxMatchingDistance, float minPtFraction)
+void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision, std::vector<std::vector<int>>& baseToTagMatchingGeo, std::vector<std::vector<int>>& baseToTagMatchingPt, std::vector<std::vector<int>>& baseToTagMatchingHF, std::vector<std::vector<int>>& tagToBaseMatchingGeo, std::vector<std::vector<int>>& tagToBaseMatchingPt, std::vector<std::vector<int>>& tagToBaseMatchingHF, V const& candidatesBase, M const& tracksBase, N const& clustersBase, O const& candidatesTag, P const& tracksTag, R const& clustersTag, bool doMatchingGeo, bool doMatchingHf, bool doMatchingPt, float maxMatchingDistance, float minPtFraction, JetPtOverlap* ptOverlap = nullptr)
 {
   // geometric matching
   if (doMatchingGeo) {
@@ -573,7 +743,10 @@ void doAllMatching(T const& jetsBasePerCollision, U const& jetsTagPerCollision,
   }
   // pt matching
   if (doMatchingPt) {
-    MatchPt<jetsBaseIsMc, jetsTagIsMc>(jetsBasePerCollision, jetsTagPerCollision, baseToTagMatchingPt, tagToBaseMatchingPt, tracksBase, candidatesBase, clustersBase, tracksTag, candidatesTag, clustersTag, minPtFraction);
+    JetPtOverlap overlap;
+    JetPtOverlap& overlapUsed = ptOverlap ? *ptOverlap : overlap; // the shared pT of all the pairs of jets can be kept by the caller
+    getPtOverlap<jetsBaseIsMc, jetsTagIsMc>(jetsBasePerCollision, jetsTagPerCollision, overlapUsed, tracksBase, candidatesBase, clustersBase, tracksTag, candidatesTag, clustersTag);
+    MatchPt(jetsBasePerCollision, jetsTagPerCollision, overlapUsed, baseToTagMatchingPt, tagToBaseMatchingPt, minPtFraction);
   }
   // HF matching
   if constexpr (jetcandidateutilities::isCandidateTable<V>() || jetcandidateutilities::isCandidateMcTable<V>()) {
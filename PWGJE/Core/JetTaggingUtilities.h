@@ -622,6 +622,95 @@ std::unique_ptr<TF1> setResolutionFunction(T const& vecParams)
   return fResoFunc;
 }
 
+/**
+ * Cumulative distribution of a resolution function over the signed impact parameter significance range
+ * [minSignImpXYSig, 0]. The integral and the function are tabulated on an equidistant grid at initialisation,
+ * so that the track probability is a cubic Hermite interpolation of the table instead of two numerical
+ * integrations of the TF1 per track.
+ */
+class ResolutionFunctionCdf
+{
+ public:
+  /**
+   * Tabulates the normalised cumulative distribution of a resolution function
+   *
+   * @param fResoFunc The resolution function. It is integrated for each track if nPoints < 2, in which case it has to outlive this object.
+   * @param minSignImpXYSig The lower limit for integration of the resolution function.
+   * @param nPoints The number of grid points.
+   */
+  void init(TF1* fResoFunc, float minSignImpXYSig, int nPoints = 2000)
+  {
+    mResoFunc = fResoFunc;
+    mMinSignImpXYSig = minSignImpXYSig;
+    mCdf.clear();
+    mPdf.clear();
+    if (nPoints < 2 || minSignImpXYSig >= 0) {
+      return;
+    }
+    mStep = -static_cast<double>(minSignImpXYSig) / (nPoints - 1);
+    mCdf.resize(nPoints);
+    mPdf.resize(nPoints);
+    double cdf = 0.;
+    for (int i = 0; i < nPoints; i++) {
+      double x = minSignImpXYSig + i * mStep;
+      if (i > 0) {
+        cdf += fResoFunc->Integral(x - mStep, x);
+      }
+      mCdf[i] = cdf;
+      mPdf[i] = fResoFunc->Eval(x);
+    }
+    for (int i = 0; i < nPoints; i++) {
+      mCdf[i] /= cdf;
+      mPdf[i] *= mStep / cdf; // slope per grid step
+    }
+  }
+
+  /**
+   * @param varSignImpXYSig The absolute impact parameter significance of the track.
+   * @return The probability of the track, as getTrackProbability with the resolution function given to init.
+   */
+  float getTrackProbability(float varSignImpXYSig) const
+  {
+    if (-varSignImpXYSig < mMinSignImpXYSig) {
+      varSignImpXYSig = -mMinSignImpXYSig - 0.01; // To avoid overflow for integral
+    }
+    if (mCdf.empty()) {
+      return mResoFunc->Integral(mMinSignImpXYSig, -varSignImpXYSig) / mResoFunc->Integral(mMinSignImpXYSig, 0);
+    }
+    if (std::isnan(varSignImpXYSig)) {
+      return varSignImpXYSig;
+    }
+    double u = (-varSignImpXYSig - mMinSignImpXYSig) / mStep;
+    int i = std::min(static_cast<int>(u), static_cast<int>(mCdf.size()) - 2);
+    double t = u - i;
+    double cdf = (1. + 2. * t) * (1. - t) * (1. - t) * mCdf[i] + t * (1. - t) * (1. - t) * mPdf[i] + t * t * (3. - 2. * t) * mCdf[i + 1] - t * t * (1. - t) * mPdf[i + 1];
+    return std::clamp(cdf, std::min(mCdf[i], mCdf[i + 1]), std::max(mCdf[i], mCdf[i + 1])); // keeps the interpolation monotonic
+  }
+
+  /**
+   * Batch variant of getTrackProbability
+   *
+   * @param varSignImpXYSig The absolute impact parameter significances of the tracks.
+   * @param nTracks The number of tracks.
+   * @param probTracks The track probabilities to be filled.
+   */
+  void getTrackProbabilities(const float* varSignImpXYSig, std::size_t nTracks, float* probTracks) const
+  {
+    for (std::size_t i = 0; i < nTracks; i++) {
+      probTracks[i] = getTrackProbability(varSignImpXYSig[i]);
+    }
+  }
+
+  bool isTabulated() const { return !mCdf.empty(); }
+
+ private:
+  TF1* mResoFunc = nullptr;
+  float mMinSignImpXYSig = -40;
+  double mStep = 0.;
+  std::vector<double> mCdf; // normalised cumulative distribution at the grid points
+  std::vector<double> mPdf; // normalised resolution function at the grid points, times the grid step
+};
+
 /**
  * Calculates the probability of a given track being associated with a jet, based on the geometric
  * sign and the resolution function of the jet's impact parameter significance. This probability
@@ -747,6 +836,75 @@ float getJetProbability(std::vector<std::unique_ptr<T>> const& fResoFuncjets, U
   return jetProb;
 }
 
+/**
+ * Combines the probabilities of the positive geometric sign tracks of a jet into the jet probability (JP)
+ *
+ * @param probTracks The track probabilities.
+ * @return The jet probability, -1 if there are fewer than two tracks.
+ */
+inline float getJetProbabilityFromTracks(std::vector<float> const& probTracks)
+{
+  if (probTracks.size() < 2)
+    return -1;
+
+  float trackjetProb = 1.;
+  for (auto const& probTrack : probTracks) {
+    trackjetProb *= probTrack;
+  }
+  float sumjetProb = 0.;
+  for (std::vector<float>::size_type i = 0; i < probTracks.size(); i++) {
+    sumjetProb += (std::pow(-1 * std::log(trackjetProb), static_cast<int>(i)) / TMath::Factorial(i));
+  }
+  return trackjetProb * sumjetProb;
+}
+
+// overloading for the case of using the tabulated resolution function, the track probabilities of a jet are evaluated in one batch
+template <typename U, typename V>
+float getJetProbability(ResolutionFunctionCdf const& resoFuncCdf, U const& jet, V const& /*tracks*/, float trackDcaXYMax, float trackDcaZMax)
+{
+  std::vector<float> varSignImpXYSig;
+  for (auto const& track : jet.template tracks_as<V>()) {
+    if (!trackAcceptanceWithDca(track, trackDcaXYMax, trackDcaZMax))
+      continue;
+    if (getGeoSign(jet, track) > 0) { // only take positive sign track for JP calculation
+      varSignImpXYSig.push_back(std::abs(track.dcaXY()) / track.sigmadcaXY());
+    }
+  }
+  std::vector<float> probTracks(varSignImpXYSig.size());
+  resoFuncCdf.getTrackProbabilities(varSignImpXYSig.data(), varSignImpXYSig.size(), probTracks.data());
+  return getJetProbabilityFromTracks(probTracks);
+}
+
+// overloading for the case of using the tabulated resolution function for each pt range
+template <typename U, typename V>
+float getJetProbability(std::vector<ResolutionFunctionCdf> const& resoFuncCdfs, U const& jet, V const& /*tracks*/, float trackDcaXYMax, float trackDcaZMax)
+{
+  static constexpr std::array<float, 6> PtBinEdges = {0.5, 1.0, 2.0, 4.0, 6.0, 9.0}; // upper edges of the pt ranges, as in getJetProbability
+  std::vector<float> probTracks;
+  for (auto const& track : jet.template tracks_as<V>()) {
+    if (!trackAcceptanceWithDca(track, trackDcaXYMax, trackDcaZMax))
+      continue;
+    if (getGeoSign(jet, track) <= 0) // only take positive sign track for JP calculation
+      continue;
+    float probTrack = -1;
+    if (track.pt() >= 0.0) {
+      auto ptBin = std::upper_bound(PtBinEdges.begin(), PtBinEdges.end(), track.pt()) - PtBinEdges.begin();
+      probTrack = resoFuncCdfs.at(ptBin).getTrackProbability(std::abs(track.dcaXY()) / track.sigmadcaXY());
+    }
+    probTracks.push_back(probTrack);
+  }
+  return getJetProbabilityFromTracks(probTracks);
+}
+
+/**
+ * Calculates the probability of a track with the tabulated resolution function, see getTrackProbability
+ */
+template <typename U>
+float getTrackProbability(ResolutionFunctionCdf const& resoFuncCdf, U const& track)
+{
+  return resoFuncCdf.getTrackProbability(std::abs(track.dcaXY()) / track.sigmadcaXY());
+}
+
 // For secaondy vertex method utilites
 template <typename ProngType, typename JetType>
 typename ProngType::iterator jetFromProngMaxDecayLength(const JetType& jet, float const& prongChi2PCAMin, float prongChi2PCAMax, float prongsigmaLxyMax, float prongIPxyMin, float prongIPxyMax, bool doXYZ = false, bool* checkSv = nullptr)
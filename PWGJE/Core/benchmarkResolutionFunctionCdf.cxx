@@ -0,0 +1,109 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmarkResolutionFunctionCdf.cxx
+/// \brief exec comparing the track probabilities of the jet-probability tagging computed with TF1::Integral
+///        (getTrackProbability with a TF1) and with the tabulated cumulative distribution (ResolutionFunctionCdf)
+///        Usage: o2-bench-je-resolution-function-cdf [number of tracks] [resolution function parameters (9)]
+
+#include "PWGJE/Core/JetTaggingUtilities.h"
+
+#include <Framework/Logger.h>
+
+#include <TF1.h>
+#include <TRandom3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// minimal track, as needed by getTrackProbability
+struct BenchTrack {
+  float mDcaXY;
+  float dcaXY() const { return mDcaXY; }
+  float sigmadcaXY() const { return 1.f; }
+};
+
+double elapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  int nTracks = 100000;
+  // gaus(0)+expo(3)+expo(5)+expo(7), narrow core and long tails, as fitted to the signed impact parameter significance
+  std::vector<float> params = {1.e5, 0., 1.1, 8., 0.8, 6., 0.3, 3., 0.08};
+  if (argc > 1) {
+    nTracks = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    if (argc != 2 + static_cast<int>(params.size())) {
+      LOG(error) << "Usage: " << argv[0] << " [number of tracks] [resolution function parameters (" << params.size() << ")]";
+      return 1;
+    }
+    for (std::size_t i = 0; i < params.size(); i++) {
+      params[i] = std::atof(argv[2 + i]);
+    }
+  }
+  auto fResoFunc = jettaggingutilities::setResolutionFunction(params);
+
+  // impact parameter significances of the tracks, including tracks beyond the integration range
+  TRandom3 random(1);
+  std::vector<BenchTrack> tracks(nTracks);
+  std::vector<float> varSignImpXYSig(nTracks);
+  for (int i = 0; i < nTracks; i++) {
+    varSignImpXYSig[i] = (i % 100 == 0) ? random.Uniform(0., 60.) : random.Exp(3.);
+    tracks[i].mDcaXY = varSignImpXYSig[i];
+  }
+
+  for (const float minSignImpXYSig : {-40.f, -10.f}) {
+    std::vector<float> probIntegral(nTracks);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nTracks; i++) {
+      probIntegral[i] = jettaggingutilities::getTrackProbability(fResoFunc, tracks[i], minSignImpXYSig);
+    }
+    const double timeIntegral = elapsedMicroseconds(start) / nTracks;
+    LOGF(info, "minSignImpXYSig = %.0f: TF1::Integral %.3f us/track", minSignImpXYSig, timeIntegral);
+
+    for (const int nPoints : {500, 2000, 8000}) {
+      jettaggingutilities::ResolutionFunctionCdf cdf;
+      start = std::chrono::steady_clock::now();
+      cdf.init(fResoFunc.get(), minSignImpXYSig, nPoints);
+      const double timeInit = elapsedMicroseconds(start);
+      std::vector<float> probCdf(nTracks);
+      start = std::chrono::steady_clock::now();
+      cdf.getTrackProbabilities(varSignImpXYSig.data(), varSignImpXYSig.size(), probCdf.data());
+      const double timeCdf = elapsedMicroseconds(start) / nTracks;
+
+      double maxDiff = 0., maxRelDiff = 0.;
+      float maxDiffSignImpXYSig = 0.;
+      for (int i = 0; i < nTracks; i++) {
+        const double diff = std::abs(probCdf[i] - probIntegral[i]);
+        if (diff > maxDiff) {
+          maxDiff = diff;
+          maxDiffSignImpXYSig = varSignImpXYSig[i];
+        }
+        if (probIntegral[i] > 1.e-6) {
+          maxRelDiff = std::max(maxRelDiff, diff / probIntegral[i]);
+        }
+      }
+      LOGF(info, "  %5d points: init %.0f us, CDF lookup %.4f us/track (x%.0f), max |dP| = %.2e (at significance %.2f), max |dP|/P (P > 1e-6) = %.2e",
+           nPoints, timeInit, timeCdf, timeIntegral / timeCdf, maxDiff, maxDiffSignImpXYSig, maxRelDiff);
+    }
+  }
+  return 0;
+}
@@ -17,6 +17,8 @@
 #ifndef PWGJE_JETFINDERS_JETFINDERHF_H_
 #define PWGJE_JETFINDERS_JETFINDERHF_H_
 
+#include "PWGJE/Core/FastJetUtilities.h"
+#include "PWGJE/Core/JetCandidateUtilities.h"
 #include "PWGJE/Core/JetDerivedDataUtilities.h"
 #include "PWGJE/Core/JetFinder.h"
 #include "PWGJE/Core/JetFindingUtilities.h"
@@ -42,7 +44,10 @@
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 
+#include <cstddef>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 template <typename CandidateTableData, typename CandidateTableMCD, typename CandidateTableMCP, typename JetTracksSubTable, typename JetParticlesSubTable, typename JetTable, typename ConstituentTable, typename JetEvtWiseSubTable, typename ConstituentEvtWiseSubTable>
@@ -115,6 +120,7 @@ struct JetFinderHFTask {
   o2::framework::Configurable<int> jetPtBinWidth{"jetPtBinWidth", 5, "used to define the width of the jetPt bins for the THnSparse"};
   o2::framework::Configurable<bool> fillTHnSparse{"fillTHnSparse", false, "switch to fill the THnSparse"};
   o2::framework::Configurable<double> jetExtraParam{"jetExtraParam", -99.0, "sets the _extra_param in fastjet"};
+  o2::framework::Configurable<bool> doIncrementalCandidateJetFinding{"doIncrementalCandidateJetFinding", false, "cluster the event without candidates once and recluster only the jets around each candidate (not used with event-wise subtraction, tracking efficiency or ghostRepeat != 1)"};
 
   o2::framework::Service<o2::framework::O2DatabasePDG> pdgDatabase;
   int trackSelection = -1;
@@ -123,6 +129,10 @@ struct JetFinderHFTask {
 
   JetFinder jetFinder;
   std::vector<fastjet::PseudoJet> inputParticles;
+  bool useIncrementalCandidateJetFinding = false;
+  std::vector<fastjet::PseudoJet> candidateParticles;
+  std::vector<int> removedParticles;
+  std::unordered_map<int, int> inputParticleIndices; // position in inputParticles of each track/particle global index
 
   std::vector<int> triggerMaskBits;
 
@@ -176,6 +186,12 @@ struct JetFinderHFTask {
         LOGP(fatal, "jetFinderHF workflow: trackingEfficiency configurable should have exactly one less entry than the number of bin edges set in trackingEfficiencyPtBinning configurable");
       }
     }
+
+    // the tracks discarded by the tracking efficiency are drawn for each candidate, and the base event ghosts have to be shared by the reclustered regions
+    useIncrementalCandidateJetFinding = doIncrementalCandidateJetFinding && !applyTrackingEfficiency && ghostRepeat == 1;
+    if (doIncrementalCandidateJetFinding && !useIncrementalCandidateJetFinding) {
+      LOGP(warning, "jetFinderHF workflow: incremental candidate jet finding requires applyTrackingEfficiency = false and ghostRepeat = 1, the event is clustered for each candidate");
+    }
   }
 
   o2::aod::EMCALClusterDefinition clusterDefinition = o2::aod::emcalcluster::getClusterDefinitionFromString(clusterDefinitionS.value);
@@ -257,6 +273,105 @@ struct JetFinderHFTask {
     jetfindingutilities::findJets(jetFinder, inputParticles, minJetPt, maxJetPt, jetRadius, jetAreaFractionMin, mcCollision, jetsTableInput, constituentsTableInput, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse, true);
   }
 
+  // function that processes all the candidates of a data or reco level event, clustering the event without candidates only once
+  template <typename T, typename U, typename V, typename M, typename N>
+  void analyseChargedIncremental(T const& collision, U const& tracks, V const& candidates, M& jetsTableInput, N& constituentsTableInput, float minJetPt, float maxJetPt)
+  {
+    if (!jetderiveddatautilities::selectCollision(collision, eventSelectionBits, skipMBGapEvents, applyRCTSelections) || !jetderiveddatautilities::selectTrigger(collision, triggerMaskBits)) {
+      return;
+    }
+    inputParticles.clear();
+    jetfindingutilities::analyseTracks<U, typename V::iterator>(inputParticles, tracks, trackSelection, applyTrackingEfficiency, trackingEfficiency, trackingEfficiencyPtBinning);
+    jetFinder.jetPtMin = minJetPt;
+    jetFinder.jetPtMax = maxJetPt;
+    auto jetRValues = static_cast<std::vector<double>>(jetRadius);
+    if (!jetFinder.clusterBaseEvent(inputParticles, jetRValues)) {
+      return;
+    }
+    inputParticleIndices.clear();
+    for (std::size_t iParticle = 0; iParticle < inputParticles.size(); iParticle++) {
+      inputParticleIndices[fastjetutilities::getConstituentIndex(inputParticles[iParticle])] = iParticle;
+    }
+
+    for (auto const& candidate : candidates) {
+      candidateParticles.clear();
+      if constexpr (jetcandidateutilities::isCandidate<typename V::iterator>()) {
+        if (!jetfindingutilities::analyseCandidate(candidateParticles, candidate, candPtMin, candPtMax, candYMin, candYMax)) {
+          continue;
+        }
+      }
+      if constexpr (jetcandidateutilities::isMcCandidate<typename V::iterator>()) {
+        if (!jetfindingutilities::analyseCandidateMC(candidateParticles, candidate, candPtMin, candPtMax, candYMin, candYMax, rejectBackgroundMCDCandidates)) {
+          continue;
+        }
+      }
+      removedParticles.clear();
+      for (auto const& track : tracks) {
+        if (jetcandidateutilities::isDaughterTrack(track, candidate)) {
+          addRemovedParticle(track.globalIndex());
+        }
+      }
+      jetfindingutilities::findJetsWithCandidate(jetFinder, candidateParticles.front(), removedParticles, jetRValues, jetAreaFractionMin, collision, jetsTableInput, constituentsTableInput, registry.get<THn>(HIST("hJet")), fillTHnSparse);
+    }
+  }
+
+  // function that processes all the candidates of a gen level event, clustering the event without candidates only once
+  template <typename T, typename U, typename V, typename M, typename N>
+  void analyseMCPIncremental(T const& mcCollision, U const& particles, V const& candidates, M& jetsTableInput, N& constituentsTableInput, int jetTypeParticleLevel, float minJetPt, float maxJetPt)
+  {
+    if (!jetderiveddatautilities::selectMcCollision(mcCollision, skipMBGapEvents, applyRCTSelections)) {
+      return;
+    }
+    inputParticles.clear();
+    jetfindingutilities::analyseParticles<false, U, typename V::iterator>(inputParticles, particleSelection, jetTypeParticleLevel, particles, pdgDatabase);
+    jetFinder.jetPtMin = minJetPt;
+    jetFinder.jetPtMax = maxJetPt;
+    auto jetRValues = static_cast<std::vector<double>>(jetRadius);
+    if (!jetFinder.clusterBaseEvent(inputParticles, jetRValues)) {
+      return;
+    }
+    inputParticleIndices.clear();
+    for (std::size_t iParticle = 0; iParticle < inputParticles.size(); iParticle++) {
+      inputParticleIndices[fastjetutilities::getConstituentIndex(inputParticles[iParticle])] = iParticle;
+    }
+
+    for (auto const& candidate : candidates) {
+      if (rejectIncorrectDecaysMCP && !jetcandidateutilities::isMatchedCandidate(candidate)) {
+        continue;
+      }
+      candidateParticles.clear();
+      if (!jetfindingutilities::analyseCandidate(candidateParticles, candidate, candPtMin, candPtMax, candYMin, candYMax)) {
+        continue;
+      }
+      removedParticles.clear();
+      addRemovedParticle(candidate.mcParticleId());
+      addRemovedDaughterParticles(candidate.template mcParticle_as<U>());
+      jetfindingutilities::findJetsWithCandidate(jetFinder, candidateParticles.front(), removedParticles, jetRValues, jetAreaFractionMin, mcCollision, jetsTableInput, constituentsTableInput, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
+    }
+  }
+
+  // adds the track/particle with the given global index to the particles replaced by the candidate, if it is in the base event
+  void addRemovedParticle(int globalIndex)
+  {
+    auto inputParticleIndex = inputParticleIndices.find(globalIndex);
+    if (inputParticleIndex != inputParticleIndices.end()) {
+      removedParticles.push_back(inputParticleIndex->second);
+    }
+  }
+
+  // adds all the descendants of a particle to the particles replaced by the candidate, as done by jetcandidateutilities::isDaughterParticle
+  template <typename T>
+  void addRemovedDaughterParticles(T const& particle)
+  {
+    if (!particle.has_daughters()) {
+      return;
+    }
+    for (auto const& daughter : particle.template daughters_as<typename std::decay_t<T>::parent_t>()) {
+      addRemovedParticle(daughter.globalIndex());
+      addRemovedDaughterParticles(daughter);
+    }
+  }
+
   void processDummy(o2::aod::JetCollisions const&)
   {
   }
@@ -264,6 +379,10 @@ struct JetFinderHFTask {
 
   void processChargedJetsData(o2::soa::Filtered<o2::aod::JetCollisions>::iterator const& collision, o2::soa::Filtered<o2::aod::JetTracks> const& tracks, CandidateTableData const& candidates)
   {
+    if (useIncrementalCandidateJetFinding) {
+      analyseChargedIncremental(collision, tracks, candidates, jetsTable, constituentsTable, jetPtMin, jetPtMax);
+      return;
+    }
     for (typename CandidateTableData::iterator const& candidate : candidates) { // why can the type not be auto?  try const auto
       analyseCharged<false>(collision, tracks, candidate, jetsTable, constituentsTable, tracks, jetPtMin, jetPtMax);
     }
@@ -280,6 +399,10 @@ struct JetFinderHFTask {
 
   void processChargedJetsMCD(o2::soa::Filtered<o2::aod::JetCollisions>::iterator const& collision, o2::soa::Filtered<o2::aod::JetTracks> const& tracks, CandidateTableMCD const& candidates)
   {
+    if (useIncrementalCandidateJetFinding) {
+      analyseChargedIncremental(collision, tracks, candidates, jetsTable, constituentsTable, jetPtMin, jetPtMax);
+      return;
+    }
     for (typename CandidateTableMCD::iterator const& candidate : candidates) {
       analyseCharged<false>(collision, tracks, candidate, jetsTable, constituentsTable, tracks, jetPtMin, jetPtMax);
     }
@@ -298,6 +421,10 @@ struct JetFinderHFTask {
                              o2::soa::Filtered<o2::aod::JetParticles> const& particles,
                              CandidateTableMCP const& candidates)
   {
+    if (useIncrementalCandidateJetFinding) {
+      analyseMCPIncremental(mcCollision, particles, candidates, jetsTable, constituentsTable, 1, jetPtMin, jetPtMax);
+      return;
+    }
     for (typename CandidateTableMCP::iterator const& candidate : candidates) {
       analyseMCP<false>(mcCollision, particles, candidate, jetsTable, constituentsTable, 1, jetPtMin, jetPtMax);
     }
@@ -92,6 +92,7 @@ struct JetTaggerHFTask {
   Configurable<std::vector<float>> paramsResoFuncBeautyJetMC{"paramsResoFuncBeautyJetMC", std::vector<float>{-1.0}, "parameters of gaus(0)+expo(3)+expo(5)+expo(7)))"};
   Configurable<std::vector<float>> paramsResoFuncLfJetMC{"paramsResoFuncLfJetMC", std::vector<float>{-1.0}, "parameters of gaus(0)+expo(3)+expo(5)+expo(7)))"};
   Configurable<float> minSignImpXYSig{"minSignImpXYSig", -40.0, "minimum of signed impact parameter significance"};
+  Configurable<int> nPointsResoFuncCdf{"nPointsResoFuncCdf", 2000, "number of points of the tabulated cumulative distribution of the resolution functions (integrated for each track if < 2)"};
   Configurable<float> tagPointForIP{"tagPointForIP", 2.5, "tagging working point for IP"};
   Configurable<float> tagPointForIPxyz{"tagPointForIPxyz", 2.5, "tagging working point for IP xyz"};
   Configurable<int64_t> timestampCCDBForIP{"timestampCCDBForIP", -1, "timestamp of the resolution function file for IP method used to query in CCDB"};
@@ -173,6 +174,18 @@ struct JetTaggerHFTask {
   std::vector<std::unique_ptr<TF1>> vecfSignImpXYSigBeautyJetMcCCDB;
   std::vector<std::unique_ptr<TF1>> vecfSignImpXYSigLfJetMcCCDB;
 
+  jettaggingutilities::ResolutionFunctionCdf cdfSignImpXYSigData;
+  jettaggingutilities::ResolutionFunctionCdf cdfSignImpXYSigIncJetMC;
+  jettaggingutilities::ResolutionFunctionCdf cdfSignImpXYSigCharmJetMC;
+  jettaggingutilities::ResolutionFunctionCdf cdfSignImpXYSigBeautyJetMC;
+  jettaggingutilities::ResolutionFunctionCdf cdfSignImpXYSigLfJetMC;
+
+  std::vector<jettaggingutilities::ResolutionFunctionCdf> vecCdfSignImpXYSigDataJetCCDB;
+  std::vector<jettaggingutilities::ResolutionFunctionCdf> vecCdfSignImpXYSigIncJetMcCCDB;
+  std::vector<jettaggingutilities::ResolutionFunctionCdf> vecCdfSignImpXYSigCharmJetMcCCDB;
+  std::vector<jettaggingutilities::ResolutionFunctionCdf> vecCdfSignImpXYSigBeautyJetMcCCDB;
+  std::vector<jettaggingutilities::ResolutionFunctionCdf> vecCdfSignImpXYSigLfJetMcCCDB;
+
   std::vector<uint16_t> decisionNonML;
   std::vector<float> scoreML;
 
@@ -184,35 +197,35 @@ struct JetTaggerHFTask {
     float jetProb = -1.0;
     if (!isMC) {
       if (usepTcategorize) {
-        jetProb = jettaggingutilities::getJetProbability(vecfSignImpXYSigDataJetCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+        jetProb = jettaggingutilities::getJetProbability(vecCdfSignImpXYSigDataJetCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax);
       } else {
-        jetProb = jettaggingutilities::getJetProbability(fSignImpXYSigData, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+        jetProb = jettaggingutilities::getJetProbability(cdfSignImpXYSigData, jet, tracks, trackDcaXYMax, trackDcaZMax);
       }
     } else {
       if (useResoFuncFromIncJet) {
         if (usepTcategorize) {
-          jetProb = jettaggingutilities::getJetProbability(vecfSignImpXYSigIncJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+          jetProb = jettaggingutilities::getJetProbability(vecCdfSignImpXYSigIncJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax);
         } else {
-          jetProb = jettaggingutilities::getJetProbability(fSignImpXYSigIncJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+          jetProb = jettaggingutilities::getJetProbability(cdfSignImpXYSigIncJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax);
         }
       } else {
         if (origin == JetTaggingSpecies::charm) {
           if (usepTcategorize) {
-            jetProb = jettaggingutilities::getJetProbability(vecfSignImpXYSigCharmJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(vecCdfSignImpXYSigCharmJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax);
           } else {
-            jetProb = jettaggingutilities::getJetProbability(fSignImpXYSigCharmJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(cdfSignImpXYSigCharmJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax);
           }
         } else if (origin == JetTaggingSpecies::beauty) {
           if (usepTcategorize) {
-            jetProb = jettaggingutilities::getJetProbability(vecfSignImpXYSigBeautyJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(vecCdfSignImpXYSigBeautyJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax);
           } else {
-            jetProb = jettaggingutilities::getJetProbability(fSignImpXYSigBeautyJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(cdfSignImpXYSigBeautyJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax);
           }
         } else {
           if (usepTcategorize) {
-            jetProb = jettaggingutilities::getJetProbability(vecfSignImpXYSigLfJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(vecCdfSignImpXYSigLfJetMcCCDB, jet, tracks, trackDcaXYMax, trackDcaZMax);
           } else {
-            jetProb = jettaggingutilities::getJetProbability(fSignImpXYSigLfJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax, minSignImpXYSig);
+            jetProb = jettaggingutilities::getJetProbability(cdfSignImpXYSigLfJetMC, jet, tracks, trackDcaXYMax, trackDcaZMax);
           }
         }
       }
@@ -229,23 +242,23 @@ struct JetTaggerHFTask {
       auto geoSign = jettaggingutilities::getGeoSign(jet, track);
       float probTrack = -1;
       if (!isMC) {
-        probTrack = jettaggingutilities::getTrackProbability(fSignImpXYSigData, track, minSignImpXYSig);
+        probTrack = jettaggingutilities::getTrackProbability(cdfSignImpXYSigData, track);
         if (geoSign > 0)
           registry.fill(HIST("h_pos_track_probability"), probTrack);
         else
           registry.fill(HIST("h_neg_track_probability"), probTrack);
       } else {
         if (useResoFuncFromIncJet) {
-          probTrack = jettaggingutilities::getTrackProbability(fSignImpXYSigIncJetMC, track, minSignImpXYSig);
+          probTrack = jettaggingutilities::getTrackProbability(cdfSignImpXYSigIncJetMC, track);
         } else {
           if (origin == JetTaggingSpecies::charm) {
-            probTrack = jettaggingutilities::getTrackProbability(fSignImpXYSigCharmJetMC, track, minSignImpXYSig);
+            probTrack = jettaggingutilities::getTrackProbability(cdfSignImpXYSigCharmJetMC, track);
           }
           if (origin == JetTaggingSpecies::beauty) {
-            probTrack = jettaggingutilities::getTrackProbability(fSignImpXYSigBeautyJetMC, track, minSignImpXYSig);
+            probTrack = jettaggingutilities::getTrackProbability(cdfSignImpXYSigBeautyJetMC, track);
           }
           if (origin == JetTaggingSpecies::lightflavour) {
-            probTrack = jettaggingutilities::getTrackProbability(fSignImpXYSigLfJetMC, track, minSignImpXYSig);
+            probTrack = jettaggingutilities::getTrackProbability(cdfSignImpXYSigLfJetMC, track);
           }
         }
         if (geoSign > 0)
@@ -498,6 +511,26 @@ struct JetTaggerHFTask {
       vecfSignImpXYSigLfJetMcCCDB.emplace_back(jettaggingutilities::setResolutionFunction(params));
     }
 
+    // the cumulative distributions of the resolution functions are tabulated once, the track probabilities are then interpolated
+    if (useJetProb) {
+      cdfSignImpXYSigData.init(fSignImpXYSigData.get(), minSignImpXYSig, nPointsResoFuncCdf);
+      cdfSignImpXYSigIncJetMC.init(fSignImpXYSigIncJetMC.get(), minSignImpXYSig, nPointsResoFuncCdf);
+      cdfSignImpXYSigCharmJetMC.init(fSignImpXYSigCharmJetMC.get(), minSignImpXYSig, nPointsResoFuncCdf);
+      cdfSignImpXYSigBeautyJetMC.init(fSignImpXYSigBeautyJetMC.get(), minSignImpXYSig, nPointsResoFuncCdf);
+      cdfSignImpXYSigLfJetMC.init(fSignImpXYSigLfJetMC.get(), minSignImpXYSig, nPointsResoFuncCdf);
+      auto initCdfs = [&](std::vector<std::unique_ptr<TF1>> const& resoFuncs, std::vector<jettaggingutilities::ResolutionFunctionCdf>& cdfs) {
+        cdfs.resize(resoFuncs.size());
+        for (size_t j = 0; j < resoFuncs.size(); j++) {
+          cdfs[j].init(resoFuncs[j].get(), minSignImpXYSig, nPointsResoFuncCdf);
+        }
+      };
+      initCdfs(vecfSignImpXYSigDataJetCCDB, vecCdfSignImpXYSigDataJetCCDB);
+      initCdfs(vecfSignImpXYSigIncJetMcCCDB, vecCdfSignImpXYSigIncJetMcCCDB);
+      initCdfs(vecfSignImpXYSigCharmJetMcCCDB, vecCdfSignImpXYSigCharmJetMcCCDB);
+      initCdfs(vecfSignImpXYSigBeautyJetMcCCDB, vecCdfSignImpXYSigBeautyJetMcCCDB);
+      initCdfs(vecfSignImpXYSigLfJetMcCCDB, vecCdfSignImpXYSigLfJetMcCCDB);
+    }
+
     // Use QA for effectivness of track probability
     if (trackProbQA) {
       AxisSpec trackProbabilityAxis = {binTrackProbability, "Track proability"};
@@ -195,14 +195,14 @@ struct JetChCorr {
 
       for (unsigned int j = 0; j < constituents1.size(); j++) {
         // cout<<constituents1[j].user_index()-1<<", ";
-        if ((n_trackL == (constituents1[j].user_index() - 1)) || (trackL == (constituents1[j].user_index() - 1)))
+        if ((n_trackL == fastjetutilities::getConstituentIndex(constituents1[j])) || (trackL == fastjetutilities::getConstituentIndex(constituents1[j])))
           found1 = true;
       }
       // cout<<endl;
       // cout<<"in subJET2 ********************************************* "<<endl;
       for (unsigned int j = 0; j < constituents2.size(); j++) {
         // cout<<constituents2[j].user_index()-1<<", ";
-        if ((n_trackL == constituents2[j].user_index() - 1) || (trackL == constituents2[j].user_index() - 1))
+        if ((n_trackL == fastjetutilities::getConstituentIndex(constituents2[j])) || (trackL == fastjetutilities::getConstituentIndex(constituents2[j])))
           found2 = true;
       }
       // cout<<endl;
@@ -209,7 +209,7 @@ struct JetSubstructureHFTask {
 
       int nHFInSubjet1 = 0;
       for (auto& subjet1Constituent : parentSubJet1.constituents()) {
-        if (subjet1Constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidate)) {
+        if (fastjetutilities::getConstituentStatus(subjet1Constituent) == static_cast<int>(JetConstituentStatus::candidate)) {
           nHFInSubjet1++;
         }
       }
@@ -231,11 +231,11 @@ struct JetSubstructureHFTask {
       std::vector<int32_t> candidates;
       std::vector<int32_t> clusters;
       for (const auto& constituent : sorted_by_pt(parentSubJet2.constituents())) {
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
-          tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+        if (fastjetutilities::getConstituentStatus(constituent) == static_cast<int>(JetConstituentStatus::track)) {
+          tracks.push_back(fastjetutilities::getConstituentIndex(constituent));
         }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidate)) {
-          candidates.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+        if (fastjetutilities::getConstituentStatus(constituent) == static_cast<int>(JetConstituentStatus::candidate)) {
+          candidates.push_back(fastjetutilities::getConstituentIndex(constituent));
         }
       }
       splittingTable(jet.globalIndex(), tracks, clusters, candidates, parentSubJet2.perp(), parentSubJet2.eta(), parentSubJet2.phi(), 0);
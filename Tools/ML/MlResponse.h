@@ -17,16 +17,22 @@
 #ifndef TOOLS_ML_MLRESPONSE_H_
 #define TOOLS_ML_MLRESPONSE_H_
 
+#include "Tools/ML/TreeEnsembleModel.h"
 #include "Tools/ML/model.h"
 
 #include <CCDB/CcdbApi.h>
 #include <Framework/Array2D.h>
 #include <Framework/Logger.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <map>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace o2
@@ -43,6 +49,34 @@ enum CutDirection {
 
 namespace analysis
 {
+/// Writer of input features into a preallocated row (e.g. of a batch matrix)
+/// It exposes the same emplace_back interface as the std::vector filled by the getInputFeatures methods, without heap allocation
+/// \note The row must be large enough to host all the configured input features
+template <typename T = float>
+class MlFeatureRow
+{
+ public:
+  explicit MlFeatureRow(std::span<T> row) : mRow(row) {}
+
+  template <typename U>
+  void emplace_back(U const& value)
+  {
+    mRow[mSize++] = static_cast<T>(value);
+  }
+
+  std::size_t size() const { return mSize; }
+
+ private:
+  std::span<T> mRow;     // row to be filled
+  std::size_t mSize = 0; // number of features written so far
+};
+
+/// Table of accessors to the input features, indexed by the input-feature enumerator (as stored in mCachedIndices)
+/// Each accessor returns the value of one feature from the arguments of the getInputFeatures methods (candidate, prongs, ...)
+/// Features not available for a given set of arguments have no accessor (nullptr)
+template <typename... TArgs>
+using MlFeatureAccessors = std::array<float (*)(TArgs const&...), std::numeric_limits<uint8_t>::max() + 1>;
+
 // TypeOutputScore is the type of the output score from o2::ml::OnnxModel (float by default)
 template <typename TypeOutputScore = float>
 class MlResponse
@@ -71,6 +105,7 @@ class MlResponse
     mNModels = binsLimits.size() - 1;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
     mPaths = std::vector<std::string>(mNModels);
+    mUseTreeModel.assign(mNModels, 0);
   }
 
   /// Configure class instance (import configurables)
@@ -96,6 +131,7 @@ class MlResponse
     mNModels = mNVar1Bins * mNVar2Bins;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
     mPaths = std::vector<std::string>(mNModels);
+    mUseTreeModel.assign(mNModels, 0);
 
     mUse2DBinning = true;
   }
@@ -148,11 +184,25 @@ class MlResponse
   /// Initialize class instance (initialize OnnxModels)
   /// \param enableOptimizations is a switch to enable optimizations
   /// \param threads is the number of active threads
-  void init(bool enableOptimizations = false, int threads = 0)
+  /// \param useNativeTreeEnsemble is a switch to evaluate single tree-ensemble models (e.g. BDTs) natively instead of with ONNX Runtime (opt-in)
+  /// \note The native evaluation is enabled only for models whose output agrees with ONNX Runtime on a set of probe inputs
+  void init(bool enableOptimizations = false, int threads = 0, bool useNativeTreeEnsemble = false)
   {
+    mTreeModels = std::vector<o2::ml::TreeEnsembleModel>(mNModels);
+    mUseTreeModel.assign(mNModels, 0);
     uint8_t counterModel{0};
     for (const auto& path : mPaths) {
       mModels[counterModel].initModel(path, enableOptimizations, threads);
+      if constexpr (std::is_same_v<TypeOutputScore, float>) {
+        if (useNativeTreeEnsemble && mTreeModels[counterModel].initModel(path)) {
+          if (mTreeModels[counterModel].getNumOutputNodes() >= mNClasses && mTreeModels[counterModel].validate(mModels[counterModel])) {
+            mUseTreeModel[counterModel] = 1;
+            LOG(info) << "Model " << static_cast<int>(counterModel) << " (" << path << ") evaluated with the native tree-ensemble backend";
+          } else {
+            LOG(warning) << "Native tree-ensemble evaluation of " << path << " not validated, falling back to ONNX Runtime";
+          }
+        }
+      }
       ++counterModel;
     }
   }
@@ -162,6 +212,7 @@ class MlResponse
   void cacheInputFeaturesIndices(std::vector<std::string> const& cfgInputFeatures)
   {
     setAvailableInputFeatures();
+    mCheckedAccessors = nullptr;
     for (const auto& inputFeature : cfgInputFeatures) {
       if (mAvailableInputFeatures.count(inputFeature)) {
         mCachedIndices.emplace_back(mAvailableInputFeatures[inputFeature]);
@@ -182,6 +233,18 @@ class MlResponse
       LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
     }
 
+    if constexpr (std::is_same_v<TypeOutputScore, float>) {
+      if (static_cast<std::size_t>(nModel) < mUseTreeModel.size() && mUseTreeModel[nModel]) {
+        if (input.size() < static_cast<std::size_t>(mTreeModels[nModel].getNumFeaturesUsed())) {
+          LOG(fatal) << "Number of input features (" << input.size() << ") smaller than the number used by model " << nModel << " (" << mTreeModels[nModel].getNumFeaturesUsed() << ")!";
+        }
+        std::vector<TypeOutputScore> output(mTreeModels[nModel].getNumOutputNodes());
+        mTreeModels[nModel].evalModel(input.data(), output.data());
+        output.resize(mNClasses);
+        return output;
+      }
+    }
+
     TypeOutputScore* outputPtr = mModels[nModel].template evalModel<TypeOutputScore>(input);
     return std::vector<TypeOutputScore>{outputPtr, outputPtr + mNClasses};
   }
@@ -195,20 +258,7 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     auto output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
-    }
-    return true;
+    return passCuts(output.data(), nModel);
   }
 
   /// ML selections
@@ -221,20 +271,7 @@ class MlResponse
   {
     int nModel = findBin(candVar);
     output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
-    }
-    return true;
+    return passCuts(output.data(), nModel);
   }
 
   /// ML selections
@@ -251,24 +288,48 @@ class MlResponse
     }
     int nModel = findBin2D(candVar1, candVar2);
     output = getModelOutput(input, nModel);
-    uint8_t iClass{0};
-    for (const auto& outputValue : output) {
-      uint8_t dir = mCutDir.at(iClass);
-      if (dir != o2::cuts_ml::CutDirection::CutNot) {
-        if (dir == o2::cuts_ml::CutDirection::CutGreater && outputValue > mCuts.get(nModel, iClass)) {
-          return false;
-        }
-        if (dir == o2::cuts_ml::CutDirection::CutSmaller && outputValue < mCuts.get(nModel, iClass)) {
-          return false;
-        }
-      }
-      ++iClass;
+    return passCuts(output.data(), nModel);
+  }
+
+  /// Batched ML selections for all the candidates of a dataframe
+  /// \param inputs is a contiguous row-major matrix with the input features of all candidates (one row per candidate)
+  /// \param candVars is the variable value (e.g. pT) of each candidate used to select which model to use
+  /// \param outputs is filled with the model output of all candidates (mNClasses scores per candidate, in candidate order)
+  /// \param isSelected is filled with the outcome of the selections for each candidate
+  /// \note Candidates are grouped by model bin and one inference is run per bin
+  template <typename T>
+  void isSelectedMlBatch(std::vector<TypeOutputScore>& inputs, const std::vector<T>& candVars, std::vector<TypeOutputScore>& outputs, std::vector<uint8_t>& isSelected)
+  {
+    mBatchBins.resize(candVars.size());
+    for (std::size_t iCand{0}; iCand < candVars.size(); ++iCand) {
+      mBatchBins[iCand] = findBin(candVars[iCand]);
     }
-    return true;
+    evalBatch(inputs, outputs, isSelected);
+  }
+
+  /// Batched ML selections for all the candidates of a dataframe with 2D model binning
+  /// \param inputs is a contiguous row-major matrix with the input features of all candidates (one row per candidate)
+  /// \param candVars1 is the first variable value (e.g. pT) of each candidate used to select which model to use
+  /// \param candVars2 is the second variable value (e.g. multiplicity) of each candidate used to select which model to use
+  /// \param outputs is filled with the model output of all candidates (mNClasses scores per candidate, in candidate order)
+  /// \param isSelected is filled with the outcome of the selections for each candidate
+  template <typename T1, typename T2>
+  void isSelectedMlBatch(std::vector<TypeOutputScore>& inputs, const std::vector<T1>& candVars1, const std::vector<T2>& candVars2, std::vector<TypeOutputScore>& outputs, std::vector<uint8_t>& isSelected)
+  {
+    if (candVars1.size() != candVars2.size()) {
+      LOG(fatal) << "Number of candidates in the two binning variables differs (" << candVars1.size() << " vs " << candVars2.size() << ")!";
+    }
+    mBatchBins.resize(candVars1.size());
+    for (std::size_t iCand{0}; iCand < candVars1.size(); ++iCand) {
+      mBatchBins[iCand] = findBin2D(candVars1[iCand], candVars2[iCand]);
+    }
+    evalBatch(inputs, outputs, isSelected);
   }
 
  protected:
   std::vector<o2::ml::OnnxModel> mModels;                 // OnnxModel objects, one for each bin
+  std::vector<o2::ml::TreeEnsembleModel> mTreeModels;     // native tree-ensemble evaluators, one for each bin
+  std::vector<uint8_t> mUseTreeModel;                     // whether the native tree-ensemble evaluator is used, one for each bin
   uint8_t mNModels = 1;                                   // number of bins
   uint8_t mNClasses = 3;                                  // number of model classes
   std::vector<double> mBinsLimits = {};                   // bin limits of the variable (e.g. pT) used to select which model to use
@@ -281,10 +342,162 @@ class MlResponse
   uint8_t mNVar1Bins = 1;                                 // number of bins of the first variable (e.g. pT) used to select which model to use
   uint8_t mNVar2Bins = 1;                                 // number of bins of the second variable (e.g. multiplicity) used to select which model to use
   bool mUse2DBinning = false;                             // switch to enable/disable 2D binning
+  std::vector<int> mBatchBins;                            // model bin of each candidate in the current batch
+  std::vector<std::size_t> mBatchOffsets;                 // first position of each model bin in mBatchOrder
+  std::vector<std::size_t> mBatchFillPos;                 // next free position of each model bin in mBatchOrder
+  std::vector<std::size_t> mBatchOrder;                   // candidate indices sorted by model bin
+  std::vector<TypeOutputScore> mBatchInputs;              // input features of the candidates of one model bin
+  std::vector<TypeOutputScore> mBatchOutputs;             // model output of the candidates of one model bin
+  const void* mCheckedAccessors = nullptr;                // table of accessors last checked against the configured input features
 
   virtual void setAvailableInputFeatures() { return; } // method to fill the map of available input features
 
+  /// Method to get the input features vector needed for ML inference from a table of accessors
+  /// \param accessors is the table of accessors to the input features of the derived class
+  /// \param args are the arguments of the accessors (candidate, prongs, ...)
+  /// \return inputFeatures vector
+  template <typename... TArgs>
+  std::vector<float> getInputFeaturesFromAccessors(MlFeatureAccessors<TArgs...> const& accessors, std::type_identity_t<TArgs> const&... args)
+  {
+    std::vector<float> inputFeatures;
+    inputFeatures.reserve(mCachedIndices.size());
+    fillInputFeaturesFromAccessors(inputFeatures, accessors, args...);
+    return inputFeatures;
+  }
+
+  /// Method to write the input features needed for ML inference into a preallocated row without heap allocation
+  /// \param row is the row to be filled (e.g. of a batch matrix), with at least as many elements as the configured input features
+  /// \param accessors is the table of accessors to the input features of the derived class
+  /// \param args are the arguments of the accessors (candidate, prongs, ...)
+  template <typename... TArgs>
+  void getInputFeaturesFromAccessors(std::span<float> row, MlFeatureAccessors<TArgs...> const& accessors, std::type_identity_t<TArgs> const&... args)
+  {
+    if (row.size() < mCachedIndices.size()) {
+      LOG(fatal) << "Row of size " << row.size() << " too small for " << mCachedIndices.size() << " input features";
+    }
+    MlFeatureRow<float> inputFeatures(row);
+    fillInputFeaturesFromAccessors(inputFeatures, accessors, args...);
+  }
+
  private:
+  /// Fills the configured input features into a container exposing emplace_back (std::vector or MlFeatureRow)
+  /// \note The configured features are checked against the table of accessors only when the table changes, the loop over the features has no branch
+  template <typename TypeInputFeatures, typename... TArgs>
+  void fillInputFeaturesFromAccessors(TypeInputFeatures& inputFeatures, MlFeatureAccessors<TArgs...> const& accessors, TArgs const&... args)
+  {
+    if (mCheckedAccessors != &accessors) {
+      for (const auto& idx : mCachedIndices) {
+        if (accessors[idx] == nullptr) {
+          LOG(fatal) << "Input feature with index " << static_cast<int>(idx) << " not available for this candidate type! Please check your configurables.";
+        }
+      }
+      mCheckedAccessors = &accessors;
+    }
+    for (const auto& idx : mCachedIndices) {
+      inputFeatures.emplace_back(accessors[idx](args...));
+    }
+  }
+
+  /// Applies the cuts of a given model bin to its output scores
+  /// \param scores is a pointer to the mNClasses scores of the candidate
+  /// \param nModel is the model index
+  /// \return boolean telling if model predictions pass the cuts
+  bool passCuts(const TypeOutputScore* scores, const int nModel) const
+  {
+    for (uint8_t iClass{0}; iClass < mNClasses; ++iClass) {
+      uint8_t dir = mCutDir.at(iClass);
+      if (dir == o2::cuts_ml::CutDirection::CutGreater && scores[iClass] > mCuts.get(nModel, iClass)) {
+        return false;
+      }
+      if (dir == o2::cuts_ml::CutDirection::CutSmaller && scores[iClass] < mCuts.get(nModel, iClass)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Runs one inference per model bin on the candidates whose bins are stored in mBatchBins
+  /// \param inputs is a contiguous row-major matrix with the input features of all candidates
+  /// \param outputs is filled with the model output of all candidates (mNClasses scores per candidate)
+  /// \param isSelected is filled with the outcome of the selections for each candidate
+  /// \note Candidates outside the bin limits are not evaluated: they are not selected and their scores are left at 0
+  void evalBatch(std::vector<TypeOutputScore>& inputs, std::vector<TypeOutputScore>& outputs, std::vector<uint8_t>& isSelected)
+  {
+    const std::size_t nCands = mBatchBins.size();
+    outputs.assign(nCands * mNClasses, TypeOutputScore{0});
+    isSelected.assign(nCands, 0);
+    if (nCands == 0) {
+      return;
+    }
+    if (inputs.size() % nCands != 0) {
+      LOG(fatal) << "Size of the input matrix (" << inputs.size() << ") is not a multiple of the number of candidates (" << nCands << ")!";
+    }
+    const std::size_t nFeatures = inputs.size() / nCands;
+
+    // counting sort of the candidates by model bin, candidates outside the bin limits (bin -1) are not selected
+    mBatchOffsets.assign(mModels.size() + 1, 0);
+    for (const auto& nModel : mBatchBins) {
+      if (nModel < 0) {
+        continue;
+      }
+      if (static_cast<std::size_t>(nModel) >= mModels.size()) {
+        LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
+      }
+      ++mBatchOffsets[nModel + 1];
+    }
+    for (std::size_t iModel{0}; iModel < mModels.size(); ++iModel) {
+      mBatchOffsets[iModel + 1] += mBatchOffsets[iModel];
+    }
+    mBatchOrder.resize(mBatchOffsets.back());
+    mBatchFillPos.assign(mBatchOffsets.begin(), mBatchOffsets.end() - 1);
+    for (std::size_t iCand{0}; iCand < nCands; ++iCand) {
+      if (mBatchBins[iCand] < 0) {
+        continue;
+      }
+      mBatchOrder[mBatchFillPos[mBatchBins[iCand]]++] = iCand;
+    }
+
+    for (std::size_t iModel{0}; iModel < mModels.size(); ++iModel) {
+      const std::size_t first = mBatchOffsets[iModel];
+      const std::size_t nRows = mBatchOffsets[iModel + 1] - first;
+      if (nRows == 0) {
+        continue;
+      }
+      TypeOutputScore* modelInputs = nullptr;
+      if (nRows == nCands) {
+        modelInputs = inputs.data(); // single bin populated: the input matrix is already contiguous
+      } else {
+        mBatchInputs.resize(nRows * nFeatures);
+        for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+          const auto* row = inputs.data() + mBatchOrder[first + iRow] * nFeatures;
+          std::copy(row, row + nFeatures, mBatchInputs.data() + iRow * nFeatures);
+        }
+        modelInputs = mBatchInputs.data();
+      }
+      bool evaluated{false};
+      if constexpr (std::is_same_v<TypeOutputScore, float>) {
+        if (iModel < mUseTreeModel.size() && mUseTreeModel[iModel]) {
+          mBatchOutputs.resize(nRows * mTreeModels[iModel].getNumOutputNodes());
+          mTreeModels[iModel].evalModel(modelInputs, static_cast<int64_t>(nRows), static_cast<int64_t>(nFeatures), mBatchOutputs.data());
+          evaluated = true;
+        }
+      }
+      if (!evaluated && !mModels[iModel].template evalModel<TypeOutputScore>(modelInputs, static_cast<int64_t>(nRows), mBatchOutputs)) {
+        LOG(fatal) << "Batched inference failed for model " << iModel << "!";
+      }
+      if (mBatchOutputs.size() < nRows * mNClasses) {
+        LOG(fatal) << "Model " << iModel << " returned " << mBatchOutputs.size() << " scores for " << nRows << " candidates and " << static_cast<int>(mNClasses) << " classes!";
+      }
+      const std::size_t stride = mBatchOutputs.size() / nRows;
+      for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+        const std::size_t iCand = mBatchOrder[first + iRow];
+        const TypeOutputScore* scores = mBatchOutputs.data() + iRow * stride;
+        std::copy(scores, scores + mNClasses, outputs.data() + iCand * mNClasses);
+        isSelected[iCand] = passCuts(scores, static_cast<int>(iModel));
+      }
+    }
+  }
+
   /// Finds matching bin in mBinsLimits
   /// \param value e.g. pT
   /// \return index of the matching bin, used to access mModels
@@ -0,0 +1,688 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     TreeEnsembleModel.cxx
+///
+/// \brief    Native evaluator for ONNX models made of a single TreeEnsembleClassifier/TreeEnsembleRegressor node
+///
+
+#include "Tools/ML/TreeEnsembleModel.h"
+
+#include "Tools/ML/model.h"
+
+#include <Framework/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+/// Minimal reader of the protobuf wire format, sufficient to extract the graph nodes and their attributes
+class ProtoReader
+{
+ public:
+  ProtoReader(const char* begin, const char* end) : mPos(begin), mEnd(end) {}
+
+  bool atEnd() const { return mPos >= mEnd || !mGood; }
+  bool good() const { return mGood; }
+
+  /// Reads the next field key
+  /// \return false at the end of the message
+  bool next(uint32_t& field, uint32_t& wireType)
+  {
+    if (atEnd()) {
+      return false;
+    }
+    const uint64_t key = readVarint();
+    field = static_cast<uint32_t>(key >> 3);
+    wireType = static_cast<uint32_t>(key & 0x7);
+    return mGood;
+  }
+
+  uint64_t readVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (mPos >= mEnd) {
+        mGood = false;
+        return 0;
+      }
+      const auto byte = static_cast<uint8_t>(*mPos++);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    mGood = false;
+    return 0;
+  }
+
+  float readFixed32Float()
+  {
+    float value = 0.f;
+    if (mEnd - mPos < 4) {
+      mGood = false;
+      return value;
+    }
+    std::memcpy(&value, mPos, sizeof(float));
+    mPos += 4;
+    return value;
+  }
+
+  /// Reads a length-delimited payload and returns a reader on it
+  ProtoReader readSubMessage()
+  {
+    const uint64_t length = readVarint();
+    if (!mGood || length > static_cast<uint64_t>(mEnd - mPos)) {
+      mGood = false;
+      return ProtoReader(mEnd, mEnd);
+    }
+    ProtoReader sub(mPos, mPos + length);
+    mPos += length;
+    return sub;
+  }
+
+  std::string readString()
+  {
+    ProtoReader sub = readSubMessage();
+    return std::string(sub.mPos, sub.mEnd);
+  }
+
+  void skip(const uint32_t wireType)
+  {
+    switch (wireType) {
+      case 0:
+        readVarint();
+        break;
+      case 1:
+        mPos += 8;
+        break;
+      case 2:
+        readSubMessage();
+        break;
+      case 5:
+        mPos += 4;
+        break;
+      default:
+        mGood = false;
+    }
+    if (mPos > mEnd) {
+      mGood = false;
+    }
+  }
+
+ private:
+  const char* mPos;
+  const char* mEnd;
+  bool mGood = true;
+};
+
+/// Attribute of an ONNX node, restricted to the types used by the tree ensembles
+struct Attribute {
+  std::string s;
+  int64_t i = 0;
+  std::vector<float> floats;
+  std::vector<int64_t> ints;
+  std::vector<std::string> strings;
+  bool hasTensor = false;
+};
+
+struct Node {
+  std::string opType;
+  std::string domain;
+  std::map<std::string, Attribute> attributes;
+};
+
+void parseAttribute(ProtoReader reader, std::string& name, Attribute& attribute)
+{
+  uint32_t field, wireType;
+  while (reader.next(field, wireType)) {
+    if (field == 1 && wireType == 2) { // name
+      name = reader.readString();
+    } else if (field == 3 && wireType == 0) { // i
+      attribute.i = static_cast<int64_t>(reader.readVarint());
+    } else if (field == 4 && wireType == 2) { // s
+      attribute.s = reader.readString();
+    } else if (field == 5 || field == 10) { // t, tensors
+      attribute.hasTensor = true;
+      reader.skip(wireType);
+    } else if (field == 7 && wireType == 2) { // floats (packed)
+      ProtoReader packed = reader.readSubMessage();
+      while (!packed.atEnd()) {
+        attribute.floats.push_back(packed.readFixed32Float());
+      }
+    } else if (field == 7 && wireType == 5) { // floats (unpacked)
+      attribute.floats.push_back(reader.readFixed32Float());
+    } else if (field == 8 && wireType == 2) { // ints (packed)
+      ProtoReader packed = reader.readSubMessage();
+      while (!packed.atEnd()) {
+        attribute.ints.push_back(static_cast<int64_t>(packed.readVarint()));
+      }
+    } else if (field == 8 && wireType == 0) { // ints (unpacked)
+      attribute.ints.push_back(static_cast<int64_t>(reader.readVarint()));
+    } else if (field == 9 && wireType == 2) { // strings
+      attribute.strings.push_back(reader.readString());
+    } else {
+      reader.skip(wireType);
+    }
+  }
+}
+
+void parseNode(ProtoReader reader, Node& node)
+{
+  uint32_t field, wireType;
+  while (reader.next(field, wireType)) {
+    if (field == 4 && wireType == 2) { // op_type
+      node.opType = reader.readString();
+    } else if (field == 7 && wireType == 2) { // domain
+      node.domain = reader.readString();
+    } else if (field == 5 && wireType == 2) { // attribute
+      std::string name;
+      Attribute attribute;
+      parseAttribute(reader.readSubMessage(), name, attribute);
+      node.attributes[name] = std::move(attribute);
+    } else {
+      reader.skip(wireType);
+    }
+  }
+}
+
+/// Extracts the nodes of the main graph of an ONNX ModelProto
+bool parseGraphNodes(const std::string& buffer, std::vector<Node>& nodes)
+{
+  ProtoReader model(buffer.data(), buffer.data() + buffer.size());
+  uint32_t field, wireType;
+  bool foundGraph = false;
+  while (model.next(field, wireType)) {
+    if (field == 7 && wireType == 2) { // graph
+      foundGraph = true;
+      ProtoReader graph = model.readSubMessage();
+      while (graph.next(field, wireType)) {
+        if (field == 1 && wireType == 2) { // node
+          nodes.emplace_back();
+          parseNode(graph.readSubMessage(), nodes.back());
+        } else {
+          graph.skip(wireType);
+        }
+      }
+      if (!graph.good()) {
+        return false;
+      }
+    } else {
+      model.skip(wireType);
+    }
+  }
+  return foundGraph && model.good();
+}
+
+/// Same logistic function as ONNX Runtime, symmetric for numerical stability
+inline float computeLogistic(const float value)
+{
+  const float v = 1.f / (1.f + std::exp(-std::abs(value)));
+  return value < 0 ? 1.f - v : v;
+}
+
+} // namespace
+
+namespace o2
+{
+
+namespace ml
+{
+
+bool TreeEnsembleModel::initModel(const std::string& localPath)
+{
+  mInitialised = false;
+
+  std::ifstream file(localPath, std::ios::binary);
+  if (!file) {
+    LOG(warning) << "TreeEnsembleModel: cannot open " << localPath;
+    return false;
+  }
+  const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  std::vector<Node> nodes;
+  if (!parseGraphNodes(buffer, nodes)) {
+    LOG(info) << "TreeEnsembleModel: " << localPath << " could not be parsed as an ONNX model";
+    return false;
+  }
+
+  // the graph must contain exactly one tree ensemble, the other nodes must not modify the scores
+  const Node* ensemble = nullptr;
+  for (const auto& node : nodes) {
+    if (node.opType == "TreeEnsembleClassifier" || node.opType == "TreeEnsembleRegressor") {
+      if (ensemble != nullptr) {
+        LOG(info) << "TreeEnsembleModel: more than one tree ensemble in the graph";
+        return false;
+      }
+      ensemble = &node;
+    } else if (node.opType != "Identity" && node.opType != "Cast") {
+      LOG(info) << "TreeEnsembleModel: unsupported operator " << node.opType << " in the graph";
+      return false;
+    }
+  }
+  if (ensemble == nullptr) {
+    LOG(info) << "TreeEnsembleModel: no tree ensemble in the graph";
+    return false;
+  }
+  mIsClassifier = (ensemble->opType == "TreeEnsembleClassifier");
+  const std::string prefix = mIsClassifier ? "class_" : "target_";
+
+  static const Attribute emptyAttribute;
+  auto getAttribute = [&ensemble](const std::string& name) -> const Attribute& {
+    auto it = ensemble->attributes.find(name);
+    return it == ensemble->attributes.end() ? emptyAttribute : it->second;
+  };
+  for (const auto& [name, attribute] : ensemble->attributes) {
+    if (attribute.hasTensor) {
+      LOG(info) << "TreeEnsembleModel: tensor attribute " << name << " not supported";
+      return false;
+    }
+  }
+
+  const auto& nodesTreeIds = getAttribute("nodes_treeids").ints;
+  const auto& nodesNodeIds = getAttribute("nodes_nodeids").ints;
+  const auto& nodesFeatureIds = getAttribute("nodes_featureids").ints;
+  const auto& nodesValues = getAttribute("nodes_values").floats;
+  const auto& nodesModes = getAttribute("nodes_modes").strings;
+  const auto& nodesTrueIds = getAttribute("nodes_truenodeids").ints;
+  const auto& nodesFalseIds = getAttribute("nodes_falsenodeids").ints;
+  const auto& nodesMissingTrue = getAttribute("nodes_missing_value_tracks_true").ints;
+  const auto& weightsTreeIds = getAttribute(prefix + "treeids").ints;
+  const auto& weightsNodeIds = getAttribute(prefix + "nodeids").ints;
+  const auto& weightsIds = getAttribute(prefix + "ids").ints;
+  const auto& weightsValues = getAttribute(prefix + "weights").floats;
+
+  const std::size_t nNodes = nodesTreeIds.size();
+  if (nNodes == 0 || nodesNodeIds.size() != nNodes || nodesFeatureIds.size() != nNodes || nodesValues.size() != nNodes || nodesModes.size() != nNodes || nodesTrueIds.size() != nNodes || nodesFalseIds.size() != nNodes || (!nodesMissingTrue.empty() && nodesMissingTrue.size() != nNodes)) {
+    LOG(info) << "TreeEnsembleModel: inconsistent node attributes";
+    return false;
+  }
+  const std::size_t nWeights = weightsTreeIds.size();
+  if (weightsNodeIds.size() != nWeights || weightsIds.size() != nWeights || weightsValues.size() != nWeights) {
+    LOG(info) << "TreeEnsembleModel: inconsistent leaf-weight attributes";
+    return false;
+  }
+
+  // post transform
+  const std::string postTransform = getAttribute("post_transform").s;
+  if (postTransform.empty() || postTransform == "NONE") {
+    mPostTransform = PostTransform::None;
+  } else if (postTransform == "LOGISTIC") {
+    mPostTransform = PostTransform::Logistic;
+  } else if (postTransform == "SOFTMAX") {
+    mPostTransform = PostTransform::Softmax;
+  } else if (postTransform == "SOFTMAX_ZERO") {
+    mPostTransform = PostTransform::SoftmaxZero;
+  } else {
+    LOG(info) << "TreeEnsembleModel: unsupported post transform " << postTransform;
+    return false;
+  }
+
+  // number of classes/targets and aggregation
+  mBaseValues = getAttribute("base_values").floats;
+  if (mIsClassifier) {
+    const auto& labelsInt = getAttribute("classlabels_int64s").ints;
+    const auto& labelsString = getAttribute("classlabels_strings").strings;
+    mNTargets = static_cast<int>(labelsInt.empty() ? labelsString.size() : labelsInt.size());
+  } else {
+    mNTargets = static_cast<int>(getAttribute("n_targets").i);
+    const std::string aggregate = getAttribute("aggregate_function").s;
+    if (aggregate == "AVERAGE") {
+      mAverage = true;
+    } else if (!aggregate.empty() && aggregate != "SUM") {
+      LOG(info) << "TreeEnsembleModel: unsupported aggregate function " << aggregate;
+      return false;
+    }
+  }
+  if (mNTargets < 1 || mNTargets > MaxTargets) {
+    LOG(info) << "TreeEnsembleModel: unsupported number of classes/targets " << mNTargets;
+    return false;
+  }
+  if (!mBaseValues.empty() && mBaseValues.size() != static_cast<std::size_t>(mNTargets) && !(mIsClassifier && mNTargets == 2 && mBaseValues.size() == 1)) {
+    LOG(info) << "TreeEnsembleModel: unexpected number of base values " << mBaseValues.size();
+    return false;
+  }
+
+  // binary classification with weights for a single class
+  mBinaryCase = false;
+  mPositiveWeights = true;
+  if (mIsClassifier && mNTargets == 2) {
+    bool hasClass0{false}, hasClass1{false};
+    for (std::size_t iWeight{0}; iWeight < nWeights; ++iWeight) {
+      hasClass0 |= (weightsIds[iWeight] == 0);
+      hasClass1 |= (weightsIds[iWeight] == 1);
+      mPositiveWeights &= (weightsValues[iWeight] >= 0.f);
+    }
+    if (hasClass1 && !hasClass0) {
+      LOG(info) << "TreeEnsembleModel: binary classifier with weights for the second class only not supported";
+      return false;
+    }
+    mBinaryCase = !hasClass1;
+    if (!mBinaryCase && mBaseValues.size() == 2) {
+      LOG(info) << "TreeEnsembleModel: two-class classifier with two base values not supported";
+      return false;
+    }
+  }
+  mNOutputs = mNTargets;
+  if (!mIsClassifier && mNTargets == 1) {
+    mPostTransform = PostTransform::None; // ONNX Runtime does not transform single-target regressions
+  }
+
+  // index of each node by (tree, node) identifiers
+  std::map<std::pair<int64_t, int64_t>, int32_t> nodeIndex;
+  for (std::size_t iNode{0}; iNode < nNodes; ++iNode) {
+    nodeIndex[{nodesTreeIds[iNode], nodesNodeIds[iNode]}] = static_cast<int32_t>(iNode);
+  }
+  std::vector<std::vector<int32_t>> leafWeightIndices(nNodes);
+  for (std::size_t iWeight{0}; iWeight < nWeights; ++iWeight) {
+    auto it = nodeIndex.find({weightsTreeIds[iWeight], weightsNodeIds[iWeight]});
+    if (it == nodeIndex.end() || weightsIds[iWeight] < 0 || weightsIds[iWeight] >= mNTargets) {
+      LOG(info) << "TreeEnsembleModel: leaf weight pointing to an unknown node or class";
+      return false;
+    }
+    leafWeightIndices[it->second].push_back(static_cast<int32_t>(iWeight));
+  }
+
+  // children of each node, roots are the nodes which are not a child of any other node
+  std::vector<int32_t> trueChild(nNodes, -1), falseChild(nNodes, -1);
+  std::vector<bool> isLeaf(nNodes, false), isChild(nNodes, false);
+  for (std::size_t iNode{0}; iNode < nNodes; ++iNode) {
+    const std::string& mode = nodesModes[iNode];
+    if (mode == "LEAF") {
+      isLeaf[iNode] = true;
+      continue;
+    }
+    if (mode != "BRANCH_LEQ" && mode != "BRANCH_LT" && mode != "BRANCH_GTE" && mode != "BRANCH_GT") {
+      LOG(info) << "TreeEnsembleModel: unsupported node mode " << mode;
+      return false;
+    }
+    auto itTrue = nodeIndex.find({nodesTreeIds[iNode], nodesTrueIds[iNode]});
+    auto itFalse = nodeIndex.find({nodesTreeIds[iNode], nodesFalseIds[iNode]});
+    if (itTrue == nodeIndex.end() || itFalse == nodeIndex.end() || nodesFeatureIds[iNode] < 0) {
+      LOG(info) << "TreeEnsembleModel: inconsistent tree structure";
+      return false;
+    }
+    trueChild[iNode] = itTrue->second;
+    falseChild[iNode] = itFalse->second;
+    isChild[itTrue->second] = true;
+    isChild[itFalse->second] = true;
+  }
+
+  // flatten the trees in depth-first order, normalising all the splits to x < t or x <= t
+  mFeature.clear();
+  mThreshold.clear();
+  mTrueNode.clear();
+  mFalseNode.clear();
+  mFlags.clear();
+  mRoots.clear();
+  mLeafOffsets.assign(1, 0);
+  mLeafTargets.clear();
+  mLeafWeights.clear();
+  mNFeaturesUsed = 0;
+  std::vector<int32_t> newIndex(nNodes, -1);
+  std::vector<int32_t> stack;
+  for (std::size_t iRoot{0}; iRoot < nNodes; ++iRoot) {
+    if (isChild[iRoot]) {
+      continue;
+    }
+    mRoots.push_back(static_cast<int32_t>(mFeature.size()));
+    stack.assign(1, static_cast<int32_t>(iRoot));
+    while (!stack.empty()) {
+      const int32_t iNode = stack.back();
+      stack.pop_back();
+      if (newIndex[iNode] >= 0) {
+        LOG(info) << "TreeEnsembleModel: node shared between branches, not a tree";
+        return false;
+      }
+      newIndex[iNode] = static_cast<int32_t>(mFeature.size());
+      mThreshold.push_back(nodesValues[iNode]);
+      if (isLeaf[iNode]) {
+        mFeature.push_back(-1);
+        mTrueNode.push_back(static_cast<int32_t>(mLeafOffsets.size()) - 1);
+        mFalseNode.push_back(-1);
+        mFlags.push_back(0);
+        for (const auto& iWeight : leafWeightIndices[iNode]) {
+          mLeafTargets.push_back(static_cast<int32_t>(weightsIds[iWeight]));
+          mLeafWeights.push_back(weightsValues[iWeight]);
+        }
+        mLeafOffsets.push_back(static_cast<int32_t>(mLeafWeights.size()));
+        continue;
+      }
+      const std::string& mode = nodesModes[iNode];
+      const bool swapped = (mode == "BRANCH_GTE" || mode == "BRANCH_GT"); // x >= t is !(x < t), x > t is !(x <= t)
+      const bool missingTrue = !nodesMissingTrue.empty() && nodesMissingTrue[iNode] != 0;
+      uint8_t flags{0};
+      if (mode == "BRANCH_LEQ" || mode == "BRANCH_GT") {
+        flags |= NodeFlags::FlagLessOrEqual;
+      }
+      if (missingTrue != swapped) {
+        flags |= NodeFlags::FlagNanTrue;
+      }
+      mFeature.push_back(static_cast<int32_t>(nodesFeatureIds[iNode]));
+      mFlags.push_back(flags);
+      mNFeaturesUsed = std::max(mNFeaturesUsed, static_cast<int>(nodesFeatureIds[iNode]) + 1);
+      // children indices are patched once they have been placed
+      mTrueNode.push_back(swapped ? falseChild[iNode] : trueChild[iNode]);
+      mFalseNode.push_back(swapped ? trueChild[iNode] : falseChild[iNode]);
+      stack.push_back(mFalseNode.back());
+      stack.push_back(mTrueNode.back());
+    }
+  }
+  for (std::size_t iNode{0}; iNode < mFeature.size(); ++iNode) {
+    if (mFeature[iNode] >= 0) {
+      mTrueNode[iNode] = newIndex[mTrueNode[iNode]];
+      mFalseNode[iNode] = newIndex[mFalseNode[iNode]];
+    }
+  }
+  if (mFeature.size() != nNodes || mRoots.empty()) {
+    LOG(info) << "TreeEnsembleModel: unreachable nodes in the ensemble";
+    return false;
+  }
+
+  LOG(info) << "TreeEnsembleModel: loaded " << ensemble->opType << " from " << localPath << " with " << mRoots.size() << " trees, " << mFeature.size() << " nodes, " << mNFeaturesUsed << " features and " << mNOutputs << " outputs";
+  mInitialised = true;
+  return true;
+}
+
+inline void TreeEnsembleModel::accumulateLeaf(const int32_t leaf, float* scores) const
+{
+  for (int32_t iWeight = mLeafOffsets[leaf]; iWeight < mLeafOffsets[leaf + 1]; ++iWeight) {
+    scores[mLeafTargets[iWeight]] += mLeafWeights[iWeight];
+  }
+}
+
+void TreeEnsembleModel::finalizeScores(float* scores, float* output) const
+{
+  // same conventions as the ONNX Runtime tree-ensemble aggregators
+  if (!mIsClassifier) {
+    const float norm = mAverage ? 1.f / static_cast<float>(mRoots.size()) : 1.f;
+    for (int iTarget{0}; iTarget < mNTargets; ++iTarget) {
+      scores[iTarget] = scores[iTarget] * norm + (mBaseValues.empty() ? 0.f : mBaseValues[iTarget]);
+    }
+  } else if (mBinaryCase && mBaseValues.size() != 2) {
+    const float score = scores[0] + (mBaseValues.empty() ? 0.f : mBaseValues[0]);
+    if (mPositiveWeights) {
+      output[0] = 1.f - score;
+      output[1] = score;
+    } else if (mPostTransform == PostTransform::Logistic) {
+      output[0] = computeLogistic(-score);
+      output[1] = computeLogistic(score);
+    } else if (score > 0.f) {
+      output[0] = -score;
+      output[1] = score;
+    } else {
+      output[0] = score;
+      output[1] = -score;
+    }
+    return;
+  } else if (mBaseValues.size() == static_cast<std::size_t>(mNTargets)) {
+    for (int iTarget{0}; iTarget < mNTargets; ++iTarget) {
+      scores[iTarget] += mBaseValues[iTarget];
+    }
+  } else if (!mBaseValues.empty()) {
+    scores[0] += mBaseValues[0];
+  }
+
+  switch (mPostTransform) {
+    case PostTransform::Logistic:
+      for (int iTarget{0}; iTarget < mNTargets; ++iTarget) {
+        output[iTarget] = computeLogistic(scores[iTarget]);
+      }
+      break;
+    case PostTransform::Softmax:
+    case PostTransform::SoftmaxZero: {
+      const bool skipZeros = (mPostTransform == PostTransform::SoftmaxZero);
+      float maxScore = scores[0];
+      for (int iTarget{1}; iTarget < mNTargets; ++iTarget) {
+        maxScore = std::max(maxScore, scores[iTarget]);
+      }
+      float sum{0.f};
+      for (int iTarget{0}; iTarget < mNTargets; ++iTarget) {
+        output[iTarget] = (skipZeros && scores[iTarget] == 0.f) ? 0.f : std::exp(scores[iTarget] - maxScore);
+        sum += output[iTarget];
+      }
+      for (int iTarget{0}; iTarget < mNTargets; ++iTarget) {
+        output[iTarget] = sum > 0.f ? output[iTarget] / sum : 0.f;
+      }
+      break;
+    }
+    default:
+      std::copy(scores, scores + mNTargets, output);
+  }
+}
+
+void TreeEnsembleModel::evalModel(const float* input, float* output) const
+{
+  float scores[MaxTargets] = {0.f};
+  for (const auto& root : mRoots) {
+    int32_t iNode = root;
+    while (mFeature[iNode] >= 0) {
+      const float value = input[mFeature[iNode]];
+      const float threshold = mThreshold[iNode];
+      const uint8_t flags = mFlags[iNode];
+      const bool goTrue = (value < threshold) | ((value == threshold) & static_cast<bool>(flags & NodeFlags::FlagLessOrEqual)) | (std::isnan(value) & static_cast<bool>(flags & NodeFlags::FlagNanTrue));
+      iNode = goTrue ? mTrueNode[iNode] : mFalseNode[iNode];
+    }
+    accumulateLeaf(mTrueNode[iNode], scores);
+  }
+  finalizeScores(scores, output);
+}
+
+void TreeEnsembleModel::evalModel(const float* input, const int64_t nRows, const int64_t nFeatures, float* output) const
+{
+  if (nFeatures < mNFeaturesUsed) {
+    LOG(fatal) << "TreeEnsembleModel: " << nFeatures << " features provided, while the model uses " << mNFeaturesUsed;
+  }
+
+  // rows are processed in blocks traversed in lockstep, so that independent node loads overlap
+  float scores[NRowsBlock][MaxTargets];
+  int32_t nodes[NRowsBlock];
+  for (int64_t firstRow{0}; firstRow < nRows; firstRow += NRowsBlock) {
+    const int nRowsBlock = static_cast<int>(std::min<int64_t>(NRowsBlock, nRows - firstRow));
+    const float* rows = input + firstRow * nFeatures;
+    for (int iRow{0}; iRow < nRowsBlock; ++iRow) {
+      std::fill(scores[iRow], scores[iRow] + mNTargets, 0.f);
+    }
+    for (const auto& root : mRoots) {
+      for (int iRow{0}; iRow < nRowsBlock; ++iRow) {
+        nodes[iRow] = root;
+      }
+      bool active = true;
+      while (active) {
+        active = false;
+        for (int iRow{0}; iRow < nRowsBlock; ++iRow) {
+          const int32_t iNode = nodes[iRow];
+          const int32_t feature = mFeature[iNode];
+          if (feature < 0) {
+            continue;
+          }
+          const float value = rows[iRow * nFeatures + feature];
+          const float threshold = mThreshold[iNode];
+          const uint8_t flags = mFlags[iNode];
+          const bool goTrue = (value < threshold) | ((value == threshold) & static_cast<bool>(flags & NodeFlags::FlagLessOrEqual)) | (std::isnan(value) & static_cast<bool>(flags & NodeFlags::FlagNanTrue));
+          nodes[iRow] = goTrue ? mTrueNode[iNode] : mFalseNode[iNode];
+          active = true;
+        }
+      }
+      for (int iRow{0}; iRow < nRowsBlock; ++iRow) {
+        accumulateLeaf(mTrueNode[nodes[iRow]], scores[iRow]);
+      }
+    }
+    for (int iRow{0}; iRow < nRowsBlock; ++iRow) {
+      finalizeScores(scores[iRow], output + (firstRow + iRow) * mNOutputs);
+    }
+  }
+}
+
+bool TreeEnsembleModel::validate(OnnxModel& onnxModel, const float tolerance) const
+{
+  if (!mInitialised) {
+    return false;
+  }
+  const int nFeatures = onnxModel.getNumInputNodes();
+  if (nFeatures < mNFeaturesUsed) {
+    LOG(info) << "TreeEnsembleModel: model uses " << mNFeaturesUsed << " features, ONNX input has " << nFeatures;
+    return false;
+  }
+
+  // probe rows with values right at, just below and just above the split thresholds
+  std::vector<std::vector<float>> thresholds(nFeatures);
+  for (std::size_t iNode{0}; iNode < mFeature.size(); ++iNode) {
+    if (mFeature[iNode] >= 0) {
+      thresholds[mFeature[iNode]].push_back(mThreshold[iNode]);
+    }
+  }
+  constexpr int NProbeRows = 64;
+  std::vector<float> probes(NProbeRows * nFeatures, 0.f);
+  uint32_t seed = 12345u;
+  for (int iRow{0}; iRow < NProbeRows; ++iRow) {
+    for (int iFeature{0}; iFeature < nFeatures; ++iFeature) {
+      if (thresholds[iFeature].empty()) {
+        continue;
+      }
+      seed = seed * 1664525u + 1013904223u; // linear congruential generator, reproducible probes
+      const float threshold = thresholds[iFeature][(seed >> 8) % thresholds[iFeature].size()];
+      const int shift = static_cast<int>((seed >> 4) % 3) - 1;
+      probes[iRow * nFeatures + iFeature] = shift == 0 ? threshold : std::nextafter(threshold, shift * INFINITY) + shift * 1.e-3f * std::abs(threshold);
+    }
+  }
+
+  std::vector<float> reference;
+  if (!onnxModel.evalModel<float>(probes.data(), NProbeRows, reference) || reference.size() != static_cast<std::size_t>(NProbeRows * mNOutputs)) {
+    LOG(info) << "TreeEnsembleModel: ONNX Runtime reference output has an unexpected size";
+    return false;
+  }
+  std::vector<float> native(NProbeRows * mNOutputs);
+  evalModel(probes.data(), NProbeRows, nFeatures, native.data());
+  for (std::size_t iValue{0}; iValue < native.size(); ++iValue) {
+    if (!(std::abs(native[iValue] - reference[iValue]) <= tolerance)) {
+      LOG(info) << "TreeEnsembleModel: native output " << native[iValue] << " differs from ONNX Runtime " << reference[iValue];
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace ml
+
+} // namespace o2
@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     TreeEnsembleModel.h
+///
+/// \brief    Native evaluator for ONNX models made of a single TreeEnsembleClassifier/TreeEnsembleRegressor node
+///
+/// The tree-ensemble attributes are read once from the .onnx file and flattened into a
+/// structure-of-arrays node table, which is then traversed without calling ONNX Runtime.
+/// Models that use features not supported here (BRANCH_EQ/NEQ nodes, PROBIT post transform,
+/// tensor-valued attributes, graphs with other operators) are rejected by initModel, so that
+/// the caller can fall back to o2::ml::OnnxModel.
+///
+
+#ifndef TOOLS_ML_TREEENSEMBLEMODEL_H_
+#define TOOLS_ML_TREEENSEMBLEMODEL_H_
+
+#include "Tools/ML/model.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+
+namespace ml
+{
+
+class TreeEnsembleModel
+{
+
+ public:
+  TreeEnsembleModel() = default;
+  ~TreeEnsembleModel() = default;
+
+  /// Reads the tree ensemble from an .onnx file
+  /// \param localPath is the path to the .onnx file
+  /// \return false if the model graph is not a single supported tree ensemble
+  bool initModel(const std::string& localPath);
+
+  /// Evaluates one row of features
+  /// \param input is a pointer to the features of the row
+  /// \param output is a pointer to getNumOutputNodes() values to be filled with the scores
+  void evalModel(const float* input, float* output) const;
+
+  /// Evaluates a batch of rows stored contiguously (row-major)
+  /// \param input is a pointer to nRows x nFeatures values
+  /// \param nRows is the number of rows
+  /// \param nFeatures is the number of features per row (at least getNumFeaturesUsed())
+  /// \param output is a pointer to nRows x getNumOutputNodes() values to be filled with the scores
+  void evalModel(const float* input, const int64_t nRows, const int64_t nFeatures, float* output) const;
+
+  /// Compares the native evaluation with ONNX Runtime on probe rows built around the split thresholds
+  /// \param onnxModel is the same model loaded in ONNX Runtime
+  /// \param tolerance is the maximum absolute difference allowed on each score
+  /// \return true if all scores agree within tolerance
+  bool validate(OnnxModel& onnxModel, const float tolerance = 1.e-5f) const;
+
+  // Getters
+  bool isInitialised() const { return mInitialised; }
+  int getNumFeaturesUsed() const { return mNFeaturesUsed; }
+  int getNumOutputNodes() const { return mNOutputs; }
+  int getNumTrees() const { return static_cast<int>(mRoots.size()); }
+  int getNumNodes() const { return static_cast<int>(mFeature.size()); }
+
+ private:
+  enum PostTransform : uint8_t {
+    None = 0,
+    Logistic,
+    Softmax,
+    SoftmaxZero
+  };
+
+  enum NodeFlags : uint8_t {
+    FlagLessOrEqual = 1 << 0, // split is x <= threshold (x < threshold otherwise)
+    FlagNanTrue = 1 << 1      // missing values (NaN) follow the true branch
+  };
+
+  static constexpr int NRowsBlock = 8;  // number of rows traversed in lockstep in batched evaluation
+  static constexpr int MaxTargets = 16; // maximum number of classes or regression targets
+
+  // Flattened nodes (structure of arrays); trees are stored contiguously in depth-first order
+  std::vector<int32_t> mFeature;   // feature index tested by the node, -1 for leaves
+  std::vector<float> mThreshold;   // split threshold
+  std::vector<int32_t> mTrueNode;  // node index if the split condition holds, leaf index for leaves
+  std::vector<int32_t> mFalseNode; // node index if the split condition does not hold
+  std::vector<uint8_t> mFlags;     // NodeFlags of the node
+  std::vector<int32_t> mRoots;     // index of the root node of each tree
+
+  // Leaf weights in compressed sparse row format
+  std::vector<int32_t> mLeafOffsets; // first weight of each leaf, size = number of leaves + 1
+  std::vector<int32_t> mLeafTargets; // class/target index of each weight
+  std::vector<float> mLeafWeights;   // weight values
+
+  std::vector<float> mBaseValues; // base values added to the summed scores
+  bool mIsClassifier = true;      // TreeEnsembleClassifier or TreeEnsembleRegressor
+  bool mBinaryCase = false;       // two classes with weights for a single class only
+  bool mPositiveWeights = true;   // all leaf weights are non-negative (binary case only)
+  bool mAverage = false;          // regressor aggregate function is AVERAGE instead of SUM
+  PostTransform mPostTransform = PostTransform::None;
+  int mNTargets = 0;              // number of classes or regression targets
+  int mNOutputs = 0;              // number of output scores per row
+  int mNFeaturesUsed = 0;         // largest feature index used + 1
+  bool mInitialised = false;
+
+  void accumulateLeaf(const int32_t leaf, float* scores) const;
+  void finalizeScores(float* scores, float* output) const;
+};
+
+} // namespace ml
+
+} // namespace o2
+
+#endif // TOOLS_ML_TREEENSEMBLEMODEL_H_
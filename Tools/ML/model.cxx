@@ -31,6 +31,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace o2
@@ -68,6 +69,46 @@ bool OnnxModel::checkHyperloop(const bool verbose)
   return alienCoresFound;
 }
 
+OnnxModel::OnnxModel(OnnxModel&& other) noexcept
+{
+  *this = std::move(other);
+}
+
+OnnxModel& OnnxModel::operator=(OnnxModel&& other) noexcept
+{
+  if (this == &other) {
+    return *this;
+  }
+  mEnv = std::move(other.mEnv);
+  mSession = std::move(other.mSession);
+  sessionOptions = std::move(other.sessionOptions);
+  mInputNames = std::move(other.mInputNames);
+  mInputShapes = std::move(other.mInputShapes);
+  mOutputNames = std::move(other.mOutputNames);
+  mOutputShapes = std::move(other.mOutputShapes);
+  mMemoryInfo = std::move(other.mMemoryInfo);
+  modelPath = std::move(other.modelPath);
+  activeThreads = other.activeThreads;
+  validFrom = other.validFrom;
+  validUntil = other.validUntil;
+  buildNodeNameViews();
+  other.mInputNamesChar.clear();
+  other.mOutputNamesChar.clear();
+  return *this;
+}
+
+void OnnxModel::buildNodeNameViews()
+{
+  mInputNamesChar.clear();
+  for (const auto& name : mInputNames) {
+    mInputNamesChar.push_back(name.c_str());
+  }
+  mOutputNamesChar.clear();
+  for (const auto& name : mOutputNames) {
+    mOutputNamesChar.push_back(name.c_str());
+  }
+}
+
 void OnnxModel::initModel(const std::string& localPath, const bool enableOptimizations, const int threads, const uint64_t from, const uint64_t until)
 {
 
@@ -90,6 +131,14 @@ void OnnxModel::initModel(const std::string& localPath, const bool enableOptimiz
   mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
   mSession = std::make_shared<Ort::Session>(*mEnv, modelPath.c_str(), sessionOptions);
 
+  // the model can be re-initialised (e.g. on a change of CCDB validity): the node descriptions of the previous model are dropped
+  mInputNames.clear();
+  mInputShapes.clear();
+  mOutputNames.clear();
+  mOutputShapes.clear();
+  mInputNamesChar.clear();
+  mOutputNamesChar.clear();
+
   Ort::AllocatorWithDefaultOptions const tmpAllocator;
   for (std::size_t i = 0; i < mSession->GetInputCount(); ++i) {
     mInputNames.push_back(mSession->GetInputNameAllocated(i, tmpAllocator).get());
@@ -103,6 +152,10 @@ void OnnxModel::initModel(const std::string& localPath, const bool enableOptimiz
   for (std::size_t i = 0; i < mSession->GetOutputCount(); ++i) {
     mOutputShapes.emplace_back(mSession->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
   }
+  // the string vectors are final here, their C-string views stay valid until the next initialisation or move
+  buildNodeNameViews();
+  mMemoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+
   LOG(info) << "Input Nodes:";
   for (std::size_t i = 0; i < mInputNames.size(); i++) {
     LOG(info) << "\t" << mInputNames[i] << " : " << printShape(mInputShapes[i]);
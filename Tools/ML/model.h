@@ -45,6 +45,11 @@ class OnnxModel
  public:
   OnnxModel() = default;
   ~OnnxModel() = default;
+  OnnxModel(const OnnxModel&) = delete;
+  OnnxModel& operator=(const OnnxModel&) = delete;
+  // the C-string views of the node names are rebuilt on move (e.g. on the reallocation of a vector of models)
+  OnnxModel(OnnxModel&&) noexcept;
+  OnnxModel& operator=(OnnxModel&&) noexcept;
 
   // Inferencing
   void initModel(const std::string&, const bool = false, const int = 0, const uint64_t = 0, const uint64_t = 0);
@@ -58,14 +63,7 @@ class OnnxModel
 
     try {
       const Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(mInputNames.size(), nullptr);
-      std::transform(std::begin(mInputNames), std::end(mInputNames), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<const char*> outputNamesChar(mOutputNames.size(), nullptr);
-      std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-      auto outputTensors = mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size());
+      auto outputTensors = mSession->Run(runOptions, mInputNamesChar.data(), input.data(), input.size(), mOutputNamesChar.data(), mOutputNamesChar.size());
       LOG(debug) << "Number of output tensors: " << outputTensors.size();
       if (outputTensors.size() != mOutputNames.size()) {
         LOG(fatal) << "Number of output tensors: " << outputTensors.size() << " does not agree with the model specified size: " << mOutputNames.size();
@@ -91,9 +89,7 @@ class OnnxModel
     assert(size % mInputShapes[0][1] == 0);
     std::vector<int64_t> inputShape{size / mInputShapes[0][1], mInputShapes[0][1]};
     std::vector<Ort::Value> inputTensors;
-    Ort::MemoryInfo memInfo =
-      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-    inputTensors.emplace_back(Ort::Value::CreateTensor<T>(memInfo, input.data(), size, inputShape.data(), inputShape.size()));
+    inputTensors.emplace_back(Ort::Value::CreateTensor<T>(mMemoryInfo, input.data(), size, inputShape.data(), inputShape.size()));
     LOG(debug) << "Input shape calculated from vector: " << printShape(inputShape);
     return evalModel<T>(inputTensors);
   }
@@ -104,8 +100,6 @@ class OnnxModel
   {
     std::vector<Ort::Value> inputTensors;
 
-    Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-
     for (std::size_t iinput = 0; iinput < input.size(); iinput++) {
       [[maybe_unused]] int totalSize = 1;
       int64_t size = input[iinput].size();
@@ -119,12 +113,39 @@ class OnnxModel
         inputShape.push_back(mInputShapes[iinput][idim]);
       }
 
-      inputTensors.emplace_back(Ort::Value::CreateTensor<T>(memInfo, input[iinput].data(), size, inputShape.data(), inputShape.size()));
+      inputTensors.emplace_back(Ort::Value::CreateTensor<T>(mMemoryInfo, input[iinput].data(), size, inputShape.data(), inputShape.size()));
     }
 
     return evalModel<T>(inputTensors);
   }
 
+  // For batched inputs: nRows rows of getNumInputNodes() features each, stored contiguously (row-major)
+  // The scores of the last output tensor are copied into output, which is resized to the number of returned values
+  template <typename T>
+  bool evalModel(T* input, const int64_t nRows, std::vector<T>& output)
+  {
+    const int64_t nFeatures = mInputShapes[0][1];
+    const int64_t inputShape[2] = {nRows, nFeatures};
+    Ort::Value inputTensor = Ort::Value::CreateTensor<T>(mMemoryInfo, input, nRows * nFeatures, inputShape, 2);
+    LOG(debug) << "Batched input of " << nRows << " rows with " << nFeatures << " features";
+
+    try {
+      const Ort::RunOptions runOptions;
+      auto outputTensors = mSession->Run(runOptions, mInputNamesChar.data(), &inputTensor, 1, mOutputNamesChar.data(), mOutputNamesChar.size());
+      if (outputTensors.size() != mOutputNames.size()) {
+        LOG(fatal) << "Number of output tensors: " << outputTensors.size() << " does not agree with the model specified size: " << mOutputNames.size();
+      }
+      const std::size_t nValues = outputTensors.back().GetTensorTypeAndShapeInfo().GetElementCount();
+      const T* outputValues = outputTensors.back().GetTensorData<T>();
+      output.assign(outputValues, outputValues + nValues);
+      return true;
+    } catch (const Ort::Exception& exception) {
+      LOG(error) << "Error running batched model inference: " << exception.what();
+    }
+    output.clear();
+    return false;
+  }
+
   // Reset session
   void resetSession()
   {
@@ -155,6 +176,9 @@ class OnnxModel
   std::vector<std::vector<int64_t>> mInputShapes;
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mOutputShapes;
+  std::vector<const char*> mInputNamesChar;  // C-string views of mInputNames, rebuilt at initialisation and on move
+  std::vector<const char*> mOutputNamesChar; // C-string views of mOutputNames, rebuilt at initialisation and on move
+  Ort::MemoryInfo mMemoryInfo{nullptr};      // CPU memory info used to wrap input buffers into tensors
 
   // Environment settings
   std::string modelPath;
@@ -165,6 +189,7 @@ class OnnxModel
   // Internal function for printing the shape of tensors
   std::string printShape(const std::vector<int64_t>&);
   bool checkHyperloop(const bool = true);
+  void buildNodeNameViews();
 };
 
 } // namespace ml